@@ -0,0 +1,114 @@
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+ Header:       BenchUtils.h
+ Date started: June 2016
+ Purpose:      Helpers shared by the benchmark programs
+ Called by:    JSBSimBench.cpp, PropertyTreeBench.cpp
+
+ ------------- Copyright (C) 2016  JSBSim development team  -------------
+
+ This program is free software; you can redistribute it and/or modify it under
+ the terms of the GNU Lesser General Public License as published by the Free Software
+ Foundation; either version 2 of the License, or (at your option) any later
+ version.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ details.
+
+ You should have received a copy of the GNU Lesser General Public License along with
+ this program; if not, write to the Free Software Foundation, Inc., 59 Temple
+ Place - Suite 330, Boston, MA  02111-1307, USA.
+
+ Further information about the GNU Lesser General Public License can also be found on
+ the world wide web at http://www.gnu.org.
+
+FUNCTIONAL DESCRIPTION
+--------------------------------------------------------------------------------
+
+The benchmark programs write their results to the standard output as CSV lines:
+
+  benchmark,case,value,unit
+
+while the messages that the models write to the standard output are discarded
+(see NullBuffer) so that they do not get mixed with the results. This header
+is included by the main file of each program only.
+
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+SENTRY
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+#ifndef BENCHUTILS_H
+#define BENCHUTILS_H
+
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+INCLUDES
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+#include <chrono>
+#include <iostream>
+#include <string>
+
+#include "FGFDMExec.h"
+
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+DEFINITIONS
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+typedef std::chrono::steady_clock Clock;
+
+// Each measurement is repeated until it has lasted at least that long.
+static const double MinDuration = 0.2;
+
+// Stream buffer that discards everything.
+class NullBuffer : public std::streambuf
+{
+protected:
+  int overflow(int c) { return c; }
+};
+
+// The results go to the standard output even once std::cout is redirected to
+// a NullBuffer.
+static std::ostream Results(std::cout.rdbuf());
+
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+FUNCTIONS
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+// Returns the time elapsed since start in seconds.
+inline double Seconds(Clock::time_point start)
+{
+  return std::chrono::duration<double>(Clock::now() - start).count();
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+inline void Report(const std::string& benchmark, const std::string& name,
+                   double value, const std::string& unit)
+{
+  Results << benchmark << ',' << name << ',' << value << ',' << unit
+          << std::endl;
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+// Loads the script scripts/<script>.xml from the root directory and runs its
+// initial conditions with the output disabled. Returns 0 if that fails.
+
+inline JSBSim::FGFDMExec* Load(const std::string& root,
+                               const std::string& script)
+{
+  JSBSim::FGFDMExec* fdm = new JSBSim::FGFDMExec;
+  fdm->SetRootDir(root);
+  fdm->SetAircraftPath("aircraft");
+  fdm->SetEnginePath("engine");
+  fdm->SetSystemsPath("systems");
+  fdm->DisableOutput();
+  if (!fdm->LoadScript("scripts/" + script + ".xml") || !fdm->RunIC()) {
+    delete fdm;
+    return 0;
+  }
+  return fdm;
+}
+
+#endif
@@ -0,0 +1,692 @@
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+ Module:       JSBSimBench.cpp
+ Date started: June 2016
+ Purpose:      Micro and macro benchmarks of JSBSim
+ Called by:    The USER.
+
+ ------------- Copyright (C) 2016  JSBSim development team  -------------
+
+ This program is free software; you can redistribute it and/or modify it under
+ the terms of the GNU Lesser General Public License as published by the Free Software
+ Foundation; either version 2 of the License, or (at your option) any later
+ version.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ details.
+
+ You should have received a copy of the GNU Lesser General Public License along with
+ this program; if not, write to the Free Software Foundation, Inc., 59 Temple
+ Place - Suite 330, Boston, MA  02111-1307, USA.
+
+ Further information about the GNU Lesser General Public License can also be found on
+ the world wide web at http://www.gnu.org.
+
+FUNCTIONAL DESCRIPTION
+--------------------------------------------------------------------------------
+
+Measures the throughput of the building blocks of the simulation (the micro
+benchmarks) and of complete simulations run without any output (the macro
+benchmarks). The program is run from the JSBSim root directory (or given its
+path as an argument) and writes its results to the standard output as CSV
+lines, in the same format as property_bench:
+
+  benchmark,case,value,unit
+
+The micro benchmarks report the mean duration of an operation in ns/op. The
+macro benchmarks run each script until it ends or until the given duration
+has elapsed and report the frame rate and the ratio of the simulated time to
+the elapsed time. The options are:
+
+  --micro           only run the micro benchmarks
+  --macro           only run the macro benchmarks
+  --duration=<sec>  maximum duration of each macro benchmark (default 5 s)
+
+The messages that the models write to the standard output are discarded so
+that they do not get mixed with the results.
+
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+INCLUDES
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+#include <cmath>
+#include <cstdlib>
+#include <deque>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "FGFDMExec.h"
+#include "input_output/FGPropertyManager.h"
+#include "input_output/FGXMLParse.h"
+#include "math/FGFunction.h"
+#include "math/FGHistory.h"
+#include "math/FGLocation.h"
+#include "math/FGMatrix33.h"
+#include "math/FGQuaternion.h"
+#include "math/FGTable.h"
+#include "models/FGAccelerations.h"
+#include "models/FGGroundReactions.h"
+#include "BenchUtils.h"
+
+using namespace std;
+using namespace JSBSim;
+
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+DEFINITIONS
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+static const char* Scripts[] = {"c1723", "737_cruise", "ball_orbit",
+                                "ah1s_flight_test"};
+
+// Number of operations between two readings of the clock.
+static const unsigned int Batch = 1024;
+
+// The results of the operations are accumulated there so that the compiler
+// can not optimize them away.
+static volatile double Sink = 0.0;
+
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+FUNCTIONS
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+// Calls op(i) with i cycling over [0, Batch) and returns the mean duration of
+// a call in nanoseconds.
+
+template <typename Op>
+static double Measure(Op& op)
+{
+  double total = 0.0;
+  size_t count = 0;
+  Clock::time_point start = Clock::now();
+
+  do {
+    for (unsigned int i=0; i<Batch; i++)
+      total += op(i);
+    count += Batch;
+  } while (Seconds(start) < MinDuration);
+
+  double elapsed = Seconds(start);
+  Sink = Sink + total;
+  return 1E9 * elapsed / count;
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+// Returns Batch pseudo random values uniformly distributed in [lo, hi]. The
+// generator is seeded so that the runs are comparable.
+
+static vector<double> Keys(double lo, double hi, unsigned int seed)
+{
+  vector<double> keys(Batch);
+  unsigned int x = seed;
+  for (unsigned int i=0; i<Batch; i++) {
+    x = 1664525*x + 1013904223;
+    keys[i] = lo + (hi - lo) * (x >> 8) / 16777215.0;
+  }
+  return keys;
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+static Element_ptr ParseXML(const string& xml)
+{
+  FGXMLParse parser;
+  istringstream input(xml);
+  readXML(input, parser);
+  return parser.GetDocument();
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+// Returns the data of a table with the given number of rows and columns. The
+// breakpoints are evenly spaced over [0, rows) and [0, cols).
+
+static string TableData(int rows, int cols, double offset)
+{
+  ostringstream data;
+  if (cols > 1) {
+    for (int c=0; c<cols; c++) data << ' ' << c;
+    data << endl;
+  }
+  for (int r=0; r<rows; r++) {
+    data << r;
+    for (int c=0; c<max(cols, 1); c++)
+      data << ' ' << sin(0.3*r + 0.7*c + offset);
+    data << endl;
+  }
+  return data.str();
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+struct Table1D {
+  FGTable* table;
+  vector<double> keys;
+  double operator()(unsigned int i) { return table->GetValue(keys[i]); }
+};
+
+// Looks up the keys by groups of Size: the duration is spread over the calls.
+struct Table1DBatch {
+  FGTable* table;
+  vector<double> keys, values;
+  unsigned int Size;
+  double operator()(unsigned int i) {
+    if (i % Size) return 0.0;
+    table->GetValues(&keys[i], &values[0], Size);
+    return values[0];
+  }
+};
+
+struct Table2D {
+  FGTable* table;
+  vector<double> rows, cols;
+  double operator()(unsigned int i) { return table->GetValue(rows[i], cols[i]); }
+};
+
+struct Table3D {
+  FGTable* table;
+  vector<double> rows, cols, tables;
+  double operator()(unsigned int i) {
+    return table->GetValue(rows[i], cols[i], tables[i]);
+  }
+};
+
+struct Function {
+  FGFunction* function;
+  FGPropertyNode *alpha, *flap;
+  vector<double> alphas, flaps;
+  double operator()(unsigned int i) {
+    alpha->setDoubleValue(alphas[i]);
+    flap->setDoubleValue(flaps[i]);
+    return function->GetValue();
+  }
+};
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+static void TableBenchmarks(FGFDMExec& fdm)
+{
+  FGPropertyManager* pm = fdm.GetPropertyManager();
+  pm->GetNode("bench/row", true);
+  pm->GetNode("bench/column", true);
+  pm->GetNode("bench/table", true);
+
+  const int rows = 40, cols = 12, tables = 6;
+
+  Element_ptr el1 = ParseXML("<table><independentVar>bench/row</independentVar>"
+                             "<tableData>" + TableData(rows, 0, 0.0) +
+                             "</tableData></table>");
+  Element_ptr el2 = ParseXML("<table>"
+                             "<independentVar lookup=\"row\">bench/row</independentVar>"
+                             "<independentVar lookup=\"column\">bench/column</independentVar>"
+                             "<tableData>" + TableData(rows, cols, 0.0) +
+                             "</tableData></table>");
+  ostringstream xml3;
+  xml3 << "<table>"
+       << "<independentVar lookup=\"row\">bench/row</independentVar>"
+       << "<independentVar lookup=\"column\">bench/column</independentVar>"
+       << "<independentVar lookup=\"table\">bench/table</independentVar>";
+  for (int t=0; t<tables; t++)
+    xml3 << "<tableData breakPoint=\"" << t << "\">"
+         << TableData(rows, cols, t) << "</tableData>";
+  xml3 << "</table>";
+  Element_ptr el3 = ParseXML(xml3.str());
+
+  FGTable table1(pm, el1);
+  FGTable table2(pm, el2);
+  FGTable table3(pm, el3);
+
+  // The keys slightly overflow the breakpoints on both sides.
+  Table1D t1;
+  t1.table = &table1;
+  t1.keys = Keys(-1.0, rows, 1);
+  Report("table", "1d", Measure(t1), "ns/op");
+
+  Table1DBatch t1b;
+  t1b.table = &table1;
+  t1b.keys = t1.keys;
+  t1b.Size = 16;
+  t1b.values.resize(t1b.Size);
+  Report("table", "1d_batch", Measure(t1b), "ns/op");
+
+  Table2D t2;
+  t2.table = &table2;
+  t2.rows = t1.keys;
+  t2.cols = Keys(-1.0, cols, 2);
+  Report("table", "2d", Measure(t2), "ns/op");
+
+  Table3D t3;
+  t3.table = &table3;
+  t3.rows = t2.rows;
+  t3.cols = t2.cols;
+  t3.tables = Keys(-1.0, tables, 3);
+  Report("table", "3d", Measure(t3), "ns/op");
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+// The functions are typical of the aerodynamic coefficients: a product of
+// properties and of a table, and an expression made of elementary functions.
+// They are not named so that they are not tied to properties that would
+// outlive them.
+
+static void FunctionBenchmarks(FGFDMExec& fdm)
+{
+  FGPropertyManager* pm = fdm.GetPropertyManager();
+  pm->GetNode("bench/qbar", true)->setDoubleValue(80.0);
+  pm->GetNode("bench/sw", true)->setDoubleValue(174.0);
+
+  Element_ptr product = ParseXML(
+    "<function><product>"
+    "<property>bench/qbar</property><property>bench/sw</property>"
+    "<table>"
+    "<independentVar lookup=\"row\">bench/row</independentVar>"
+    "<independentVar lookup=\"column\">bench/column</independentVar>"
+    "<tableData>" + TableData(40, 12, 0.0) + "</tableData></table>"
+    "</product></function>");
+  Element_ptr expression = ParseXML(
+    "<function><sum>"
+    "<product><value>0.5</value><sin><property>bench/row</property></sin></product>"
+    "<quotient><property>bench/qbar</property>"
+    "<pow><property>bench/column</property><value>2</value></pow></quotient>"
+    "<difference><abs><property>bench/row</property></abs>"
+    "<value>1.0</value></difference>"
+    "</sum></function>");
+
+  FGFunction lift(&fdm, product);
+  FGFunction expr(&fdm, expression);
+
+  Function f;
+  f.alpha = pm->GetNode("bench/row");
+  f.flap = pm->GetNode("bench/column");
+  f.alphas = Keys(-1.0, 40, 4);
+  f.flaps = Keys(1.0, 12, 5);
+
+  f.function = &lift;
+  Report("function", "product_table", Measure(f), "ns/op");
+  f.function = &expr;
+  Report("function", "expression", Measure(f), "ns/op");
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+struct MatrixVector {
+  vector<FGMatrix33> m;
+  vector<FGColumnVector3> v;
+  double operator()(unsigned int i) { return (m[i] * v[i])(1); }
+};
+
+struct MatrixMatrix {
+  vector<FGMatrix33> m;
+  double operator()(unsigned int i) {
+    return (m[i] * m[(i+1) % Batch])(1,2);
+  }
+};
+
+struct MatrixInverse {
+  vector<FGMatrix33> m;
+  double operator()(unsigned int i) { return m[i].Inverse()(2,3); }
+};
+
+struct CrossProduct {
+  vector<FGColumnVector3> v;
+  double operator()(unsigned int i) {
+    return (v[i] * v[(i+1) % Batch]).Normalize()(3);
+  }
+};
+
+struct QuaternionProduct {
+  vector<FGQuaternion> q;
+  double operator()(unsigned int i) {
+    return (q[i] * q[(i+1) % Batch])(1);
+  }
+};
+
+struct QuaternionMatrix {
+  vector<double> phi, theta, psi;
+  double operator()(unsigned int i) {
+    FGQuaternion q(phi[i], theta[i], psi[i]);
+    return q.GetT()(1,2);
+  }
+};
+
+struct QuaternionEuler {
+  vector<FGMatrix33> m;
+  double operator()(unsigned int i) { return m[i].GetEuler()(2); }
+};
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+static void MathBenchmarks(void)
+{
+  vector<double> phi = Keys(-M_PI, M_PI, 6);
+  vector<double> theta = Keys(-0.5*M_PI, 0.5*M_PI, 7);
+  vector<double> psi = Keys(0.0, 2.0*M_PI, 8);
+  vector<FGMatrix33> matrices(Batch);
+  vector<FGColumnVector3> vectors(Batch);
+  vector<FGQuaternion> quaternions(Batch);
+
+  for (unsigned int i=0; i<Batch; i++) {
+    quaternions[i] = FGQuaternion(phi[i], theta[i], psi[i]);
+    matrices[i] = quaternions[i].GetT();
+    vectors[i] = FGColumnVector3(phi[i], theta[i], psi[i]);
+  }
+
+  MatrixVector mv;
+  mv.m = matrices;
+  mv.v = vectors;
+  Report("matrix33", "times_vector", Measure(mv), "ns/op");
+
+  MatrixMatrix mm;
+  mm.m = matrices;
+  Report("matrix33", "times_matrix", Measure(mm), "ns/op");
+
+  MatrixInverse mi;
+  mi.m = matrices;
+  Report("matrix33", "inverse", Measure(mi), "ns/op");
+
+  QuaternionEuler me;
+  me.m = matrices;
+  Report("matrix33", "euler", Measure(me), "ns/op");
+
+  CrossProduct cp;
+  cp.v = vectors;
+  Report("columnvector3", "cross_normalize", Measure(cp), "ns/op");
+
+  QuaternionProduct qp;
+  qp.q = quaternions;
+  Report("quaternion", "product", Measure(qp), "ns/op");
+
+  QuaternionMatrix qm;
+  qm.phi = phi;
+  qm.theta = theta;
+  qm.psi = psi;
+  Report("quaternion", "from_euler_to_matrix", Measure(qm), "ns/op");
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+// The histories of the derivatives that FGPropagate integrates with the
+// Adams-Bashforth schemes: 3 vectors and 1 quaternion. They are stored either
+// in FGHistory or, as they formerly were, in std::deque.
+
+template <typename T>
+static void Assign(deque<T>& history, const T& value)
+{
+  history.assign(5, value);
+}
+
+template <typename T>
+static void Assign(FGHistory<T, 5>& history, const T& value)
+{
+  history.assign(value);
+}
+
+template <typename T>
+static void Push(deque<T>& history, const T& value)
+{
+  history.push_front(value);
+  history.pop_back();
+}
+
+template <typename T>
+static void Push(FGHistory<T, 5>& history, const T& value)
+{
+  history.push(value);
+}
+
+template <typename V, typename Q>
+struct Histories {
+  V vectors[3];
+  Q quaternion;
+
+  void Assign(const FGColumnVector3& v, const FGQuaternion& q) {
+    for (unsigned int k=0; k<3; k++) ::Assign(vectors[k], v);
+    ::Assign(quaternion, q);
+  }
+};
+
+// Pushes the derivatives and integrates them with the AB4 scheme, as
+// FGPropagate does at each step.
+template <typename V, typename Q>
+struct HistoryStep {
+  Histories<V, Q> histories;
+  vector<FGColumnVector3> v;
+  vector<FGQuaternion> q;
+  double operator()(unsigned int i) {
+    double result = 0.0;
+    for (unsigned int k=0; k<3; k++) {
+      V& h = histories.vectors[k];
+      Push(h, v[(i+k) % Batch]);
+      result += ((55.0*h[0] - 59.0*h[1] + 37.0*h[2] - 9.0*h[3])/24.0)(1);
+    }
+    Q& h = histories.quaternion;
+    Push(h, q[i]);
+    FGQuaternion dq = (55.0/24.0)*h[0] + (-59.0/24.0)*h[1] + (37.0/24.0)*h[2]
+                    + (-9.0/24.0)*h[3];
+    return result + dq(1);
+  }
+};
+
+// Copies the histories, as a snapshot of the state does.
+template <typename V, typename Q>
+struct HistoryCopy {
+  Histories<V, Q> source, target;
+  double operator()(unsigned int i) {
+    target = source;
+    return target.vectors[i % 3][0](1);
+  }
+};
+
+template <typename V, typename Q>
+static void HistoryBenchmark(const string& name,
+                             const vector<FGColumnVector3>& vectors,
+                             const vector<FGQuaternion>& quaternions)
+{
+  HistoryStep<V, Q> step;
+  step.histories.Assign(vectors[0], quaternions[0]);
+  step.v = vectors;
+  step.q = quaternions;
+  Report("history", name + "_push_ab4", Measure(step), "ns/op");
+
+  HistoryCopy<V, Q> copy;
+  copy.source = step.histories;
+  Report("history", name + "_copy", Measure(copy), "ns/op");
+}
+
+static void HistoryBenchmarks(void)
+{
+  vector<double> x = Keys(-1.0, 1.0, 9);
+  vector<double> y = Keys(-1.0, 1.0, 10);
+  vector<double> z = Keys(-1.0, 1.0, 11);
+  vector<FGColumnVector3> vectors(Batch);
+  vector<FGQuaternion> quaternions(Batch);
+
+  for (unsigned int i=0; i<Batch; i++) {
+    vectors[i] = FGColumnVector3(x[i], y[i], z[i]);
+    quaternions[i] = FGQuaternion(x[i], y[i], z[i]);
+  }
+
+  HistoryBenchmark<deque<FGColumnVector3>, deque<FGQuaternion> >
+    ("deque", vectors, quaternions);
+  HistoryBenchmark<FGHistory<FGColumnVector3, 5>, FGHistory<FGQuaternion, 5> >
+    ("fghistory", vectors, quaternions);
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+// WGS84 semimajor and semiminor axes in feet.
+static const double Semimajor = 20925646.32546;
+static const double Semiminor = 20855486.5951;
+
+struct GeodeticToECEF {
+  vector<double> lon, lat, h;
+  double operator()(unsigned int i) {
+    FGLocation loc;
+    loc.SetEllipse(Semimajor, Semiminor);
+    loc.SetPositionGeodetic(lon[i], lat[i], h[i]);
+    return loc(1);
+  }
+};
+
+struct ECEFToGeodetic {
+  vector<FGColumnVector3> ecef;
+  double operator()(unsigned int i) {
+    FGLocation loc(ecef[i]);
+    loc.SetEllipse(Semimajor, Semiminor);
+    return loc.GetGeodLatitudeRad() + loc.GetGeodAltitude();
+  }
+};
+
+struct LocalFrame {
+  vector<FGColumnVector3> ecef;
+  double operator()(unsigned int i) {
+    FGLocation loc(ecef[i]);
+    return loc.GetTec2l()(1,1) + loc.GetLongitude();
+  }
+};
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+static void LocationBenchmarks(void)
+{
+  GeodeticToECEF g2e;
+  g2e.lon = Keys(-M_PI, M_PI, 9);
+  g2e.lat = Keys(-0.5*M_PI, 0.5*M_PI, 10);
+  g2e.h = Keys(0.0, 40000.0, 11);
+  Report("location", "geodetic_to_ecef", Measure(g2e), "ns/op");
+
+  ECEFToGeodetic e2g;
+  for (unsigned int i=0; i<Batch; i++) {
+    FGLocation loc;
+    loc.SetEllipse(Semimajor, Semiminor);
+    loc.SetPositionGeodetic(g2e.lon[i], g2e.lat[i], g2e.h[i]);
+    e2g.ecef.push_back(FGColumnVector3(loc(1), loc(2), loc(3)));
+  }
+  Report("location", "ecef_to_geodetic", Measure(e2g), "ns/op");
+
+  LocalFrame lf;
+  lf.ecef = e2g.ecef;
+  Report("location", "local_frame", Measure(lf), "ns/op");
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+// The friction forces of the gear units in contact with the ground are solved
+// by FGAccelerations::Run() once the accelerations of the rigid body are
+// computed. The benchmark runs it on the inputs of an aircraft at rest on the
+// runway: they do not change from one call to the next.
+
+struct GearFriction {
+  FGAccelerations* accelerations;
+  double operator()(unsigned int) {
+    accelerations->Run(false);
+    return accelerations->GetForces(1);
+  }
+};
+
+static bool GearBenchmarks(const string& root)
+{
+  FGFDMExec* fdm = Load(root, "c172_runway_at_rest_cg_shift");
+  if (!fdm) {
+    cerr << "Failed to load the script c172_runway_at_rest_cg_shift" << endl;
+    return false;
+  }
+
+  // Let the aircraft settle on its gear.
+  for (int i=0; i<120; i++) fdm->Run();
+
+  GearFriction gf;
+  gf.accelerations = fdm->GetAccelerations();
+  Report("gear_friction", "contacts",
+         fdm->GetGroundReactions()->GetMultipliersList()->size(), "multipliers");
+  Report("gear_friction", "c172x_at_rest", Measure(gf), "ns/op");
+
+  delete fdm;
+  return true;
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+// Runs the script until it ends or until the duration has elapsed.
+
+static bool ScriptBenchmark(const string& root, const string& script,
+                            double duration)
+{
+  FGFDMExec* fdm = Load(root, script);
+  if (!fdm) {
+    cerr << "Failed to load the script " << script << endl;
+    return false;
+  }
+
+  double start_time = fdm->GetSimTime();
+  size_t frames = 0;
+  Clock::time_point start = Clock::now();
+
+  do {
+    bool result = true;
+    for (unsigned int i=0; i<100 && result; i++) {
+      result = fdm->Run();
+      frames++;
+    }
+    if (!result) break;
+  } while (Seconds(start) < duration);
+
+  double elapsed = Seconds(start);
+  Report("script", script + "_frames", frames, "frames");
+  Report("script", script + "_fps", frames / elapsed, "frames/s");
+  Report("script", script + "_realtime",
+         (fdm->GetSimTime() - start_time) / elapsed, "x");
+
+  delete fdm;
+  return true;
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+int main(int argc, char* argv[])
+{
+  string root = "./";
+  bool micro = true, macro = true;
+  double duration = 5.0;
+
+  for (int i=1; i<argc; i++) {
+    string arg = argv[i];
+    if (arg == "--micro")
+      macro = false;
+    else if (arg == "--macro")
+      micro = false;
+    else if (arg.compare(0, 11, "--duration=") == 0)
+      duration = atof(arg.c_str() + 11);
+    else if (arg.compare(0, 2, "--") == 0) {
+      cerr << "Usage: " << argv[0]
+           << " [--micro] [--macro] [--duration=<sec>] [root]" << endl;
+      return EXIT_FAILURE;
+    }
+    else
+      root = arg + "/";
+  }
+
+  NullBuffer discard;
+  streambuf* output = cout.rdbuf(&discard);
+  FGJSBBase::debug_lvl = 0;
+  int status = EXIT_SUCCESS;
+
+  Results << "benchmark,case,value,unit" << endl;
+
+  if (micro) {
+    FGFDMExec fdm;
+    TableBenchmarks(fdm);
+    FunctionBenchmarks(fdm);
+    MathBenchmarks();
+    HistoryBenchmarks();
+    LocationBenchmarks();
+    if (!GearBenchmarks(root)) status = EXIT_FAILURE;
+  }
+
+  if (macro) {
+    for (unsigned int i=0; i<sizeof(Scripts)/sizeof(Scripts[0]); i++)
+      if (!ScriptBenchmark(root, Scripts[i], duration)) status = EXIT_FAILURE;
+  }
+
+  cout.rdbuf(output);
+  return status;
+}
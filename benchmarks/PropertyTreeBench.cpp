@@ -0,0 +1,191 @@
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+ Module:       PropertyTreeBench.cpp
+ Date started: June 2016
+ Purpose:      Benchmark of the property tree
+ Called by:    The USER.
+
+ ------------- Copyright (C) 2016  JSBSim development team  -------------
+
+ This program is free software; you can redistribute it and/or modify it under
+ the terms of the GNU Lesser General Public License as published by the Free Software
+ Foundation; either version 2 of the License, or (at your option) any later
+ version.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ details.
+
+ You should have received a copy of the GNU Lesser General Public License along with
+ this program; if not, write to the Free Software Foundation, Inc., 59 Temple
+ Place - Suite 330, Boston, MA  02111-1307, USA.
+
+ Further information about the GNU Lesser General Public License can also be found on
+ the world wide web at http://www.gnu.org.
+
+FUNCTIONAL DESCRIPTION
+--------------------------------------------------------------------------------
+
+Measures the time needed to load the bundled aircraft (most of which is spent
+binding the properties) and the throughput of the property lookups by name.
+The program is run from the JSBSim root directory (or given its path as an
+argument) and writes its results to the standard output as CSV lines:
+
+  benchmark,case,value,unit
+
+The messages that the models write to the standard output while they are
+loaded are discarded so that they do not get mixed with the results.
+
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+INCLUDES
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+#include <cstdlib>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "FGFDMExec.h"
+#include "input_output/FGPropertyManager.h"
+#include "BenchUtils.h"
+
+using namespace std;
+using namespace JSBSim;
+
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+DEFINITIONS
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+static const char* Scripts[] = {"c1723", "737_cruise", "ah1s_flight_test",
+                                "x153", "Short_S23_1"};
+
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+FUNCTIONS
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+// Collects the nodes of the tree and their paths relative to the root.
+
+static void Collect(FGPropertyNode* node, const string& path,
+                    vector<FGPropertyNode*>& nodes, vector<string>& paths)
+{
+  for (int i=0; i<node->nChildren(); i++) {
+    FGPropertyNode* child = static_cast<FGPropertyNode*>(node->getChild(i));
+    ostringstream name;
+    name << path << child->getNameString() << '[' << child->getIndex() << ']';
+    nodes.push_back(child);
+    paths.push_back(name.str());
+    Collect(child, name.str() + '/', nodes, paths);
+  }
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+// Returns the number of lookups per second of the full paths.
+
+static double PathLookups(FGPropertyNode* root, const vector<string>& paths)
+{
+  size_t count = 0;
+  Clock::time_point start = Clock::now();
+
+  do {
+    for (unsigned int i=0; i<paths.size(); i++) {
+      if (!root->GetNode(paths[i])) {
+        cerr << "Lookup failed: " << paths[i] << endl;
+        exit(EXIT_FAILURE);
+      }
+    }
+    count += paths.size();
+  } while (Seconds(start) < MinDuration);
+
+  return count / Seconds(start);
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+// Returns the number of lookups per second of the nodes by name and index in
+// their parent.
+
+static double ChildLookups(const vector<FGPropertyNode*>& nodes)
+{
+  size_t count = 0;
+  Clock::time_point start = Clock::now();
+
+  do {
+    for (unsigned int i=0; i<nodes.size(); i++) {
+      FGPropertyNode* node = nodes[i];
+      if (node->getParent()->getChild(node->getName(), node->getIndex()) != node) {
+        cerr << "Lookup failed: " << node->GetFullyQualifiedName() << endl;
+        exit(EXIT_FAILURE);
+      }
+    }
+    count += nodes.size();
+  } while (Seconds(start) < MinDuration);
+
+  return count / Seconds(start);
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+int main(int argc, char* argv[])
+{
+  string root = argc > 1 ? string(argv[1]) + "/" : "./";
+  NullBuffer discard;
+  streambuf* output = cout.rdbuf(&discard);
+  FGJSBBase::debug_lvl = 0;
+
+  Results << "benchmark,case,value,unit" << endl;
+
+  for (unsigned int i=0; i<sizeof(Scripts)/sizeof(Scripts[0]); i++) {
+    const string script = Scripts[i];
+    const int repeats = 5;
+    FGFDMExec* fdm = 0;
+
+    Clock::time_point start = Clock::now();
+    for (int r=0; r<repeats; r++) {
+      delete fdm;
+      fdm = Load(root, script);
+      if (!fdm) {
+        cerr << "Failed to load the script " << script << endl;
+        cout.rdbuf(output);
+        return EXIT_FAILURE;
+      }
+    }
+    Report("load", script, 1000.0 * Seconds(start) / repeats, "ms");
+
+    FGPropertyNode* tree = fdm->GetPropertyManager()->GetNode();
+    vector<FGPropertyNode*> nodes;
+    vector<string> paths;
+    Collect(tree, "", nodes, paths);
+
+    int widest = 0;
+    for (unsigned int j=0; j<nodes.size(); j++)
+      widest = max(widest, nodes[j]->nChildren());
+
+    Report("properties", script, nodes.size(), "nodes");
+    Report("widest_node", script, widest, "children");
+    Report("path_lookup", script, PathLookups(tree, paths), "lookups/s");
+    Report("child_lookup", script, ChildLookups(nodes), "lookups/s");
+
+    delete fdm;
+  }
+
+  // A node with many children, as found in the arrays of engines, tanks or
+  // gear units of some models.
+  const int sizes[] = {8, 64, 512, 4096};
+  for (unsigned int i=0; i<sizeof(sizes)/sizeof(sizes[0]); i++) {
+    FGPropertyManager pm;
+    FGPropertyNode* wide = pm.GetNode("wide", true);
+    vector<FGPropertyNode*> nodes;
+
+    Clock::time_point start = Clock::now();
+    for (int j=0; j<sizes[i]; j++)
+      nodes.push_back(wide->GetNode("item", j, true));
+    ostringstream name;
+    name << "wide_" << sizes[i];
+    Report("create", name.str(), 1e9 * Seconds(start) / sizes[i], "ns/node");
+    Report("child_lookup", name.str(), ChildLookups(nodes), "lookups/s");
+  }
+
+  cout.rdbuf(output);
+  return EXIT_SUCCESS;
+}
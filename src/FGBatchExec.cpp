@@ -0,0 +1,235 @@
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+Module: FGBatchExec.cpp
+Date started: February 2016
+Purpose: Runs a batch of independent FDM instances on a pool of threads
+
+ ------------- Copyright (C) 2016  JSBSim development team  -------------
+
+ This program is free software; you can redistribute it and/or modify it under
+ the terms of the GNU Lesser General Public License as published by the Free Software
+ Foundation; either version 2 of the License, or (at your option) any later
+ version.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ details.
+
+ You should have received a copy of the GNU Lesser General Public License along with
+ this program; if not, write to the Free Software Foundation, Inc., 59 Temple
+ Place - Suite 330, Boston, MA  02111-1307, USA.
+
+ Further information about the GNU Lesser General Public License can also be found on
+ the world wide web at http://www.gnu.org.
+
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+INCLUDES
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+#include <iostream>
+#include <exception>
+#include "FGBatchExec.h"
+#include "FGFDMExec.h"
+
+using namespace std;
+
+namespace JSBSim {
+
+IDENT(IdSrc,"$Id$");
+IDENT(IdHdr,ID_BATCHEXEC);
+
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+LOCAL CLASSES
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+namespace {
+
+class RunICTask : public FGBatchExec::Task
+{
+public:
+  bool Execute(FGFDMExec* fdm, unsigned int) { return fdm->RunIC(); }
+};
+
+class RunTask : public FGBatchExec::Task
+{
+public:
+  RunTask(unsigned int n) : steps(n) {}
+  bool Execute(FGFDMExec* fdm, unsigned int) {
+    for (unsigned int i=0; i<steps; i++)
+      if (!fdm->Run()) return false;
+    return true;
+  }
+private:
+  unsigned int steps;
+};
+
+}
+
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+CLASS IMPLEMENTATION
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+FGBatchExec::FGBatchExec(unsigned int nthreads)
+  : Pool(nthreads)
+{
+  Debug(0);
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+FGBatchExec::~FGBatchExec()
+{
+  for (unsigned int i=0; i<Instances.size(); i++) delete Instances[i].exec;
+
+  Debug(1);
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+FGFDMExec* FGBatchExec::AddInstance(void)
+{
+  Instance instance;
+
+  instance.exec = new FGFDMExec();
+  instance.running = true;
+  Instances.push_back(instance);
+
+  return instance.exec;
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+FGFDMExec* FGBatchExec::GetInstance(unsigned int idx) const
+{
+  if (idx >= Instances.size()) return 0;
+
+  return Instances[idx].exec;
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+bool FGBatchExec::IsRunning(unsigned int idx) const
+{
+  if (idx >= Instances.size()) return false;
+
+  return Instances[idx].running;
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+string FGBatchExec::GetError(unsigned int idx) const
+{
+  if (idx >= Instances.size()) return string();
+
+  return Instances[idx].error;
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+// Each iteration of the job only accesses the instance it is in charge of so no
+// synchronization is needed. The exceptions must not leave the thread pool:
+// they stop the instance that has thrown them.
+
+bool FGBatchExec::ForEach(Task& task)
+{
+  class BatchJob : public FGThreadPool::Job {
+  public:
+    BatchJob(vector<Instance>& inst, Task& t) : instances(inst), task(t) {}
+    void Execute(unsigned int idx) {
+      Instance& instance = instances[idx];
+      if (!instance.running) return;
+
+      try {
+        instance.running = task.Execute(instance.exec, idx);
+      } catch (const string& msg) {
+        instance.running = false;
+        instance.error = msg;
+      } catch (const exception& e) {
+        instance.running = false;
+        instance.error = e.what();
+      } catch (...) {
+        instance.running = false;
+        instance.error = "Unknown exception";
+      }
+    }
+  private:
+    vector<Instance>& instances;
+    Task& task;
+  } job(Instances, task);
+
+  vector<bool> started(Instances.size());
+  for (unsigned int i=0; i<Instances.size(); i++)
+    started[i] = Instances[i].running;
+
+  Pool.ParallelFor(Instances.size(), job);
+
+  bool running = false;
+  for (unsigned int i=0; i<Instances.size(); i++) {
+    if (started[i] && !Instances[i].error.empty() && debug_lvl > 0)
+      cerr << "Instance #" << i << " stopped: " << Instances[i].error << endl;
+    running = running || Instances[i].running;
+  }
+
+  return running;
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+bool FGBatchExec::RunIC(void)
+{
+  RunICTask task;
+  return ForEach(task);
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+bool FGBatchExec::Run(unsigned int steps)
+{
+  RunTask task(steps);
+  return ForEach(task);
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+//    The bitmasked value choices are as follows:
+//    unset: In this case (the default) JSBSim would only print
+//       out the normally expected messages, essentially echoing
+//       the config files as they are read. If the environment
+//       variable is not set, debug_lvl is set to 1 internally
+//    0: This requests JSBSim not to output any messages
+//       whatsoever.
+//    1: This value explicity requests the normal JSBSim
+//       startup messages
+//    2: This value asks for a message to be printed out when
+//       a class is instantiated
+//    4: When this value is set, a message is displayed when a
+//       FGModel object executes its Run() method
+//    8: When this value is set, various runtime state variables
+//       are printed out periodically
+//    16: When set various parameters are sanity checked and
+//       a message is printed out when they go out of bounds
+
+void FGBatchExec::Debug(int from)
+{
+  if (debug_lvl <= 0) return;
+
+  if (debug_lvl & 1) { // Standard console startup message output
+  }
+  if (debug_lvl & 2 ) { // Instantiation/Destruction notification
+    if (from == 0) cout << "Instantiated: FGBatchExec" << endl;
+    if (from == 1) cout << "Destroyed:    FGBatchExec" << endl;
+  }
+  if (debug_lvl & 4 ) { // Run() method entry print for FGModel-derived objects
+  }
+  if (debug_lvl & 8 ) { // Runtime state variables
+  }
+  if (debug_lvl & 16) { // Sanity checking
+  }
+  if (debug_lvl & 64) {
+    if (from == 0) { // Constructor
+      cout << IdSrc << endl;
+      cout << IdHdr << endl;
+    }
+  }
+}
+
+}
@@ -0,0 +1,165 @@
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+Header: FGBatchExec.h
+Date started: February 2016
+
+ ------------- Copyright (C) 2016  JSBSim development team  -------------
+
+ This program is free software; you can redistribute it and/or modify it under
+ the terms of the GNU Lesser General Public License as published by the Free Software
+ Foundation; either version 2 of the License, or (at your option) any later
+ version.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ details.
+
+ You should have received a copy of the GNU Lesser General Public License along with
+ this program; if not, write to the Free Software Foundation, Inc., 59 Temple
+ Place - Suite 330, Boston, MA  02111-1307, USA.
+
+ Further information about the GNU Lesser General Public License can also be found on
+ the world wide web at http://www.gnu.org.
+
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+SENTRY
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+#ifndef FGBATCHEXEC_H
+#define FGBATCHEXEC_H
+
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+INCLUDES
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+#include <vector>
+#include <string>
+
+#include "FGJSBBase.h"
+#include "FGThreadPool.h"
+
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+DEFINITIONS
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+#define ID_BATCHEXEC "$Id$"
+
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+FORWARD DECLARATIONS
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+namespace JSBSim {
+
+class FGFDMExec;
+
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+CLASS DOCUMENTATION
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+/** Runs a batch of independent FDM instances on a pool of threads.
+    The batch owns the FGFDMExec instances created by AddInstance(). Each
+    instance has its own property tree, its own ground callback and its own
+    models so the instances do not share any mutable data: the only process
+    wide data that JSBSim uses (debug level and message queue) are local to
+    each thread.
+
+    The instances are set up from the calling thread (paths, scripts, initial
+    conditions, etc.) and are then executed in parallel by RunIC(), Run() or
+    ForEach(). The iterations are distributed between the threads of a
+    work-stealing FGThreadPool. Since the instances are independent, the
+    results of an instance are exactly the same than the results of the same
+    instance run alone, whatever the number of threads.
+
+    Each instance also draws its random numbers from its own streams (see
+    FGFDMExec::GetRandom()) so the results of the models that use random
+    numbers only depend on the seed of their instance.
+
+    Usage:
+    @code
+    FGBatchExec batch(4);
+    for (unsigned int i=0; i<100; i++) {
+      FGFDMExec* fdm = batch.AddInstance();
+      fdm->SetRootDir(root);
+      fdm->LoadScript(script);
+    }
+    batch.RunIC();
+    while (batch.Run()) {}
+    @endcode
+*/
+
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+CLASS DECLARATION
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+class FGBatchExec : public FGJSBBase
+{
+public:
+  /// The interface of the tasks executed on each instance of the batch.
+  class Task {
+  public:
+    virtual ~Task() {}
+    /** Executes the task on an instance.
+        @param fdm the instance.
+        @param index the index of the instance in the batch.
+        @return false if the instance must be stopped. */
+    virtual bool Execute(FGFDMExec* fdm, unsigned int index) = 0;
+  };
+
+  /** Constructor.
+      @param nthreads the number of threads used to run the instances. If 0,
+                      the number of hardware threads is used. */
+  FGBatchExec(unsigned int nthreads = 0);
+  /// Destructor. Deletes all the instances of the batch.
+  ~FGBatchExec();
+
+  /** Creates a new instance in the batch.
+      @return a pointer to the new instance. */
+  FGFDMExec* AddInstance(void);
+
+  /// Returns the number of instances in the batch.
+  unsigned int GetNumInstances(void) const { return Instances.size(); }
+  /// Returns the number of threads used to run the batch.
+  unsigned int GetNumThreads(void) const { return Pool.GetNumThreads(); }
+  /** Returns an instance of the batch.
+      @param idx the index of the instance.
+      @return a pointer to the instance or 0 if the index is out of range. */
+  FGFDMExec* GetInstance(unsigned int idx) const;
+  /** Checks if an instance is still running.
+      An instance is stopped when a task returns false or throws an exception.
+      @param idx the index of the instance. */
+  bool IsRunning(unsigned int idx) const;
+  /** Returns the error that stopped an instance.
+      @param idx the index of the instance.
+      @return the message of the exception caught or an empty string. */
+  std::string GetError(unsigned int idx) const;
+
+  /** Executes a task on all the running instances.
+      @param task the task to execute.
+      @return true if at least one instance is still running. */
+  bool ForEach(Task& task);
+  /** Calls FGFDMExec::RunIC() for all the running instances.
+      @return true if at least one instance is still running. */
+  bool RunIC(void);
+  /** Calls FGFDMExec::Run() for all the running instances. The instances for
+      which Run() returns false are stopped.
+      @param steps the number of time steps to execute.
+      @return true if at least one instance is still running. */
+  bool Run(unsigned int steps = 1);
+
+private:
+  struct Instance {
+    FGFDMExec* exec;
+    bool running;
+    std::string error;
+  };
+
+  FGThreadPool Pool;
+  std::vector<Instance> Instances;
+
+  void Debug(int from);
+};
+
+} // namespace JSBSim
+
+#endif
@@ -46,9 +46,13 @@ INCLUDES
 #include <iterator>
 #include <cstdlib>
 #include <iomanip>
+#include <exception>
+#include <set>
+#include <thread>
 
 #include "FGFDMExec.h"
 #include "models/atmosphere/FGStandardAtmosphere.h"
+#include "models/atmosphere/FGMSIS.h"
 #include "models/atmosphere/FGWinds.h"
 #include "models/FGFCS.h"
 #include "models/FGPropulsion.h"
@@ -66,7 +70,9 @@ INCLUDES
 #include "models/FGOutput.h"
 #include "initialization/FGTrim.h"
 #include "input_output/FGScript.h"
-#include "input_output/FGXMLFileRead.h"
+#include "math/FGFunctionOptimizer.h"
+#include "math/FGTable.h"
+#include "FGThreadPool.h"
 
 using namespace std;
 
@@ -90,11 +96,17 @@ FGFDMExec::FGFDMExec(FGPropertyManager* root, unsigned int* fdmctr) : Root(root)
   Trim            = 0;
   Script          = 0;
   disperse        = 0;
+  FunctionOptimizer = 0;
+  ModelPool       = 0;
+  Profiler        = 0;
+  StopProfiling   = false;
+  FrameProfile    = 0;
 
   RootDir = "";
 
   modelLoaded = false;
   IsChild = false;
+  AtmosphereModel = eStandardAtmosphere;
   holding = false;
   Terminate = false;
   StandAlone = false;
@@ -111,6 +123,7 @@ FGFDMExec::FGFDMExec(FGPropertyManager* root, unsigned int* fdmctr) : Root(root)
   AircraftPath = "aircraft";
   EnginePath = "engine";
   SystemsPath = "systems";
+  ModelCache = new FGModelCache;
 
   try {
     char* num = getenv("JSBSIM_DEBUG");
@@ -162,6 +175,14 @@ FGFDMExec::FGFDMExec(FGPropertyManager* root, unsigned int* fdmctr) : Root(root)
   trim_completed = 0;
 
   Constructing = true;
+  BindProperties();
+  Constructing = false;
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+void FGFDMExec::BindProperties(void)
+{
   typedef int (FGFDMExec::*iPMF)(void) const;
   instance->Tie("simulation/do_simple_trim", this, (iPMF)0, &FGFDMExec::DoTrim, false);
   instance->Tie("simulation/reset", this, (iPMF)0, &FGFDMExec::ResetToInitialConditions, false);
@@ -173,8 +194,8 @@ FGFDMExec::FGFDMExec(FGPropertyManager* root, unsigned int* fdmctr) : Root(root)
   instance->Tie("simulation/jsbsim-debug", this, &FGFDMExec::GetDebugLevel, &FGFDMExec::SetDebugLevel);
   instance->Tie("simulation/frame", (int *)&Frame, false);
   instance->Tie("simulation/trim-completed", (int *)&trim_completed, false);
-
-  Constructing = false;
+  instance->Tie("simulation/parallel-models", this, &FGFDMExec::GetParallelModels, &FGFDMExec::SetParallelModels);
+  instance->Tie("profiling/enabled", this, &FGFDMExec::GetProfiling, &FGFDMExec::SetProfiling);
 }
 
 //%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
@@ -182,8 +203,10 @@ FGFDMExec::FGFDMExec(FGPropertyManager* root, unsigned int* fdmctr) : Root(root)
 FGFDMExec::~FGFDMExec()
 {
   try {
+    DeleteProfiler();
     Unbind();
     DeAllocate();
+    delete ModelPool;
 
     delete instance;
 
@@ -206,8 +229,6 @@ FGFDMExec::~FGFDMExec()
   ChildFDMList.clear();
 
   PropertyCatalog.clear();
-  
-  SetGroundCallback(0);
 
   if (FDMctr > 0) (*FDMctr)--;
 
@@ -227,23 +248,36 @@ bool FGFDMExec::Allocate(void)
   // Note that this does not affect the order in which the models will be
   // executed later.
   Models[eInertial]          = new FGInertial(this);
-  SetGroundCallback(new FGDefaultGroundCallback(static_cast<FGInertial*>(Models[eInertial])->GetRefRadius()));
 
   // See the eModels enum specification in the header file. The order of the
   // enums specifies the order of execution. The Models[] vector is the primary
   // storage array for the list of models.
   Models[ePropagate]         = new FGPropagate(this);
   Models[eInput]             = new FGInput(this);
-  Models[eAtmosphere]        = new FGStandardAtmosphere(this);
+  if (AtmosphereModel == eMSISAtmosphere)
+    Models[eAtmosphere]      = new MSIS(this);
+  else
+    Models[eAtmosphere]      = new FGStandardAtmosphere(this);
   Models[eWinds]             = new FGWinds(this);
   Models[eSystems]           = new FGFCS(this);
   Models[eMassBalance]       = new FGMassBalance(this);
   Models[eAuxiliary]         = new FGAuxiliary(this);
+
+  // The properties tied by the models that can be executed concurrently are
+  // recorded (see BuildStages).
+  ModelProperties.assign(eNumStandardModels, vector<FGPropertyNode*>());
+  size_t first = instance->GetNumTiedProperties();
   Models[ePropulsion]        = new FGPropulsion(this);
+  AssignTiedProperties(ePropulsion, first);
   Models[eAerodynamics]      = new FGAerodynamics (this);
+  AssignTiedProperties(eAerodynamics, first);
   Models[eGroundReactions]   = new FGGroundReactions(this);
+  AssignTiedProperties(eGroundReactions, first);
   Models[eExternalReactions] = new FGExternalReactions(this);
+  AssignTiedProperties(eExternalReactions, first);
   Models[eBuoyantForces]     = new FGBuoyantForces(this);
+  AssignTiedProperties(eBuoyantForces, first);
+
   Models[eAircraft]          = new FGAircraft(this);
   Models[eAccelerations]     = new FGAccelerations(this);
   Models[eOutput]            = new FGOutput(this);
@@ -292,11 +326,21 @@ bool FGFDMExec::DeAllocate(void)
 
   for (unsigned int i=0; i<eNumStandardModels; i++) delete Models[i];
   Models.clear();
+  Stages.clear();
+  ModelProperties.clear();
 
   delete Script;
   delete IC;
   delete Trim;
 
+  // The shared expressions are referenced by the model functions so they must
+  // be deleted after the models.
+  delete FunctionOptimizer;
+  FunctionOptimizer = 0;
+
+  // The nodes of the snapshot properties must be looked up again.
+  SnapshotProperties = 0;
+
   Error       = 0;
 
   modelLoaded = false;
@@ -309,6 +353,9 @@ bool FGFDMExec::Run(void)
 {
   bool success=true;
 
+  if (StopProfiling) DeleteProfiler();
+  FGProfiler::Timer frameTimer(FrameProfile);
+
   Debug(2);
 
   for (unsigned int i=1; i<ChildFDMList.size(); i++) {
@@ -321,9 +368,25 @@ bool FGFDMExec::Run(void)
   // returns true if success, false if complete
   if (Script != 0 && !IntegrationSuspended()) success = Script->RunScript();
 
-  for (unsigned int i = 0; i < Models.size(); i++) {
-    LoadInputs(i);
-    Models[i]->Run(holding);
+  if (Stages.empty()) {
+    if (ModelProfiles.empty()) {
+      for (unsigned int i = 0; i < Models.size(); i++) {
+        LoadInputs(i);
+        Models[i]->Run(holding);
+      }
+    } else {
+      for (unsigned int i = 0; i < Models.size(); i++) {
+        {
+          FGProfiler::Timer timer(InputsProfiles[i]);
+          LoadInputs(i);
+        }
+        FGProfiler::Timer timer(ModelProfiles[i]);
+        Models[i]->Run(holding);
+      }
+    }
+  } else {
+    for (unsigned int i = 0; i < Stages.size(); i++)
+      RunStage(Stages[i]);
   }
 
   if (ResetMode) {
@@ -338,6 +401,107 @@ bool FGFDMExec::Run(void)
   return success;
 }
 
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+// Executes the models of a stage concurrently. The messages posted by each
+// model are collected by the thread that executes it and are then forwarded in
+// the order of the models, as if they had been executed sequentially.
+
+namespace {
+class ModelJob : public FGThreadPool::Job
+{
+public:
+  ModelJob(const vector<FGModel*>& models, const vector<unsigned int>& idx,
+           bool hold, const vector<FGProfiler::Section*>& profiles)
+    : Models(models), Indices(idx), Holding(hold), Profiles(profiles),
+      Errors(idx.size()), Posted(idx.size()) {}
+
+  void Execute(unsigned int i) {
+    FGModel* model = Models[Indices[i]];
+    try {
+      FGProfiler::Timer timer(Profiles.empty() ? 0 : Profiles[Indices[i]]);
+      model->Run(Holding);
+    }
+    catch (...) {
+      Errors[i] = current_exception();
+    }
+    while (model->SomeMessages())
+      Posted[i].push_back(*model->ProcessNextMessage());
+  }
+
+  const vector<FGModel*>& Models;
+  const vector<unsigned int>& Indices;
+  bool Holding;
+  const vector<FGProfiler::Section*>& Profiles;
+  vector<exception_ptr> Errors;
+  vector<vector<FGJSBBase::Message> > Posted;
+};
+}
+
+void FGFDMExec::RunStage(const ModelStage& stage)
+{
+  if (stage.Models.size() == 1) {
+    unsigned int idx = stage.Models[0];
+    if (ModelProfiles.empty()) {
+      LoadInputs(idx);
+      Models[idx]->Run(holding);
+    } else {
+      {
+        FGProfiler::Timer timer(InputsProfiles[idx]);
+        LoadInputs(idx);
+      }
+      FGProfiler::Timer timer(ModelProfiles[idx]);
+      Models[idx]->Run(holding);
+    }
+    return;
+  }
+
+  for (unsigned int i=0; i<stage.Models.size(); i++) {
+    unsigned int idx = stage.Models[i];
+    FGProfiler::Timer timer(InputsProfiles.empty() ? 0 : InputsProfiles[idx]);
+    LoadInputs(idx);
+  }
+
+  for (unsigned int i=0; i<stage.SharedReads.size(); i++)
+    stage.SharedReads[i]->getDoubleValue();
+
+  // The calling thread executes some of the models so its pending messages
+  // are put aside while the stage is executed.
+  queue<Message> pending;
+  pending.swap(Messages);
+
+  ModelJob job(Models, stage.Models, holding, ModelProfiles);
+  ModelPool->ParallelFor(stage.Models.size(), job);
+
+  Messages.swap(pending);
+  for (unsigned int i=0; i<job.Posted.size(); i++) {
+    for (unsigned int j=0; j<job.Posted[i].size(); j++) {
+      Message& msg = job.Posted[i][j];
+      msg.messageId = messageId++;
+      PutMessage(msg);
+    }
+  }
+
+  for (unsigned int i=0; i<job.Errors.size(); i++)
+    if (job.Errors[i]) rethrow_exception(job.Errors[i]);
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+void FGFDMExec::EvaluateDerivatives(void)
+{
+  static const eModels models[] = {eInertial, eAtmosphere, eAuxiliary,
+                                   eAerodynamics, eExternalReactions,
+                                   eAircraft, eAccelerations};
+
+  for (unsigned int i = 0; i < sizeof(models)/sizeof(models[0]); i++) {
+    if (Models[models[i]]->GetRate() != 1) continue;
+    LoadInputs(models[i]);
+    Models[models[i]]->Run(false);
+  }
+
+  LoadInputs(ePropagate);
+}
+
 //%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
 
 void FGFDMExec::LoadInputs(unsigned int idx)
@@ -357,9 +521,12 @@ void FGFDMExec::LoadInputs(unsigned int idx)
     break;
   case eAtmosphere:
     Atmosphere->in.altitudeASL = Propagate->GetAltitudeASL();
+    Atmosphere->in.fieldTemperature = Winds->GetFieldTemperature();
     break;
   case eWinds:
     Winds->in.AltitudeASL      = Propagate->GetAltitudeASL();
+    Winds->in.latitude         = Propagate->GetGeodLatitudeRad();
+    Winds->in.longitude        = Propagate->GetLongitude();
     Winds->in.DistanceAGL      = Propagate->GetDistanceAGL();
     Winds->in.Tl2b             = Propagate->GetTl2b();
     Winds->in.Tw2b             = Auxiliary->GetTw2b();
@@ -560,6 +727,10 @@ bool FGFDMExec::RunIC(void)
   Models[eInput]->InitModel();
   Models[eOutput]->InitModel();
 
+  // Measure the input and output instances that have been added since the
+  // profiling has been enabled.
+  if (Profiler) ProfileModels();
+
   Run();
   ResumeIntegration(); // Restores the integration rate to what it was.
 
@@ -641,6 +812,7 @@ vector <string> FGFDMExec::EnumerateFDMs(void)
 bool FGFDMExec::LoadScript(const string& script, double deltaT, const string& initfile)
 {
   bool result;
+  Element::DispersionScope dispersions(GetRandom("dispersions"));
 
   Script = new FGScript(this);
   result = Script->LoadScript(RootDir + script, deltaT, initfile);
@@ -665,7 +837,6 @@ bool FGFDMExec::LoadModel(const string& AircraftPath, const string& EnginePath,
 bool FGFDMExec::LoadModel(const string& model, bool addModelToPath)
 {
   string aircraftCfgFileName;
-  bool result = false; // initialize result to false, indicating input file not yet read
 
   modelName = model; // Set the class modelName attribute
 
@@ -679,14 +850,59 @@ bool FGFDMExec::LoadModel(const string& model, bool addModelToPath)
   if (addModelToPath) FullAircraftPath += "/" + model;
   aircraftCfgFileName = FullAircraftPath + "/" + model + ".xml";
 
+  if (ModelCache->GetFileName() == aircraftCfgFileName) {
+    // The model has already been loaded, for instance from another instance
+    // before a script using the same aircraft is loaded.
+    if (modelLoaded) return true;
+  } else
+    ModelCache = new FGModelCache(aircraftCfgFileName, CacheDir);
+
+  return ReadModel(aircraftCfgFileName);
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+bool FGFDMExec::LoadModel(const FGFDMExec& fdmex)
+{
+  if (!fdmex.modelLoaded) {
+    cerr << "Error: attempted to load the aircraft of an instance which has "
+         << "not loaded any aircraft" << endl;
+    return false;
+  }
+
+  if (!SetAtmosphereModel(fdmex.AtmosphereModel)) return false;
+
+  modelName = fdmex.modelName;
+  AircraftPath = fdmex.AircraftPath;
+  EnginePath = fdmex.EnginePath;
+  SystemsPath = fdmex.SystemsPath;
+  FullAircraftPath = fdmex.FullAircraftPath;
+  CacheDir = fdmex.CacheDir;
+  ModelCache = fdmex.ModelCache;
+
+  // Some components use the time step when they are loaded.
+  dT = fdmex.IntegrationSuspended() ? fdmex.saved_dT : fdmex.dT;
+
+  return ReadModel(ModelCache->GetFileName());
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+bool FGFDMExec::ReadModel(const string& aircraftCfgFileName)
+{
+  bool result = false; // initialize result to false, indicating input file not yet read
+  Element::DispersionScope dispersions(GetRandom("dispersions"));
+
   if (modelLoaded) {
     DeAllocate();
     Allocate();
   }
 
+  // The instances sharing the cache load their model one at a time.
+  FGModelCache::Scope cache(ModelCache);
+
   int saved_debug_lvl = debug_lvl;
-  FGXMLFileRead XMLFileRead;
-  Element *document = XMLFileRead.LoadXMLDocument(aircraftCfgFileName); // "document" is a class member
+  Element *document = ModelCache->LoadXMLDocument(aircraftCfgFileName);
 
   if (document) {
     if (IsChild) debug_lvl = 0;
@@ -736,7 +952,9 @@ bool FGFDMExec::LoadModel(const string& model, bool addModelToPath)
     // Process the ground_reactions element. This element is REQUIRED.
     element = document->FindElement("ground_reactions");
     if (element) {
+      size_t first = instance->GetNumTiedProperties();
       result = ((FGGroundReactions*)Models[eGroundReactions])->Load(element);
+      AssignTiedProperties(eGroundReactions, first);
       if (!result) {
         cerr << endl << "Aircraft ground_reactions element has problems in file " << aircraftCfgFileName << endl;
         return result;
@@ -750,7 +968,9 @@ bool FGFDMExec::LoadModel(const string& model, bool addModelToPath)
     // Process the external_reactions element. This element is OPTIONAL.
     element = document->FindElement("external_reactions");
     if (element) {
+      size_t first = instance->GetNumTiedProperties();
       result = ((FGExternalReactions*)Models[eExternalReactions])->Load(element);
+      AssignTiedProperties(eExternalReactions, first);
       if (!result) {
         cerr << endl << "Aircraft external_reactions element has problems in file " << aircraftCfgFileName << endl;
         return result;
@@ -760,7 +980,9 @@ bool FGFDMExec::LoadModel(const string& model, bool addModelToPath)
     // Process the buoyant_forces element. This element is OPTIONAL.
     element = document->FindElement("buoyant_forces");
     if (element) {
+      size_t first = instance->GetNumTiedProperties();
       result = ((FGBuoyantForces*)Models[eBuoyantForces])->Load(element);
+      AssignTiedProperties(eBuoyantForces, first);
       if (!result) {
         cerr << endl << "Aircraft buoyant_forces element has problems in file " << aircraftCfgFileName << endl;
         return result;
@@ -770,7 +992,9 @@ bool FGFDMExec::LoadModel(const string& model, bool addModelToPath)
     // Process the propulsion element. This element is OPTIONAL.
     element = document->FindElement("propulsion");
     if (element) {
+      size_t first = instance->GetNumTiedProperties();
       result = ((FGPropulsion*)Models[ePropulsion])->Load(element);
+      AssignTiedProperties(ePropulsion, first);
       if (!result) {
         cerr << endl << "Aircraft propulsion element has problems in file " << aircraftCfgFileName << endl;
         return result;
@@ -813,7 +1037,9 @@ bool FGFDMExec::LoadModel(const string& model, bool addModelToPath)
     // Process the aerodynamics element. This element is OPTIONAL, but almost always expected.
     element = document->FindElement("aerodynamics");
     if (element) {
+      size_t first = instance->GetNumTiedProperties();
       result = ((FGAerodynamics*)Models[eAerodynamics])->Load(element);
+      AssignTiedProperties(eAerodynamics, first);
       if (!result) {
         cerr << endl << "Aircraft aerodynamics element has problems in file " << aircraftCfgFileName << endl;
         return result;
@@ -855,7 +1081,18 @@ bool FGFDMExec::LoadModel(const string& model, bool addModelToPath)
     // structure for the FGModel-derived classes.
     LoadModelConstants();
 
+    // Now that all the functions are loaded, merge the sub-expressions that
+    // they have in common.
+    if (FGFunctionOptimizer::IsEnabled()) {
+      FunctionOptimizer = new FGFunctionOptimizer;
+      for (unsigned int i=0; i<Models.size(); i++)
+        Models[i]->RegisterFunctions(*FunctionOptimizer);
+      FunctionOptimizer->Optimize();
+    }
+
     modelLoaded = true;
+    if (ModelPool) BuildStages();
+    if (Profiler) ProfileModels();
 
     if (IsChild) debug_lvl = saved_debug_lvl;
 
@@ -1033,6 +1270,20 @@ bool FGFDMExec::ReadPrologue(Element* el) // el for ReadPrologue is the document
 
 //%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
 
+void FGFDMExec::SetGroundCallback(FGGroundCallback* gc)
+{
+  Inertial->SetGroundCallback(gc);
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+FGGroundCallback* FGFDMExec::GetGroundCallback(void) const
+{
+  return Inertial->GetGroundCallback();
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
 bool FGFDMExec::ReadChild(Element* el)
 {
   // Add a new childData object to the child FDM list
@@ -1047,6 +1298,7 @@ bool FGFDMExec::ReadChild(Element* el)
 
   child->exec = new FGFDMExec(Root, FDMctr);
   child->exec->SetChild(true);
+  child->exec->SetGroundCallback(GetGroundCallback());
 
   string childAircraft = el->GetAttributeValue("name");
   string sMated = el->GetAttributeValue("mated");
@@ -1057,6 +1309,7 @@ bool FGFDMExec::ReadChild(Element* el)
   child->exec->SetAircraftPath( AircraftPath );
   child->exec->SetEnginePath( EnginePath );
   child->exec->SetSystemsPath( SystemsPath );
+  child->exec->SetCacheDir( CacheDir );
   child->exec->LoadModel(childAircraft);
 
   Element* location = el->FindElement("location");
@@ -1143,8 +1396,436 @@ void FGFDMExec::DoTrim(int mode)
 void FGFDMExec::SRand(int sr)
 {
   RandomSeed = sr;
-  gaussian_random_number_phase = 0;
-  srand(RandomSeed);
+
+  map<string, FGRandom>::iterator it;
+  for (it = RandomStreams.begin(); it != RandomStreams.end(); ++it)
+    it->second.Seed(RandomSeed);
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+FGRandom* FGFDMExec::GetRandom(const string& name)
+{
+  map<string, FGRandom>::iterator it = RandomStreams.find(name);
+
+  if (it == RandomStreams.end())
+    it = RandomStreams.insert(make_pair(name, FGRandom(RandomSeed, name))).first;
+
+  return &it->second;
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+// The properties that are tied to a member of a class are restored with that
+// member: only the properties that store their value themselves are collected.
+
+static void CollectUntiedNodes(SGPropertyNode* node, vector<FGPropertyNode*>& nodes)
+{
+  for (int i=0; i<node->nChildren(); i++) {
+    SGPropertyNode* child = node->getChild(i);
+
+    if (!child->isTied()) {
+      switch(child->getType()) {
+      case simgear::props::BOOL:
+      case simgear::props::INT:
+      case simgear::props::LONG:
+      case simgear::props::FLOAT:
+      case simgear::props::DOUBLE:
+        nodes.push_back(static_cast<FGPropertyNode*>(child));
+        break;
+      default:
+        break;
+      }
+    }
+
+    CollectUntiedNodes(child, nodes);
+  }
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+void FGFDMExec::SetParallelModels(int nthreads)
+{
+  delete ModelPool;
+  ModelPool = 0;
+  Stages.clear();
+
+  if (nthreads > 1) {
+    ModelPool = new FGThreadPool(min(nthreads, 5));
+    // The stages only last a few microseconds: the threads should not go to
+    // sleep between them unless they would take the processors from each
+    // other.
+    if ((unsigned int)nthreads <= thread::hardware_concurrency())
+      ModelPool->SetSpinWait(200);
+    if (modelLoaded) BuildStages();
+  }
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+int FGFDMExec::GetParallelModels(void) const
+{
+  return ModelPool ? ModelPool->GetNumThreads() : 1;
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+void FGFDMExec::SetProfiling(bool enabled)
+{
+  if (!enabled) {
+    if (Profiler) StopProfiling = true;
+    return;
+  }
+
+  StopProfiling = false;
+  if (!Profiler) {
+    Profiler = new FGProfiler(instance);
+    ProfileModels();
+  }
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+bool FGFDMExec::SetAtmosphereModel(eAtmosphereModel model)
+{
+  if (model == AtmosphereModel) return true;
+
+  if (modelLoaded) {
+    cerr << "The atmosphere model must be selected before the aircraft is loaded"
+         << endl;
+    return false;
+  }
+
+  AtmosphereModel = model;
+
+  // The models tie their properties again when they are allocated.
+  bool profiling = GetProfiling();
+  DeleteProfiler();
+  Unbind();
+  DeAllocate();
+  Allocate();
+  Constructing = true;
+  BindProperties();
+  Constructing = false;
+  if (profiling) SetProfiling(true);
+
+  return true;
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+void FGFDMExec::DeleteProfiler(void)
+{
+  if (!Profiler) return;
+
+  for (unsigned int i=0; i<Models.size(); i++)
+    Models[i]->SetProfiler(0);
+  ModelProfiles.clear();
+  InputsProfiles.clear();
+  FrameProfile = 0;
+  StopProfiling = false;
+
+  delete Profiler;
+  Profiler = 0;
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+// Creates the sections of the executive and asks the models to create theirs.
+// Since the profiler returns the existing sections, this can be called again
+// to take into account the elements added to the models.
+
+void FGFDMExec::ProfileModels(void)
+{
+  static const char* names[eNumStandardModels] = {
+    "propagate", "input", "inertial", "atmosphere", "winds", "fcs",
+    "mass-balance", "auxiliary", "propulsion", "aerodynamics",
+    "ground-reactions", "external-reactions", "buoyant-forces", "aircraft",
+    "accelerations", "output"};
+
+  FrameProfile = Profiler->AddSection("frame");
+  ModelProfiles.resize(Models.size());
+  InputsProfiles.resize(Models.size());
+
+  for (unsigned int i=0; i<Models.size(); i++) {
+    string path = string("models/") + names[i];
+    ModelProfiles[i] = Profiler->AddSection(path);
+    InputsProfiles[i] = Profiler->AddSection(path + "/load-inputs");
+    Models[i]->SetProfiler(Profiler);
+  }
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+// Records the properties tied by a model since the index 'first'. 'first' is
+// then moved past them.
+
+void FGFDMExec::AssignTiedProperties(unsigned int idx, size_t& first)
+{
+  size_t last = instance->GetNumTiedProperties();
+
+  for (size_t i=first; i<last; i++)
+    ModelProperties[idx].push_back(instance->GetTiedProperty(i));
+
+  first = last;
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+// Returns the models which outputs are read by the model 'idx' in LoadInputs.
+// This table must be kept consistent with LoadInputs. It is only filled for
+// the models that can be executed concurrently.
+
+static unsigned int GetModelInputs(unsigned int idx)
+{
+  switch(idx) {
+  case FGFDMExec::ePropulsion:
+    return 1 << FGFDMExec::eAtmosphere | 1 << FGFDMExec::eAuxiliary
+         | 1 << FGFDMExec::eSystems | 1 << FGFDMExec::ePropagate;
+  case FGFDMExec::eAerodynamics:
+    return 1 << FGFDMExec::eAuxiliary | 1 << FGFDMExec::eMassBalance
+         | 1 << FGFDMExec::eAircraft;
+  case FGFDMExec::eGroundReactions:
+    return 1 << FGFDMExec::eAuxiliary | 1 << FGFDMExec::eAtmosphere
+         | 1 << FGFDMExec::eSystems | 1 << FGFDMExec::eMassBalance
+         | 1 << FGFDMExec::ePropagate | 1 << FGFDMExec::eGroundReactions;
+  case FGFDMExec::eExternalReactions:
+    return 0;
+  case FGFDMExec::eBuoyantForces:
+    return 1 << FGFDMExec::eAtmosphere | 1 << FGFDMExec::eInertial;
+  default:
+    return ~0U;
+  }
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+static bool Intersect(const set<FGPropertyNode*>& a,
+                      const set<FGPropertyNode*>& b)
+{
+  for (set<FGPropertyNode*>::const_iterator it=a.begin(); it!=a.end(); ++it)
+    if (b.count(*it)) return true;
+
+  return false;
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+// Groups the models in stages (see SetParallelModels). The properties read by
+// the functions of a model are expanded through the functions and tables
+// bound to properties since reading such a property evaluates them.
+
+void FGFDMExec::BuildStages(void)
+{
+  struct ModelAccess {
+    set<FGPropertyNode*> Reads;
+    set<FGPropertyNode*> Writes;
+    set<FGPropertyNode*> Bound;
+    set<const FGParameter*> Shared;
+    bool Opaque;
+  };
+
+  Stages.clear();
+
+  map<FGPropertyNode*, const FGParameter*> bound;
+  vector<vector<const FGParameter*> > params(Models.size());
+
+  for (unsigned int i=0; i<Models.size(); i++) {
+    Models[i]->CollectParameters(params[i]);
+    for (unsigned int j=0; j<params[i].size(); j++) {
+      const FGParameter* p = params[i][j];
+      FGPropertyNode* node = 0;
+      if (const FGFunction* f = dynamic_cast<const FGFunction*>(p))
+        node = f->GetBoundProperty();
+      else if (const FGTable* t = dynamic_cast<const FGTable*>(p))
+        node = t->GetBoundProperty();
+      if (node) bound[node] = p;
+    }
+  }
+
+  vector<ModelAccess> access(Models.size());
+
+  for (unsigned int i=0; i<Models.size(); i++) {
+    ModelAccess& model = access[i];
+    model.Opaque = GetModelInputs(i) == ~0U;
+    if (model.Opaque) continue;
+
+    model.Writes.insert(ModelProperties[i].begin(), ModelProperties[i].end());
+
+    vector<const FGParameter*> pending(params[i]);
+    set<const FGParameter*> visited;
+
+    while (!pending.empty() && !model.Opaque) {
+      const FGParameter* p = pending.back();
+      pending.pop_back();
+      if (!visited.insert(p).second) continue;
+
+      FGPropertyDependencies deps;
+      if (!FGFunction::GetDependencies(p, deps)) {
+        model.Opaque = true;
+        break;
+      }
+
+      if (const FGFunction* f = dynamic_cast<const FGFunction*>(p)) {
+        f->GetSharedExpressions(model.Shared);
+        if (f->GetCopyToProperty()) model.Writes.insert(f->GetCopyToProperty());
+      }
+
+      for (size_t j=0; j<deps.GetNumProperties(); j++) {
+        FGPropertyNode* node = deps.GetProperty(j);
+        model.Reads.insert(node);
+        map<FGPropertyNode*, const FGParameter*>::const_iterator it = bound.find(node);
+        if (it != bound.end()) {
+          model.Bound.insert(node);
+          pending.push_back(it->second);
+        }
+      }
+    }
+  }
+
+  for (unsigned int i=0; i<Models.size(); i++) {
+    bool merge = !Stages.empty() && !access[i].Opaque;
+
+    if (merge) {
+      const ModelStage& last = Stages.back();
+      for (unsigned int j=0; j<last.Models.size() && merge; j++) {
+        unsigned int k = last.Models[j];
+        const ModelAccess& a = access[i];
+        const ModelAccess& b = access[k];
+        if (b.Opaque || GetModelInputs(i) & 1 << k
+            || Intersect(a.Reads, b.Writes) || Intersect(a.Writes, b.Reads)
+            || Intersect(a.Writes, b.Writes) || Intersect(a.Bound, b.Bound))
+          merge = false;
+        for (set<const FGParameter*>::const_iterator it=a.Shared.begin();
+             it!=a.Shared.end() && merge; ++it)
+          if (b.Shared.count(*it)) merge = false;
+      }
+    }
+
+    if (merge)
+      Stages.back().Models.push_back(i);
+    else {
+      Stages.push_back(ModelStage());
+      Stages.back().Models.push_back(i);
+    }
+  }
+
+  for (unsigned int i=0; i<Stages.size(); i++) {
+    ModelStage& stage = Stages[i];
+    if (stage.Models.size() < 2) continue;
+
+    map<FGPropertyNode*, unsigned int> count;
+    for (unsigned int j=0; j<stage.Models.size(); j++) {
+      const set<FGPropertyNode*>& reads = access[stage.Models[j]].Reads;
+      for (set<FGPropertyNode*>::const_iterator it=reads.begin(); it!=reads.end(); ++it)
+        count[*it]++;
+    }
+    for (map<FGPropertyNode*, unsigned int>::const_iterator it=count.begin(); it!=count.end(); ++it)
+      if (it->second > 1) stage.SharedReads.push_back(it->first);
+
+    if (debug_lvl & 1) {
+      static const char* names[] = {"Propagate", "Input", "Inertial",
+                                    "Atmosphere", "Winds", "Systems",
+                                    "MassBalance", "Auxiliary", "Propulsion",
+                                    "Aerodynamics", "GroundReactions",
+                                    "ExternalReactions", "BuoyantForces",
+                                    "Aircraft", "Accelerations", "Output"};
+      cout << "  Models executed concurrently:";
+      for (unsigned int j=0; j<stage.Models.size(); j++)
+        cout << " " << names[stage.Models[j]];
+      cout << endl;
+    }
+  }
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+void FGFDMExec::CollectSnapshotProperties(vector<FGPropertyNode*>& nodes)
+{
+  CollectUntiedNodes(instance->GetNode(), nodes);
+
+  for (unsigned int i=0; i<ChildFDMList.size(); i++)
+    ChildFDMList[i]->exec->CollectSnapshotProperties(nodes);
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+void FGFDMExec::ArchiveState(FGSnapshot& snapshot)
+{
+  string name = modelName;
+  snapshot.Archive(name);
+  if (!snapshot.IsSaving() && name != modelName)
+    throw string("The snapshot of the model " + name + " cannot be restored in "
+                 "the model " + modelName + ".");
+
+  snapshot.Archive(sim_time);
+  snapshot.Archive(dT);
+  snapshot.Archive(saved_dT);
+  snapshot.Archive(Frame);
+  snapshot.Archive(holding);
+  snapshot.Archive(IncrementThenHolding);
+  snapshot.Archive(TimeStepsUntilHold);
+  snapshot.Archive(Terminate);
+  snapshot.Archive(ResetMode);
+  snapshot.Archive(RandomSeed);
+
+  // The streams are referenced by pointers so they are restored in place.
+  if (snapshot.IsSaving()) {
+    map<string, FGRandom> streams = RandomStreams;
+    snapshot.Archive(streams);
+  } else {
+    map<string, FGRandom> streams;
+    snapshot.Archive(streams);
+    map<string, FGRandom>::const_iterator it;
+    for (it = streams.begin(); it != streams.end(); ++it)
+      *GetRandom(it->first) = it->second;
+  }
+
+  for (unsigned int i=0; i<Models.size(); i++)
+    Models[i]->ArchiveState(snapshot);
+
+  IC->ArchiveState(snapshot);
+
+  if (Script) Script->ArchiveState(snapshot);
+
+  for (unsigned int i=0; i<ChildFDMList.size(); i++)
+    ChildFDMList[i]->exec->ArchiveState(snapshot);
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+void FGFDMExec::SaveState(FGSnapshot& snapshot)
+{
+  vector<FGPropertyNode*> nodes;
+  CollectSnapshotProperties(nodes);
+
+  // The paths are only needed to restore the snapshot in another instance. As
+  // they are slow to compute, they are shared by the snapshots until a
+  // property is added.
+  if (!SnapshotProperties || SnapshotProperties->Nodes != nodes) {
+    SnapshotProperties = new FGSnapshot::PropertyList;
+    SnapshotProperties->Nodes = nodes;
+    SnapshotProperties->Paths.reserve(nodes.size());
+    for (unsigned int i=0; i<nodes.size(); i++)
+      SnapshotProperties->Paths.push_back(nodes[i]->GetFullyQualifiedName());
+  }
+
+  snapshot.StartSaving();
+  snapshot.SaveProperties(SnapshotProperties);
+  ArchiveState(snapshot);
+  snapshot.FinishSaving();
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+bool FGFDMExec::RestoreState(FGSnapshot& snapshot)
+{
+  try {
+    snapshot.StartRestoring();
+    ArchiveState(snapshot);
+    snapshot.RestoreProperties(SnapshotProperties, Root);
+    if (!snapshot.FinishRestoring()) snapshot.Mismatch();
+  } catch (const string& msg) {
+    cerr << "Failed to restore the snapshot: " << msg << endl;
+    return false;
+  }
+
+  return true;
 }
 
 //%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
@@ -43,12 +43,18 @@ INCLUDES
 
 #include <vector>
 #include <string>
+#include <map>
 
 #include "FGJSBBase.h"
 #include "input_output/FGPropertyManager.h"
+#include "input_output/FGGroundCallback.h"
+#include "input_output/FGSnapshot.h"
+#include "input_output/FGModelCache.h"
 #include "models/FGPropagate.h"
 #include "math/FGColumnVector3.h"
+#include "math/FGRandom.h"
 #include "models/FGOutput.h"
+#include "FGProfiler.h"
 
 /*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
 DEFINITIONS
@@ -64,6 +70,8 @@ namespace JSBSim {
 
 class FGScript;
 class FGTrim;
+class FGFunctionOptimizer;
+class FGThreadPool;
 class FGAerodynamics;
 class FGAircraft;
 class FGAtmosphere;
@@ -248,6 +256,9 @@ public:
                  eOutput,
                  eNumStandardModels };
 
+  /// Models of the atmosphere (see SetAtmosphereModel).
+  enum eAtmosphereModel { eStandardAtmosphere=0, eMSISAtmosphere };
+
   /** Unbind all tied JSBSim properties. */
   void Unbind(void) {instance->Unbind();}
 
@@ -260,14 +271,25 @@ public:
       @return true if successful */
   bool RunIC(void);
 
-  /** Sets the ground callback pointer. For optimal memory management, a shared
+  /** Executes again the models that compute the forces, the moments and the
+      accelerations from the state of FGPropagate. This is used by the
+      multistage integrators of FGPropagate to evaluate the derivatives of the
+      state at the intermediate stages of a time step. The models which have
+      an internal state (systems, propulsion, ground reactions, etc.) and the
+      models that are not executed at every time step are not executed again:
+      their outputs are held during the time step. */
+  void EvaluateDerivatives(void);
+
+  /** Sets the ground callback pointer. Each FDM instance has its own ground
+      callback (the child FDMs share the callback of their parent). For
+      optimal memory management, a shared
       pointer is used internally that maintains a reference counter. The calling
       application must therefore use FGGroundCallback_ptr 'smart pointers' to
       manage their copy of the ground callback.
       @param gc A pointer to a ground callback object
       @see FGGroundCallback
    */
-  void SetGroundCallback(FGGroundCallback* gc) { FGLocation::SetGroundCallback(gc); }
+  void SetGroundCallback(FGGroundCallback* gc);
 
   /** Loads an aircraft model.
       @param AircraftPath path to the aircraft/ directory. For instance:
@@ -297,9 +319,30 @@ public:
       instance: "aircraft/x15/x15.xml"
       @param addModelToPath set to true to add the model name to the
       AircraftPath, defaults to true
-      @return true if successful*/
+      @return true if successful. The model is not loaded again if it is
+      already loaded.*/
   bool LoadModel(const std::string& model, bool addModelToPath = true);
 
+  /** Loads the aircraft model that another instance has already loaded.
+      The files of the model are not read again: the instances share the
+      documents read from the files, as well as the data of the tables. Only
+      the state of the model is allocated for this instance. The paths to the
+      aircraft, engine and systems directories and the time step are copied
+      from the other instance. The instances that share the model can be run concurrently
+      once they are loaded.
+
+      A script that uses the same aircraft can then be loaded: the model is
+      not loaded again.
+      @code
+      FGFDMExec fdmex;
+      fdmex.LoadModel("c172x");
+      FGFDMExec copy;
+      copy.LoadModel(fdmex);
+      @endcode
+      @param fdmex an instance which has loaded an aircraft model.
+      @return true if successful*/
+  bool LoadModel(const FGFDMExec& fdmex);
+
   /** Loads a script
       @param Script The full path name and file name for the script to be loaded.
       @param deltaT The simulation integration step size, if given.  If no value is supplied
@@ -368,7 +411,7 @@ public:
       @return A pointer to the current ground callback object.
       @see FGGroundCallback
    */
-  FGGroundCallback* GetGroundCallback(void) {return FGLocation::GetGroundCallback();}
+  FGGroundCallback* GetGroundCallback(void) const;
   /// Retrieves the script object
   FGScript* GetScript(void) {return Script;}
   /// Returns a pointer to the FGInitialCondition object
@@ -385,6 +428,8 @@ public:
   const std::string& GetSystemsPath(void)   {return SystemsPath;}
   /// Retrieves the full aircraft path name.
   const std::string& GetFullAircraftPath(void) {return FullAircraftPath;}
+  /// Retrieves the cache of the files of the aircraft model.
+  FGModelCache* GetModelCache(void) const {return ModelCache;}
 
   /** Retrieves the value of a property.
       @param property the name of the property
@@ -399,6 +444,15 @@ public:
     instance->GetNode()->SetDouble(property, value);
   }
 
+  /** Looks up a property once for all for the fast accesses to its value.
+      @param property the name of the property
+      @param create true to create the property if it does not exist
+      @result the handle of the property. It is invalid if the property does
+              not exist and has not been created. */
+  FGPropertyHandle GetPropertyHandle(const std::string& property,
+                                     bool create = false)
+  { return FGPropertyHandle(instance->GetNode(property, create)); }
+
   /// Returns the model name.
   const std::string& GetModelName(void) const { return modelName; }
 
@@ -556,6 +610,18 @@ public:
       @return the string representing the root (base) JSBSim directory. */
   const std::string& GetRootDir(void) const {return RootDir;}
 
+  /** Sets the directory where a binary form of the model files is stored.
+      The binary files are read in place of the XML files the next time the
+      model is loaded, which skips the XML parsing as long as the XML files are
+      not modified. The directory must exist. No binary file is written if the
+      directory is empty (the default).
+      @param cacheDir the path to the directory
+      @see FGModelCache */
+  void SetCacheDir(const std::string& cacheDir) {CacheDir = cacheDir;}
+
+  /// Retrieves the directory where a binary form of the model files is stored.
+  const std::string& GetCacheDir(void) const {return CacheDir;}
+
   /** Increments the simulation time if not in Holding mode. The Frame counter
       is also incremented.
       @return the new simulation time.     */
@@ -578,6 +644,108 @@ public:
       @param FGIC The initial conditions that will be passed to the simulation. */
   void Initialize(FGInitialCondition *FGIC);
 
+  /** Sets the seed of the random numbers of this instance. All the streams
+      returned by GetRandom() are restarted from the new seed. The seed can
+      also be set with the property simulation/randomseed.
+      @param sr the seed. */
+  void SRand(int sr);
+  /// Returns the seed of the random numbers of this instance.
+  int  SRand(void) const {return RandomSeed;}
+  /** Returns a stream of random numbers of this instance.
+      The stream is created from the current seed on the first call and the
+      same stream is returned by the subsequent calls with the same name. The
+      numbers of a stream only depend on the seed and on the name of the
+      stream so each subsystem should use its own stream.
+      @param name the name of the stream.
+      @return a pointer to the stream. */
+  FGRandom* GetRandom(const std::string& name);
+
+  /** Saves the complete state of the simulation in a snapshot. The state of
+      the child FDMs is saved in the same snapshot. See FGSnapshot for the
+      details of what is saved.
+      @param snapshot the snapshot which previous content is replaced. */
+  void SaveState(FGSnapshot& snapshot);
+  /** Restores the state of the simulation from a snapshot. The snapshot can
+      have been saved by this instance or by another instance that has loaded
+      the same model and script. The next call to Run() then continues the
+      simulation from the time at which the snapshot has been saved.
+      @param snapshot the snapshot to restore. It is left unchanged and can be
+                      restored again.
+      @return false if the snapshot does not match the model. The state of the
+              simulation is then undefined. */
+  bool RestoreState(FGSnapshot& snapshot);
+
+  /** Executes concurrently the models that are independent of each other.
+      Within a frame, the models Propulsion, Aerodynamics, GroundReactions,
+      ExternalReactions and BuoyantForces only read the outputs of the models
+      that are executed before them. They are grouped in stages which models
+      are executed concurrently by a pool of threads. Two models are placed in
+      the same stage unless:
+      - one of them reads the outputs of the other one (see LoadInputs());
+      - one of them reads a property that the other one ties or writes, or
+        they both read the same function or table bound to a property;
+      - they share a sub-expression merged by FGFunctionOptimizer;
+      - one of them uses random numbers or properties that are not bound at
+        load time, in which case the model is always executed alone.
+
+      The models of a stage therefore read the same values as if they were
+      executed sequentially and the results are identical. The messages that
+      the models post are forwarded in the order of the models. The parallel
+      execution is only profitable for heavy models (many engines, rotors or
+      landing gears): the synchronization of the threads costs a few
+      microseconds per stage. The ground callback is only called by the
+      GroundReactions model so it does not need to be thread safe.
+
+      The number of threads can also be set with the property
+      simulation/parallel-models.
+      @param nthreads the number of threads including the calling thread. The
+                      models are executed sequentially if it is 0 or 1 (the
+                      default). No more than 5 models can be executed
+                      concurrently. */
+  void SetParallelModels(int nthreads);
+  /// Returns the number of threads that execute the models.
+  int GetParallelModels(void) const;
+  /** Returns the number of stages in which the models are executed. Each stage
+      is either made of a single model or of models that are executed
+      concurrently. */
+  unsigned int GetNumStages(void) const { return (unsigned int)Stages.size(); }
+
+  /** Enables or disables the profiling of the frames (see FGProfiler).
+      When enabled, the executive measures each frame, each model and the
+      loading of its inputs, and the models measure their own parts (the
+      channels and the components of the flight control system, the engines,
+      the output and input instances). The statistics are published under
+      profiling/.
+
+      The profiling can also be enabled with the property profiling/enabled.
+      When it is disabled, the profiler is destroyed at the beginning of the
+      next frame and the frames run the code paths of the models that do not
+      measure anything.
+      @param enabled true to enable the profiling. */
+  void SetProfiling(bool enabled);
+  /// Checks if the profiling is enabled.
+  bool GetProfiling(void) const { return Profiler && !StopProfiling; }
+  /// Returns the profiler, or 0 if the profiling is disabled.
+  FGProfiler* GetProfiler(void) const { return Profiler; }
+
+  /// Returns the optimizer of the functions of the aircraft, or 0 if no
+  /// aircraft is loaded or if the optimization is disabled.
+  const FGFunctionOptimizer* GetFunctionOptimizer(void) const
+  { return FunctionOptimizer; }
+
+  /** Selects the model of the atmosphere: the 1976 US standard atmosphere
+      (the default) or the NRLMSISE-00 model (see MSIS), which depends on the
+      location and on the date. The models are allocated again and tie their
+      properties again, so the model must be selected before the aircraft is
+      loaded and before any property is tied by the application. The
+      instances that load their aircraft from another one
+      (LoadModel(const FGFDMExec&)) use the same model.
+      @param model the model of the atmosphere.
+      @return false if an aircraft is already loaded. */
+  bool SetAtmosphereModel(eAtmosphereModel model);
+  /// Returns the model of the atmosphere.
+  eAtmosphereModel GetAtmosphereModel(void) const { return AtmosphereModel; }
+
 private:
   int Error;
   unsigned int Frame;
@@ -594,6 +762,7 @@ private:
   bool Constructing;
   bool modelLoaded;
   bool IsChild;
+  eAtmosphereModel AtmosphereModel;
   std::string modelName;
   std::string AircraftPath;
   std::string FullAircraftPath;
@@ -602,6 +771,7 @@ private:
   std::string CFGVersion;
   std::string Release;
   std::string RootDir;
+  std::string CacheDir;
 
   // Standard Model pointers - shortcuts for internal executive use only.
   FGPropagate* Propagate;
@@ -628,6 +798,7 @@ private:
   FGScript*           Script;
   FGInitialCondition* IC;
   FGTrim*             Trim;
+  FGFunctionOptimizer* FunctionOptimizer;
 
   FGPropertyManager* Root;
   bool StandAlone;
@@ -639,18 +810,50 @@ private:
   std::vector <std::string> PropertyCatalog;
   std::vector <childData*> ChildFDMList;
   std::vector <FGModel*> Models;
-
+  std::map <std::string, FGRandom> RandomStreams;
+  SGSharedPtr<FGSnapshot::PropertyList> SnapshotProperties;
+  SGSharedPtr<FGModelCache> ModelCache;
+
+  // Models executed together, see SetParallelModels().
+  struct ModelStage {
+    std::vector<unsigned int> Models;
+    // Properties read by several models of the stage. They are read once
+    // before the stage is executed so that their getters can update their
+    // internal caches without a race.
+    std::vector<FGPropertyNode*> SharedReads;
+  };
+  std::vector<ModelStage> Stages;
+  std::vector<std::vector<FGPropertyNode*> > ModelProperties;
+  FGThreadPool* ModelPool;
+
+  // Profiling, see SetProfiling(). The sections are empty when the profiling
+  // is disabled. Since the profiling can be disabled in the middle of a frame
+  // (by a script or an input), the profiler is only destroyed at the beginning
+  // of the next one.
+  FGProfiler* Profiler;
+  bool StopProfiling;
+  FGProfiler::Section* FrameProfile;
+  std::vector<FGProfiler::Section*> ModelProfiles;
+  std::vector<FGProfiler::Section*> InputsProfiles;
+
+  bool ReadModel(const std::string& aircraftCfgFileName);
   bool ReadFileHeader(Element*);
   bool ReadChild(Element*);
   bool ReadPrologue(Element*);
-  void SRand(int sr);
-  int  SRand(void) const {return RandomSeed;}
   void LoadInputs(unsigned int idx);
   void LoadPlanetConstants(void);
   void LoadModelConstants(void);
+  void AssignTiedProperties(unsigned int idx, size_t& first);
+  void BuildStages(void);
+  void RunStage(const ModelStage& stage);
+  void ProfileModels(void);
+  void DeleteProfiler(void);
   bool Allocate(void);
   bool DeAllocate(void);
+  void BindProperties(void);
   int GetDisperse(void) const {return disperse;}
+  void ArchiveState(FGSnapshot& snapshot);
+  void CollectSnapshotProperties(std::vector<FGPropertyNode*>& nodes);
 
   void Debug(int from);
 };
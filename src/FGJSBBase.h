@@ -189,7 +189,9 @@ public:
   /// Disables highlighting in the console output.
   void disableHighLighting(void);
 
-  static short debug_lvl;
+  /** The debug level. Like the message queue, it is local to each thread so
+      that instances run by different threads do not share it. */
+  static thread_local short debug_lvl;
 
   /** Converts from degrees Kelvin to degrees Fahrenheit.
   *   @param kelvin The temperature in degrees Kelvin.
@@ -335,16 +337,14 @@ public:
   
   static double sign(double num) {return num>=0.0?1.0:-1.0;}
 
-  static double GaussianRandomNumber(void);
-
 protected:
-  static Message localMsg;
+  static thread_local Message localMsg;
 
-  static std::queue <Message> Messages;
+  static thread_local std::queue <Message> Messages;
 
   void Debug(int) {};
 
-  static unsigned int messageId;
+  static thread_local unsigned int messageId;
 
   static const double radtodeg;
   static const double degtorad;
@@ -371,8 +371,6 @@ protected:
 
   static std::string CreateIndexedPropertyName(const std::string& Property, int index);
 
-  static int gaussian_random_number_phase;
-
 public:
 /// Moments L, M, N
 enum {eL     = 1, eM,     eN    };
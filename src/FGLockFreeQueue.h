@@ -0,0 +1,137 @@
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+ Header:       FGLockFreeQueue.h
+ Date started: June 2016
+
+ ------------- Copyright (C) 2016  JSBSim development team  -------------
+
+ This program is free software; you can redistribute it and/or modify it under
+ the terms of the GNU Lesser General Public License as published by the Free Software
+ Foundation; either version 2 of the License, or (at your option) any later
+ version.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ details.
+
+ You should have received a copy of the GNU Lesser General Public License along with
+ this program; if not, write to the Free Software Foundation, Inc., 59 Temple
+ Place - Suite 330, Boston, MA  02111-1307, USA.
+
+ Further information about the GNU Lesser General Public License can also be found on
+ the world wide web at http://www.gnu.org.
+
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+SENTRY
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+#ifndef FGLOCKFREEQUEUE_H
+#define FGLOCKFREEQUEUE_H
+
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+INCLUDES
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+#include <atomic>
+#include <utility>
+#include <vector>
+
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+DEFINITIONS
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+#define ID_LOCKFREEQUEUE "$Id$"
+
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+FORWARD DECLARATIONS
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+namespace JSBSim {
+
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+CLASS DOCUMENTATION
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+/** Bounded queue that transfers items from one thread to another without any
+    lock. The queue is safe as long as a single thread pushes the items (the
+    producer) and a single thread pops them (the consumer). Neither of them
+    ever waits: push() fails when the queue is full and pop() fails when it is
+    empty.
+
+    The storage is allocated once by the constructor. The slots are reused
+    so the items which own memory (strings for instance) keep their capacity
+    from one use to the next.
+    @code
+    FGLockFreeQueue<Command> queue(256);
+    // Producer thread
+    if (!queue.push(command)) ...; // Try again later
+    // Consumer thread
+    Command command;
+    while (queue.pop(command)) Execute(command);
+    @endcode
+ */
+
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+CLASS DECLARATION
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+template <typename T>
+class FGLockFreeQueue
+{
+public:
+  /** Constructor.
+      @param capacity the maximum number of items in the queue. */
+  explicit FGLockFreeQueue(size_t capacity)
+    : Items(capacity), Head(0), Tail(0) {}
+
+  /// Returns the maximum number of items in the queue.
+  size_t capacity(void) const { return Items.size(); }
+
+  /** Adds an item at the end of the queue. Must only be called by the
+      producer.
+      @return false if the queue is full. */
+  bool push(const T& item) {
+    size_t head = Head.load(std::memory_order_relaxed);
+    if (head - Tail.load(std::memory_order_acquire) == Items.size())
+      return false;
+
+    Items[head % Items.size()] = item;
+    Head.store(head+1, std::memory_order_release);
+    return true;
+  }
+
+  /** Removes the item at the front of the queue. Must only be called by the
+      consumer.
+      @param item receives the item.
+      @return false if the queue is empty. */
+  bool pop(T& item) {
+    size_t tail = Tail.load(std::memory_order_relaxed);
+    if (tail == Head.load(std::memory_order_acquire))
+      return false;
+
+    std::swap(item, Items[tail % Items.size()]);
+    Tail.store(tail+1, std::memory_order_release);
+    return true;
+  }
+
+  /// Returns true if the queue holds no item.
+  bool empty(void) const {
+    return Head.load(std::memory_order_acquire)
+        == Tail.load(std::memory_order_acquire);
+  }
+
+  /// Returns true if no item can be pushed.
+  bool full(void) const {
+    return Head.load(std::memory_order_acquire)
+         - Tail.load(std::memory_order_acquire) == Items.size();
+  }
+
+private:
+  std::vector<T> Items;
+  std::atomic<size_t> Head;
+  std::atomic<size_t> Tail;
+};
+}
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+#endif
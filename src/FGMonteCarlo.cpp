@@ -0,0 +1,501 @@
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+Module: FGMonteCarlo.cpp
+Date started: June 2016
+Purpose: Runs a Monte Carlo campaign on a pool of threads
+
+ ------------- Copyright (C) 2016  JSBSim development team  -------------
+
+ This program is free software; you can redistribute it and/or modify it under
+ the terms of the GNU Lesser General Public License as published by the Free Software
+ Foundation; either version 2 of the License, or (at your option) any later
+ version.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ details.
+
+ You should have received a copy of the GNU Lesser General Public License along with
+ this program; if not, write to the Free Software Foundation, Inc., 59 Temple
+ Place - Suite 330, Boston, MA  02111-1307, USA.
+
+ Further information about the GNU Lesser General Public License can also be found on
+ the world wide web at http://www.gnu.org.
+
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+INCLUDES
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+#include <algorithm>
+#include <exception>
+#include <fstream>
+#include <iostream>
+#include <limits>
+#include <sstream>
+
+#include "FGMonteCarlo.h"
+#include "FGBatchExec.h"
+#include "FGFDMExec.h"
+#include "input_output/FGSnapshot.h"
+#include "input_output/FGXMLElement.h"
+#include "input_output/FGXMLFileRead.h"
+#include "math/FGRandom.h"
+
+using namespace std;
+
+namespace JSBSim {
+
+IDENT(IdSrc,"$Id$");
+IDENT(IdHdr,ID_MONTECARLO);
+
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+LOCAL CLASSES
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+// An instance of the batch with its initial state and the results of the run
+// that it is currently executing.
+struct FGMonteCarlo::Slot {
+  FGSnapshot Initial;
+  vector<FGPropertyHandle> Dispersed;
+  vector<FGPropertyHandle> Summary;
+
+  unsigned int Run;
+  int RandomSeed;
+  bool Failed;
+  string Error;
+  double SimTime;
+  unsigned int Samples;
+  vector<double> Values;
+  vector<double> Current;
+  vector<double> Min;
+  vector<double> Max;
+  vector<double> Sum;
+};
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+// Executes the run #first+idx on the instance #idx. The errors are recorded in
+// the slot so that the instance stays available for the next runs: its state
+// is entirely restored from the snapshot at the beginning of each run.
+
+class FGMonteCarlo::RunTask : public FGBatchExec::Task
+{
+public:
+  RunTask(const FGMonteCarlo& mc, vector<Slot>& s, const vector<double>& n,
+          unsigned int f)
+    : campaign(mc), slots(s), nominal(n), first(f) {}
+
+  bool Execute(FGFDMExec* fdm, unsigned int idx) {
+    Slot& slot = slots[idx];
+    slot.Run = first + idx;
+    if (slot.Run >= campaign.NumRuns) return true;
+
+    slot.Failed = false;
+    slot.Error.clear();
+    slot.Samples = 0;
+
+    try {
+      Simulate(fdm, slot);
+    } catch (const string& msg) {
+      slot.Failed = true;
+      slot.Error = msg;
+    } catch (const exception& e) {
+      slot.Failed = true;
+      slot.Error = e.what();
+    } catch (...) {
+      slot.Failed = true;
+      slot.Error = "Unknown exception";
+    }
+
+    slot.SimTime = fdm->GetSimTime();
+    return true;
+  }
+
+private:
+  const FGMonteCarlo& campaign;
+  vector<Slot>& slots;
+  const vector<double>& nominal;
+  unsigned int first;
+
+  void Simulate(FGFDMExec* fdm, Slot& slot) {
+    if (!fdm->RestoreState(slot.Initial))
+      throw string("The initial state could not be restored");
+
+    ostringstream name;
+    name << "run/" << slot.Run;
+    FGRandom random(campaign.Seed, name.str());
+
+    for (unsigned int i=0; i<campaign.Dispersions.size(); i++) {
+      const Dispersion& d = campaign.Dispersions[i];
+      slot.Values[i] = Element::Disperse(nominal[i], d.Magnitude, d.Type,
+                                         random);
+      slot.Dispersed[i].SetValue(slot.Values[i]);
+    }
+
+    slot.RandomSeed = (int)(random.GetUInt32() & 0x7fffffff);
+    fdm->SRand(slot.RandomSeed);
+
+    if (!fdm->RunIC())
+      throw string("The initialization has failed");
+
+    Sample(slot);
+    while (fdm->Run()) {
+      if (fdm->Holding())
+        throw string("The simulation has been suspended");
+      Sample(slot);
+    }
+    Sample(slot);
+  }
+
+  void Sample(Slot& slot) {
+    if (slot.Summary.empty()) return;
+
+    FGPropertyHandle::GetValues(slot.Summary, &slot.Current[0]);
+
+    if (slot.Samples == 0) {
+      slot.Min = slot.Current;
+      slot.Max = slot.Current;
+      slot.Sum = slot.Current;
+    } else {
+      for (unsigned int i=0; i<slot.Current.size(); i++) {
+        double value = slot.Current[i];
+        slot.Min[i] = min(slot.Min[i], value);
+        slot.Max[i] = max(slot.Max[i], value);
+        slot.Sum[i] += value;
+      }
+    }
+
+    slot.Samples++;
+  }
+};
+
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+CLASS IMPLEMENTATION
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+FGMonteCarlo::FGMonteCarlo(unsigned int nthreads)
+  : NumThreads(nthreads), AircraftPath("aircraft"), EnginePath("engine"),
+    SystemsPath("systems"), NumRuns(1), Seed(0), NumFailures(0)
+{
+  Debug(0);
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+FGMonteCarlo::~FGMonteCarlo()
+{
+  Debug(1);
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+bool FGMonteCarlo::Load(const string& filename)
+{
+  FGXMLFileRead XMLFileRead;
+  Element* document = XMLFileRead.LoadXMLDocument(RootDir + filename);
+
+  if (!document) {
+    cerr << "File: " << filename << " could not be loaded." << endl;
+    return false;
+  }
+
+  return Load(document);
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+bool FGMonteCarlo::Load(Element* el)
+{
+  if (el->GetName() != "monte_carlo") {
+    cerr << el->ReadFrom() << "The element <" << el->GetName()
+         << "> does not describe a Monte Carlo campaign." << endl;
+    return false;
+  }
+
+  if (el->HasAttribute("runs")) {
+    double runs = el->GetAttributeValueAsNumber("runs");
+    if (runs < 0.0) {
+      cerr << el->ReadFrom() << "The number of runs must be positive." << endl;
+      return false;
+    }
+    NumRuns = (unsigned int)runs;
+  }
+
+  if (el->HasAttribute("seed"))
+    Seed = (unsigned int)el->GetAttributeValueAsNumber("seed");
+
+  Element* element = el->FindElement("script");
+  if (element) Script = element->GetAttributeValue("file");
+
+  if (Script.empty()) {
+    cerr << el->ReadFrom() << "A script must be specified in the element "
+         << "<script>." << endl;
+    return false;
+  }
+
+  element = el->FindElement("results");
+  if (element) ResultsFile = element->GetAttributeValue("file");
+
+  Element* dispersions = el->FindElement("dispersions");
+  if (dispersions) {
+    element = dispersions->FindElement("property");
+    while (element) {
+      string type = element->GetAttributeValue("type");
+      if (!element->HasAttribute("dispersion")) {
+        cerr << element->ReadFrom() << "The dispersion of the property "
+             << element->GetDataLine() << " is missing." << endl;
+        return false;
+      }
+      if (!AddDispersion(element->GetDataLine(), type,
+                         element->GetAttributeValueAsNumber("dispersion"))) {
+        cerr << element->ReadFrom() << "Unknown dispersion type " << type
+             << endl;
+        return false;
+      }
+      element = dispersions->FindNextElement("property");
+    }
+  }
+
+  Element* summary = el->FindElement("summary");
+  if (summary) {
+    element = summary->FindElement("property");
+    while (element) {
+      AddSummary(element->GetDataLine());
+      element = summary->FindNextElement("property");
+    }
+  }
+
+  Debug(2);
+
+  return true;
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+bool FGMonteCarlo::AddDispersion(const string& property, const string& type,
+                                 double dispersion)
+{
+  if (!Element::IsDispersionType(type)) return false;
+
+  Dispersion d;
+  d.Property = property;
+  d.Type = type;
+  d.Magnitude = dispersion;
+  Dispersions.push_back(d);
+
+  return true;
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+void FGMonteCarlo::AddSummary(const string& property)
+{
+  Summary.push_back(property);
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+bool FGMonteCarlo::Run(void)
+{
+  if (ResultsFile.empty()) {
+    cerr << "No results file given for the Monte Carlo campaign." << endl;
+    return false;
+  }
+
+  ofstream results(ResultsFile.c_str());
+  if (!results.is_open()) {
+    cerr << "Could not open the results file " << ResultsFile << endl;
+    return false;
+  }
+
+  return Run(results);
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+// Each instance of the batch loads the script once. The runs are then executed
+// in rounds: each round executes one run on each instance of the batch and its
+// results are written before the next round starts.
+
+bool FGMonteCarlo::Run(ostream& results)
+{
+  NumFailures = 0;
+
+  if (Script.empty()) {
+    cerr << "No script given for the Monte Carlo campaign." << endl;
+    return false;
+  }
+
+  FGBatchExec batch(NumThreads);
+  unsigned int ninstances = min(batch.GetNumThreads(), NumRuns);
+  vector<Slot> slots(ninstances);
+
+  for (unsigned int i=0; i<ninstances; i++) {
+    FGFDMExec* fdm = batch.AddInstance();
+    Slot& slot = slots[i];
+
+    fdm->SetRootDir(RootDir);
+    fdm->SetAircraftPath(AircraftPath);
+    fdm->SetEnginePath(EnginePath);
+    fdm->SetSystemsPath(SystemsPath);
+
+    if (!fdm->LoadScript(Script)) {
+      cerr << "Script file " << Script << " was not successfully loaded"
+           << endl;
+      return false;
+    }
+
+    fdm->DisableOutput();
+
+    for (unsigned int j=0; j<Dispersions.size(); j++) {
+      const string& property = Dispersions[j].Property;
+      FGPropertyHandle handle = fdm->GetPropertyHandle(property);
+      if (!handle.IsValid()) {
+        cerr << "No property by the name " << property << endl;
+        return false;
+      }
+      if (!handle.GetNode()->getAttribute(SGPropertyNode::WRITE)) {
+        cerr << "The property " << property << " is read only." << endl;
+        return false;
+      }
+      slot.Dispersed.push_back(handle);
+    }
+
+    for (unsigned int j=0; j<Summary.size(); j++) {
+      FGPropertyHandle handle = fdm->GetPropertyHandle(Summary[j]);
+      if (!handle.IsValid()) {
+        cerr << "No property by the name " << Summary[j] << endl;
+        return false;
+      }
+      slot.Summary.push_back(handle);
+    }
+
+    slot.Values.resize(Dispersions.size());
+    slot.Current.resize(Summary.size());
+    fdm->SaveState(slot.Initial);
+  }
+
+  // The nominal values are those of the script as it has been loaded.
+  vector<double> nominal(Dispersions.size());
+  if (ninstances > 0) {
+    for (unsigned int j=0; j<Dispersions.size(); j++)
+      nominal[j] = slots[0].Dispersed[j].GetValue();
+  }
+
+  WriteHeader(results);
+
+  for (unsigned int first=0; first<NumRuns; first+=ninstances) {
+    RunTask task(*this, slots, nominal, first);
+    batch.ForEach(task);
+
+    for (unsigned int i=0; i<ninstances && first+i<NumRuns; i++) {
+      const Slot& slot = slots[i];
+      if (slot.Failed) {
+        cerr << "Run #" << slot.Run << " failed: " << slot.Error << endl;
+        NumFailures++;
+      }
+      WriteResult(results, slot);
+    }
+
+    results.flush();
+  }
+
+  return true;
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+void FGMonteCarlo::WriteHeader(ostream& results) const
+{
+  results << "run,seed,status,sim-time-sec";
+
+  for (unsigned int i=0; i<Dispersions.size(); i++)
+    results << "," << Dispersions[i].Property;
+
+  for (unsigned int i=0; i<Summary.size(); i++) {
+    const string& name = Summary[i];
+    results << "," << name << "/min," << name << "/max," << name << "/mean,"
+            << name << "/final";
+  }
+
+  results << endl;
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+// The values are written with enough digits to be read back without any loss.
+
+void FGMonteCarlo::WriteResult(ostream& results, const Slot& slot) const
+{
+  streamsize precision = results.precision(numeric_limits<double>::digits10+2);
+
+  results << slot.Run << "," << slot.RandomSeed << "," << slot.Failed << ","
+          << slot.SimTime;
+
+  for (unsigned int i=0; i<slot.Values.size(); i++)
+    results << "," << slot.Values[i];
+
+  for (unsigned int i=0; i<slot.Current.size(); i++) {
+    if (slot.Samples > 0)
+      results << "," << slot.Min[i] << "," << slot.Max[i] << ","
+              << slot.Sum[i] / slot.Samples << "," << slot.Current[i];
+    else
+      results << ",nan,nan,nan,nan";
+  }
+
+  results << "\n";
+  results.precision(precision);
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+//    The bitmasked value choices are as follows:
+//    unset: In this case (the default) JSBSim would only print
+//       out the normally expected messages, essentially echoing
+//       the config files as they are read. If the environment
+//       variable is not set, debug_lvl is set to 1 internally
+//    0: This requests JSBSim not to output any messages
+//       whatsoever.
+//    1: This value explicity requests the normal JSBSim
+//       startup messages
+//    2: This value asks for a message to be printed out when
+//       a class is instantiated
+//    4: When this value is set, a message is displayed when a
+//       FGModel object executes its Run() method
+//    8: When this value is set, various runtime state variables
+//       are printed out periodically
+//    16: When set various parameters are sanity checked and
+//       a message is printed out when they go out of bounds
+
+void FGMonteCarlo::Debug(int from)
+{
+  if (debug_lvl <= 0) return;
+
+  if (debug_lvl & 1) { // Standard console startup message output
+    if (from == 2) { // Load
+      cout << endl << "  Monte Carlo campaign: " << Script << endl;
+      cout << "    Runs: " << NumRuns << ", seed: " << Seed << endl;
+      for (unsigned int i=0; i<Dispersions.size(); i++)
+        cout << "    Dispersion: " << Dispersions[i].Property << " ("
+             << Dispersions[i].Type << ", " << Dispersions[i].Magnitude << ")"
+             << endl;
+      for (unsigned int i=0; i<Summary.size(); i++)
+        cout << "    Summary: " << Summary[i] << endl;
+    }
+  }
+  if (debug_lvl & 2 ) { // Instantiation/Destruction notification
+    if (from == 0) cout << "Instantiated: FGMonteCarlo" << endl;
+    if (from == 1) cout << "Destroyed:    FGMonteCarlo" << endl;
+  }
+  if (debug_lvl & 4 ) { // Run() method entry print for FGModel-derived objects
+  }
+  if (debug_lvl & 8 ) { // Runtime state variables
+  }
+  if (debug_lvl & 16) { // Sanity checking
+  }
+  if (debug_lvl & 64) {
+    if (from == 0) { // Constructor
+      cout << IdSrc << endl;
+      cout << IdHdr << endl;
+    }
+  }
+}
+
+}
@@ -0,0 +1,221 @@
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+ Header: FGMonteCarlo.h
+ Date started: June 2016
+
+ ------------- Copyright (C) 2016  JSBSim development team  -------------
+
+ This program is free software; you can redistribute it and/or modify it under
+ the terms of the GNU Lesser General Public License as published by the Free Software
+ Foundation; either version 2 of the License, or (at your option) any later
+ version.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ details.
+
+ You should have received a copy of the GNU Lesser General Public License along with
+ this program; if not, write to the Free Software Foundation, Inc., 59 Temple
+ Place - Suite 330, Boston, MA  02111-1307, USA.
+
+ Further information about the GNU Lesser General Public License can also be found on
+ the world wide web at http://www.gnu.org.
+
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+SENTRY
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+#ifndef FGMONTECARLO_H
+#define FGMONTECARLO_H
+
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+INCLUDES
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+#include <iosfwd>
+#include <string>
+#include <vector>
+
+#include "FGJSBBase.h"
+
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+DEFINITIONS
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+#define ID_MONTECARLO "$Id$"
+
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+FORWARD DECLARATIONS
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+namespace JSBSim {
+
+class Element;
+
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+CLASS DOCUMENTATION
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+/** Runs a Monte Carlo campaign: a script is run a number of times, each run
+    with its own set of dispersed property values, and a summary of each run
+    is written to a results file.
+
+    The campaign is described by an XML file:
+    @code
+    <monte_carlo name="C172 cruise" runs="200" seed="1">
+      <script file="scripts/c1723.xml"/>
+      <results file="c1723_mc.csv"/>
+      <dispersions>
+        <property type="gaussian" dispersion="50"> ic/h-sl-ft </property>
+        <property type="uniform" dispersion="5"> ic/vc-kts </property>
+      </dispersions>
+      <summary>
+        <property> position/h-sl-ft </property>
+        <property> attitude/theta-deg </property>
+      </summary>
+    </monte_carlo>
+    @endcode
+
+    The dispersions use the same types and the same formula as the
+    dispersions of the aircraft files (see Element::DisperseValue()): the
+    dispersed value is computed from the nominal value of the property, which
+    is its value once the script is loaded, and from the magnitude given by
+    the attribute dispersion, expressed in the units of the property.
+
+    The script is loaded once by each thread, not once per run. Right after
+    the script is loaded, the state of the instance is saved in a snapshot.
+    Each run restores this snapshot, sets the dispersed properties, then
+    initializes the simulation (FGFDMExec::RunIC()) and runs the script to its
+    end. The runs are executed in parallel by an FGBatchExec.
+
+    The random numbers of the run #n are drawn from the stream "run/n" of the
+    seed of the campaign (see FGRandom): the dispersed values are drawn first,
+    in the order of the file, then the seed of the random numbers of the
+    instance (see FGFDMExec::SRand()). A run therefore only depends on the seed
+    of the campaign and on its index: the results do not depend on the number
+    of threads, and a campaign that is run again with more runs starts with
+    the same runs.
+
+    The results file is a comma separated file with one line per run. The
+    columns are:
+    - the index of the run and the seed of the random numbers of the instance;
+    - the status of the run: 0 if the run has reached the end of the script,
+      1 if it has failed (the error is printed to the console);
+    - the simulation time at the end of the run;
+    - the dispersed values;
+    - the minimum, the maximum, the mean and the final value of each summary
+      property. The values are sampled after each time step.
+
+    The lines are written as soon as the runs are completed, in the order of
+    the runs. The values are written with enough digits so that a run can be
+    reproduced by setting the dispersed values in a single instance.
+
+    The output directives of the aircraft and of the script are disabled
+    during the campaign.
+ */
+
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+CLASS DECLARATION
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+class FGMonteCarlo : public FGJSBBase
+{
+public:
+  /** Constructor.
+      @param nthreads the number of threads used to run the campaign. If 0,
+                      the number of hardware threads is used. */
+  FGMonteCarlo(unsigned int nthreads = 0);
+  /// Destructor
+  ~FGMonteCarlo();
+
+  /** Sets the root directory of the instances. The script and the campaign
+      file are relative to this directory. */
+  void SetRootDir(const std::string& rootDir) { RootDir = rootDir; }
+  /// Sets the path to the aircraft, relative to the root directory.
+  void SetAircraftPath(const std::string& path) { AircraftPath = path; }
+  /// Sets the path to the engines, relative to the root directory.
+  void SetEnginePath(const std::string& path) { EnginePath = path; }
+  /// Sets the path to the systems, relative to the root directory.
+  void SetSystemsPath(const std::string& path) { SystemsPath = path; }
+
+  /** Loads a campaign file.
+      @param filename the name of the file, relative to the root directory.
+      @return true if the file has been successfully loaded. */
+  bool Load(const std::string& filename);
+  /** Loads a campaign from an XML element.
+      @param el the element <monte_carlo>.
+      @return true if the campaign has been successfully loaded. */
+  bool Load(Element* el);
+
+  /** Sets the script run by the campaign.
+      @param script the script, relative to the root directory. */
+  void SetScript(const std::string& script) { Script = script; }
+  /// Returns the script run by the campaign.
+  const std::string& GetScript(void) const { return Script; }
+  /// Sets the number of runs.
+  void SetNumRuns(unsigned int runs) { NumRuns = runs; }
+  /// Returns the number of runs.
+  unsigned int GetNumRuns(void) const { return NumRuns; }
+  /// Sets the seed of the campaign.
+  void SetSeed(unsigned int seed) { Seed = seed; }
+  /// Returns the seed of the campaign.
+  unsigned int GetSeed(void) const { return Seed; }
+  /// Sets the name of the results file.
+  void SetResultsFile(const std::string& fname) { ResultsFile = fname; }
+  /// Returns the name of the results file.
+  const std::string& GetResultsFile(void) const { return ResultsFile; }
+
+  /** Adds a dispersed property.
+      @param property the name of the property.
+      @param type the type of the dispersion (see Element::Disperse()).
+      @param dispersion the magnitude of the dispersion.
+      @return false if the type of the dispersion is unknown. */
+  bool AddDispersion(const std::string& property, const std::string& type,
+                     double dispersion);
+  /** Adds a property to the summary of the runs.
+      @param property the name of the property. */
+  void AddSummary(const std::string& property);
+
+  /** Runs the campaign and writes the results to the results file.
+      @return false if the campaign could not be started. */
+  bool Run(void);
+  /** Runs the campaign.
+      @param results the stream to which the results are written.
+      @return false if the campaign could not be started. */
+  bool Run(std::ostream& results);
+
+  /// Returns the number of runs that have failed during the last campaign.
+  unsigned int GetNumFailures(void) const { return NumFailures; }
+
+private:
+  struct Dispersion {
+    std::string Property;
+    std::string Type;
+    double Magnitude;
+  };
+
+  struct Slot;
+  class RunTask;
+
+  unsigned int NumThreads;
+  std::string RootDir;
+  std::string AircraftPath;
+  std::string EnginePath;
+  std::string SystemsPath;
+  std::string Script;
+  std::string ResultsFile;
+  unsigned int NumRuns;
+  unsigned int Seed;
+  unsigned int NumFailures;
+  std::vector<Dispersion> Dispersions;
+  std::vector<std::string> Summary;
+
+  void WriteHeader(std::ostream& results) const;
+  void WriteResult(std::ostream& results, const Slot& slot) const;
+  void Debug(int from);
+};
+
+} // namespace JSBSim
+
+#endif
@@ -0,0 +1,241 @@
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+Module: FGProfiler.cpp
+Date started: June 2016
+Purpose: Measures the time spent in the different parts of a frame
+
+ ------------- Copyright (C) 2016  JSBSim development team  -------------
+
+ This program is free software; you can redistribute it and/or modify it under
+ the terms of the GNU Lesser General Public License as published by the Free Software
+ Foundation; either version 2 of the License, or (at your option) any later
+ version.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ details.
+
+ You should have received a copy of the GNU Lesser General Public License along with
+ this program; if not, write to the Free Software Foundation, Inc., 59 Temple
+ Place - Suite 330, Boston, MA  02111-1307, USA.
+
+ Further information about the GNU Lesser General Public License can also be found on
+ the world wide web at http://www.gnu.org.
+
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+INCLUDES
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+#include <cctype>
+#include <cmath>
+#include <iomanip>
+#include <iostream>
+
+#include "FGProfiler.h"
+#include "input_output/FGPropertyManager.h"
+
+using namespace std;
+
+namespace JSBSim {
+
+IDENT(IdSrc,"$Id$");
+IDENT(IdHdr,ID_PROFILER);
+
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+CLASS IMPLEMENTATION
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+FGProfiler::Section::Section(const string& path)
+  : Path(path), Count(0.0), Sum(0.0), Min(0.0), Max(0.0), Bins(NumBins, 0)
+{
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+// The bin of a duration of m*2^e nanoseconds (0.5 <= m < 1) is 8*e+k where k
+// is the index of m in 8 equal intervals of [0.5, 1).
+
+void FGProfiler::Section::AddSample(double seconds)
+{
+  if (Count == 0.0 || seconds < Min) Min = seconds;
+  if (seconds > Max) Max = seconds;
+  Sum += seconds;
+  Count += 1.0;
+
+  int e = 0;
+  double m = frexp(seconds*1E9, &e);
+  int bin = 8*e + (int)((m - 0.5)*16.0);
+  if (bin < 0) bin = 0;
+  if (bin >= (int)NumBins) bin = NumBins - 1;
+  Bins[bin]++;
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+// Returns the upper bound of the bin that contains the 99th percentile,
+// bounded by the extreme values.
+
+double FGProfiler::Section::GetP99(void) const
+{
+  if (Count == 0.0) return 0.0;
+
+  double rank = ceil(0.99*Count);
+  double total = 0.0;
+  unsigned int bin = 0;
+  for (; bin < NumBins - 1; bin++) {
+    total += Bins[bin];
+    if (total >= rank) break;
+  }
+
+  double upper = ldexp(0.5 + (bin % 8 + 1)/16.0, bin / 8) * 1E-3;
+  return max(GetMin(), min(upper, GetMax()));
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+FGProfiler::FGProfiler(FGPropertyManager* pm)
+  : PropertyManager(pm)
+{
+  Debug(0);
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+FGProfiler::~FGProfiler()
+{
+  static const char* stats[] = {"count", "min-us", "mean-us", "max-us",
+                                "p99-us"};
+
+  for (unsigned int i=0; i<Sections.size(); i++) {
+    string base = "profiling/" + Sections[i]->GetPath() + "/";
+    for (unsigned int j=0; j<sizeof(stats)/sizeof(stats[0]); j++)
+      PropertyManager->Untie(base + stats[j]);
+    delete Sections[i];
+  }
+
+  Debug(1);
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+FGProfiler::Section* FGProfiler::AddSection(const string& path)
+{
+  map<string, Section*>::iterator it = SectionsByPath.find(path);
+  if (it != SectionsByPath.end()) return it->second;
+
+  Section* section = new Section(path);
+  Sections.push_back(section);
+  SectionsByPath[path] = section;
+
+  string base = "profiling/" + path + "/";
+  PropertyManager->Tie(base + "count", section, &Section::GetCount);
+  PropertyManager->Tie(base + "min-us", section, &Section::GetMin);
+  PropertyManager->Tie(base + "mean-us", section, &Section::GetMean);
+  PropertyManager->Tie(base + "max-us", section, &Section::GetMax);
+  PropertyManager->Tie(base + "p99-us", section, &Section::GetP99);
+
+  return section;
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+// The names of the elements are free text: they are converted to lower case,
+// the characters that can not be used in a property name are replaced by '-'
+// and the nodes that do not start with a letter are prefixed by '_'.
+
+FGProfiler::Section* FGProfiler::AddSection(const string& parent,
+                                            const string& name)
+{
+  string path = parent;
+  bool start = true;
+
+  for (unsigned int i=0; i<name.size(); i++) {
+    char c = tolower(name[i]);
+    if (c == '/') {
+      start = true;
+      continue;
+    }
+    if (start) {
+      path += '/';
+      if (!isalpha(c) && c != '_') path += '_';
+      start = false;
+    }
+    if (isalnum(c) || c == '_' || c == '.' || c == '-')
+      path += c;
+    else
+      path += '-';
+  }
+
+  if (path == parent) path += "/unnamed";
+
+  return AddSection(path);
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+void FGProfiler::Report(ostream& out) const
+{
+  size_t width = 7;
+  for (unsigned int i=0; i<Sections.size(); i++)
+    width = max(width, Sections[i]->GetPath().size());
+
+  ios::fmtflags flags = out.flags();
+  streamsize precision = out.precision();
+
+  out << endl << left << setw(width) << "Section" << right
+      << setw(12) << "count" << setw(12) << "min(us)" << setw(12) << "mean(us)"
+      << setw(12) << "p99(us)" << setw(12) << "max(us)" << endl;
+  out << fixed << setprecision(2);
+  for (unsigned int i=0; i<Sections.size(); i++) {
+    const Section* s = Sections[i];
+    out << left << setw(width) << s->GetPath() << right
+        << setw(12) << setprecision(0) << s->GetCount() << setprecision(2)
+        << setw(12) << s->GetMin() << setw(12) << s->GetMean()
+        << setw(12) << s->GetP99() << setw(12) << s->GetMax() << endl;
+  }
+
+  out.flags(flags);
+  out.precision(precision);
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+//    The bitmasked value choices are as follows:
+//    unset: In this case (the default) JSBSim would only print
+//       out the normally expected messages, essentially echoing
+//       the config files as they are read. If the environment
+//       variable is not set, debug_lvl is set to 1 internally
+//    0: This requests JSBSim not to output any messages
+//       whatsoever.
+//    1: This value explicity requests the normal JSBSim
+//       startup messages
+//    2: This value asks for a message to be printed out when
+//       a class is instantiated
+//    4: When this value is set, a message is displayed when a
+//       FGModel object executes its Run() method
+//    8: When this value is set, various runtime state variables
+//       are printed out periodically
+//    16: When set various parameters are sanity checked and
+//       a message is printed out when they go out of bounds
+
+void FGProfiler::Debug(int from)
+{
+  if (debug_lvl <= 0) return;
+
+  if (debug_lvl & 1) { // Standard console startup message output
+  }
+  if (debug_lvl & 2 ) { // Instantiation/Destruction notification
+    if (from == 0) cout << "Instantiated: FGProfiler" << endl;
+    if (from == 1) cout << "Destroyed:    FGProfiler" << endl;
+  }
+  if (debug_lvl & 4 ) { // Run() method entry print for FGModel-derived objects
+  }
+  if (debug_lvl & 8 ) { // Runtime state variables
+  }
+  if (debug_lvl & 16) { // Sanity checking
+  }
+  if (debug_lvl & 64) {
+    if (from == 0) { // Constructor
+      cout << IdSrc << endl;
+      cout << IdHdr << endl;
+    }
+  }
+}
+}
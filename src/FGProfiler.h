@@ -0,0 +1,184 @@
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+ Header: FGProfiler.h
+ Date started: June 2016
+
+ ------------- Copyright (C) 2016  JSBSim development team  -------------
+
+ This program is free software; you can redistribute it and/or modify it under
+ the terms of the GNU Lesser General Public License as published by the Free Software
+ Foundation; either version 2 of the License, or (at your option) any later
+ version.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ details.
+
+ You should have received a copy of the GNU Lesser General Public License along with
+ this program; if not, write to the Free Software Foundation, Inc., 59 Temple
+ Place - Suite 330, Boston, MA  02111-1307, USA.
+
+ Further information about the GNU Lesser General Public License can also be found on
+ the world wide web at http://www.gnu.org.
+
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+SENTRY
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+#ifndef FGPROFILER_H
+#define FGPROFILER_H
+
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+INCLUDES
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+#include <chrono>
+#include <iosfwd>
+#include <map>
+#include <string>
+#include <vector>
+
+#include "FGJSBBase.h"
+
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+DEFINITIONS
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+#define ID_PROFILER "$Id$"
+
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+FORWARD DECLARATIONS
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+namespace JSBSim {
+
+class FGPropertyManager;
+
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+CLASS DOCUMENTATION
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+/** Measures the time spent in the different parts of a frame.
+
+    The profiler is made of sections, each of which accumulates the durations
+    of a part of the frame: a model, the loading of its inputs, a channel or a
+    component of the flight control system, an engine, an output or an input
+    handler... The durations are measured with a monotonic clock by the
+    FGProfiler::Timer objects.
+
+    The statistics of each section are published under the property
+    <tt>profiling/<section>/</tt>, in microseconds:
+    - <tt>count</tt>: the number of samples,
+    - <tt>min-us</tt>, <tt>mean-us</tt> and <tt>max-us</tt>,
+    - <tt>p99-us</tt>: the 99th percentile. It is estimated from a histogram
+      whose bins are about 9% wide.
+
+    The profiler is created by FGFDMExec::SetProfiling() which registers the
+    sections of the models. When the profiling is disabled, no profiler exists
+    and the models only check that they have no section before running
+    their parts.
+
+    A section is only updated by the thread that runs the part it measures,
+    so the models of a parallel stage (see FGFDMExec::SetParallelModels()) can
+    be profiled as well.
+ */
+
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+CLASS DECLARATION
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+class FGProfiler : public FGJSBBase
+{
+public:
+  /// The statistics of the durations of a part of the frame.
+  class Section {
+  public:
+    explicit Section(const std::string& path);
+
+    /// Returns the path of the section, relative to profiling/.
+    const std::string& GetPath(void) const { return Path; }
+    /** Adds a duration to the statistics.
+        @param seconds the duration in seconds. */
+    void AddSample(double seconds);
+
+    /// Returns the number of samples.
+    double GetCount(void) const { return Count; }
+    /// Returns the shortest duration in microseconds.
+    double GetMin(void) const { return Count ? Min*1E6 : 0.0; }
+    /// Returns the mean duration in microseconds.
+    double GetMean(void) const { return Count ? Sum*1E6/Count : 0.0; }
+    /// Returns the longest duration in microseconds.
+    double GetMax(void) const { return Max*1E6; }
+    /// Returns an estimate of the 99th percentile in microseconds.
+    double GetP99(void) const;
+
+  private:
+    // 8 bins per octave of nanoseconds, up to about 20 minutes.
+    static const unsigned int NumBins = 8*40;
+
+    std::string Path;
+    double Count;
+    double Sum;
+    double Min;
+    double Max;
+    std::vector<unsigned int> Bins;
+  };
+
+  /** Measures the time elapsed between its construction and its destruction
+      and adds it to a section. Nothing is measured if the section is null. */
+  class Timer {
+  public:
+    explicit Timer(Section* section) : Sect(section) {
+      if (Sect) Start = std::chrono::steady_clock::now();
+    }
+    ~Timer() {
+      if (Sect) {
+        std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - Start;
+        Sect->AddSample(elapsed.count());
+      }
+    }
+  private:
+    Section* Sect;
+    std::chrono::steady_clock::time_point Start;
+
+    Timer(const Timer&);
+    Timer& operator=(const Timer&);
+  };
+
+  /** Constructor.
+      @param pm the property manager under which the statistics are
+                published. */
+  FGProfiler(FGPropertyManager* pm);
+  /// Destructor. Unties the properties of the sections.
+  ~FGProfiler();
+
+  /** Returns the section with the given path, which is created if it does
+      not exist yet.
+      @param path the path of the section relative to profiling/. */
+  Section* AddSection(const std::string& path);
+  /** Returns the section named after an element of the model (a channel, a
+      component, ...).
+      @param parent the path of the parent of the section.
+      @param name the name of the element. It is converted to a valid property
+                  name. */
+  Section* AddSection(const std::string& parent, const std::string& name);
+
+  /** Writes a table of the statistics of all the sections, in the order in
+      which they have been created. */
+  void Report(std::ostream& out) const;
+
+private:
+  FGPropertyManager* PropertyManager;
+  std::vector<Section*> Sections;
+  std::map<std::string, Section*> SectionsByPath;
+
+  FGProfiler(const FGProfiler&);
+  FGProfiler& operator=(const FGProfiler&);
+
+  void Debug(int from);
+};
+
+} // namespace JSBSim
+
+#endif
@@ -0,0 +1,373 @@
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+Module: FGRealTimeScheduler.cpp
+Date started: June 2016
+Purpose: Runs the frames of a simulation at absolute real time deadlines
+
+ ------------- Copyright (C) 2016  JSBSim development team  -------------
+
+ This program is free software; you can redistribute it and/or modify it under
+ the terms of the GNU Lesser General Public License as published by the Free Software
+ Foundation; either version 2 of the License, or (at your option) any later
+ version.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ details.
+
+ You should have received a copy of the GNU Lesser General Public License along with
+ this program; if not, write to the Free Software Foundation, Inc., 59 Temple
+ Place - Suite 330, Boston, MA  02111-1307, USA.
+
+ Further information about the GNU Lesser General Public License can also be found on
+ the world wide web at http://www.gnu.org.
+
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+INCLUDES
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+#include <cmath>
+#include <cstring>
+#include <iostream>
+
+#if defined(__linux__)
+#  include <errno.h>
+#  include <pthread.h>
+#  include <sched.h>
+#  include <time.h>
+#else
+#  include <chrono>
+#  include <thread>
+#endif
+
+#include "FGRealTimeScheduler.h"
+#include "FGFDMExec.h"
+
+using namespace std;
+
+namespace JSBSim {
+
+IDENT(IdSrc,"$Id$");
+IDENT(IdHdr,ID_REALTIMESCHEDULER);
+
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+CLOCK
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+#if defined(__linux__)
+
+static double Now(void)
+{
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return ts.tv_sec + ts.tv_nsec*1E-9;
+}
+
+static void SleepUntil(double deadline)
+{
+  struct timespec ts;
+  double seconds = floor(deadline);
+  ts.tv_sec = (time_t)seconds;
+  ts.tv_nsec = (long)((deadline - seconds)*1E9);
+  // The deadline is absolute: the sleep is simply resumed when it is
+  // interrupted by a signal.
+  while (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &ts, 0) == EINTR);
+}
+
+#else
+
+static double Now(void)
+{
+  return chrono::duration<double>(chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+static void SleepUntil(double deadline)
+{
+  chrono::duration<double> d(deadline);
+  this_thread::sleep_until(chrono::steady_clock::time_point(chrono::duration_cast<chrono::steady_clock::duration>(d)));
+}
+
+#endif
+
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+CLASS IMPLEMENTATION
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+FGRealTimeScheduler::FGRealTimeScheduler(FGFDMExec* fdmex)
+  : FDMExec(fdmex), Policy(eCatchUp), MaxCatchUp(10), Period(0.0),
+    Origin(0.0), SimOrigin(0.0), Deadline(0.0), PauseStart(0.0),
+    Paused(false), FrameDuration(0.0), Frames(0.0), Overruns(0.0),
+    Dropped(0.0), CatchUps(0.0), Jitter(0.0), JitterSum(0.0), JitterMax(0.0),
+    JitterCount(0.0), FrameMax(0.0)
+{
+  FGPropertyManager* PropertyManager = FDMExec->GetPropertyManager();
+
+  PropertyManager->Tie("simulation/realtime/overrun-policy", this,
+                       &FGRealTimeScheduler::GetPolicy,
+                       &FGRealTimeScheduler::SetPolicy);
+  PropertyManager->Tie("simulation/realtime/max-catch-up-frames", this,
+                       &FGRealTimeScheduler::GetMaxCatchUpFrames,
+                       &FGRealTimeScheduler::SetMaxCatchUpFrames);
+  PropertyManager->Tie("simulation/realtime/frames", &Frames);
+  PropertyManager->Tie("simulation/realtime/overruns", &Overruns);
+  PropertyManager->Tie("simulation/realtime/dropped-frames", &Dropped);
+  PropertyManager->Tie("simulation/realtime/catch-up-frames", &CatchUps);
+  PropertyManager->Tie("simulation/realtime/jitter-us", this,
+                       &FGRealTimeScheduler::GetJitter);
+  PropertyManager->Tie("simulation/realtime/jitter-mean-us", this,
+                       &FGRealTimeScheduler::GetJitterMean);
+  PropertyManager->Tie("simulation/realtime/jitter-max-us", this,
+                       &FGRealTimeScheduler::GetJitterMax);
+  PropertyManager->Tie("simulation/realtime/frame-us", this,
+                       &FGRealTimeScheduler::GetFrame);
+  PropertyManager->Tie("simulation/realtime/frame-max-us", this,
+                       &FGRealTimeScheduler::GetFrameMax);
+  PropertyManager->Tie("simulation/realtime/lag-sec", this,
+                       &FGRealTimeScheduler::GetLag);
+
+  Debug(0);
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+FGRealTimeScheduler::~FGRealTimeScheduler()
+{
+  static const char* props[] = {"overrun-policy", "max-catch-up-frames",
+                                "frames", "overruns", "dropped-frames",
+                                "catch-up-frames", "jitter-us",
+                                "jitter-mean-us", "jitter-max-us", "frame-us",
+                                "frame-max-us", "lag-sec"};
+  FGPropertyManager* PropertyManager = FDMExec->GetPropertyManager();
+
+  for (unsigned int i=0; i<sizeof(props)/sizeof(props[0]); i++)
+    PropertyManager->Untie(string("simulation/realtime/") + props[i]);
+
+  Debug(1);
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+bool FGRealTimeScheduler::SetRealTimePriority(int priority)
+{
+#if defined(__linux__)
+  struct sched_param param;
+  memset(&param, 0, sizeof(param));
+  param.sched_priority = priority;
+  int error = pthread_setschedparam(pthread_self(), SCHED_FIFO, &param);
+  if (error) {
+    cerr << "Could not set the SCHED_FIFO priority " << priority << ": "
+         << strerror(error) << endl;
+    return false;
+  }
+  return true;
+#else
+  cerr << "The real time priority is not supported on this platform" << endl;
+  return false;
+#endif
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+bool FGRealTimeScheduler::SetCPUAffinity(int cpu)
+{
+#if defined(__linux__)
+  if (cpu < 0 || cpu >= CPU_SETSIZE) {
+    cerr << "Invalid CPU index " << cpu << endl;
+    return false;
+  }
+
+  cpu_set_t cpus;
+  CPU_ZERO(&cpus);
+  CPU_SET(cpu, &cpus);
+  int error = pthread_setaffinity_np(pthread_self(), sizeof(cpus), &cpus);
+  if (error) {
+    cerr << "Could not bind the simulation to the CPU " << cpu << ": "
+         << strerror(error) << endl;
+    return false;
+  }
+  return true;
+#else
+  cerr << "The CPU affinity is not supported on this platform" << endl;
+  return false;
+#endif
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+void FGRealTimeScheduler::Start(void)
+{
+  Period = FDMExec->GetDeltaT();
+  Origin = Deadline = Now();
+  SimOrigin = FDMExec->GetSimTime();
+  Paused = false;
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+void FGRealTimeScheduler::Pause(void)
+{
+  if (Paused) return;
+
+  PauseStart = Now();
+  Paused = true;
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+void FGRealTimeScheduler::Resume(void)
+{
+  if (!Paused) return;
+
+  double pause = Now() - PauseStart;
+  Origin += pause;
+  Deadline += pause;
+  Paused = false;
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+bool FGRealTimeScheduler::Run(void)
+{
+  Resume();
+
+  // The time step may be modified by the simulation.
+  Period = FDMExec->GetDeltaT();
+
+  double now = Now();
+  if (now < Deadline) {
+    SleepUntil(Deadline);
+    now = Now();
+  }
+
+  Jitter = max(now - Deadline, 0.0);
+  JitterSum += Jitter;
+  JitterMax = max(JitterMax, Jitter);
+  JitterCount += 1.0;
+
+  bool result = RunFrame();
+  Deadline += Period;
+  now = Now();
+
+  if (result && now > Deadline) {
+    Overruns += 1.0;
+
+    switch (Policy) {
+    case eCatchUp:
+      for (int i=0; i<MaxCatchUp && now > Deadline; i++) {
+        if (FDMExec->Holding()) break;
+        result = RunFrame();
+        CatchUps += 1.0;
+        Deadline += Period;
+        now = Now();
+        if (!result) return false;
+      }
+      if (now > Deadline) SkipMissedDeadlines(now);
+      break;
+    case eDrop:
+      SkipMissedDeadlines(now);
+      break;
+    case eSlip:
+      Deadline = now;
+      break;
+    }
+  }
+
+  return result;
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+bool FGRealTimeScheduler::RunFrame(void)
+{
+  double start = Now();
+  bool result = FDMExec->Run();
+  FrameDuration = Now() - start;
+  FrameMax = max(FrameMax, FrameDuration);
+  Frames += 1.0;
+  return result;
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+// Moves the deadline to the first one of the schedule that is still ahead.
+
+void FGRealTimeScheduler::SkipMissedDeadlines(double now)
+{
+  if (Period <= 0.0) {
+    Deadline = now;
+    return;
+  }
+
+  double missed = floor((now - Deadline)/Period) + 1.0;
+  Deadline += missed*Period;
+  Dropped += missed;
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+double FGRealTimeScheduler::GetElapsedTime(void) const
+{
+  return (Paused ? PauseStart : Now()) - Origin;
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+double FGRealTimeScheduler::GetLag(void) const
+{
+  return GetElapsedTime() - (FDMExec->GetSimTime() - SimOrigin);
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+void FGRealTimeScheduler::SetPolicy(int policy)
+{
+  if (policy < eDrop || policy > eSlip) {
+    cerr << "Unknown overrun policy " << policy << endl;
+    return;
+  }
+  Policy = (eOverrunPolicy)policy;
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+//    The bitmasked value choices are as follows:
+//    unset: In this case (the default) JSBSim would only print
+//       out the normally expected messages, essentially echoing
+//       the config files as they are read. If the environment
+//       variable is not set, debug_lvl is set to 1 internally
+//    0: This requests JSBSim not to output any messages
+//       whatsoever.
+//    1: This value explicity requests the normal JSBSim
+//       startup messages
+//    2: This value asks for a message to be printed out when
+//       a class is instantiated
+//    4: When this value is set, a message is displayed when a
+//       FGModel object executes its Run() method
+//    8: When this value is set, various runtime state variables
+//       are printed out periodically
+//    16: When set various parameters are sanity checked and
+//       a message is printed out when they go out of bounds
+
+void FGRealTimeScheduler::Debug(int from)
+{
+  if (debug_lvl <= 0) return;
+
+  if (debug_lvl & 1) { // Standard console startup message output
+  }
+  if (debug_lvl & 2 ) { // Instantiation/Destruction notification
+    if (from == 0) cout << "Instantiated: FGRealTimeScheduler" << endl;
+    if (from == 1) cout << "Destroyed:    FGRealTimeScheduler" << endl;
+  }
+  if (debug_lvl & 4 ) { // Run() method entry print for FGModel-derived objects
+  }
+  if (debug_lvl & 8 ) { // Runtime state variables
+  }
+  if (debug_lvl & 16) { // Sanity checking
+  }
+  if (debug_lvl & 64) {
+    if (from == 0) { // Constructor
+      cout << IdSrc << endl;
+      cout << IdHdr << endl;
+    }
+  }
+}
+}
@@ -0,0 +1,185 @@
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+ Header: FGRealTimeScheduler.h
+ Date started: June 2016
+
+ ------------- Copyright (C) 2016  JSBSim development team  -------------
+
+ This program is free software; you can redistribute it and/or modify it under
+ the terms of the GNU Lesser General Public License as published by the Free Software
+ Foundation; either version 2 of the License, or (at your option) any later
+ version.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ details.
+
+ You should have received a copy of the GNU Lesser General Public License along with
+ this program; if not, write to the Free Software Foundation, Inc., 59 Temple
+ Place - Suite 330, Boston, MA  02111-1307, USA.
+
+ Further information about the GNU Lesser General Public License can also be found on
+ the world wide web at http://www.gnu.org.
+
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+SENTRY
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+#ifndef FGREALTIMESCHEDULER_H
+#define FGREALTIMESCHEDULER_H
+
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+INCLUDES
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+#include "FGJSBBase.h"
+
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+DEFINITIONS
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+#define ID_REALTIMESCHEDULER "$Id$"
+
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+FORWARD DECLARATIONS
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+namespace JSBSim {
+
+class FGFDMExec;
+
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+CLASS DOCUMENTATION
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+/** Runs the frames of a simulation in real time.
+
+    The frames are started at absolute deadlines spaced by the time step of
+    the simulation. The scheduler sleeps until each deadline on a monotonic
+    clock (with clock_nanosleep() where it is available) so that the errors
+    do not accumulate from one frame to the next.
+
+    A frame overruns when it ends after the deadline of the next frame. What
+    happens next depends on the overrun policy:
+    - eDrop: the missed deadlines are skipped and the simulation falls behind
+      the real time by as many frames.
+    - eCatchUp: the missed frames are run immediately, at most
+      GetMaxCatchUpFrames() of them in a row. The deadlines that are still
+      missed after that are skipped as with eDrop.
+    - eSlip: the schedule is shifted by the overrun: the next frame is started
+      immediately and the following deadlines are counted from it.
+
+    The statistics of the scheduler are published under
+    <tt>simulation/realtime/</tt>:
+    - <tt>frames</tt>, <tt>overruns</tt>, <tt>dropped-frames</tt> and
+      <tt>catch-up-frames</tt>: counts since the start.
+    - <tt>jitter-us</tt>, <tt>jitter-mean-us</tt> and
+      <tt>jitter-max-us</tt>: the delay between a deadline and the instant
+      when the scheduler woke up to start the frame.
+    - <tt>frame-us</tt> and <tt>frame-max-us</tt>: the duration of a frame.
+    - <tt>lag-sec</tt>: how far the simulation time is behind the real time
+      elapsed since the start, pauses excluded.
+    The properties <tt>overrun-policy</tt> (0: eDrop, 1: eCatchUp, 2: eSlip)
+    and <tt>max-catch-up-frames</tt> can be modified while the simulation
+    runs.
+
+    The priority and the CPU affinity only apply to the thread that calls
+    SetRealTimePriority() and SetCPUAffinity(), which should be the thread that
+    calls Run(). They are only supported on Linux and usually require
+    privileges.
+ */
+
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+CLASS DECLARATION
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+class FGRealTimeScheduler : public FGJSBBase
+{
+public:
+  enum eOverrunPolicy {eDrop=0, eCatchUp, eSlip};
+
+  /** Constructor.
+      @param fdmex the instance that is run. Its time step is the period of
+                   the frames. */
+  FGRealTimeScheduler(FGFDMExec* fdmex);
+  /// Destructor. Unties the properties of the statistics.
+  ~FGRealTimeScheduler();
+
+  void SetOverrunPolicy(eOverrunPolicy policy) { Policy = policy; }
+  eOverrunPolicy GetOverrunPolicy(void) const { return Policy; }
+  /// Sets the maximum number of frames that are run in a row to catch up.
+  void SetMaxCatchUpFrames(int frames) { MaxCatchUp = frames > 0 ? frames : 0; }
+  int GetMaxCatchUpFrames(void) const { return MaxCatchUp; }
+
+  /** Runs the calling thread with the SCHED_FIFO policy.
+      @param priority the priority, between 1 and 99.
+      @return false if the priority could not be set. */
+  bool SetRealTimePriority(int priority);
+  /** Binds the calling thread to a CPU.
+      @param cpu the index of the CPU.
+      @return false if the affinity could not be set. */
+  bool SetCPUAffinity(int cpu);
+
+  /// Starts the schedule: the first frame is due immediately.
+  void Start(void);
+  /** Waits for the deadline of the next frame and runs it, followed by the
+      frames that catch up the schedule after an overrun.
+      @return the result of FGFDMExec::Run(): false when the simulation is
+              over. */
+  bool Run(void);
+  /** Stops the clock of the schedule while the simulation is held. Resume()
+      restarts it: the duration of the pause is not counted as lag. */
+  void Pause(void);
+  void Resume(void);
+
+  /// Returns the real time elapsed since the start, pauses excluded.
+  double GetElapsedTime(void) const;
+  /// Returns the duration of the last frame in seconds.
+  double GetFrameDuration(void) const { return FrameDuration; }
+
+private:
+  FGFDMExec* FDMExec;
+  eOverrunPolicy Policy;
+  int MaxCatchUp;
+
+  double Period;
+  double Origin;
+  double SimOrigin;
+  double Deadline;
+  double PauseStart;
+  bool Paused;
+
+  double FrameDuration;
+  double Frames;
+  double Overruns;
+  double Dropped;
+  double CatchUps;
+  double Jitter;
+  double JitterSum;
+  double JitterMax;
+  double JitterCount;
+  double FrameMax;
+
+  bool RunFrame(void);
+  void SkipMissedDeadlines(double now);
+
+  int GetPolicy(void) const { return Policy; }
+  void SetPolicy(int policy);
+  double GetJitter(void) const { return Jitter*1E6; }
+  double GetJitterMean(void) const
+  { return JitterCount ? JitterSum*1E6/JitterCount : 0.0; }
+  double GetJitterMax(void) const { return JitterMax*1E6; }
+  double GetFrame(void) const { return FrameDuration*1E6; }
+  double GetFrameMax(void) const { return FrameMax*1E6; }
+  double GetLag(void) const;
+
+  FGRealTimeScheduler(const FGRealTimeScheduler&);
+  FGRealTimeScheduler& operator=(const FGRealTimeScheduler&);
+
+  void Debug(int from);
+};
+
+} // namespace JSBSim
+
+#endif
@@ -0,0 +1,269 @@
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+Module: FGThreadPool.cpp
+Date started: February 2016
+Purpose: Shares the iterations of a loop between a pool of threads
+
+ ------------- Copyright (C) 2016  JSBSim development team  -------------
+
+ This program is free software; you can redistribute it and/or modify it under
+ the terms of the GNU Lesser General Public License as published by the Free Software
+ Foundation; either version 2 of the License, or (at your option) any later
+ version.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ details.
+
+ You should have received a copy of the GNU Lesser General Public License along with
+ this program; if not, write to the Free Software Foundation, Inc., 59 Temple
+ Place - Suite 330, Boston, MA  02111-1307, USA.
+
+ Further information about the GNU Lesser General Public License can also be found on
+ the world wide web at http://www.gnu.org.
+
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+INCLUDES
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+#include <chrono>
+#include <iostream>
+#include "FGThreadPool.h"
+
+using namespace std;
+
+namespace JSBSim {
+
+IDENT(IdSrc,"$Id$");
+IDENT(IdHdr,ID_THREADPOOL);
+
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+CLASS IMPLEMENTATION
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+FGThreadPool::FGThreadPool(unsigned int nthreads)
+  : CurrentJob(0), Generation(0), Busy(0), SpinWait(0), JobDebugLevel(0),
+    Quit(false)
+{
+  if (nthreads == 0) nthreads = thread::hardware_concurrency();
+  if (nthreads == 0) nthreads = 1;
+
+  for (unsigned int i=0; i<nthreads; i++) {
+    Range* range = new Range;
+    range->Begin = range->End = 0;
+    Ranges.push_back(range);
+  }
+
+  // The thread #0 is the one that calls ParallelFor()
+  for (unsigned int i=1; i<nthreads; i++)
+    Workers.push_back(thread(&FGThreadPool::WorkerLoop, this, i));
+
+  Debug(0);
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+FGThreadPool::~FGThreadPool()
+{
+  {
+    lock_guard<mutex> guard(Lock);
+    Quit = true;
+  }
+  Start.notify_all();
+
+  for (unsigned int i=0; i<Workers.size(); i++) Workers[i].join();
+  for (unsigned int i=0; i<Ranges.size(); i++) delete Ranges[i];
+
+  Debug(1);
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+void FGThreadPool::ParallelFor(unsigned int n, Job& job)
+{
+  if (n == 0) return;
+
+  if (Workers.empty()) {
+    for (unsigned int i=0; i<n; i++) job.Execute(i);
+    return;
+  }
+
+  unsigned int nthreads = Ranges.size();
+  for (unsigned int i=0; i<nthreads; i++) {
+    lock_guard<mutex> guard(Ranges[i]->Lock);
+    Ranges[i]->Begin = (n * i) / nthreads;
+    Ranges[i]->End = (n * (i+1)) / nthreads;
+  }
+
+  {
+    lock_guard<mutex> guard(Lock);
+    CurrentJob = &job;
+    JobDebugLevel = debug_lvl;
+    Busy = Workers.size();
+    Generation++;
+  }
+  Start.notify_all();
+
+  Work(0);
+
+  unsigned int busy;
+  while ((busy = Busy) > 0 && Spin(Busy, busy));
+
+  if (busy > 0) {
+    unique_lock<mutex> guard(Lock);
+    while (Busy > 0) Done.wait(guard);
+  }
+  CurrentJob = 0;
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+void FGThreadPool::WorkerLoop(unsigned int id)
+{
+  unsigned int done = 0;
+
+  while (true) {
+    Spin(Generation, done);
+
+    {
+      unique_lock<mutex> guard(Lock);
+      while (!Quit && Generation == done) Start.wait(guard);
+      if (Quit) return;
+      done = Generation;
+      debug_lvl = JobDebugLevel;
+    }
+
+    Work(id);
+
+    if (--Busy == 0) {
+      lock_guard<mutex> guard(Lock);
+      Done.notify_one();
+    }
+  }
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+// Waits actively for at most SpinWait microseconds for a counter to move away
+// from its initial value. Returns true if the counter has changed.
+
+bool FGThreadPool::Spin(const atomic<unsigned int>& value,
+                        unsigned int initial) const
+{
+  unsigned int duration = SpinWait;
+  if (duration == 0) return value != initial;
+
+  chrono::steady_clock::time_point deadline = chrono::steady_clock::now()
+                                              + chrono::microseconds(duration);
+  unsigned int count = 0;
+
+  while (value == initial) {
+    // Reading the clock is slower than checking the counter.
+    if ((++count & 63) == 0 && chrono::steady_clock::now() > deadline)
+      return false;
+  }
+
+  return true;
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+void FGThreadPool::Work(unsigned int id)
+{
+  unsigned int index;
+
+  do {
+    while (Pop(id, index)) CurrentJob->Execute(index);
+  } while (Steal(id));
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+// The owner of a range takes its iterations from the front.
+
+bool FGThreadPool::Pop(unsigned int id, unsigned int& index)
+{
+  Range* range = Ranges[id];
+  lock_guard<mutex> guard(range->Lock);
+
+  if (range->Begin == range->End) return false;
+
+  index = range->Begin++;
+  return true;
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+// A thread which range is exhausted takes the upper half of the first non empty
+// range it finds. Since its own range is empty, the other threads cannot steal
+// from it in the meantime.
+
+bool FGThreadPool::Steal(unsigned int id)
+{
+  unsigned int nthreads = Ranges.size();
+
+  for (unsigned int i=1; i<nthreads; i++) {
+    Range* victim = Ranges[(id+i) % nthreads];
+    unsigned int begin, end;
+    {
+      lock_guard<mutex> guard(victim->Lock);
+      unsigned int count = victim->End - victim->Begin;
+      if (count == 0) continue;
+      end = victim->End;
+      begin = end - (count+1)/2;
+      victim->End = begin;
+    }
+
+    Range* range = Ranges[id];
+    lock_guard<mutex> guard(range->Lock);
+    range->Begin = begin;
+    range->End = end;
+    return true;
+  }
+
+  return false;
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+//    The bitmasked value choices are as follows:
+//    unset: In this case (the default) JSBSim would only print
+//       out the normally expected messages, essentially echoing
+//       the config files as they are read. If the environment
+//       variable is not set, debug_lvl is set to 1 internally
+//    0: This requests JSBSim not to output any messages
+//       whatsoever.
+//    1: This value explicity requests the normal JSBSim
+//       startup messages
+//    2: This value asks for a message to be printed out when
+//       a class is instantiated
+//    4: When this value is set, a message is displayed when a
+//       FGModel object executes its Run() method
+//    8: When this value is set, various runtime state variables
+//       are printed out periodically
+//    16: When set various parameters are sanity checked and
+//       a message is printed out when they go out of bounds
+
+void FGThreadPool::Debug(int from)
+{
+  if (debug_lvl <= 0) return;
+
+  if (debug_lvl & 1) { // Standard console startup message output
+  }
+  if (debug_lvl & 2 ) { // Instantiation/Destruction notification
+    if (from == 0) cout << "Instantiated: FGThreadPool (" << Ranges.size()
+                        << " threads)" << endl;
+    if (from == 1) cout << "Destroyed:    FGThreadPool" << endl;
+  }
+  if (debug_lvl & 4 ) { // Run() method entry print for FGModel-derived objects
+  }
+  if (debug_lvl & 8 ) { // Runtime state variables
+  }
+  if (debug_lvl & 16) { // Sanity checking
+  }
+  if (debug_lvl & 64) {
+    if (from == 0) { // Constructor
+      cout << IdSrc << endl;
+      cout << IdHdr << endl;
+    }
+  }
+}
+
+}
@@ -0,0 +1,147 @@
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+Header: FGThreadPool.h
+Date started: February 2016
+
+ ------------- Copyright (C) 2016  JSBSim development team  -------------
+
+ This program is free software; you can redistribute it and/or modify it under
+ the terms of the GNU Lesser General Public License as published by the Free Software
+ Foundation; either version 2 of the License, or (at your option) any later
+ version.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ details.
+
+ You should have received a copy of the GNU Lesser General Public License along with
+ this program; if not, write to the Free Software Foundation, Inc., 59 Temple
+ Place - Suite 330, Boston, MA  02111-1307, USA.
+
+ Further information about the GNU Lesser General Public License can also be found on
+ the world wide web at http://www.gnu.org.
+
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+SENTRY
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+#ifndef FGTHREADPOOL_H
+#define FGTHREADPOOL_H
+
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+INCLUDES
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+#include <atomic>
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+
+#include "FGJSBBase.h"
+
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+DEFINITIONS
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+#define ID_THREADPOOL "$Id$"
+
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+FORWARD DECLARATIONS
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+namespace JSBSim {
+
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+CLASS DOCUMENTATION
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+/** A pool of threads that share the iterations of a loop.
+    The iterations 0..n-1 of a job are initially split in contiguous ranges,
+    one range per thread. Each thread executes the iterations of its range from
+    the front and, once its range is exhausted, steals the upper half of the
+    range of another thread. The loads are thus balanced even when the
+    iterations do not have the same cost.
+
+    The thread that calls ParallelFor() takes part in the job so a pool of N
+    threads creates N-1 worker threads. The workers inherit the debug level of
+    the calling thread.
+
+    The iterations of a job are executed concurrently: they must not modify
+    data shared with the other iterations and must not throw exceptions.
+
+    By default the idle threads are put to sleep, which costs a few tens of
+    microseconds to wake them up. When the jobs are short and submitted at a
+    high rate (e.g. several times per simulation frame) the threads can be
+    requested to spin for a while before they go to sleep, see SetSpinWait().
+*/
+
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+CLASS DECLARATION
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+class FGThreadPool : public FGJSBBase
+{
+public:
+  /// The interface of the jobs executed by the pool.
+  class Job {
+  public:
+    virtual ~Job() {}
+    /** Executes one iteration of the job.
+        @param index the index of the iteration. */
+    virtual void Execute(unsigned int index) = 0;
+  };
+
+  /** Constructor.
+      @param nthreads the number of threads of the pool including the calling
+                      thread. If 0, the number of hardware threads is used. */
+  FGThreadPool(unsigned int nthreads = 0);
+  /// Destructor
+  ~FGThreadPool();
+
+  /// Returns the number of threads of the pool including the calling thread.
+  unsigned int GetNumThreads(void) const { return Ranges.size(); }
+
+  /** Sets the time during which the threads wait actively for a new job (or
+      for the completion of the current job) before they go to sleep.
+      @param microseconds the duration of the active wait. 0 (the default)
+                          puts the threads to sleep immediately. */
+  void SetSpinWait(unsigned int microseconds) { SpinWait = microseconds; }
+
+  /** Executes the iterations 0..n-1 of a job and returns when they are all
+      completed.
+      @param n the number of iterations.
+      @param job the job to execute. */
+  void ParallelFor(unsigned int n, Job& job);
+
+private:
+  struct Range {
+    std::mutex Lock;
+    unsigned int Begin;
+    unsigned int End;
+  };
+
+  std::vector<std::thread> Workers;
+  std::vector<Range*> Ranges;
+  std::mutex Lock;
+  std::condition_variable Start;
+  std::condition_variable Done;
+  Job* CurrentJob;
+  std::atomic<unsigned int> Generation;
+  std::atomic<unsigned int> Busy;
+  std::atomic<unsigned int> SpinWait;
+  short JobDebugLevel;
+  bool Quit;
+
+  void WorkerLoop(unsigned int id);
+  bool Spin(const std::atomic<unsigned int>& value, unsigned int initial) const;
+  void Work(unsigned int id);
+  bool Pop(unsigned int id, unsigned int& index);
+  bool Steal(unsigned int id);
+  void Debug(int from);
+};
+
+} // namespace JSBSim
+
+#endif
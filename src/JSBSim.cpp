@@ -41,6 +41,8 @@ INCLUDES
 
 #include "initialization/FGTrim.h"
 #include "FGFDMExec.h"
+#include "FGMonteCarlo.h"
+#include "FGRealTimeScheduler.h"
 #include "input_output/FGXMLFileRead.h"
 
 #if !defined(__GNUC__) && !defined(sgi) && !defined(_MSC_VER)
@@ -60,6 +62,7 @@ INCLUDES
 #  include <sys/time.h>
 #endif
 
+#include <fstream>
 #include <iostream>
 #include <cstdlib>
 
@@ -78,9 +81,12 @@ GLOBAL DATA
 %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
 
 string RootDir = "";
+string CacheDir = "";
 string ScriptName;
 string AircraftName;
 string ResetName;
+string MonteCarloName;
+string ProfileName;
 vector <string> LogOutputName;
 vector <string> LogDirectiveName;
 vector <string> CommandLineProperties;
@@ -93,11 +99,17 @@ bool play_nice;
 bool suspend;
 bool catalog;
 bool nohighlight;
+bool profile;
 
 double end_time = 1e99;
 double simulation_rate = 1./120.;
 bool override_sim_rate = false;
 double sleep_period=0.01;
+JSBSim::FGRealTimeScheduler::eOverrunPolicy overrun_policy = JSBSim::FGRealTimeScheduler::eCatchUp;
+int max_catch_up_frames = 10;
+int rt_priority = 0;
+int cpu_affinity = -1;
+JSBSim::FGFDMExec::eAtmosphereModel atmosphere_model = JSBSim::FGFDMExec::eStandardAtmosphere;
 
 /*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
 FORWARD DECLARATIONS
@@ -107,24 +119,6 @@ bool options(int, char**);
 int real_main(int argc, char* argv[]);
 void PrintHelp(void);
 
-#if defined(__BORLANDC__) || defined(_MSC_VER) || defined(__MINGW32__)
-  double getcurrentseconds(void)
-  {
-    struct timeb tm_ptr;
-    ftime(&tm_ptr);
-    return tm_ptr.time + tm_ptr.millitm*0.001;
-  }
-#else
-  double getcurrentseconds(void)
-  {
-    struct timeval tval;
-    struct timezone tz;
-
-    gettimeofday(&tval, &tz);
-    return (tval.tv_sec + tval.tv_usec*1e-6);
-  }
-#endif
-
 #if defined(__BORLANDC__) || defined(_MSC_VER) || defined(__MINGW32__)
   void sim_nsleep(long nanosec)
   {
@@ -298,6 +292,8 @@ int real_main(int argc, char* argv[])
   ScriptName = "";
   AircraftName = "";
   ResetName = "";
+  MonteCarloName = "";
+  ProfileName = "";
   LogOutputName.clear();
   LogDirectiveName.clear();
   bool result = false, success;
@@ -307,19 +303,17 @@ int real_main(int argc, char* argv[])
 
   double new_five_second_value = 0.0;
   double actual_elapsed_time = 0;
-  double initial_seconds = 0;
-  double current_seconds = 0.0;
-  double paused_seconds = 0.0;
-  double sim_lag_time = 0;
   double cycle_duration = 0.0;
   double override_sim_rate_value = 0.0;
   long sleep_nseconds = 0;
+  JSBSim::FGRealTimeScheduler* scheduler = 0;
 
   realtime = false;
   play_nice = false;
   suspend = false;
   catalog = false;
   nohighlight = false;
+  profile = false;
 
   // *** PARSE OPTIONS PASSED INTO THIS SPECIFIC APPLICATION: JSBSim *** //
   success = options(argc, argv);
@@ -328,12 +322,33 @@ int real_main(int argc, char* argv[])
     exit(-1);
   }
 
+  // *** RUN A MONTE CARLO CAMPAIGN *** //
+  if (!MonteCarloName.empty()) {
+    JSBSim::FGMonteCarlo campaign;
+    campaign.SetRootDir(RootDir);
+
+    if (!campaign.Load(MonteCarloName)) {
+      cerr << "Monte Carlo file " << MonteCarloName
+           << " was not successfully loaded" << endl;
+      exit(-1);
+    }
+
+    if (!ScriptName.empty()) campaign.SetScript(ScriptName);
+    if (!LogOutputName.empty()) campaign.SetResultsFile(LogOutputName[0]);
+
+    if (!campaign.Run()) exit(-1);
+
+    return 0;
+  }
+
   // *** SET UP JSBSIM *** //
   FDMExec = new JSBSim::FGFDMExec();
+  FDMExec->SetAtmosphereModel(atmosphere_model);
   FDMExec->SetRootDir(RootDir);
   FDMExec->SetAircraftPath("aircraft");
   FDMExec->SetEnginePath("engine");
   FDMExec->SetSystemsPath("systems");
+  FDMExec->SetCacheDir(CacheDir);
   FDMExec->GetPropertyManager()->Tie("simulation/frame_start_time", &actual_elapsed_time);
   FDMExec->GetPropertyManager()->Tie("simulation/cycle_duration", &cycle_duration);
 
@@ -439,6 +454,8 @@ int real_main(int argc, char* argv[])
     }
   }
 
+  if (profile) FDMExec->SetProfiling(true);
+
   FDMExec->RunIC();
 
   // PRINT SIMULATION CONFIGURATION
@@ -478,7 +495,15 @@ int real_main(int argc, char* argv[])
   else          sleep_nseconds = (sleep_period )*1e9;           // 0.01 seconds
 
   tzset(); 
-  current_seconds = initial_seconds = getcurrentseconds();
+
+  if (realtime) {
+    scheduler = new JSBSim::FGRealTimeScheduler(FDMExec);
+    scheduler->SetOverrunPolicy(overrun_policy);
+    scheduler->SetMaxCatchUpFrames(max_catch_up_frames);
+    if (cpu_affinity >= 0) scheduler->SetCPUAffinity(cpu_affinity);
+    if (rt_priority > 0) scheduler->SetRealTimePriority(rt_priority);
+    scheduler->Start();
+  }
 
   // *** CYCLIC EXECUTION LOOP, AND MESSAGE READING *** //
   while (result && FDMExec->GetSimTime() <= end_time) {
@@ -502,23 +527,15 @@ int real_main(int argc, char* argv[])
 
       } else {                    // ------------ RUNNING IN REALTIME MODE
 
-        // "was_paused" will be true if entering this "run" loop from a paused state.
+        // The scheduler sleeps until the deadline of the next frame and deals
+        // with the overruns. The time spent holding is not counted.
         if (was_paused) {
-          initial_seconds += paused_seconds;
+          scheduler->Resume();
           was_paused = false;
         }
-        current_seconds = getcurrentseconds();                      // Seconds since 1 Jan 1970
-        actual_elapsed_time = current_seconds - initial_seconds;    // Real world elapsed seconds since start
-        sim_lag_time = actual_elapsed_time - FDMExec->GetSimTime(); // How far behind sim-time is from actual
-                                                                    // elapsed time.
-        for (int i=0; i<(int)(sim_lag_time/frame_duration); i++) {  // catch up sim time to actual elapsed time.
-          result = FDMExec->Run();
-          cycle_duration = getcurrentseconds() - current_seconds;   // Calculate cycle duration
-          current_seconds = getcurrentseconds();                    // Get new current_seconds
-          if (FDMExec->Holding()) break;
-        }
-
-        if (play_nice) sim_nsleep(sleep_nseconds);
+        result = scheduler->Run();
+        actual_elapsed_time = scheduler->GetElapsedTime();
+        cycle_duration = scheduler->GetFrameDuration();
 
         if (FDMExec->GetSimTime() >= new_five_second_value) { // Print out elapsed time every five seconds.
           cout << "Simulation elapsed time: " << FDMExec->GetSimTime() << endl;
@@ -526,8 +543,8 @@ int real_main(int argc, char* argv[])
         }
       }
     } else { // Suspended
+      if (scheduler && !was_paused) scheduler->Pause();
       was_paused = true;
-      paused_seconds = getcurrentseconds() - current_seconds;
       sim_nsleep(sleep_nseconds);
       result = FDMExec->Run();
     }
@@ -542,7 +559,21 @@ quit:
   strftime(s, 99, "%A %B %d %Y %X", localtime(&tod));
   cout << "End: " << s << " (HH:MM:SS)" << endl;
 
+  // PRINT THE PROFILE OF THE FRAMES
+  if (profile && FDMExec->GetProfiler()) {
+    if (ProfileName.empty())
+      FDMExec->GetProfiler()->Report(cout);
+    else {
+      ofstream report(ProfileName.c_str());
+      if (report.is_open())
+        FDMExec->GetProfiler()->Report(report);
+      else
+        cerr << "Could not open the profile report file " << ProfileName << endl;
+    }
+  }
+
   // CLEAN UP
+  delete scheduler;
   delete FDMExec;
 
   return 0;
@@ -558,6 +589,7 @@ bool options(int count, char **arg)
 {
   int i;
   bool result = true;
+  string realtime_option;
 
   if (count == 1) {
     PrintHelp();
@@ -585,6 +617,54 @@ bool options(int count, char **arg)
       exit (0);
     } else if (keyword == "--realtime") {
       realtime = true;
+    } else if (keyword == "--overrun") {
+      realtime_option = keyword;
+      if (value == "drop")
+        overrun_policy = JSBSim::FGRealTimeScheduler::eDrop;
+      else if (value == "catchup")
+        overrun_policy = JSBSim::FGRealTimeScheduler::eCatchUp;
+      else if (value == "slip")
+        overrun_policy = JSBSim::FGRealTimeScheduler::eSlip;
+      else {
+        cerr << endl << "  Invalid overrun policy given!" << endl << endl;
+        result = false;
+      }
+    } else if (keyword == "--max-catchup") {
+      realtime_option = keyword;
+      if (n != string::npos) {
+        max_catch_up_frames = atoi(value.c_str());
+        if (max_catch_up_frames < 0) {
+          cerr << endl << "  Invalid maximum number of catch up frames given!" << endl << endl;
+          result = false;
+        }
+      } else {
+        gripe;
+        exit(1);
+      }
+    } else if (keyword == "--rt-priority") {
+      realtime_option = keyword;
+      if (n != string::npos) {
+        rt_priority = atoi(value.c_str());
+        if (rt_priority < 1 || rt_priority > 99) {
+          cerr << endl << "  Invalid real time priority given!" << endl << endl;
+          result = false;
+        }
+      } else {
+        gripe;
+        exit(1);
+      }
+    } else if (keyword == "--cpu") {
+      realtime_option = keyword;
+      if (n != string::npos) {
+        cpu_affinity = atoi(value.c_str());
+        if (cpu_affinity < 0) {
+          cerr << endl << "  Invalid CPU index given!" << endl << endl;
+          result = false;
+        }
+      } else {
+        gripe;
+        exit(1);
+      }
     } else if (keyword == "--nice") {
       play_nice = true;
       if (n != string::npos) {
@@ -597,10 +677,22 @@ bool options(int count, char **arg)
       } else {
         sleep_period = 0.01;
       }
+    } else if (keyword == "--atmosphere") {
+      if (value == "standard")
+        atmosphere_model = JSBSim::FGFDMExec::eStandardAtmosphere;
+      else if (value == "msis")
+        atmosphere_model = JSBSim::FGFDMExec::eMSISAtmosphere;
+      else {
+        cerr << endl << "  Invalid atmosphere model given!" << endl << endl;
+        result = false;
+      }
     } else if (keyword == "--suspend") {
       suspend = true;
     } else if (keyword == "--nohighlight") {
         nohighlight = true;
+    } else if (keyword == "--profile") {
+      profile = true;
+      if (n != string::npos) ProfileName = value;
     } else if (keyword == "--outputlogfile") {
       if (n != string::npos) {
         LogOutputName.push_back(value);
@@ -622,6 +714,13 @@ bool options(int count, char **arg)
         gripe;
         exit(1);
       }
+    } else if (keyword == "--cachedir") {
+      if (n != string::npos) {
+        CacheDir = value;
+      } else {
+        gripe;
+        exit(1);
+      }
     } else if (keyword == "--aircraft") {
       if (n != string::npos) {
         AircraftName = value;
@@ -636,6 +735,13 @@ bool options(int count, char **arg)
         gripe;
         exit(1);
       }
+    } else if (keyword == "--montecarlo") {
+      if (n != string::npos) {
+        MonteCarloName = value;
+      } else {
+        gripe;
+        exit(1);
+      }
     } else if (keyword == "--initfile") {
       if (n != string::npos) {
         ResetName = value;
@@ -725,6 +831,10 @@ bool options(int count, char **arg)
     cerr << "You cannot specify an aircraft file with a script." << endl;
     result = false;
   }
+  if (!realtime_option.empty() && !realtime) {
+    cerr << "The option " << realtime_option << " requires --realtime." << endl << endl;
+    result = false;
+  }
 
   return result;
 
@@ -743,13 +853,27 @@ void PrintHelp(void)
     cout << "    --logdirectivefile=<filename>  specifies the name of a data logging directives file" << endl;
     cout << "                                   (can appear multiple times)" << endl;
     cout << "    --root=<path>  specifies the JSBSim root directory (where aircraft/, engine/, etc. reside)" << endl;
+    cout << "    --cachedir=<path>  specifies a directory where a binary form of the aircraft files is kept" << endl;
+    cout << "                       to speed up the next runs" << endl;
     cout << "    --aircraft=<filename>  specifies the name of the aircraft to be modeled" << endl;
     cout << "    --script=<filename>  specifies a script to run" << endl;
     cout << "    --realtime  specifies to run in actual real world time" << endl;
+    cout << "    --overrun=<drop|catchup|slip>  specifies what to do in real time when a frame overruns:" << endl;
+    cout << "                                   skip the missed frames, run them at once (the default)" << endl;
+    cout << "                                   or shift the following deadlines" << endl;
+    cout << "    --max-catchup=<frames>  specifies the maximum number of frames run at once to catch up (default 10)" << endl;
+    cout << "    --rt-priority=<1-99>  runs the simulation with the SCHED_FIFO real time priority (Linux only)" << endl;
+    cout << "    --cpu=<index>  binds the simulation to a CPU (Linux only)" << endl;
     cout << "    --nice  specifies to run at lower CPU usage" << endl;
+    cout << "    --atmosphere=<standard|msis>  specifies the model of the atmosphere: the US standard" << endl;
+    cout << "                                  atmosphere (the default) or NRLMSISE-00" << endl;
     cout << "    --nohighlight  specifies that console output should be pure text only (no color)" << endl;
     cout << "    --suspend  specifies to suspend the simulation after initialization" << endl;
+    cout << "    --profile  measures the time spent in each part of the frames and prints a report at exit" << endl;
+    cout << "               (profile=filename writes the report to a file)" << endl;
     cout << "    --initfile=<filename>  specifies an initilization file" << endl;
+    cout << "    --montecarlo=<filename>  runs the Monte Carlo campaign described in the file" << endl;
+    cout << "                             (the results are written to the output file name, if given)" << endl;
     cout << "    --catalog specifies that all properties for this aircraft model should be printed" << endl;
     cout << "              (catalog=aircraftname is an optional format)" << endl;
     cout << "    --property=<name=value> e.g. --property=simulation/integrator/rate/rotational=1" << endl;
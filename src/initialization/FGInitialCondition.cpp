@@ -53,6 +53,7 @@ INCLUDES
 #include "models/FGAircraft.h"
 #include "models/FGAccelerations.h"
 #include "input_output/FGXMLFileRead.h"
+#include "input_output/FGSnapshot.h"
 
 using namespace std;
 
@@ -70,6 +71,7 @@ FGInitialCondition::FGInitialCondition(FGFDMExec *FDMExec) : fdmex(FDMExec)
   if(FDMExec != NULL ) {
     Atmosphere=fdmex->GetAtmosphere();
     Aircraft=fdmex->GetAircraft();
+    Inertial=fdmex->GetInertial();
   } else {
     cout << "FGInitialCondition: This class requires a pointer to a valid FGFDMExec object" << endl;
   }
@@ -103,7 +105,7 @@ void FGInitialCondition::ResetIC(double u0, double v0, double w0,
 
   position.SetLongitude(lonRad0);
   position.SetLatitude(latRad0);
-  position.SetAltitudeAGL(altAGLFt0);
+  Inertial->SetAltitudeAGL(position, altAGLFt0);
 
   orientation = FGQuaternion(phi0, theta0, psi0);
   const FGMatrix33& Tb2l = orientation.GetTInv();
@@ -151,7 +153,7 @@ void FGInitialCondition::InitializeIC(void)
 
 void FGInitialCondition::SetVequivalentKtsIC(double ve)
 {
-  double altitudeASL = position.GetAltitudeASL();
+  double altitudeASL = Inertial->GetAltitudeASL(position);
   double rho = Atmosphere->GetDensity(altitudeASL);
   double rhoSL = Atmosphere->GetDensitySL();
   SetVtrueFpsIC(ve*ktstofps*sqrt(rhoSL/rho));
@@ -162,7 +164,7 @@ void FGInitialCondition::SetVequivalentKtsIC(double ve)
 
 void FGInitialCondition::SetMachIC(double mach)
 {
-  double altitudeASL = position.GetAltitudeASL();
+  double altitudeASL = Inertial->GetAltitudeASL(position);
   double soundSpeed = Atmosphere->GetSoundSpeed(altitudeASL);
   SetVtrueFpsIC(mach*soundSpeed);
   lastSpeedSet = setmach;
@@ -172,7 +174,7 @@ void FGInitialCondition::SetMachIC(double mach)
 
 void FGInitialCondition::SetVcalibratedKtsIC(double vcas)
 {
-  double altitudeASL = position.GetAltitudeASL();
+  double altitudeASL = Inertial->GetAltitudeASL(position);
   double pressure = Atmosphere->GetPressure(altitudeASL);
   double pressureSL = Atmosphere->GetPressureSL();
   double rhoSL = Atmosphere->GetDensitySL();
@@ -649,7 +651,7 @@ void FGInitialCondition::SetTerrainElevationFtIC(double elev)
 {
   double agl = GetAltitudeAGLFtIC();
 
-  fdmex->GetGroundCallback()->SetTerrainGeoCentRadius(elev + position.GetSeaLevelRadius());
+  fdmex->GetGroundCallback()->SetTerrainGeoCentRadius(elev + Inertial->GetSeaLevelRadius(position));
 
   if (lastAltitudeSet == setagl)
     SetAltitudeAGLFtIC(agl);
@@ -657,24 +659,31 @@ void FGInitialCondition::SetTerrainElevationFtIC(double elev)
 
 //******************************************************************************
 
+double FGInitialCondition::GetAltitudeASLFtIC(void) const
+{
+  return Inertial->GetAltitudeASL(position);
+}
+
+//******************************************************************************
+
 double FGInitialCondition::GetAltitudeAGLFtIC(void) const
 {
-  return position.GetAltitudeAGL();
+  return Inertial->GetAltitudeAGL(position);
 }
 
 //******************************************************************************
 
 double FGInitialCondition::GetTerrainElevationFtIC(void) const
 {
-  return position.GetTerrainRadius() - position.GetSeaLevelRadius();
+  return Inertial->GetTerrainRadius(position) - Inertial->GetSeaLevelRadius(position);
 }
 
 //******************************************************************************
 
 void FGInitialCondition::SetAltitudeAGLFtIC(double agl)
 {
-  double terrainElevation = position.GetTerrainRadius()
-    - position.GetSeaLevelRadius();
+  double terrainElevation = Inertial->GetTerrainRadius(position)
+    - Inertial->GetSeaLevelRadius(position);
   SetAltitudeASLFtIC(agl + terrainElevation);
   lastAltitudeSet = setagl;
 }
@@ -686,7 +695,7 @@ void FGInitialCondition::SetAltitudeAGLFtIC(double agl)
 
 void FGInitialCondition::SetAltitudeASLFtIC(double alt)
 {
-  double altitudeASL = position.GetAltitudeASL();
+  double altitudeASL = Inertial->GetAltitudeASL(position);
   double pressure = Atmosphere->GetPressure(altitudeASL);
   double pressureSL = Atmosphere->GetPressureSL();
   double soundSpeed = Atmosphere->GetSoundSpeed(altitudeASL);
@@ -698,7 +707,7 @@ void FGInitialCondition::SetAltitudeASLFtIC(double alt)
   double ve0 = vt * sqrt(rho/rhoSL);
 
   altitudeASL=alt;
-  position.SetAltitudeASL(alt);
+  Inertial->SetAltitudeASL(position, alt);
 
   soundSpeed = Atmosphere->GetSoundSpeed(altitudeASL);
   rho = Atmosphere->GetDensity(altitudeASL);
@@ -735,9 +744,9 @@ void FGInitialCondition::SetLatitudeRadIC(double lat)
     SetAltitudeAGLFtIC(altitude);
     break;
   default:
-    altitude = position.GetAltitudeASL();
+    altitude = Inertial->GetAltitudeASL(position);
     position.SetLatitude(lat);
-    position.SetAltitudeASL(altitude);
+    Inertial->SetAltitudeASL(position, altitude);
   }
 }
 
@@ -754,9 +763,9 @@ void FGInitialCondition::SetLongitudeRadIC(double lon)
     SetAltitudeAGLFtIC(altitude);
     break;
   default:
-    altitude = position.GetAltitudeASL();
+    altitude = Inertial->GetAltitudeASL(position);
     position.SetLongitude(lon);
-    position.SetAltitudeASL(altitude);
+    Inertial->SetAltitudeASL(position, altitude);
     break;
   }
 }
@@ -811,7 +820,7 @@ double FGInitialCondition::GetBodyWindFpsIC(int idx) const
 
 double FGInitialCondition::GetVcalibratedKtsIC(void) const
 {
-  double altitudeASL = position.GetAltitudeASL();
+  double altitudeASL = Inertial->GetAltitudeASL(position);
   double pressure = Atmosphere->GetPressure(altitudeASL);
   double pressureSL = Atmosphere->GetPressureSL();
   double rhoSL = Atmosphere->GetDensitySL();
@@ -826,7 +835,7 @@ double FGInitialCondition::GetVcalibratedKtsIC(void) const
 
 double FGInitialCondition::GetVequivalentKtsIC(void) const
 {
-  double altitudeASL = position.GetAltitudeASL();
+  double altitudeASL = Inertial->GetAltitudeASL(position);
   double rho = Atmosphere->GetDensity(altitudeASL);
   double rhoSL = Atmosphere->GetDensitySL();
   return fpstokts * vt * sqrt(rho/rhoSL);
@@ -836,7 +845,7 @@ double FGInitialCondition::GetVequivalentKtsIC(void) const
 
 double FGInitialCondition::GetMachIC(void) const
 {
-  double altitudeASL = position.GetAltitudeASL();
+  double altitudeASL = Inertial->GetAltitudeASL(position);
   double soundSpeed = Atmosphere->GetSoundSpeed(altitudeASL);
   return vt / soundSpeed;
 }
@@ -855,6 +864,7 @@ double FGInitialCondition::GetBodyVelFpsIC(int idx) const
 
 bool FGInitialCondition::Load(string rstfile, bool useStoredPath)
 {
+  Element::DispersionScope dispersions(fdmex->GetRandom("dispersions"));
   string init_file_name;
   if( useStoredPath ) {
     init_file_name = fdmex->GetFullAircraftPath() + "/" + rstfile + ".xml";
@@ -1056,15 +1066,15 @@ bool FGInitialCondition::Load_v2(Element* document)
         if (position_el->FindElement("radius")) {
           position.SetRadius(position_el->FindElementValueAsNumberConvertTo("radius", "FT"));
         } else if (position_el->FindElement("altitudeAGL")) {
-          position.SetAltitudeAGL(position_el->FindElementValueAsNumberConvertTo("altitudeAGL", "FT"));
+          Inertial->SetAltitudeAGL(position, position_el->FindElementValueAsNumberConvertTo("altitudeAGL", "FT"));
         } else if (position_el->FindElement("altitudeMSL")) {
-          position.SetAltitudeASL(position_el->FindElementValueAsNumberConvertTo("altitudeMSL", "FT"));
+          Inertial->SetAltitudeASL(position, position_el->FindElementValueAsNumberConvertTo("altitudeMSL", "FT"));
         } else {
           cerr << endl << "  No altitude or radius initial condition is given." << endl;
           result = false;
         }
 
-        double altitude = position.GetAltitudeASL();
+        double altitude = Inertial->GetAltitudeASL(position);
         double longitude = position.GetLongitude();
 
         if (latitude_el) {
@@ -1089,7 +1099,7 @@ bool FGInitialCondition::Load_v2(Element* document)
   }
 
   if (document->FindElement("elevation"))
-    fdmex->GetGroundCallback()->SetTerrainGeoCentRadius(document->FindElementValueAsNumberConvertTo("elevation", "FT")+position.GetSeaLevelRadius());
+    fdmex->GetGroundCallback()->SetTerrainGeoCentRadius(document->FindElementValueAsNumberConvertTo("elevation", "FT")+Inertial->GetSeaLevelRadius(position));
 
   // End of position initialization
 
@@ -1441,6 +1451,26 @@ void FGInitialCondition::bind(FGPropertyManager* PropertyManager)
                        true);
 }
 
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+void FGInitialCondition::ArchiveState(FGSnapshot& snapshot)
+{
+  snapshot.Archive(vUVW_NED);
+  snapshot.Archive(vPQR_body);
+  snapshot.Archive(position);
+  snapshot.Archive(orientation);
+  snapshot.Archive(vt);
+  snapshot.Archive(targetNlfIC);
+  snapshot.Archive(Tw2b);
+  snapshot.Archive(Tb2w);
+  snapshot.Archive(alpha);
+  snapshot.Archive(beta);
+  snapshot.Archive(lastSpeedSet);
+  snapshot.Archive(lastAltitudeSet);
+  snapshot.Archive(enginesRunning);
+  snapshot.Archive(needTrim);
+}
+
 //%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
 //    The bitmasked value choices are as follows:
 //    unset: In this case (the default) JSBSim would only print
@@ -67,8 +67,10 @@ class FGMatrix33;
 class FGColumnVector3;
 class FGAtmosphere;
 class FGAircraft;
+class FGInertial;
 class FGPropertyManager;
 class Element;
+class FGSnapshot;
 
 typedef enum { setvt, setvc, setve, setmach, setuvw, setned, setvg } speedset;
 typedef enum { setasl, setagl} altitudeset;
@@ -374,7 +376,7 @@ public:
 
   /** Gets the initial altitude above sea level.
       @return Initial altitude in feet. */
-  double GetAltitudeASLFtIC(void) const { return position.GetAltitudeASL(); }
+  double GetAltitudeASLFtIC(void) const;
 
   /** Gets the initial altitude above ground level.
       @return Initial altitude AGL in feet */
@@ -666,6 +668,10 @@ public:
 
   void bind(FGPropertyManager* pm);
 
+  /** Saves the initial conditions to a snapshot or restores them from it so
+      that a restored simulation is reset to the same initial conditions. */
+  void ArchiveState(FGSnapshot& snapshot);
+
 private:
   FGColumnVector3 vUVW_NED;
   FGColumnVector3 vPQR_body;
@@ -686,6 +692,7 @@ private:
   FGFDMExec *fdmex;
   FGAtmosphere* Atmosphere;
   FGAircraft* Aircraft;
+  FGInertial* Inertial;
 
   bool Load_v1(Element* document);
   bool Load_v2(Element* document);
@@ -29,45 +29,8 @@ FGLinearization::FGLinearization(FGFDMExec * fdm, int mode)
     std::cout << "\nlinearization: " << std::endl;
     std::clock_t time_start=clock(), time_linDone;
     FGStateSpace ss(fdm);
-
-    ss.x.add(new FGStateSpace::Vt);
-    ss.x.add(new FGStateSpace::Alpha);
-    ss.x.add(new FGStateSpace::Theta);
-    ss.x.add(new FGStateSpace::Q);
-
-    // get propulsion pointer to determine type/ etc.
-    FGEngine * engine0 = fdm->GetPropulsion()->GetEngine(0);
-    FGThruster * thruster0 = engine0->GetThruster();
-
-    if (thruster0->GetType()==FGThruster::ttPropeller)
-    {
-        ss.x.add(new FGStateSpace::Rpm0);
-        // TODO add variable prop pitch property
-        // if (variablePropPitch) ss.x.add(new FGStateSpace::PropPitch);
-        int numEngines = fdm->GetPropulsion()->GetNumEngines();
-        if (numEngines>1) ss.x.add(new FGStateSpace::Rpm1);
-        if (numEngines>2) ss.x.add(new FGStateSpace::Rpm2);
-        if (numEngines>3) ss.x.add(new FGStateSpace::Rpm3);
-        if (numEngines>4) {
-            std::cerr << "more than 4 engines not currently handled" << std::endl;
-        }
-    }
-    ss.x.add(new FGStateSpace::Beta);
-    ss.x.add(new FGStateSpace::Phi);
-    ss.x.add(new FGStateSpace::P);
-    ss.x.add(new FGStateSpace::Psi);
-    ss.x.add(new FGStateSpace::R);
-    ss.x.add(new FGStateSpace::Latitude);
-    ss.x.add(new FGStateSpace::Longitude);
-    ss.x.add(new FGStateSpace::Alt);
-
-    ss.u.add(new FGStateSpace::ThrottleCmd);
-    ss.u.add(new FGStateSpace::DaCmd);
-    ss.u.add(new FGStateSpace::DeCmd);
-    ss.u.add(new FGStateSpace::DrCmd);
-
-    // state feedback
-    ss.y = ss.x;
+    ss.setNumThreads(0);
+    setupStateSpace(fdm, ss);
 
     std::vector< std::vector<double> > A,B,C,D;
     std::vector<double> x0 = ss.x.get(), u0 = ss.u.get();
@@ -110,6 +73,49 @@ FGLinearization::FGLinearization(FGFDMExec * fdm, int mode)
 }
 
 
+void FGLinearization::setupStateSpace(FGFDMExec * fdm, FGStateSpace & ss)
+{
+
+    ss.x.add(new FGStateSpace::Vt);
+    ss.x.add(new FGStateSpace::Alpha);
+    ss.x.add(new FGStateSpace::Theta);
+    ss.x.add(new FGStateSpace::Q);
+
+    // get propulsion pointer to determine type/ etc.
+    FGEngine * engine0 = fdm->GetPropulsion()->GetEngine(0);
+    FGThruster * thruster0 = engine0->GetThruster();
+
+    if (thruster0->GetType()==FGThruster::ttPropeller)
+    {
+        ss.x.add(new FGStateSpace::Rpm0);
+        // TODO add variable prop pitch property
+        // if (variablePropPitch) ss.x.add(new FGStateSpace::PropPitch);
+        int numEngines = fdm->GetPropulsion()->GetNumEngines();
+        if (numEngines>1) ss.x.add(new FGStateSpace::Rpm1);
+        if (numEngines>2) ss.x.add(new FGStateSpace::Rpm2);
+        if (numEngines>3) ss.x.add(new FGStateSpace::Rpm3);
+        if (numEngines>4) {
+            std::cerr << "more than 4 engines not currently handled" << std::endl;
+        }
+    }
+    ss.x.add(new FGStateSpace::Beta);
+    ss.x.add(new FGStateSpace::Phi);
+    ss.x.add(new FGStateSpace::P);
+    ss.x.add(new FGStateSpace::Psi);
+    ss.x.add(new FGStateSpace::R);
+    ss.x.add(new FGStateSpace::Latitude);
+    ss.x.add(new FGStateSpace::Longitude);
+    ss.x.add(new FGStateSpace::Alt);
+
+    ss.u.add(new FGStateSpace::ThrottleCmd);
+    ss.u.add(new FGStateSpace::DaCmd);
+    ss.u.add(new FGStateSpace::DeCmd);
+    ss.u.add(new FGStateSpace::DrCmd);
+
+    // state feedback
+    ss.y = ss.x;
+}
+
 } // JSBSim
 
 // vim:ts=4:sw=4
@@ -38,6 +38,11 @@ class FGLinearization
 {
 public:
     FGLinearization(FGFDMExec * fdmPtr, int mode);
+
+    // adds the states and the inputs of the linearization of fdm to a state space
+    // whose outputs are the states (state feedback). The components belong
+    // to the caller and are shared by the states and the outputs.
+    static void setupStateSpace(FGFDMExec * fdm, FGStateSpace & ss);
 };
 
 } // JSBSim
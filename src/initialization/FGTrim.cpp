@@ -398,7 +398,9 @@ void FGTrim::trimOnGround(void)
 
     FGColumnVector3 normal, vDummy;
     FGLocation lDummy;
-    double height = gearLoc.GetContactPoint(lDummy, normal, vDummy, vDummy);
+    double height = fdmex->GetInertial()->GetContactPoint(gearLoc, lDummy,
+                                                          normal, vDummy,
+                                                          vDummy);
     c.normal = Tec2b * normal;
 
     contacts.push_back(c);
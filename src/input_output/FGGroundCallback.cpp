@@ -34,11 +34,19 @@ SENTRY
 #include "math/FGColumnVector3.h"
 #include "math/FGLocation.h"
 #include "FGGroundCallback.h"
+#include "FGSnapshot.h"
 
 namespace JSBSim {
 
 //%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
 
+void FGGroundCallback::ArchiveState(FGSnapshot& snapshot)
+{
+  snapshot.Archive(time);
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
 FGDefaultGroundCallback::FGDefaultGroundCallback(double referenceRadius)
 {
   mSeaLevelRadius = referenceRadius; // Sea level radius
@@ -70,4 +78,13 @@ double FGDefaultGroundCallback::GetAGLevel(double t, const FGLocation& loc,
 
 //%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
 
+void FGDefaultGroundCallback::ArchiveState(FGSnapshot& snapshot)
+{
+  FGGroundCallback::ArchiveState(snapshot);
+  snapshot.Archive(mSeaLevelRadius);
+  snapshot.Archive(mTerrainLevelRadius);
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
 } // namespace JSBSim
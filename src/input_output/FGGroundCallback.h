@@ -51,6 +51,7 @@ namespace JSBSim {
 
 class FGLocation;
 class FGColumnVector3;
+class FGSnapshot;
 
 /*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
 CLASS DOCUMENTATION
@@ -141,6 +142,12 @@ public:
 
   void SetTime(double _time) { time = _time; }
 
+  /** Saves the state of the callback to a snapshot or restores it from a
+      snapshot. Only needs to be implemented if the callback has a state that
+      changes during the simulation.
+      @param snapshot the snapshot */
+  virtual void ArchiveState(FGSnapshot& snapshot);
+
 private:
   double time;
 };
@@ -173,6 +180,8 @@ public:
    double GetSeaLevelRadius(const FGLocation& location) const
    {return mSeaLevelRadius; }
 
+   void ArchiveState(FGSnapshot& snapshot);
+
 private:
 
    double mSeaLevelRadius;
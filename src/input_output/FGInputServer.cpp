@@ -0,0 +1,692 @@
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+ Module:       FGInputServer.cpp
+ Date started: June 2016
+ Purpose:      Telnet server for several concurrent clients
+ Called by:    FGInput
+
+ ------------- Copyright (C) 2016  JSBSim development team  -------------
+
+ This program is free software; you can redistribute it and/or modify it under
+ the terms of the GNU Lesser General Public License as published by the Free Software
+ Foundation; either version 2 of the License, or (at your option) any later
+ version.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ details.
+
+ You should have received a copy of the GNU Lesser General Public License along with
+ this program; if not, write to the Free Software Foundation, Inc., 59 Temple
+ Place - Suite 330, Boston, MA  02111-1307, USA.
+
+ Further information about the GNU Lesser General Public License can also be found on
+ the world wide web at http://www.gnu.org.
+
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+INCLUDES
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+#include <cstring>
+#include <cstdlib>
+#include <sstream>
+#include <iomanip>
+
+#if !defined(_MSC_VER) && !defined(__MINGW32__)
+#  include <unistd.h>
+#  include <fcntl.h>
+#  include <errno.h>
+#  include <sys/socket.h>
+#  include <netinet/in.h>
+#  include <netinet/tcp.h>
+#  if defined(__linux__)
+#    include <sys/epoll.h>
+#  else
+#    include <poll.h>
+#  endif
+#endif
+
+#include "FGInputServer.h"
+#include "FGFDMExec.h"
+#include "models/FGAircraft.h"
+#include "input_output/FGXMLElement.h"
+#include "input_output/string_utilities.h"
+
+using namespace std;
+
+namespace JSBSim {
+
+IDENT(IdSrc,"$Id$");
+IDENT(IdHdr,ID_INPUTSERVER);
+
+// Maximum number of commands waiting to be executed and of replies waiting to
+// be sent.
+static const size_t QueueSize = 1024;
+// The input of a client is no longer read once the data waiting to be parsed
+// (a partial line or the lines waiting for room in the command queue) reaches
+// this size. A client which sends a line longer than this is disconnected.
+static const size_t MaxInputSize = 65536;
+// The commands of a client are no longer executed once the replies waiting to
+// be sent to it reach this size, until the client has read them.
+static const size_t MaxOutputSize = 65536;
+
+static const char Prompt[] = "JSBSim> ";
+
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+CLASS IMPLEMENTATION
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+FGInputServer::FGInputServer(FGFDMExec* fdmex) :
+  FGInputType(fdmex),
+  SockPort(0),
+  Listener(-1),
+  Poller(-1),
+  Stopping(false),
+  Commands(QueueSize),
+  Replies(QueueSize),
+  NextClientId(0)
+{
+  WakeUp[0] = WakeUp[1] = -1;
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+FGInputServer::~FGInputServer()
+{
+#if !defined(_MSC_VER) && !defined(__MINGW32__)
+  if (IOThread.joinable()) {
+    Stopping = true;
+    if (write(WakeUp[1], "", 1) < 0) perror("write");
+    IOThread.join();
+  }
+
+  if (Listener >= 0) close(Listener);
+  if (WakeUp[0] >= 0) close(WakeUp[0]);
+  if (WakeUp[1] >= 0) close(WakeUp[1]);
+  if (Poller >= 0) close(Poller);
+#endif
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+bool FGInputServer::Load(Element* el)
+{
+  if (!FGInputType::Load(el))
+    return false;
+
+  SockPort = atoi(el->GetAttributeValue("port").c_str());
+
+  if (SockPort == 0) {
+    cerr << endl << "No port assigned in input element" << endl;
+    return false;
+  }
+
+  return true;
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+bool FGInputServer::InitModel(void)
+{
+  if (!FGInputType::InitModel()) return false;
+
+  // The connections are kept when the simulation is reset.
+  if (IOThread.joinable()) return true;
+
+#if defined(_MSC_VER) || defined(__MINGW32__)
+  cerr << "The input server is not available on this platform." << endl;
+  return false;
+#else
+  if (!Listen()) return false;
+
+  IOThread = thread(&FGInputServer::IOLoop, this);
+  return true;
+#endif
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+// Executes the commands in the order they have been received. The execution
+// is interrupted if the queue of replies is full: the remaining commands are
+// executed at the next frame.
+
+void FGInputServer::Read(bool Holding)
+{
+  if (!IOThread.joinable()) return;
+
+  Command command;
+  Reply reply;
+  bool replied = false;
+
+  while (!Replies.full() && Commands.pop(command)) {
+    reply.Client = command.Client;
+    reply.Text.clear();
+    reply.Close = false;
+    if (Execute(command, Holding, reply)) {
+      Replies.push(reply);
+      replied = true;
+    }
+  }
+
+#if !defined(_MSC_VER) && !defined(__MINGW32__)
+  if (replied && write(WakeUp[1], "", 1) < 0 && errno != EAGAIN)
+    perror("write");
+#endif
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+FGPropertyNode* FGInputServer::GetNode(unsigned int client,
+                                       const string& path, string& error)
+{
+  NodeCache& cache = Nodes[client];
+  NodeCache::const_iterator it = cache.find(path);
+  if (it != cache.end()) return it->second;
+
+  FGPropertyNode* node = 0;
+  try {
+    node = PropertyManager->GetNode(path);
+  } catch(...) {
+    error = "Badly formed property query\n";
+    return 0;
+  }
+
+  // Unknown properties are not cached since they can be created later on.
+  if (node == 0) {
+    error = "Unknown property\n";
+    return 0;
+  }
+
+  cache[path] = node;
+  return node;
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+// Executes a command in the simulation thread.
+// Returns false if the command needs no reply.
+
+bool FGInputServer::Execute(const Command& command, bool Holding,
+                            Reply& reply)
+{
+  FGPropertyNode* node = 0;
+  string& text = reply.Text;
+
+  switch(command.Type) {
+  case cmdSet:
+    if (command.Argument.empty()) {
+      text = "No property argument supplied.\n";
+      break;
+    }
+    node = GetNode(command.Client, command.Argument, text);
+    if (!node) break;
+    if (!node->hasValue())
+      text = "Not a leaf property\n";
+    else
+      node->setDoubleValue(atof(command.Value.c_str()));
+    break;
+  case cmdGet:
+    if (command.Argument.empty()) {
+      text = "No property argument supplied.\n";
+      break;
+    }
+    node = GetNode(command.Client, command.Argument, text);
+    if (!node) break;
+    if (!node->hasValue()) {
+      if (Holding) // if holding can query property list
+        text = FDMExec->QueryPropertyCatalog(command.Argument);
+      else
+        text = "Must be in HOLD to search properties\n";
+    } else {
+      ostringstream buf;
+      buf << command.Argument << " = " << setw(12) << setprecision(6)
+          << node->getDoubleValue() << endl;
+      text = buf.str();
+    }
+    break;
+  case cmdHold:
+    FDMExec->Hold();
+    break;
+  case cmdResume:
+    FDMExec->Resume();
+    break;
+  case cmdIterate:
+    {
+      int iterations = 0;
+      istringstream(command.Argument) >> iterations;
+      if (command.Argument.empty())
+        text = "No argument supplied for number of iterations.\n";
+      else if (iterations <= 0)
+        text = "Required argument must be a positive Integer.\n";
+      else {
+        FDMExec->EnableIncrementThenHold(iterations);
+        FDMExec->Resume();
+      }
+    }
+    break;
+  case cmdInfo:
+    {
+      ostringstream info;
+      info << "JSBSim version: " << JSBSim_version << endl;
+      info << "Config File version: " << needed_cfg_version << endl;
+      info << "Aircraft simulated: " << FDMExec->GetAircraft()->GetAircraftName() << endl;
+      info << "Simulation time: " << setw(8) << setprecision(3) << FDMExec->GetSimTime() << endl;
+      text = info.str();
+    }
+    break;
+  case cmdHelp:
+    text = " JSBSim Server commands:\n\n"
+           "   get {property name}\n"
+           "   set {property name} {value}\n"
+           "   hold\n"
+           "   resume\n"
+           "   iterate {value}\n"
+           "   help\n"
+           "   quit\n"
+           "   info\n\n";
+    break;
+  case cmdQuit:
+    reply.Close = true;
+    break;
+  case cmdUnknown:
+    text = "Unknown command: " + command.Argument + "\n";
+    break;
+  case cmdDisconnect:
+    Nodes.erase(command.Client);
+    return false;
+  }
+
+  return true;
+}
+
+#if !defined(_MSC_VER) && !defined(__MINGW32__)
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+static bool SetNonBlocking(int fd)
+{
+  int flags = fcntl(fd, F_GETFL, 0);
+  return flags >= 0 && fcntl(fd, F_SETFL, flags | O_NONBLOCK) == 0;
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+bool FGInputServer::Listen(void)
+{
+  Listener = socket(AF_INET, SOCK_STREAM, 0);
+  if (Listener < 0) {
+    cerr << "Could not create socket for the input server, error = " << errno
+         << endl;
+    return false;
+  }
+
+  int on = 1;
+  setsockopt(Listener, SOL_SOCKET, SO_REUSEADDR, (char*)&on, sizeof(on));
+
+  struct sockaddr_in address;
+  memset(&address, 0, sizeof(address));
+  address.sin_family = AF_INET;
+  address.sin_port = htons(SockPort);
+  address.sin_addr.s_addr = htonl(INADDR_ANY);
+
+  if (bind(Listener, (struct sockaddr*)&address, sizeof(address)) < 0
+      || listen(Listener, 16) < 0 || !SetNonBlocking(Listener)) {
+    cerr << "Could not listen on port " << SockPort << ", error = " << errno
+         << endl;
+    return false;
+  }
+
+  if (pipe(WakeUp) < 0 || !SetNonBlocking(WakeUp[0])
+      || !SetNonBlocking(WakeUp[1])) {
+    cerr << "Could not create the pipe of the input server" << endl;
+    return false;
+  }
+
+#if defined(__linux__)
+  Poller = epoll_create(16);
+  if (Poller < 0) {
+    cerr << "Could not create the event queue of the input server" << endl;
+    return false;
+  }
+#endif
+
+  Watch(Listener, true, false);
+  Watch(WakeUp[0], true, false);
+
+  if (debug_lvl > 0)
+    cout << "Input server listening on port " << SockPort << endl;
+
+  return true;
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+// Registers a socket, or changes its events, in the set of sockets that are
+// waited for.
+
+void FGInputServer::Watch(int fd, bool input, bool output)
+{
+  int flags = (input ? 1 : 0) | (output ? 2 : 0);
+  map<int, int>::iterator it = Watched.find(fd);
+  if (it != Watched.end() && it->second == flags) return;
+
+#if defined(__linux__)
+  struct epoll_event event;
+  memset(&event, 0, sizeof(event));
+  event.events = (input ? (uint32_t)EPOLLIN : 0u)
+               | (output ? (uint32_t)EPOLLOUT : 0u);
+  event.data.fd = fd;
+  if (epoll_ctl(Poller, it == Watched.end() ? EPOLL_CTL_ADD : EPOLL_CTL_MOD,
+                fd, &event) < 0)
+    perror("epoll_ctl");
+#endif
+
+  Watched[fd] = flags;
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+// A client is waited for input as long as its pending input and output are
+// below the limits: the TCP flow control then holds the client back until the
+// commands already received have been queued and their replies have been read.
+// It is waited for output as long as some data could not be sent.
+
+void FGInputServer::Watch(const Client& client)
+{
+  Watch(client.Socket, client.Input.size() < MaxInputSize
+                       && client.Output.size() < MaxOutputSize,
+        !client.Output.empty());
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+void FGInputServer::Unwatch(int fd)
+{
+#if defined(__linux__)
+  struct epoll_event event;
+  epoll_ctl(Poller, EPOLL_CTL_DEL, fd, &event);
+#endif
+
+  Watched.erase(fd);
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+// Waits for the events of the watched sockets. Each event is returned as the
+// socket and a bit field: 1 if it can be read (or has been closed), 2 if it
+// can be written.
+
+void FGInputServer::Wait(int timeout, vector<pair<int, int> >& events)
+{
+  events.clear();
+
+#if defined(__linux__)
+  struct epoll_event ready[64];
+  int n = epoll_wait(Poller, ready, 64, timeout);
+
+  for (int i=0; i<n; i++) {
+    int flags = 0;
+    if (ready[i].events & (EPOLLIN | EPOLLERR | EPOLLHUP)) flags |= 1;
+    if (ready[i].events & EPOLLOUT) flags |= 2;
+    int fd = ready[i].data.fd;
+    events.push_back(make_pair(fd, flags));
+  }
+#else
+  vector<struct pollfd> fds;
+  for (map<int, int>::const_iterator it=Watched.begin(); it!=Watched.end(); ++it) {
+    struct pollfd p;
+    p.fd = it->first;
+    p.events = (it->second & 1 ? POLLIN : 0) | (it->second & 2 ? POLLOUT : 0);
+    p.revents = 0;
+    fds.push_back(p);
+  }
+
+  if (poll(&fds[0], fds.size(), timeout) <= 0) return;
+
+  for (unsigned int i=0; i<fds.size(); i++) {
+    int flags = 0;
+    if (fds[i].revents & (POLLIN | POLLERR | POLLHUP)) flags |= 1;
+    if (fds[i].revents & POLLOUT) flags |= 2;
+    if (flags) events.push_back(make_pair(fds[i].fd, flags));
+  }
+#endif
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+// Body of the I/O thread.
+
+void FGInputServer::IOLoop(void)
+{
+  vector<pair<int, int> > events;
+  Reply reply;
+
+  while (!Stopping) {
+    // The clients blocked by a full queue are retried periodically.
+    bool blocked = !Disconnected.empty();
+    for (map<unsigned int, Client>::iterator it=Clients.begin(); it!=Clients.end(); ++it)
+      blocked |= it->second.Blocked;
+
+    Wait(blocked ? 5 : 500, events);
+
+    for (unsigned int i=0; i<events.size(); i++) {
+      int fd = events[i].first;
+      if (fd == Listener)
+        Accept();
+      else if (fd == WakeUp[0]) {
+        char buf[64];
+        while (read(WakeUp[0], buf, sizeof(buf)) > 0);
+      } else {
+        map<int, unsigned int>::const_iterator it = ClientIds.find(fd);
+        if (it == ClientIds.end()) continue;
+        unsigned int id = it->second;
+        if (events[i].second & 2) Flush(id, Clients[id]);
+        if (events[i].second & 1 && Clients.count(id)) Receive(id);
+      }
+    }
+
+    while (Replies.pop(reply)) {
+      map<unsigned int, Client>::iterator it = Clients.find(reply.Client);
+      if (it == Clients.end()) continue;
+      Client& client = it->second;
+      client.Output += reply.Text;
+      client.Output += Prompt;
+      // The connection is closed once the reply to quit has been sent.
+      if (reply.Close) client.Closing = true;
+      Flush(reply.Client, client);
+    }
+
+    while (!Disconnected.empty() && Commands.push(Disconnected.front()))
+      Disconnected.pop_front();
+
+    for (map<unsigned int, Client>::iterator it=Clients.begin(); it!=Clients.end(); ++it) {
+      if (it->second.Blocked) ParseLines(it->first, it->second);
+    }
+  }
+
+  while (!Clients.empty()) Close(Clients.begin()->first);
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+void FGInputServer::Accept(void)
+{
+  int fd;
+
+  while ((fd = accept(Listener, 0, 0)) >= 0) {
+    if (!SetNonBlocking(fd)) {
+      close(fd);
+      continue;
+    }
+
+    int on = 1;
+    setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, (char*)&on, sizeof(on));
+
+    unsigned int id = NextClientId++;
+    Client& client = Clients[id];
+    client.Socket = fd;
+    client.Blocked = false;
+    client.Quitting = false;
+    client.Closing = false;
+    client.Output = string("Connected to JSBSim server\n") + Prompt;
+    ClientIds[fd] = id;
+
+    Watch(client);
+    Flush(id, client);
+  }
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+void FGInputServer::Receive(unsigned int id)
+{
+  Client& client = Clients[id];
+  char buf[4096];
+  ssize_t num_chars;
+
+  do {
+    num_chars = recv(client.Socket, buf, sizeof(buf), 0);
+    if (num_chars > 0) client.Input.append(buf, num_chars);
+  } while (num_chars > 0 && client.Input.size() < MaxInputSize);
+
+  if (num_chars == 0
+      || (num_chars < 0 && errno != EAGAIN && errno != EWOULDBLOCK)) {
+    Close(id);
+    return;
+  }
+
+  if (client.Input.size() >= MaxInputSize
+      && client.Input.find_first_of("\r\n") == string::npos) {
+    cerr << "Input server: the request is too long, closing the connection."
+         << endl;
+    Close(id);
+    return;
+  }
+
+  // The lines of a client which is already blocked must wait for the
+  // previous ones.
+  if (!client.Blocked)
+    ParseLines(id, client);
+  else
+    Watch(client);
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+// Splits the complete lines received from a client into commands. The lines
+// which cannot be queued are kept and parsed again later on.
+
+void FGInputServer::ParseLines(unsigned int id, Client& client)
+{
+  const char* blanks = " \t";
+  size_t start = 0, end;
+  Command command;
+  command.Client = id;
+
+  client.Blocked = false;
+
+  // The commands of a client which does not read its replies are held back.
+  if (client.Output.size() >= MaxOutputSize) {
+    Watch(client);
+    return;
+  }
+
+  while (!client.Quitting
+         && (end = client.Input.find_first_of("\r\n", start)) != string::npos) {
+    string line = client.Input.substr(start, end-start);
+    string token[3];
+    size_t pos = 0;
+
+    for (unsigned int i=0; i<3; i++) {
+      size_t first = line.find_first_not_of(blanks, pos);
+      if (first == string::npos) break;
+      pos = line.find_first_of(blanks, first);
+      token[i] = line.substr(first, pos == string::npos ? pos : pos-first);
+      if (pos == string::npos) break;
+    }
+
+    if (token[0].empty()) {
+      start = end+1;
+      continue;
+    }
+
+    string name = to_lower(token[0]);
+    command.Argument = token[1];
+    command.Value = token[2];
+
+    if (name == "set") command.Type = cmdSet;
+    else if (name == "get") command.Type = cmdGet;
+    else if (name == "hold") command.Type = cmdHold;
+    else if (name == "resume") command.Type = cmdResume;
+    else if (name == "iterate") command.Type = cmdIterate;
+    else if (name == "info") command.Type = cmdInfo;
+    else if (name == "help") command.Type = cmdHelp;
+    else if (name == "quit") command.Type = cmdQuit;
+    else {
+      command.Type = cmdUnknown;
+      command.Argument = token[0];
+    }
+
+    if (!Commands.push(command)) {
+      client.Blocked = true;
+      break;
+    }
+
+    // The lines after quit are ignored.
+    if (command.Type == cmdQuit) client.Quitting = true;
+
+    start = end+1;
+  }
+
+  client.Input.erase(0, client.Quitting ? string::npos : start);
+  Watch(client);
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+// Sends the pending output of a client. The socket is watched for output as
+// long as some data could not be sent. The commands held back while the output
+// was over the limit are parsed once it has been sent.
+
+void FGInputServer::Flush(unsigned int id, Client& client)
+{
+  int flags = 0;
+#ifdef MSG_NOSIGNAL
+  flags = MSG_NOSIGNAL;
+#endif
+
+  size_t sent = 0;
+  while (sent < client.Output.size()) {
+    ssize_t n = send(client.Socket, client.Output.data() + sent,
+                     client.Output.size() - sent, flags);
+    if (n <= 0) break;
+    sent += n;
+  }
+
+  client.Output.erase(0, sent);
+
+  // The reply to quit is the last one that the client gets.
+  if (client.Output.empty() && client.Closing)
+    Close(id);
+  else if (!client.Blocked && !client.Input.empty()
+           && client.Output.size() < MaxOutputSize)
+    ParseLines(id, client);
+  else
+    Watch(client);
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+// Closes a connection. The simulation thread is notified so that it can drop
+// the nodes cached for the client.
+
+void FGInputServer::Close(unsigned int id)
+{
+  map<unsigned int, Client>::iterator it = Clients.find(id);
+  if (it == Clients.end()) return;
+
+  Unwatch(it->second.Socket);
+  close(it->second.Socket);
+  ClientIds.erase(it->second.Socket);
+  Clients.erase(it);
+
+  Command command;
+  command.Client = id;
+  command.Type = cmdDisconnect;
+  Disconnected.push_back(command);
+}
+
+#endif
+}
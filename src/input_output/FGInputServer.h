@@ -0,0 +1,185 @@
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+ Header:       FGInputServer.h
+ Date started: June 2016
+
+ ------------- Copyright (C) 2016  JSBSim development team  -------------
+
+ This program is free software; you can redistribute it and/or modify it under
+ the terms of the GNU Lesser General Public License as published by the Free Software
+ Foundation; either version 2 of the License, or (at your option) any later
+ version.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ details.
+
+ You should have received a copy of the GNU Lesser General Public License along with
+ this program; if not, write to the Free Software Foundation, Inc., 59 Temple
+ Place - Suite 330, Boston, MA  02111-1307, USA.
+
+ Further information about the GNU Lesser General Public License can also be found on
+ the world wide web at http://www.gnu.org.
+
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+SENTRY
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+#ifndef FGINPUTSERVER_H
+#define FGINPUTSERVER_H
+
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+INCLUDES
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+#include <atomic>
+#include <deque>
+#include <map>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "FGInputType.h"
+#include "FGLockFreeQueue.h"
+#include "input_output/FGPropertyManager.h"
+
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+DEFINITIONS
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+#define ID_INPUTSERVER "$Id$"
+
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+FORWARD DECLARATIONS
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+namespace JSBSim {
+
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+CLASS DOCUMENTATION
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+/** Implements a telnet server that accepts several clients at the same time.
+    The server understands the same commands as FGInputSocket (get, set, hold,
+    resume, iterate, info, help and quit):
+    @code
+    <input type="SERVER" port="1137"/>
+    @endcode
+
+    The sockets are managed by a dedicated thread which waits for the network
+    events (with epoll on Linux, poll elsewhere), accepts the clients and
+    splits their requests in commands. The commands are transferred to the
+    simulation thread through a lock free queue and are executed at the
+    beginning of the next frame, in the order in which they have been
+    received. The replies travel back to the I/O thread through a second
+    queue. The simulation thread therefore never waits for the network and
+    the duration of a frame does not depend on the traffic.
+
+    The property nodes are looked up once per client: the nodes are cached so
+    that a client which repeatedly sets or gets the same properties does not
+    search the property tree again.
+
+    When the queue of commands is full, the I/O thread stops reading the
+    clients until the simulation thread has executed some of the commands.
+    It also stops reading and executing the commands of a client which lets
+    its replies pile up, until the client has read them.
+
+    This input is not available on Windows.
+ */
+
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+CLASS DECLARATION
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+class FGInputServer : public FGInputType
+{
+public:
+  /** Constructor. */
+  FGInputServer(FGFDMExec* fdmex);
+
+  /** Destructor: stops the I/O thread and closes the connections. */
+  ~FGInputServer();
+
+  /** Init the input directives from an XML file.
+      @param element XML Element that is pointing to the input directives
+  */
+  bool Load(Element* el);
+
+  /** Initializes the instance. This method opens the listening socket and
+      starts the I/O thread.
+      @result true if the execution succeeded.
+   */
+  bool InitModel(void);
+
+  /// Executes the commands received since the previous frame.
+  void Read(bool Holding);
+
+private:
+  enum CommandType {cmdSet, cmdGet, cmdHold, cmdResume, cmdIterate, cmdInfo,
+                    cmdHelp, cmdQuit, cmdUnknown, cmdDisconnect};
+
+  struct Command {
+    unsigned int Client;
+    CommandType Type;
+    std::string Argument;
+    std::string Value;
+  };
+
+  struct Reply {
+    unsigned int Client;
+    std::string Text;
+    bool Close;
+  };
+
+  // State of a connection. Only accessed by the I/O thread.
+  struct Client {
+    int Socket;
+    std::string Input;
+    std::string Output;
+    bool Blocked;
+    bool Quitting;
+    bool Closing;
+  };
+
+  typedef std::map<std::string, FGPropertyNode_ptr> NodeCache;
+
+  unsigned int SockPort;
+  int Listener;
+  int WakeUp[2];
+  int Poller;
+  std::thread IOThread;
+  std::atomic<bool> Stopping;
+
+  FGLockFreeQueue<Command> Commands;
+  FGLockFreeQueue<Reply> Replies;
+
+  // Only accessed by the simulation thread.
+  std::map<unsigned int, NodeCache> Nodes;
+
+  // Only accessed by the I/O thread.
+  std::map<unsigned int, Client> Clients;
+  std::map<int, unsigned int> ClientIds;
+  std::deque<Command> Disconnected;
+  std::map<int, int> Watched; // 1: input, 2: output
+  unsigned int NextClientId;
+
+  bool Listen(void);
+  void IOLoop(void);
+  void Accept(void);
+  void Receive(unsigned int id);
+  void ParseLines(unsigned int id, Client& client);
+  void Flush(unsigned int id, Client& client);
+  void Close(unsigned int id);
+  void Watch(int fd, bool input, bool output);
+  void Watch(const Client& client);
+  void Unwatch(int fd);
+  void Wait(int timeout, std::vector<std::pair<int, int> >& events);
+
+  bool Execute(const Command& command, bool Holding, Reply& reply);
+  FGPropertyNode* GetNode(unsigned int client, const std::string& path,
+                          std::string& error);
+};
+}
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+#endif
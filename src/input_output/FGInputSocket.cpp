@@ -108,12 +108,29 @@ bool FGInputSocket::InitModel(void)
 
 //%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
 
+// Returns the handle of a property. The handles of the leaf properties are
+// cached so that the path of a property is only parsed the first time it is
+// set or read. Unknown properties are not cached since they can be created
+// later on.
+
+FGPropertyHandle FGInputSocket::GetHandle(const string& path)
+{
+  map<string, FGPropertyHandle>::const_iterator it = Handles.find(path);
+  if (it != Handles.end()) return it->second;
+
+  FGPropertyHandle handle(PropertyManager->GetNode(path));
+  if (handle.IsValid() && handle.GetNode()->hasValue()) Handles[path] = handle;
+  return handle;
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
 void FGInputSocket::Read(bool Holding)
 {
   string line, token;
   size_t start=0, string_start=0, string_end=0;
   double value=0;
-  FGPropertyNode* node=0;
+  FGPropertyHandle handle;
 
   if (socket == 0) return;
   if (!socket->GetConnectStatus()) return;
@@ -151,21 +168,21 @@ void FGInputSocket::Read(bool Holding)
           break;
         }
         try {
-          node = PropertyManager->GetNode(argument);
+          handle = GetHandle(argument);
         } catch(...) {
           socket->Reply("Badly formed property query\n");
           break;
         }
 
-        if (node == 0) {
+        if (!handle.IsValid()) {
           socket->Reply("Unknown property\n");
           break;
-        } else if (!node->hasValue()) {
+        } else if (!handle.GetNode()->hasValue()) {
           socket->Reply("Not a leaf property\n");
           break;
         } else {
           value = atof(str_value.c_str());
-          node->setDoubleValue(value);
+          handle.SetValue(value);
         }
         socket->Reply("");
 
@@ -176,25 +193,25 @@ void FGInputSocket::Read(bool Holding)
           break;
         }
         try {
-          node = PropertyManager->GetNode(argument);
+          handle = GetHandle(argument);
         } catch(...) {
           socket->Reply("Badly formed property query\n");
           break;
         }
 
-        if (node == 0) {
+        if (!handle.IsValid()) {
           socket->Reply("Unknown property\n");
           break;
-        } else if (!node->hasValue()) {
+        } else if (!handle.GetNode()->hasValue()) {
           if (Holding) { // if holding can query property list
             string query = FDMExec->QueryPropertyCatalog(argument);
             socket->Reply(query);
           } else {
             socket->Reply("Must be in HOLD to search properties\n");
           }
-        } else if (node > 0) {
+        } else {
           ostringstream buf;
-          buf << argument << " = " << setw(12) << setprecision(6) << node->getDoubleValue() << endl;
+          buf << argument << " = " << setw(12) << setprecision(6) << handle.GetValue() << endl;
           socket->Reply(buf.str());
         }
 
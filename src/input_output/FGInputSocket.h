@@ -38,8 +38,11 @@ SENTRY
 INCLUDES
 %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
 
+#include <map>
+
 #include "FGInputType.h"
 #include "input_output/FGfdmSocket.h"
+#include "input_output/FGPropertyManager.h"
 
 /*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
 DEFINITIONS
@@ -93,6 +96,9 @@ protected:
   unsigned int SockPort;
   FGfdmSocket* socket;
   std::string data;
+  std::map<std::string, FGPropertyHandle> Handles;
+
+  FGPropertyHandle GetHandle(const std::string& path);
 };
 }
 //%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
@@ -138,6 +138,9 @@ protected:
   unsigned int InputIdx;
   bool enabled;
 
+  /** The inputs are polled at every frame: the rate attribute of an <input>
+      element does not throttle them. */
+  bool LoadSchedule(Element*) { return true; }
   void Debug(int from);
 };
 }
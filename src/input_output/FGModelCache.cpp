@@ -0,0 +1,394 @@
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+ Module:       FGModelCache.cpp
+ Date started: April 2016
+ Purpose:      Share the files of a model between FDM instances
+
+ ------------- Copyright (C) 2016  JSBSim development team  -------------
+
+ This program is free software; you can redistribute it and/or modify it under
+ the terms of the GNU Lesser General Public License as published by the Free Software
+ Foundation; either version 2 of the License, or (at your option) any later
+ version.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ details.
+
+ You should have received a copy of the GNU Lesser General Public License along with
+ this program; if not, write to the Free Software Foundation, Inc., 59 Temple
+ Place - Suite 330, Boston, MA  02111-1307, USA.
+
+ Further information about the GNU Lesser General Public License can also be found on
+ the world wide web at http://www.gnu.org.
+
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+INCLUDES
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+#include <sys/stat.h>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <ctime>
+#include <fstream>
+#include <sstream>
+#include <thread>
+
+#include "FGJSBBase.h"
+#include "FGModelCache.h"
+#include "FGXMLFileRead.h"
+
+using namespace std;
+
+namespace JSBSim {
+
+IDENT(IdSrc, "$Id$");
+IDENT(IdHdr, ID_MODELCACHE);
+
+thread_local FGModelCache* FGModelCache::Current = 0;
+
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+CLASS IMPLEMENTATION
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+Element* FGModelCache::LoadXMLDocument(const string& filename)
+{
+  lock_guard<recursive_mutex> lock(Mutex);
+  map<string, Element_ptr>::iterator it = Documents.find(filename);
+
+  if (it != Documents.end())
+    return it->second;
+
+  Element_ptr document;
+
+  if (!CacheDir.empty()) document = ReadBinaryDocument(filename);
+
+  if (!document) {
+    FGXMLFileRead XMLFileRead;
+    document = XMLFileRead.LoadXMLDocument(filename);
+    if (document && !CacheDir.empty()) WriteBinaryDocument(filename, document);
+  }
+
+  if (document) Documents[filename] = document;
+
+  return document;
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+FGModelCache::CachedData* FGModelCache::GetData(const Element* el)
+{
+  lock_guard<recursive_mutex> lock(Mutex);
+  map<const Element*, SGSharedPtr<CachedData> >::iterator it = Data.find(el);
+
+  if (it != Data.end())
+    return it->second;
+
+  return 0;
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+void FGModelCache::SetData(const Element* el, CachedData* data)
+{
+  lock_guard<recursive_mutex> lock(Mutex);
+  Data[el] = data;
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+// Binary form of the documents
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+static const char BinaryMagic[8] = {'J', 'S', 'B', 'X', 'M', 'L', 'B', 'F'};
+static const uint32_t BinaryVersion = 1;
+static const uint32_t ByteOrderMark = 0x01020304;
+
+// The header of the binary files. The fields are naturally aligned so that the
+// layout does not depend on the compiler.
+struct BinaryHeader {
+  char Magic[8];
+  uint32_t Version;
+  uint32_t ByteOrder;
+  uint64_t SourceSize;     // Size of the XML file
+  int64_t SourceTime;      // Modification time of the XML file
+  int64_t WriteTime;       // Time at which the binary file has been written
+  uint64_t SourceHash;     // Hash of the contents of the XML file
+};
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+// 64 bits FNV-1a hash.
+
+static uint64_t Hash(const char* data, size_t size,
+                     uint64_t hash=0xcbf29ce484222325ULL)
+{
+  for (size_t i=0; i<size; i++) {
+    hash ^= (unsigned char)data[i];
+    hash *= 0x100000001b3ULL;
+  }
+  return hash;
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+static bool ReadFile(const string& filename, string& contents)
+{
+  ifstream file(filename.c_str(), ios::in | ios::binary);
+  if (!file.is_open()) return false;
+
+  ostringstream buffer;
+  buffer << file.rdbuf();
+  contents = buffer.str();
+  return true;
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+static string XMLFileName(const string& filename)
+{
+  // Same convention than FGXMLFileRead
+  if (filename.find(".xml") == string::npos) return filename + ".xml";
+  return filename;
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+// Writes the elements to a buffer. The strings are replaced by their index in
+// the string table.
+
+class BinaryWriter {
+public:
+  void Write(uint32_t value) { Elements.append((const char*)&value, sizeof(value)); }
+  void Write(const string& str) {
+    map<string, uint32_t>::iterator it = Index.find(str);
+    if (it == Index.end()) {
+      it = Index.insert(make_pair(str, (uint32_t)Strings.size())).first;
+      Strings.push_back(&it->first);
+    }
+    Write(it->second);
+  }
+
+  void Write(Element* el) {
+    Write(el->GetName());
+    Write(el->GetFileName());
+    Write((uint32_t)el->GetLineNumber());
+
+    const map<string, string>& attributes = el->GetAttributes();
+    Write((uint32_t)attributes.size());
+    for (map<string, string>::const_iterator it = attributes.begin();
+         it != attributes.end(); ++it) {
+      Write(it->first);
+      Write(it->second);
+    }
+
+    unsigned int n = el->GetNumDataLines();
+    Write((uint32_t)n);
+    for (unsigned int i=0; i<n; i++) Write(el->GetDataLine(i));
+
+    n = el->GetNumElements();
+    Write((uint32_t)n);
+    for (unsigned int i=0; i<n; i++) Write(el->GetElement(i));
+  }
+
+  // The string table followed by the elements.
+  string Contents(void) const {
+    string contents;
+    uint32_t n = (uint32_t)Strings.size();
+    contents.append((const char*)&n, sizeof(n));
+    for (uint32_t i=0; i<n; i++) {
+      uint32_t length = (uint32_t)Strings[i]->size();
+      contents.append((const char*)&length, sizeof(length));
+      contents.append(*Strings[i]);
+    }
+    return contents + Elements;
+  }
+
+private:
+  map<string, uint32_t> Index;
+  vector<const string*> Strings;
+  string Elements;
+};
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+// Rebuilds the elements from a buffer. Any inconsistency (truncated or corrupt
+// file) makes the reader fail so that the XML file is read instead.
+
+class BinaryReader {
+public:
+  BinaryReader(const char* data, size_t size)
+    : Cursor(data), End(data+size), Failed(false) {}
+
+  bool Read(uint32_t& value) {
+    if (Failed || End - Cursor < (ptrdiff_t)sizeof(value)) return Fail();
+    memcpy(&value, Cursor, sizeof(value));
+    Cursor += sizeof(value);
+    return true;
+  }
+
+  bool ReadStrings(void) {
+    uint32_t n, length;
+    if (!Read(n) || n > (uint32_t)(End - Cursor)) return Fail();
+    Strings.resize(n);
+    for (uint32_t i=0; i<n; i++) {
+      if (!Read(length) || length > (uint32_t)(End - Cursor)) return Fail();
+      Strings[i].assign(Cursor, length);
+      Cursor += length;
+    }
+    return true;
+  }
+
+  const string& ReadString(void) {
+    static const string empty;
+    uint32_t index;
+    if (!Read(index)) return empty;
+    if (index >= Strings.size()) { Fail(); return empty; }
+    return Strings[index];
+  }
+
+  Element* ReadElement(Element* parent) {
+    Element* el = new Element(ReadString());
+    el->SetParent(parent);
+    if (parent) parent->AddChildElement(el);
+    el->SetFileName(ReadString());
+
+    uint32_t n;
+    if (Read(n)) el->SetLineNumber((int)n);
+
+    if (Read(n)) {
+      for (uint32_t i=0; i<n && !Failed; i++) {
+        const string& key = ReadString();
+        el->AddAttribute(key, ReadString());
+      }
+    }
+
+    if (Read(n)) {
+      for (uint32_t i=0; i<n && !Failed; i++)
+        el->AddData(ReadString());
+    }
+
+    if (Read(n)) {
+      for (uint32_t i=0; i<n && !Failed; i++)
+        ReadElement(el);
+    }
+
+    return el;
+  }
+
+  bool Succeeded(void) const { return !Failed && Cursor == End; }
+
+private:
+  const char* Cursor;
+  const char* End;
+  bool Failed;
+  vector<string> Strings;
+
+  bool Fail(void) { Failed = true; return false; }
+};
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+string FGModelCache::GetBinaryFileName(const string& filename) const
+{
+  // The binary files of all the models are stored in the same directory so
+  // their name is built from the full path of the XML file.
+  string xmlname = XMLFileName(filename);
+  ostringstream name;
+
+  name << CacheDir;
+  if (CacheDir[CacheDir.size()-1] != '/') name << '/';
+  name << xmlname.substr(xmlname.find_last_of("/\\")+1) << '.' << hex
+       << Hash(xmlname.c_str(), xmlname.size()) << ".bin";
+
+  return name.str();
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+Element_ptr FGModelCache::ReadBinaryDocument(const string& filename)
+{
+  string xmlname = XMLFileName(filename);
+  struct stat source;
+  string contents;
+
+  if (stat(xmlname.c_str(), &source) != 0
+      || !ReadFile(GetBinaryFileName(filename), contents)
+      || contents.size() < sizeof(BinaryHeader))
+    return 0;
+
+  BinaryHeader header;
+  memcpy(&header, contents.data(), sizeof(header));
+
+  if (memcmp(header.Magic, BinaryMagic, sizeof(BinaryMagic)) != 0
+      || header.Version != BinaryVersion || header.ByteOrder != ByteOrderMark
+      || header.SourceSize != (uint64_t)source.st_size)
+    return 0;
+
+  // The modification time is only trusted if the XML file has not been
+  // modified during the second in which the binary file has been written.
+  // Otherwise the contents of the XML file are checked.
+  if (header.SourceTime != (int64_t)source.st_mtime
+      || header.SourceTime >= header.WriteTime) {
+    string xml;
+    if (!ReadFile(xmlname, xml) || Hash(xml.data(), xml.size()) != header.SourceHash)
+      return 0;
+  }
+
+  BinaryReader reader(contents.data() + sizeof(header),
+                      contents.size() - sizeof(header));
+  if (!reader.ReadStrings()) return 0;
+
+  // The elements that have been read are released if the reader fails.
+  Element_ptr document = reader.ReadElement(0);
+  if (!reader.Succeeded()) return 0;
+
+  return document;
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+void FGModelCache::WriteBinaryDocument(const string& filename, Element* document)
+{
+  string xmlname = XMLFileName(filename);
+  struct stat source;
+  string xml;
+
+  if (stat(xmlname.c_str(), &source) != 0 || !ReadFile(xmlname, xml))
+    return;
+
+  BinaryHeader header;
+  memset(&header, 0, sizeof(header));
+  memcpy(header.Magic, BinaryMagic, sizeof(BinaryMagic));
+  header.Version = BinaryVersion;
+  header.ByteOrder = ByteOrderMark;
+  header.SourceSize = (uint64_t)source.st_size;
+  header.SourceTime = (int64_t)source.st_mtime;
+  header.WriteTime = (int64_t)time(0);
+  header.SourceHash = Hash(xml.data(), xml.size());
+
+  BinaryWriter writer;
+  writer.Write(document);
+
+  // The file is written under a temporary name then renamed so that the
+  // processes that run concurrently never read a partially written file.
+  string binname = GetBinaryFileName(filename);
+  ostringstream tmpname;
+  tmpname << binname << '.' << hex << hash<thread::id>()(this_thread::get_id())
+          << '.' << (size_t)this;
+
+  ofstream file(tmpname.str().c_str(), ios::out | ios::binary | ios::trunc);
+  if (!file.is_open()) {
+    cerr << "Could not write the cache file " << binname << endl;
+    return;
+  }
+
+  string contents = writer.Contents();
+  file.write((const char*)&header, sizeof(header));
+  file.write(contents.data(), contents.size());
+  file.close();
+
+  if (file.fail() || rename(tmpname.str().c_str(), binname.c_str()) != 0) {
+    cerr << "Could not write the cache file " << binname << endl;
+    remove(tmpname.str().c_str());
+  }
+}
+}
@@ -0,0 +1,163 @@
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+ Header:       FGModelCache.h
+ Date started: April 2016
+
+ ------------- Copyright (C) 2016  JSBSim development team  -------------
+
+ This program is free software; you can redistribute it and/or modify it under
+ the terms of the GNU Lesser General Public License as published by the Free Software
+ Foundation; either version 2 of the License, or (at your option) any later
+ version.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ details.
+
+ You should have received a copy of the GNU Lesser General Public License along with
+ this program; if not, write to the Free Software Foundation, Inc., 59 Temple
+ Place - Suite 330, Boston, MA  02111-1307, USA.
+
+ Further information about the GNU Lesser General Public License can also be found on
+ the world wide web at http://www.gnu.org.
+
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+SENTRY
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+#ifndef FGMODELCACHE_H
+#define FGMODELCACHE_H
+
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+INCLUDES
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+#include <map>
+#include <mutex>
+#include <string>
+
+#include "FGXMLElement.h"
+
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+DEFINITIONS
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+#define ID_MODELCACHE "$Id$"
+
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+FORWARD DECLARATIONS
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+namespace JSBSim {
+
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+CLASS DOCUMENTATION
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+/** Holds the files of a model once they have been read.
+    The cache keeps the XML documents of the aircraft file and of the files it
+    includes (engines, thrusters, systems, etc.) as well as the data that the
+    classes have extracted from the elements of these documents, such as the
+    breakpoints and the values of the tables.
+
+    The cache is shared by the FDM instances that load the same model: the
+    files are then parsed only once and the large read-only data of the model
+    is allocated only once. Only the state of each instance is allocated
+    when the model is loaded.
+
+    When a cache directory is given, the documents are also stored on disk in
+    a binary form which is read instead of the XML file when a model is loaded
+    again, possibly by another process. Reading the binary form is much
+    faster than parsing the XML file. Each binary file records the size, the
+    modification time and a hash of the contents of the XML file from which
+    it has been built: it is used only if the size and the modification time
+    match or, failing that, if the contents of the XML file hash to the same
+    value. Otherwise the XML file is parsed and the binary file is rebuilt.
+
+    The binary file is a flat block that contains no pointer: a table of
+    the strings of the document (element names, attributes, data lines, file
+    names) followed by the elements in the order of the document. Each element
+    refers to its strings by their index in the table.
+
+    The classes reading the documents may modify them (the elements of an
+    included file are appended to the element that includes it) so the
+    instances sharing a cache load their model one at a time. A Scope locks
+    the cache and makes it the current cache of the calling thread while a
+    model is loaded.
+*/
+
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+CLASS DECLARATION
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+class FGModelCache : public SGReferenced
+{
+public:
+  /** Constructor
+      @param filename the name of the aircraft file of the model.
+      @param cachedir the directory where the binary form of the documents is
+                      stored. If empty, the documents are not stored on disk.
+   */
+  FGModelCache(const std::string& filename="", const std::string& cachedir="")
+    : FileName(filename), CacheDir(cachedir) {}
+
+  /// Returns the name of the aircraft file of the model.
+  const std::string& GetFileName(void) const { return FileName; }
+
+  /// Base class of the data extracted from the elements.
+  class CachedData : public SGReferenced {
+  public:
+    virtual ~CachedData() {}
+  };
+
+  /** Reads an XML document. The file is read only once: the following calls
+      return the document that has been read the first time. If a valid binary
+      form of the file is found in the cache directory, it is read in place of
+      the XML file.
+      @param filename the full path name of the file
+      @return the document or 0 if the file could not be read. */
+  Element* LoadXMLDocument(const std::string& filename);
+
+  /** Returns the data extracted from an element of a document.
+      @param el the element
+      @return the data or 0 if no data has been stored for this element. */
+  CachedData* GetData(const Element* el);
+
+  /** Stores the data extracted from an element of a document so that the
+      instances that load the same element can reuse it. The data must not be
+      modified once it is stored.
+      @param el the element
+      @param data the data extracted from the element */
+  void SetData(const Element* el, CachedData* data);
+
+  /// Returns the current cache of the calling thread, or 0 if there is none.
+  static FGModelCache* GetCurrent(void) { return Current; }
+
+  /** Locks a cache and makes it the current cache of the calling thread for
+      the lifetime of the scope. */
+  class Scope {
+  public:
+    Scope(FGModelCache* cache)
+      : lock(cache->Mutex), previous(Current) { Current = cache; }
+    ~Scope() { Current = previous; }
+  private:
+    std::lock_guard<std::recursive_mutex> lock;
+    FGModelCache* previous;
+  };
+
+private:
+  std::string FileName;
+  std::string CacheDir;
+  std::map<std::string, Element_ptr> Documents;
+  std::map<const Element*, SGSharedPtr<CachedData> > Data;
+  std::recursive_mutex Mutex;
+  static thread_local FGModelCache* Current;
+
+  std::string GetBinaryFileName(const std::string& filename) const;
+  Element_ptr ReadBinaryDocument(const std::string& filename);
+  void WriteBinaryDocument(const std::string& filename, Element* document);
+};
+}
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+#endif
@@ -37,9 +37,12 @@ HISTORY
 INCLUDES
 %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
 
+#include <fstream>
+
 #include "FGJSBBase.h"
 #include "FGModelLoader.h"
-#include "FGXMLFileRead.h"
+#include "FGModelCache.h"
+#include "FGFDMExec.h"
 #include "models/FGModel.h"
 
 using namespace std;
@@ -59,7 +62,6 @@ Element_ptr FGModelLoader::Open(Element *el)
   string fname = el->GetAttributeValue("file");
 
   if (!fname.empty()) {
-    FGXMLFileRead XMLFileRead;
     string file;
 
     try {
@@ -72,21 +74,20 @@ Element_ptr FGModelLoader::Open(Element *el)
       return NULL;
     }
 
-    if (CachedFiles.find(file) != CachedFiles.end())
-      document = CachedFiles[file];
-    else {
-      document = XMLFileRead.LoadXMLDocument(file);
-      if (document == 0L) {
-        cerr << endl << el->ReadFrom()
-             << "Could not open file: " << file << endl;
-        return NULL;
-      }
-      CachedFiles[file] = document;
+    // The files are read once by the cache of the executive and shared by the
+    // instances that load the same model.
+    document = model->GetExec()->GetModelCache()->LoadXMLDocument(file);
+    if (document == 0L) {
+      cerr << endl << el->ReadFrom()
+           << "Could not open file: " << file << endl;
+      return NULL;
     }
 
+    // When the document is shared, it may already have been appended to the
+    // element by a previous load.
     if (document->GetName() != el->GetName()) {
       document->SetParent(el);
-      el->AddChildElement(document);
+      if (!el->HasChildElement(document)) el->AddChildElement(document);
     }
   }
 
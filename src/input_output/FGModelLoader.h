@@ -72,7 +72,6 @@ public:
 
 private:
   const FGModel* model;
-  std::map<std::string, Element_ptr> CachedFiles;
 };
 
  std::string CheckFullPathName(const std::string& path, const std::string& fname);
@@ -0,0 +1,224 @@
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+ Module:       FGOutputBinaryFile.cpp
+ Date started: May 2016
+ Purpose:      Manage output of sim parameters to a binary file
+ Called by:    FGOutput
+
+ ------------- Copyright (C) 2016  JSBSim development team  -------------
+
+ This program is free software; you can redistribute it and/or modify it under
+ the terms of the GNU Lesser General Public License as published by the Free Software
+ Foundation; either version 2 of the License, or (at your option) any later
+ version.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ details.
+
+ You should have received a copy of the GNU Lesser General Public License along with
+ this program; if not, write to the Free Software Foundation, Inc., 59 Temple
+ Place - Suite 330, Boston, MA  02111-1307, USA.
+
+ Further information about the GNU Lesser General Public License can also be found on
+ the world wide web at http://www.gnu.org.
+
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+INCLUDES
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+#include <chrono>
+#include <cstring>
+
+#include "FGOutputBinaryFile.h"
+#include "input_output/FGXMLElement.h"
+#include "input_output/string_utilities.h"
+#include "math/FGFunction.h"
+
+using namespace std;
+
+namespace JSBSim {
+
+IDENT(IdSrc,"$Id$");
+IDENT(IdHdr,ID_OUTPUTBINARYFILE);
+
+// Size of the ring buffer in bytes.
+static const size_t RingSize = 1 << 20;
+
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+CLASS IMPLEMENTATION
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+FGOutputBinaryFile::FGOutputBinaryFile(FGFDMExec* fdmex) :
+  FGOutputFile(fdmex),
+  SinglePrecision(false),
+  Capacity(0),
+  Head(0),
+  Tail(0),
+  Stopping(false)
+{
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+bool FGOutputBinaryFile::Load(Element* el)
+{
+  if (!FGOutputFile::Load(el))
+    return false;
+
+  string precision = el->GetAttributeValue("precision");
+  SetSinglePrecision(to_lower(precision) == "single");
+
+  if (SubSystems) {
+    cerr << el->ReadFrom() << fgred
+         << "The subsystems are not output to binary files. The properties "
+         << "must be listed instead." << reset << endl;
+  }
+
+  return true;
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+bool FGOutputBinaryFile::OpenFile(void)
+{
+  // The output continues in the same file if the simulation is reset without
+  // requesting a new output.
+  if (Writer.joinable()) return true;
+
+  char type = SinglePrecision ? 'f' : 'd';
+
+  Format.Columns.clear();
+  Format.Columns.push_back(FGOutputBinaryFormat::Column('d', "Time", "sec"));
+  for (unsigned int i=0; i<OutputProperties.size(); i++) {
+    string name = OutputProperties[i]->GetFullyQualifiedName();
+    string unit = FGOutputBinaryFormat::GetUnit(name);
+    if (!OutputCaptions[i].empty()) name = OutputCaptions[i];
+    Format.Columns.push_back(FGOutputBinaryFormat::Column(type, name, unit));
+  }
+  for (unsigned int i=0; i<PreFunctions.size(); i++) {
+    string name = PreFunctions[i]->GetName();
+    Format.Columns.push_back(FGOutputBinaryFormat::Column(type, name,
+                                      FGOutputBinaryFormat::GetUnit(name)));
+  }
+
+  string header = Format.BuildHeader();
+
+  datafile.clear();
+  datafile.open(Filename.c_str(), ios::out | ios::binary | ios::trunc);
+  if (!datafile) {
+    cerr << endl << fgred << highint << "ERROR: unable to open the file "
+         << reset << Filename.c_str() << endl
+         << fgred << highint << "       => Output to this file is disabled."
+         << reset << endl << endl;
+    Disable();
+    return false;
+  }
+
+  datafile.write(header.data(), header.size());
+
+  Capacity = max(RingSize / Format.RecordSize, (size_t)2);
+  Ring.resize(Capacity * Format.RecordSize);
+  Head = 0;
+  Tail = 0;
+  Stopping = false;
+  Writer = thread(&FGOutputBinaryFile::WriteRecords, this);
+
+  return true;
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+void FGOutputBinaryFile::CloseFile(void)
+{
+  if (Writer.joinable()) {
+    Stopping = true;
+    WakeUp.notify_one();
+    Writer.join();
+  }
+
+  if (datafile.is_open()) datafile.close();
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+void FGOutputBinaryFile::Print(void)
+{
+  if (!Writer.joinable()) return;
+
+  size_t head = Head.load(memory_order_relaxed);
+
+  // Wait for the writer thread if the buffer is full.
+  while (head - Tail.load(memory_order_acquire) == Capacity) {
+    WakeUp.notify_one();
+    this_thread::yield();
+  }
+
+  char* record = &Ring[(head % Capacity) * Format.RecordSize];
+  double time = FDMExec->GetSimTime();
+  memcpy(record, &time, sizeof(double));
+  record += sizeof(double);
+
+  if (SinglePrecision) {
+    for (unsigned int i=0; i<OutputProperties.size(); i++, record += sizeof(float)) {
+      float value = (float)OutputProperties[i]->getDoubleValue();
+      memcpy(record, &value, sizeof(float));
+    }
+    for (unsigned int i=0; i<PreFunctions.size(); i++, record += sizeof(float)) {
+      float value = (float)PreFunctions[i]->getDoubleValue();
+      memcpy(record, &value, sizeof(float));
+    }
+  } else {
+    for (unsigned int i=0; i<OutputProperties.size(); i++, record += sizeof(double)) {
+      double value = OutputProperties[i]->getDoubleValue();
+      memcpy(record, &value, sizeof(double));
+    }
+    for (unsigned int i=0; i<PreFunctions.size(); i++, record += sizeof(double)) {
+      double value = PreFunctions[i]->getDoubleValue();
+      memcpy(record, &value, sizeof(double));
+    }
+  }
+
+  Head.store(head+1, memory_order_release);
+
+  // The writer thread wakes up periodically by itself. It is only woken up
+  // early when the buffer is filling up.
+  if (head+1 - Tail.load(memory_order_relaxed) >= Capacity/4)
+    WakeUp.notify_one();
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+// Body of the writer thread.
+
+void FGOutputBinaryFile::WriteRecords(void)
+{
+  const size_t recordSize = Format.RecordSize;
+
+  while (true) {
+    size_t tail = Tail.load(memory_order_relaxed);
+    size_t head = Head.load(memory_order_acquire);
+
+    if (head == tail) {
+      // The records stored before the output was stopped must be written.
+      if (Stopping && Head.load(memory_order_acquire) == tail) break;
+
+      unique_lock<mutex> lock(WakeUpMutex);
+      WakeUp.wait_for(lock, chrono::milliseconds(20));
+      continue;
+    }
+
+    // The records are written in at most two blocks when they wrap around
+    // the end of the buffer.
+    size_t first = tail % Capacity;
+    size_t count = min(head - tail, Capacity - first);
+    datafile.write(&Ring[first * recordSize], count * recordSize);
+    if (count < head - tail)
+      datafile.write(&Ring[0], (head - tail - count) * recordSize);
+
+    Tail.store(head, memory_order_release);
+  }
+
+  datafile.flush();
+}
+}
@@ -0,0 +1,130 @@
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+ Header:       FGOutputBinaryFile.h
+ Date started: May 2016
+
+ ------------- Copyright (C) 2016  JSBSim development team  -------------
+
+ This program is free software; you can redistribute it and/or modify it under
+ the terms of the GNU Lesser General Public License as published by the Free Software
+ Foundation; either version 2 of the License, or (at your option) any later
+ version.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ details.
+
+ You should have received a copy of the GNU Lesser General Public License along with
+ this program; if not, write to the Free Software Foundation, Inc., 59 Temple
+ Place - Suite 330, Boston, MA  02111-1307, USA.
+
+ Further information about the GNU Lesser General Public License can also be found on
+ the world wide web at http://www.gnu.org.
+
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+SENTRY
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+#ifndef FGOUTPUTBINARYFILE_H
+#define FGOUTPUTBINARYFILE_H
+
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+INCLUDES
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+#include <atomic>
+#include <condition_variable>
+#include <fstream>
+#include <mutex>
+#include <thread>
+
+#include "FGOutputFile.h"
+#include "FGOutputBinaryFormat.h"
+
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+DEFINITIONS
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+#define ID_OUTPUTBINARYFILE "$Id$"
+
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+FORWARD DECLARATIONS
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+namespace JSBSim {
+
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+CLASS DOCUMENTATION
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+/** Implements the output to a binary file. The file holds the simulation time,
+    the properties and the functions listed in the output directives, in the
+    format described by FGOutputBinaryFormat. The values are stored in double
+    precision unless the attribute precision="single" is given:
+    @code
+    <output name="datalog.bin" type="BINARY" rate="120" precision="single">
+      <property> velocities/vc-kts </property>
+      <property caption="Altitude"> position/h-sl-ft </property>
+    </output>
+    @endcode
+
+    The simulation thread only copies the values to a ring buffer. A writer
+    thread drains the buffer to the file, so neither the formatting nor the
+    file accesses slow down the simulation. The simulation thread waits only
+    if the buffer is full.
+
+    The subsystems (velocities, forces, etc.) are not output to binary files:
+    the corresponding properties must be listed instead.
+ */
+
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+CLASS DECLARATION
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+class FGOutputBinaryFile : public FGOutputFile
+{
+public:
+  /// Constructor
+  FGOutputBinaryFile(FGFDMExec* fdmex);
+  /// Destructor: flushes the buffer and closes the file.
+  ~FGOutputBinaryFile() { CloseFile(); }
+
+  /** Init the output directives from an XML file.
+      @param element XML Element that is pointing to the output directives
+  */
+  bool Load(Element* el);
+
+  /** Selects the precision of the values.
+      @param single true to store the values in single precision. */
+  void SetSinglePrecision(bool single) { SinglePrecision = single; }
+
+  /// Copies the output values to the buffer.
+  void Print(void);
+
+protected:
+  bool OpenFile(void);
+  void CloseFile(void);
+
+private:
+  bool SinglePrecision;
+  FGOutputBinaryFormat Format;
+  std::ofstream datafile;
+
+  // Single producer, single consumer ring buffer of records. Head is only
+  // modified by the simulation thread and Tail by the writer thread.
+  std::vector<char> Ring;
+  size_t Capacity;
+  std::atomic<size_t> Head;
+  std::atomic<size_t> Tail;
+
+  std::thread Writer;
+  std::atomic<bool> Stopping;
+  std::mutex WakeUpMutex;
+  std::condition_variable WakeUp;
+
+  void WriteRecords(void);
+};
+}
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+#endif
@@ -0,0 +1,243 @@
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+ Header:       FGOutputBinaryFormat.h
+ Date started: May 2016
+
+ ------------- Copyright (C) 2016  JSBSim development team  -------------
+
+ This program is free software; you can redistribute it and/or modify it under
+ the terms of the GNU Lesser General Public License as published by the Free Software
+ Foundation; either version 2 of the License, or (at your option) any later
+ version.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ details.
+
+ You should have received a copy of the GNU Lesser General Public License along with
+ this program; if not, write to the Free Software Foundation, Inc., 59 Temple
+ Place - Suite 330, Boston, MA  02111-1307, USA.
+
+ Further information about the GNU Lesser General Public License can also be found on
+ the world wide web at http://www.gnu.org.
+
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+SENTRY
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+#ifndef FGOUTPUTBINARYFORMAT_H
+#define FGOUTPUTBINARYFORMAT_H
+
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+INCLUDES
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+#include <cstring>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <stdint.h>
+
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+DEFINITIONS
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+#define ID_OUTPUTBINARYFORMAT "$Id$"
+
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+FORWARD DECLARATIONS
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+namespace JSBSim {
+
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+CLASS DOCUMENTATION
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+/** Describes the layout of the files written by the BINARY output.
+    This header does not depend on the JSBSim library so that the tools which
+    read the output files (prep_plot, datafile) can include it.
+
+    A file is made of a header followed by fixed size records, one per output
+    time step. All the values are stored in the byte order of the machine that
+    wrote the file.
+
+    The header is made of:
+    - the 8 characters "JSBSIMBO";
+    - the version of the format, the byte order mark 0x01020304, the number of
+      columns, the size of a record and the size of the header, each of them
+      as a 32 bits unsigned integer;
+    - for each column: its type ('d' for a double precision number, 'f' for a
+      single precision number), its name and its unit. The type is a 32 bits
+      unsigned integer and each string is made of its length (32 bits
+      unsigned integer) followed by its characters;
+    - zero bytes up to the next multiple of 8 bytes.
+
+    The first column is the simulation time and is always a double precision
+    number. A record holds the values of all the columns in the order of the
+    header, with no padding between the values.
+
+    With gnuplot, a file can be plotted with:
+    @code
+    plot "output.bin" binary skip=<header size> format="%double%float..." using 1:2
+    @endcode
+    The format string is returned by GetGnuplotFormat().
+*/
+
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+CLASS DECLARATION
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+struct FGOutputBinaryFormat
+{
+  /// Description of a column.
+  struct Column {
+    Column(char type='d', const std::string& name="",
+           const std::string& unit="")
+      : Type(type), Name(name), Unit(unit) {}
+    char Type;
+    std::string Name;
+    std::string Unit;
+  };
+
+  std::vector<Column> Columns;
+  uint32_t RecordSize;
+  uint32_t HeaderSize;
+
+  FGOutputBinaryFormat(void) : RecordSize(0), HeaderSize(0) {}
+
+  /// Returns the number of bytes used to store a value of the given type.
+  static uint32_t GetSize(char type) { return type == 'f' ? 4 : 8; }
+
+  /** Builds the header of the columns and computes the size of the records.
+      @return the header to write at the beginning of the file. */
+  std::string BuildHeader(void) {
+    std::string body;
+    RecordSize = 0;
+    for (unsigned int i=0; i<Columns.size(); i++) {
+      AppendInteger(body, (uint32_t)Columns[i].Type);
+      AppendString(body, Columns[i].Name);
+      AppendString(body, Columns[i].Unit);
+      RecordSize += GetSize(Columns[i].Type);
+    }
+
+    const size_t fixedSize = 8 + 5*sizeof(uint32_t);
+    HeaderSize = (uint32_t)((fixedSize + body.size() + 7) & ~(size_t)7);
+
+    std::string header("JSBSIMBO", 8);
+    AppendInteger(header, Version);
+    AppendInteger(header, ByteOrderMark);
+    AppendInteger(header, (uint32_t)Columns.size());
+    AppendInteger(header, RecordSize);
+    AppendInteger(header, HeaderSize);
+    header += body;
+    header.resize(HeaderSize, '\0');
+
+    return header;
+  }
+
+  /** Reads the header of a file. The stream is left at the beginning of the
+      first record.
+      @return false if the stream does not start with a valid header. In that
+              case the stream must be rewound before it is read otherwise. */
+  bool ReadHeader(std::istream& in) {
+    char magic[8];
+    uint32_t version, byteOrder, numColumns;
+
+    if (!in.read(magic, 8) || memcmp(magic, "JSBSIMBO", 8) != 0
+        || !ReadInteger(in, version) || version != Version
+        || !ReadInteger(in, byteOrder) || byteOrder != ByteOrderMark
+        || !ReadInteger(in, numColumns) || !ReadInteger(in, RecordSize)
+        || !ReadInteger(in, HeaderSize))
+      return false;
+
+    Columns.resize(numColumns);
+    for (unsigned int i=0; i<numColumns; i++) {
+      uint32_t type;
+      if (!ReadInteger(in, type) || !ReadString(in, Columns[i].Name)
+          || !ReadString(in, Columns[i].Unit))
+        return false;
+      Columns[i].Type = (char)type;
+    }
+
+    return (bool)in.seekg(HeaderSize);
+  }
+
+  /** Reads a record.
+      @param values the values of the columns, converted to double.
+      @return false at the end of the file. */
+  bool ReadRecord(std::istream& in, std::vector<double>& values) const {
+    std::vector<char> record(RecordSize);
+    if (!in.read(&record[0], RecordSize)) return false;
+
+    values.resize(Columns.size());
+    const char* cursor = &record[0];
+    for (unsigned int i=0; i<Columns.size(); i++) {
+      if (Columns[i].Type == 'f') {
+        float value;
+        memcpy(&value, cursor, sizeof(value));
+        values[i] = value;
+      } else
+        memcpy(&values[i], cursor, sizeof(double));
+      cursor += GetSize(Columns[i].Type);
+    }
+    return true;
+  }
+
+  /** Returns the unit given by the suffix of a property name, e.g. ft for
+      position/h-sl-ft.
+      @return an empty string if the suffix is not a known unit. */
+  static std::string GetUnit(const std::string& name) {
+    static const char* units[] = {"ft", "fps", "kts", "mph", "rad", "deg",
+                                  "rad_sec", "deg_sec", "rad_sec2", "ft_sec2",
+                                  "fps2", "lbs", "lbsft", "psf", "psi", "inhg",
+                                  "slugs", "slug_ft3", "slugs_ft3", "sec",
+                                  "norm", "hp", "rpm", "pph", "pps", "gal", "R",
+                                  "K", "degF", "degC", "m", "km", "mps", "nm",
+                                  0};
+    std::string::size_type dash = name.find_last_of('-');
+    if (dash == std::string::npos || name.find('/', dash) != std::string::npos)
+      return std::string();
+
+    std::string suffix = name.substr(dash+1);
+    for (unsigned int i=0; units[i]; i++)
+      if (suffix == units[i]) return suffix;
+
+    return std::string();
+  }
+
+  /// Returns the format of a record in the syntax of gnuplot.
+  std::string GetGnuplotFormat(void) const {
+    std::ostringstream format;
+    for (unsigned int i=0; i<Columns.size(); i++)
+      format << (Columns[i].Type == 'f' ? "%float" : "%double");
+    return format.str();
+  }
+
+  static const uint32_t Version = 1;
+  static const uint32_t ByteOrderMark = 0x01020304;
+
+private:
+  static void AppendInteger(std::string& buffer, uint32_t value) {
+    buffer.append((const char*)&value, sizeof(value));
+  }
+  static void AppendString(std::string& buffer, const std::string& str) {
+    AppendInteger(buffer, (uint32_t)str.size());
+    buffer += str;
+  }
+  static bool ReadInteger(std::istream& in, uint32_t& value) {
+    return (bool)in.read((char*)&value, sizeof(value));
+  }
+  static bool ReadString(std::istream& in, std::string& str) {
+    uint32_t length;
+    if (!ReadInteger(in, length) || length > 65536) return false;
+    str.resize(length);
+    return length == 0 || (bool)in.read(&str[0], length);
+  }
+};
+}
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+#endif
@@ -0,0 +1,283 @@
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+ Module:       FGOutputBinarySocket.cpp
+ Date started: June 2016
+ Purpose:      Manage the binary output of sim parameters to a socket
+ Called by:    FGOutput
+
+ ------------- Copyright (C) 2016  JSBSim development team  -------------
+
+ This program is free software; you can redistribute it and/or modify it under
+ the terms of the GNU Lesser General Public License as published by the Free Software
+ Foundation; either version 2 of the License, or (at your option) any later
+ version.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ details.
+
+ You should have received a copy of the GNU Lesser General Public License along with
+ this program; if not, write to the Free Software Foundation, Inc., 59 Temple
+ Place - Suite 330, Boston, MA  02111-1307, USA.
+
+ Further information about the GNU Lesser General Public License can also be found on
+ the world wide web at http://www.gnu.org.
+
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+INCLUDES
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+#include <cstring>
+
+#include "FGOutputBinarySocket.h"
+#include "FGFDMExec.h"
+#include "input_output/FGXMLElement.h"
+#include "input_output/string_utilities.h"
+#include "math/FGFunction.h"
+
+using namespace std;
+
+namespace JSBSim {
+
+IDENT(IdSrc,"$Id$");
+IDENT(IdHdr,ID_OUTPUTBINARYSOCKET);
+
+// Largest message that fits in an UDP datagram without fragmentation.
+static const unsigned int DatagramSize = 1400;
+// Largest message that fits in an UDP datagram over IPv4.
+static const unsigned int MaxDatagramSize = 65507;
+
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+CLASS IMPLEMENTATION
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+// The values are written byte by byte so that the messages are little endian
+// whatever the byte order of the machine.
+
+static char* PutInteger(char* dest, uint64_t value, unsigned int size)
+{
+  for (unsigned int i=0; i<size; i++, value >>= 8)
+    dest[i] = (char)(value & 0xff);
+
+  return dest + size;
+}
+
+static char* PutDouble(char* dest, double value)
+{
+  uint64_t bits;
+  memcpy(&bits, &value, sizeof(bits));
+  return PutInteger(dest, bits, sizeof(bits));
+}
+
+static char* PutFloat(char* dest, float value)
+{
+  uint32_t bits;
+  memcpy(&bits, &value, sizeof(bits));
+  return PutInteger(dest, bits, sizeof(bits));
+}
+
+static void AppendString(vector<char>& buffer, const string& str)
+{
+  size_t pos = buffer.size();
+  buffer.resize(pos + 2 + str.size());
+  char* cursor = PutInteger(&buffer[pos], str.size(), 2);
+  if (!str.empty()) memcpy(cursor, str.data(), str.size());
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+FGOutputBinarySocket::FGOutputBinarySocket(FGFDMExec* fdmex) :
+  FGOutputSocket(fdmex),
+  SinglePrecision(false),
+  MaxFrames(0),
+  FramesPerMessage(1),
+  NumFrames(0),
+  Sequence(0)
+{
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+FGOutputBinarySocket::~FGOutputBinarySocket()
+{
+  if (NumFrames > 0 && socket && socket->GetConnectStatus())
+    SendRecords();
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+bool FGOutputBinarySocket::Load(Element* el)
+{
+  if (!FGOutputSocket::Load(el))
+    return false;
+
+  string precision = el->GetAttributeValue("precision");
+  SetSinglePrecision(to_lower(precision) == "single");
+
+  if (el->HasAttribute("frames")) {
+    double frames = el->GetAttributeValueAsNumber("frames");
+    if (frames < 1.0) {
+      cerr << el->ReadFrom() << fgred
+           << "The number of frames per message must be at least 1." << reset
+           << endl;
+      return false;
+    }
+    SetMaxFrames((unsigned int)frames);
+  }
+
+  if (SubSystems) {
+    cerr << el->ReadFrom() << fgred
+         << "The subsystems are not output to binary sockets. The properties "
+         << "must be listed instead." << reset << endl;
+  }
+
+  return true;
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+bool FGOutputBinarySocket::InitModel(void)
+{
+  // The records batched before a reset are sent to the previous socket.
+  if (NumFrames > 0 && socket && socket->GetConnectStatus())
+    SendRecords();
+
+  NumFrames = 0;
+  return FGOutputSocket::InitModel();
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+// Called by FGOutputSocket::InitModel() once the socket is connected.
+
+void FGOutputBinarySocket::PrintHeaders(void)
+{
+  char type = SinglePrecision ? 'f' : 'd';
+
+  Format.Columns.clear();
+  Format.Columns.push_back(FGOutputBinaryFormat::Column('d', "Time", "sec"));
+  for (unsigned int i=0; i<OutputProperties.size(); i++) {
+    string name = OutputProperties[i]->GetFullyQualifiedName();
+    string unit = FGOutputBinaryFormat::GetUnit(name);
+    if (!OutputCaptions[i].empty()) name = OutputCaptions[i];
+    Format.Columns.push_back(FGOutputBinaryFormat::Column(type, name, unit));
+  }
+  for (unsigned int i=0; i<PreFunctions.size(); i++) {
+    string name = PreFunctions[i]->GetName();
+    Format.Columns.push_back(FGOutputBinaryFormat::Column(type, name,
+                                      FGOutputBinaryFormat::GetUnit(name)));
+  }
+
+  Format.RecordSize = 0;
+  for (unsigned int i=0; i<Format.Columns.size(); i++)
+    Format.RecordSize += FGOutputBinaryFormat::GetSize(Format.Columns[i].Type);
+
+  if (MaxFrames > 0) {
+    FramesPerMessage = MaxFrames;
+    if (SockProtocol == FGfdmSocket::ptUDP) {
+      unsigned int maxFrames = max((MaxDatagramSize - HeaderSize)
+                                   / Format.RecordSize, 1U);
+      if (FramesPerMessage > maxFrames) {
+        cerr << fgred << "The messages of " << MaxFrames << " frames of the "
+             << "output " << Name << " do not fit in an UDP datagram. They "
+             << "are limited to " << maxFrames << " frames." << reset << endl;
+        FramesPerMessage = maxFrames;
+      }
+    }
+  } else
+    FramesPerMessage = max((DatagramSize - HeaderSize) / Format.RecordSize, 1U);
+
+  Buffer.reserve(HeaderSize + FramesPerMessage * Format.RecordSize);
+  LastSend = chrono::steady_clock::now();
+
+  SendSchema();
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+void FGOutputBinarySocket::Print(void)
+{
+  if (socket == 0) return;
+  if (!socket->GetConnectStatus()) return;
+
+  chrono::steady_clock::time_point now = chrono::steady_clock::now();
+
+  // The consumers which have missed the schema get a new one every second.
+  if (NumFrames == 0 && SockProtocol == FGfdmSocket::ptUDP
+      && now - LastSchema >= chrono::seconds(1))
+    SendSchema();
+
+  if (NumFrames == 0) Buffer.resize(HeaderSize);
+
+  size_t pos = Buffer.size();
+  Buffer.resize(pos + Format.RecordSize);
+  char* cursor = PutDouble(&Buffer[pos], FDMExec->GetSimTime());
+
+  if (SinglePrecision) {
+    for (unsigned int i=0; i<OutputProperties.size(); i++)
+      cursor = PutFloat(cursor, (float)OutputProperties[i]->getDoubleValue());
+    for (unsigned int i=0; i<PreFunctions.size(); i++)
+      cursor = PutFloat(cursor, (float)PreFunctions[i]->getDoubleValue());
+  } else {
+    for (unsigned int i=0; i<OutputProperties.size(); i++)
+      cursor = PutDouble(cursor, OutputProperties[i]->getDoubleValue());
+    for (unsigned int i=0; i<PreFunctions.size(); i++)
+      cursor = PutDouble(cursor, PreFunctions[i]->getDoubleValue());
+  }
+
+  NumFrames++;
+
+  // When the simulation runs in real time (or slower), the output period has
+  // always elapsed and each record is sent immediately. Otherwise the records
+  // are batched until the message is full.
+  chrono::duration<double> period(1.0 / GetRateHz());
+  if (NumFrames >= FramesPerMessage || now - LastSend >= period)
+    SendRecords();
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+void FGOutputBinarySocket::SendSchema(void)
+{
+  vector<char> records;
+  records.swap(Buffer);
+
+  Buffer.resize(HeaderSize + 4);
+  PutInteger(&Buffer[HeaderSize], Format.RecordSize, 4);
+  for (unsigned int i=0; i<Format.Columns.size(); i++) {
+    Buffer.push_back(Format.Columns[i].Type);
+    AppendString(Buffer, Format.Columns[i].Name);
+    AppendString(Buffer, Format.Columns[i].Unit);
+  }
+
+  SendMessage(mkSchema, Format.Columns.size());
+  LastSchema = chrono::steady_clock::now();
+
+  Buffer.swap(records);
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+void FGOutputBinarySocket::SendRecords(void)
+{
+  SendMessage(mkData, NumFrames);
+  NumFrames = 0;
+  LastSend = chrono::steady_clock::now();
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+// Fills the header at the beginning of the buffer and sends the message.
+
+void FGOutputBinarySocket::SendMessage(MessageKind kind, unsigned int count)
+{
+  char* cursor = &Buffer[0];
+  memcpy(cursor, "JSBS", 4);
+  cursor = PutInteger(cursor+4, Version, 2);
+  cursor = PutInteger(cursor, kind, 2);
+  cursor = PutInteger(cursor, Buffer.size(), 4);
+  cursor = PutInteger(cursor, Sequence++, 4);
+  PutInteger(cursor, count, 4);
+
+  socket->Send(&Buffer[0], Buffer.size());
+}
+}
@@ -0,0 +1,161 @@
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+ Header:       FGOutputBinarySocket.h
+ Date started: June 2016
+
+ ------------- Copyright (C) 2016  JSBSim development team  -------------
+
+ This program is free software; you can redistribute it and/or modify it under
+ the terms of the GNU Lesser General Public License as published by the Free Software
+ Foundation; either version 2 of the License, or (at your option) any later
+ version.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ details.
+
+ You should have received a copy of the GNU Lesser General Public License along with
+ this program; if not, write to the Free Software Foundation, Inc., 59 Temple
+ Place - Suite 330, Boston, MA  02111-1307, USA.
+
+ Further information about the GNU Lesser General Public License can also be found on
+ the world wide web at http://www.gnu.org.
+
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+SENTRY
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+#ifndef FGOUTPUTBINARYSOCKET_H
+#define FGOUTPUTBINARYSOCKET_H
+
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+INCLUDES
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+#include <chrono>
+#include <vector>
+
+#include "FGOutputSocket.h"
+#include "FGOutputBinaryFormat.h"
+
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+DEFINITIONS
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+#define ID_OUTPUTBINARYSOCKET "$Id$"
+
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+FORWARD DECLARATIONS
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+namespace JSBSim {
+
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+CLASS DOCUMENTATION
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+/** Implements the binary output to a socket. The simulation time, the
+    properties and the functions listed in the output directives are packed in
+    fixed size records which are sent without any conversion to text:
+    @code
+    <output name="localhost" type="BINARY_SOCKET" port="5600" protocol="UDP"
+            rate="60" precision="single" frames="10">
+      <property> velocities/vc-kts </property>
+      <property caption="Altitude"> position/h-sl-ft </property>
+    </output>
+    @endcode
+
+    The data is sent in messages made of a header followed by a body. All the
+    values are little endian. The header is made of:
+    - the 4 characters "JSBS";
+    - the version of the protocol and the kind of the message (1 for a schema,
+      2 for data), each of them as a 16 bits unsigned integer;
+    - the size of the message (header included), a sequence number incremented
+      for each message and the number of items in the body, each of them as a
+      32 bits unsigned integer.
+
+    The body of a schema message describes the records: the size of a record
+    (32 bits unsigned integer) followed, for each column, by its type ('d' for
+    a double precision number, 'f' for a single precision number, 8 bits), its
+    name and its unit (16 bits length followed by the characters). The first
+    column is the simulation time and is always a double precision number.
+
+    The body of a data message is made of records, each of them holding the
+    values of the columns in the order of the schema with no padding.
+
+    The schema is sent when the socket is connected. With the UDP protocol, it
+    is also repeated every second so that a consumer can join at any time.
+
+    The output rate is set by the attribute rate. When the simulation runs
+    faster than real time, the records are batched: a message is sent when the
+    output period has elapsed in real time since the previous message or when
+    the message holds the number of records given by the attribute frames. By
+    default, a message holds as many records as can fit in a UDP datagram
+    without fragmentation (1400 bytes). With the UDP protocol, the number of
+    frames is limited so that a message fits in a datagram (65507 bytes).
+
+    The subsystems (velocities, forces, etc.) are not output by this class:
+    the corresponding properties must be listed instead.
+ */
+
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+CLASS DECLARATION
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+class FGOutputBinarySocket : public FGOutputSocket
+{
+public:
+  /// Constructor
+  FGOutputBinarySocket(FGFDMExec* fdmex);
+  /// Destructor: sends the records that are still batched.
+  ~FGOutputBinarySocket();
+
+  /** Init the output directives from an XML file.
+      @param element XML Element that is pointing to the output directives
+  */
+  bool Load(Element* el);
+
+  /** Initializes the instance: connects the socket and sends the schema.
+      @result true if the execution succeeded.
+   */
+  bool InitModel(void);
+
+  /** Selects the precision of the values.
+      @param single true to send the values in single precision. */
+  void SetSinglePrecision(bool single) { SinglePrecision = single; }
+
+  /** Sets the maximum number of records in a message.
+      @param frames the number of records. 0 selects the number of records
+                    that fit in a UDP datagram. */
+  void SetMaxFrames(unsigned int frames) { MaxFrames = frames; }
+
+  /// Adds a record to the current message and sends it if needed.
+  void Print(void);
+
+  enum MessageKind { mkSchema = 1, mkData = 2 };
+
+  static const unsigned int Version = 1;
+  static const unsigned int HeaderSize = 20;
+
+protected:
+  void PrintHeaders(void);
+
+private:
+  bool SinglePrecision;
+  unsigned int MaxFrames;
+  unsigned int FramesPerMessage;
+  unsigned int NumFrames;
+  unsigned int Sequence;
+  FGOutputBinaryFormat Format;
+  std::vector<char> Buffer;
+  std::chrono::steady_clock::time_point LastSend;
+  std::chrono::steady_clock::time_point LastSchema;
+
+  void SendSchema(void);
+  void SendRecords(void);
+  void SendMessage(MessageKind kind, unsigned int count);
+};
+}
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+#endif
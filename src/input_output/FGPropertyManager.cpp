@@ -28,6 +28,9 @@
 INCLUDES
 %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
 
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
 #include "FGPropertyManager.h"
 
 /*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
@@ -418,4 +421,100 @@ void FGPropertyManager::Tie (const string &name, double *pointer, bool useDefaul
   }
 }
 
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+void FGPropertyDependencies::Add(FGPropertyNode* node)
+{
+  // The changes are tracked on the node that actually stores the value.
+  while (node->isAlias())
+    node = static_cast<FGPropertyNode*>(node->getAliasTarget());
+
+  if (find(Nodes.begin(), Nodes.end(), node) != Nodes.end()) return;
+
+  // The value of a tied property is not read here: its getter might depend on
+  // properties that are not defined yet. The dependent value is not valid
+  // anyway so it will be computed at the first check.
+  Nodes.push_back(node);
+  Stamps.push_back(node->getChangeStamp());
+  Values.push_back(0.0);
+  Valid = false;
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+bool FGPropertyDependencies::Changed(void)
+{
+  bool changed = !Valid;
+
+  for (unsigned int i=0; i<Nodes.size(); i++) {
+    FGPropertyNode* node = Nodes[i];
+
+    if (node->isTied()) {
+      double value = node->getDoubleValue();
+      if (memcmp(&value, &Values[i], sizeof(double)) != 0) {
+        Values[i] = value;
+        changed = true;
+      }
+    } else {
+      unsigned int stamp = node->getChangeStamp();
+      if (stamp != Stamps[i]) {
+        Stamps[i] = stamp;
+        changed = true;
+      }
+    }
+  }
+
+  if (changed) Valid = false;
+
+  return changed;
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+bool FGPropertyDependencies::IsEnabled(void)
+{
+  char* tracking = getenv("JSBSIM_DEPENDENCY_TRACKING");
+  return tracking && atoi(tracking) != 0;
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+FGPropertyHandle::FGPropertyHandle(FGPropertyNode* node)
+  : Node(node), Pointer(0)
+{
+  if (!node) return;
+
+  while (node->isAlias())
+    node = static_cast<FGPropertyNode*>(node->getAliasTarget());
+
+  // The variable can only be accessed directly when the node does not check
+  // the accesses (read only or traced properties) and when nobody needs to be
+  // notified of its modifications.
+  if (node->getAttributes() != (SGPropertyNode::READ|SGPropertyNode::WRITE))
+    return;
+
+  for (SGPropertyNode* n = node; n; n = n->getParent())
+    if (n->nListeners() > 0) return;
+
+  Pointer = node->getTiedPointer<double>();
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+void FGPropertyHandle::GetValues(const vector<FGPropertyHandle>& handles,
+                                 double* values)
+{
+  for (unsigned int i=0; i<handles.size(); i++)
+    values[i] = handles[i].GetValue();
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+void FGPropertyHandle::SetValues(const vector<FGPropertyHandle>& handles,
+                                 const double* values)
+{
+  for (unsigned int i=0; i<handles.size(); i++)
+    handles[i].SetValue(values[i]);
+}
+
 } // namespace JSBSim
@@ -376,6 +376,137 @@ class FGPropertyNode : public SGPropertyNode
 typedef SGSharedPtr<FGPropertyNode> FGPropertyNode_ptr;
 typedef SGSharedPtr<const FGPropertyNode> FGConstPropertyNode_ptr;
 
+/** Tracks the changes of the properties which a value depends on.
+    The value only needs to be computed again when Changed() returns true:
+
+    @code
+    if (Dependencies.Changed()) {
+      Value = Compute();
+      Dependencies.Validate();
+    }
+    @endcode
+
+    The changes of the untied properties are detected with their change stamp
+    while the values of the tied properties, which can be modified without the
+    property tree being notified, are compared to the values read at the
+    previous check.
+
+    The tracking of dependencies is optional and is enabled by setting the
+    environment variable JSBSIM_DEPENDENCY_TRACKING to a non zero value.
+  */
+
+class FGPropertyDependencies
+{
+  public:
+    /// Constructor
+    FGPropertyDependencies(void) : Valid(false) {}
+
+    /** Adds a property to the set of dependencies.
+        Adding the same property twice has no effect.
+        @param node the property node. */
+    void Add(FGPropertyNode* node);
+
+    /// Returns the number of properties in the set of dependencies.
+    size_t GetNumProperties(void) const { return Nodes.size(); }
+
+    /// Returns the i-th property of the set of dependencies.
+    FGPropertyNode* GetProperty(size_t i) const { return Nodes[i]; }
+
+    /** Checks whether one of the properties has changed since the previous
+        check.
+        @return true if a property has changed or if the dependent value has
+                not been validated since the previous change. */
+    bool Changed(void);
+
+    /// Flags the dependent value as up to date.
+    void Validate(void) { Valid = true; }
+
+    /// Forces the dependent value to be computed at the next check.
+    void Invalidate(void) { Valid = false; }
+
+    /// Returns true if the tracking of dependencies is enabled.
+    static bool IsEnabled(void);
+
+  private:
+    std::vector<FGPropertyNode*> Nodes;
+    std::vector<unsigned int> Stamps;
+    std::vector<double> Values;
+    bool Valid;
+};
+
+/** Provides a fast access to the value of a property.
+    The property is looked up once when the handle is built so the accesses
+    to its value do not parse the path of the property. In addition, when the
+    property is tied to a double precision variable, the handle keeps the
+    address of the variable and reads or writes it directly. Otherwise the
+    value is accessed through the property node.
+
+    The bulk methods GetValues() and SetValues() transfer the values of a set
+    of handles from or to an array:
+
+    @code
+    std::vector<FGPropertyHandle> handles;
+    handles.push_back(FDMExec->GetPropertyHandle("velocities/vc-kts"));
+    handles.push_back(FDMExec->GetPropertyHandle("position/h-sl-ft"));
+    std::vector<double> values(handles.size());
+
+    while (FDMExec->Run())
+      FGPropertyHandle::GetValues(handles, &values[0]);
+    @endcode
+
+    The handles must be built again when the model is reloaded or when the
+    property is tied to another variable. The listeners of the tied properties
+    are not notified of the modifications made through a handle.
+  */
+
+class FGPropertyHandle
+{
+  public:
+    /// Default constructor: builds an invalid handle.
+    FGPropertyHandle(void) : Pointer(0) {}
+
+    /** Constructor.
+        @param node the property node, possibly null. */
+    explicit FGPropertyHandle(FGPropertyNode* node);
+
+    /// Returns true if the handle refers to a property.
+    bool IsValid(void) const { return Node.valid(); }
+
+    /// Returns true if the value is read and written without the property node.
+    bool IsDirect(void) const { return Pointer != 0; }
+
+    /// Returns the property node.
+    FGPropertyNode* GetNode(void) const { return Node; }
+
+    /// Returns the value of the property.
+    double GetValue(void) const
+    { return Pointer ? *Pointer : Node->getDoubleValue(); }
+
+    /// Sets the value of the property.
+    void SetValue(double value) const {
+      if (Pointer) *Pointer = value;
+      else Node->setDoubleValue(value);
+    }
+
+    /** Reads the values of a set of properties.
+        @param handles the handles of the properties.
+        @param values the array that receives the values. It must hold at least
+                      handles.size() elements. */
+    static void GetValues(const std::vector<FGPropertyHandle>& handles,
+                          double* values);
+
+    /** Modifies the values of a set of properties.
+        @param handles the handles of the properties.
+        @param values the array of the values. It must hold at least
+                      handles.size() elements. */
+    static void SetValues(const std::vector<FGPropertyHandle>& handles,
+                          const double* values);
+
+  private:
+    FGPropertyNode_ptr Node;
+    double* Pointer;
+};
+
 class FGPropertyManager
 {
   public:
@@ -430,6 +561,21 @@ class FGPropertyManager
      */
     void Unbind (void);
 
+    /**
+     * Get the number of properties tied by this manager.
+     *
+     * The properties are numbered in the order they have been tied.
+     */
+    size_t GetNumTiedProperties (void) const { return tied_properties.size(); }
+
+    /**
+     * Get a property tied by this manager.
+     *
+     * @param i The index of the property (see GetNumTiedProperties).
+     */
+    FGPropertyNode* GetTiedProperty (size_t i) const
+    { return static_cast<FGPropertyNode*>(tied_properties[i].ptr()); }
+
         // Templates cause ambiguity here
 
     /**
@@ -53,6 +53,7 @@ INCLUDES
 #include "models/FGInput.h"
 #include "math/FGCondition.h"
 #include "math/FGFunction.h"
+#include "input_output/FGSnapshot.h"
 
 using namespace std;
 
@@ -299,9 +300,9 @@ bool FGScript::LoadScript(const string& script, double default_dT,
     while (set_element) {
       prop_name = set_element->GetAttributeValue("name");
       if (PropertyManager->HasNode(prop_name)) {
-        newEvent->SetParam.push_back( PropertyManager->GetNode(prop_name) );
+        newEvent->SetParam.push_back( FGPropertyHandle(PropertyManager->GetNode(prop_name)) );
       } else {
-        newEvent->SetParam.push_back( 0L );
+        newEvent->SetParam.push_back( FGPropertyHandle() );
       }
       newEvent->SetParamName.push_back( prop_name );
 
@@ -312,7 +313,7 @@ bool FGScript::LoadScript(const string& script, double default_dT,
         newEvent->Functions.push_back((FGFunction*)0L);
       } else if (set_element->FindElement("function")) {
         value = 0.0;
-        newEvent->Functions.push_back(new FGFunction(PropertyManager, set_element->FindElement("function")));
+        newEvent->Functions.push_back(new FGFunction(FDMExec, set_element->FindElement("function")));
       }
       newEvent->SetValue.push_back(value);
       newEvent->OriginalValue.push_back(0.0);
@@ -387,14 +388,14 @@ bool FGScript::RunScript(void)
 
         // The conditions are true, do the setting of the desired Event parameters
         for (i=0; i<thisEvent.SetValue.size(); i++) {
-          if (thisEvent.SetParam[i] == 0L) { // Late bind property if necessary
+          if (!thisEvent.SetParam[i].IsValid()) { // Late bind property if necessary
             if (PropertyManager->HasNode(thisEvent.SetParamName[i])) {
-              thisEvent.SetParam[i] = PropertyManager->GetNode(thisEvent.SetParamName[i]);
+              thisEvent.SetParam[i] = FGPropertyHandle(PropertyManager->GetNode(thisEvent.SetParamName[i]));
             } else {
               throw("No property, \""+thisEvent.SetParamName[i]+"\" is defined.");
             }
           }
-          thisEvent.OriginalValue[i] = thisEvent.SetParam[i]->getDoubleValue();
+          thisEvent.OriginalValue[i] = thisEvent.SetParam[i].GetValue();
           if (thisEvent.Functions[i] != 0) { // Parameter should be set to a function value
             try {
               thisEvent.SetValue[i] = thisEvent.Functions[i]->GetValue();
@@ -464,7 +465,7 @@ bool FGScript::RunScript(void)
             cerr << "Invalid Action specified" << endl;
             break;
           }
-          thisEvent.SetParam[i]->setDoubleValue(newSetValue);
+          thisEvent.SetParam[i].SetValue(newSetValue);
         }
       }
 
@@ -520,6 +521,27 @@ bool FGScript::RunScript(void)
   return true;
 }
 
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+void FGScript::ArchiveState(FGSnapshot& snapshot)
+{
+  snapshot.Archive(StartTime);
+  snapshot.Archive(EndTime);
+
+  for (unsigned int i=0; i<Events.size(); i++) {
+    struct event& ev = Events[i];
+    snapshot.Archive(ev.Triggered);
+    snapshot.Archive(ev.Notified);
+    snapshot.Archive(ev.StartTime);
+    snapshot.Archive(ev.TimeSpan);
+    snapshot.Archive(ev.SetValue);
+    snapshot.Archive(ev.newValue);
+    snapshot.Archive(ev.OriginalValue);
+    snapshot.Archive(ev.ValueSpan);
+    snapshot.Archive(ev.Transiting);
+  }
+}
+
 //%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
 //    The bitmasked value choices are as follows:
 //    unset: In this case (the default) JSBSim would only print
@@ -584,7 +606,7 @@ void FGScript::Debug(int from)
         cout << ":" << endl << "    {";
         for (unsigned j=0; j<Events[i].SetValue.size(); j++) {
           if (Events[i].SetValue[j] == 0.0 && Events[i].Functions[j] != 0L) {
-            if (Events[i].SetParam[j] == 0) {
+            if (!Events[i].SetParam[j].IsValid()) {
               if (Events[i].SetParamName[j].size() == 0) {
               cerr << fgred << highint << endl
                    << "  An attempt has been made to access a non-existent property" << endl
@@ -596,11 +618,11 @@ void FGScript::Debug(int from)
                      << " to function value (Late Bound)";
             }
             } else {
-            cout << endl << "      set " << Events[i].SetParam[j]->GetRelativeName("/fdm/jsbsim/")
+            cout << endl << "      set " << Events[i].SetParam[j].GetNode()->GetRelativeName("/fdm/jsbsim/")
                  << " to function value";
             }
           } else {
-            if (Events[i].SetParam[j] == 0) {
+            if (!Events[i].SetParam[j].IsValid()) {
               if (Events[i].SetParamName[j].size() == 0) {
               cerr << fgred << highint << endl
                    << "  An attempt has been made to access a non-existent property" << endl
@@ -612,7 +634,7 @@ void FGScript::Debug(int from)
                      << " to function value (Late Bound)";
             }
             } else {
-            cout << endl << "      set " << Events[i].SetParam[j]->GetRelativeName("/fdm/jsbsim/")
+            cout << endl << "      set " << Events[i].SetParam[j].GetNode()->GetRelativeName("/fdm/jsbsim/")
                  << " to " << Events[i].SetValue[j];
           }
           }
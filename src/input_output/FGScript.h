@@ -59,6 +59,7 @@ namespace JSBSim {
 class FGFDMExec;
 class FGCondition;
 class FGFunction;
+class FGSnapshot;
 
 /*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
 CLASS DOCUMENTATION
@@ -197,6 +198,7 @@ public:
   bool RunScript(void);
 
   void ResetEvents(void);
+  void ArchiveState(FGSnapshot& snapshot);
 
 private:
   enum eAction {
@@ -224,7 +226,7 @@ private:
     double           TimeSpan;
     std::string           Name;
     std::string           Description;
-    std::vector <FGPropertyNode_ptr>  SetParam;
+    std::vector <FGPropertyHandle>  SetParam;
     std::vector <std::string>  SetParamName;
     std::vector <FGPropertyNode_ptr>  NotifyProperties;
     std::vector <std::string>              NotifyPropertyNames;
@@ -0,0 +1,202 @@
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+ Module:       FGSnapshot.cpp
+ Date started: March 2016
+ Purpose:      In-memory copy of the state of a simulation
+
+ ------------- Copyright (C) 2016  JSBSim development team  -------------
+
+ This program is free software; you can redistribute it and/or modify it under
+ the terms of the GNU Lesser General Public License as published by the Free Software
+ Foundation; either version 2 of the License, or (at your option) any later
+ version.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ details.
+
+ You should have received a copy of the GNU Lesser General Public License along with
+ this program; if not, write to the Free Software Foundation, Inc., 59 Temple
+ Place - Suite 330, Boston, MA  02111-1307, USA.
+
+ Further information about the GNU Lesser General Public License can also be found on
+ the world wide web at http://www.gnu.org.
+
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+INCLUDES
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+#include "FGSnapshot.h"
+#include "FGPropertyManager.h"
+#include "math/FGColumnVector3.h"
+#include "math/FGMatrix33.h"
+
+using namespace std;
+
+namespace JSBSim {
+
+IDENT(IdSrc,"$Id$");
+IDENT(IdHdr,ID_SNAPSHOT);
+
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+CLASS IMPLEMENTATION
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+FGSnapshot::FGSnapshot(void)
+  : Saving(false), ScalarCursor(0), SlotCursor(0)
+{
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+FGSnapshot::~FGSnapshot()
+{
+  Clear();
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+void FGSnapshot::Clear(void)
+{
+  for (unsigned int i=0; i<Slots.size(); i++) delete Slots[i];
+  Slots.clear();
+  Scalars.clear();
+  PropertyValues.clear();
+  Properties = 0;
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+// The slots of a previous save are reused when the types match so that saving
+// the same simulation again does not allocate memory.
+
+void FGSnapshot::StartSaving(void)
+{
+  Saving = true;
+  Scalars.clear();
+  ScalarCursor = 0;
+  SlotCursor = 0;
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+void FGSnapshot::FinishSaving(void)
+{
+  for (size_t i=SlotCursor; i<Slots.size(); i++) delete Slots[i];
+  Slots.resize(SlotCursor);
+  ScalarCursor = Scalars.size();
+  Saving = false;
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+void FGSnapshot::StartRestoring(void)
+{
+  Saving = false;
+  ScalarCursor = 0;
+  SlotCursor = 0;
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+bool FGSnapshot::FinishRestoring(void) const
+{
+  return ScalarCursor == Scalars.size() && SlotCursor == Slots.size();
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+void FGSnapshot::Mismatch(void) const
+{
+  throw string("The snapshot does not match the model that is restored.");
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+void FGSnapshot::Archive(double& value)
+{
+  if (Saving)
+    Scalars.push_back(value);
+  else {
+    if (ScalarCursor >= Scalars.size()) Mismatch();
+    value = Scalars[ScalarCursor++];
+  }
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+void FGSnapshot::Archive(bool& value)
+{
+  double v = value ? 1.0 : 0.0;
+  Archive(v);
+  value = v != 0.0;
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+void FGSnapshot::Archive(int& value)
+{
+  double v = value;
+  Archive(v);
+  value = (int)v;
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+void FGSnapshot::Archive(unsigned int& value)
+{
+  double v = value;
+  Archive(v);
+  value = (unsigned int)v;
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+void FGSnapshot::Archive(FGColumnVector3& value)
+{
+  for (unsigned int i=1; i<=3; i++) Archive(value(i));
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+void FGSnapshot::Archive(FGMatrix33& value)
+{
+  for (unsigned int i=1; i<=3; i++)
+    for (unsigned int j=1; j<=3; j++)
+      Archive(value(i,j));
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+void FGSnapshot::SaveProperties(PropertyList* list)
+{
+  Properties = list;
+  PropertyValues.resize(list->Nodes.size());
+
+  for (unsigned int i=0; i<list->Nodes.size(); i++)
+    PropertyValues[i] = list->Nodes[i]->getDoubleValue();
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+// When the snapshot is restored in the instance that saved it, the nodes are
+// used directly. Otherwise they are looked up by their path in the property
+// tree of the instance.
+
+void FGSnapshot::RestoreProperties(PropertyList* list,
+                                   FGPropertyManager* PropertyManager)
+{
+  if (!Properties) Mismatch();
+
+  if (list == Properties.ptr()) {
+    for (unsigned int i=0; i<list->Nodes.size(); i++)
+      list->Nodes[i]->setDoubleValue(PropertyValues[i]);
+  } else {
+    const vector<string>& paths = Properties->Paths;
+    for (unsigned int i=0; i<paths.size(); i++) {
+      FGPropertyNode* node = PropertyManager->GetNode(paths[i]);
+      if (node && !node->isTied()) node->setDoubleValue(PropertyValues[i]);
+    }
+  }
+}
+
+}
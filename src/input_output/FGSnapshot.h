@@ -0,0 +1,198 @@
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+ Header:       FGSnapshot.h
+ Date started: March 2016
+
+ ------------- Copyright (C) 2016  JSBSim development team  -------------
+
+ This program is free software; you can redistribute it and/or modify it under
+ the terms of the GNU Lesser General Public License as published by the Free Software
+ Foundation; either version 2 of the License, or (at your option) any later
+ version.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ details.
+
+ You should have received a copy of the GNU Lesser General Public License along with
+ this program; if not, write to the Free Software Foundation, Inc., 59 Temple
+ Place - Suite 330, Boston, MA  02111-1307, USA.
+
+ Further information about the GNU Lesser General Public License can also be found on
+ the world wide web at http://www.gnu.org.
+
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+SENTRY
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+#ifndef FGSNAPSHOT_H
+#define FGSNAPSHOT_H
+
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+INCLUDES
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+#include <vector>
+#include <string>
+
+#include "FGJSBBase.h"
+#include "simgear/structure/SGSharedPtr.hxx"
+
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+DEFINITIONS
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+#define ID_SNAPSHOT "$Id$"
+
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+FORWARD DECLARATIONS
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+namespace JSBSim {
+
+class FGColumnVector3;
+class FGMatrix33;
+class FGPropertyNode;
+class FGPropertyManager;
+
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+CLASS DOCUMENTATION
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+/** An in-memory copy of the state of a simulation.
+    A snapshot is filled by FGFDMExec::SaveState() and can then be restored any
+    number of times by FGFDMExec::RestoreState(), either in the instance that
+    saved it or in another instance that has loaded the same model. The
+    simulation then continues exactly as it would have from the time the
+    snapshot was taken.
+
+    The snapshot holds:
+    - the values of the properties that are not tied to a member of a class
+      (the properties created by the systems, the functions and the scripts);
+    - the state that each model, FCS component, engine, thruster, tank, gear,
+      etc. stores in its members. Each of these classes provides a method
+      ArchiveState() which passes its members to Archive() in a fixed order.
+      The same method is used to save and to restore the members, so the
+      snapshot does not need to know the classes that it stores.
+    - the initial conditions (FGInitialCondition), so that a restored
+      simulation is reset or reinitialized to the same conditions.
+
+    The properties that are created after the snapshot is taken are left
+    untouched by the restoration, as well as the properties that hold strings.
+    The output files are not rewound.
+
+    @code
+    FGSnapshot snapshot;
+    fdmex->SaveState(snapshot);
+    for (unsigned int i=0; i<n; i++) {
+      fdmex->RestoreState(snapshot);
+      // Run a branch of the simulation
+    }
+    @endcode
+*/
+
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+CLASS DECLARATION
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+class FGSnapshot : public FGJSBBase
+{
+public:
+  /// The properties which values are stored in the snapshots of an instance.
+  struct PropertyList : public SGReferenced {
+    std::vector<FGPropertyNode*> Nodes;
+    std::vector<std::string> Paths;
+  };
+
+  /// Constructor
+  FGSnapshot(void);
+  /// Destructor
+  ~FGSnapshot();
+
+  /// Returns true if the snapshot is being saved, false if it is restored.
+  bool IsSaving(void) const { return Saving; }
+  /// Returns true if the snapshot does not hold any state yet.
+  bool IsEmpty(void) const { return Scalars.empty() && Slots.empty(); }
+
+  /** Saves a value to the snapshot or restores it from the snapshot.
+      @param value the value to save or to restore. */
+  void Archive(double& value);
+  void Archive(bool& value);
+  void Archive(int& value);
+  void Archive(unsigned int& value);
+  void Archive(FGColumnVector3& value);
+  void Archive(FGMatrix33& value);
+
+  /** Saves or restores a value of any copyable type. The value is saved and
+      restored with its copy constructor and its assignment operator. */
+  template <typename T> void Archive(T& value) {
+    if (Saving) {
+      if (SlotCursor < Slots.size()) {
+        Slot<T>* slot = dynamic_cast<Slot<T>*>(Slots[SlotCursor]);
+        if (slot) {
+          slot->Value = value;
+          SlotCursor++;
+          return;
+        }
+        delete Slots[SlotCursor];
+        Slots[SlotCursor++] = new Slot<T>(value);
+      } else {
+        Slots.push_back(new Slot<T>(value));
+        SlotCursor++;
+      }
+    } else {
+      Slot<T>* slot = 0;
+      if (SlotCursor < Slots.size())
+        slot = dynamic_cast<Slot<T>*>(Slots[SlotCursor]);
+      if (!slot) Mismatch();
+      value = slot->Value;
+      SlotCursor++;
+    }
+  }
+
+  /** Saves or restores the elements of an array.
+      @param values the first element of the array.
+      @param n the number of elements. */
+  template <typename T> void Archive(T* values, unsigned int n) {
+    for (unsigned int i=0; i<n; i++) Archive(values[i]);
+  }
+
+private:
+  friend class FGFDMExec;
+
+  struct SlotBase {
+    virtual ~SlotBase() {}
+  };
+
+  template <typename T> struct Slot : public SlotBase {
+    Slot(const T& value) : Value(value) {}
+    T Value;
+  };
+
+  bool Saving;
+  std::vector<double> Scalars;
+  size_t ScalarCursor;
+  std::vector<SlotBase*> Slots;
+  size_t SlotCursor;
+
+  SGSharedPtr<PropertyList> Properties;
+  std::vector<double> PropertyValues;
+
+  // The copy of a snapshot is not supported.
+  FGSnapshot(const FGSnapshot&);
+  FGSnapshot& operator=(const FGSnapshot&);
+
+  void StartSaving(void);
+  void FinishSaving(void);
+  void StartRestoring(void);
+  bool FinishRestoring(void) const;
+  void SaveProperties(PropertyList* list);
+  void RestoreProperties(PropertyList* list, FGPropertyManager* PropertyManager);
+  void Mismatch(void) const;
+  void Clear(void);
+};
+
+} // namespace JSBSim
+
+#endif
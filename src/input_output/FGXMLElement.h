@@ -53,6 +53,8 @@ FORWARD DECLARATIONS
 
 namespace JSBSim {
 
+class FGRandom;
+
 /*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
 CLASS DOCUMENTATION
 %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
@@ -185,6 +187,11 @@ public:
       @return the element name, or the empty string if no name has been set.*/
   const std::string& GetName(void) const {return name;}
 
+  /** Retrieves all the attributes of the element.
+      @return a map of the attribute values indexed by their key. */
+  const std::map<std::string, std::string>& GetAttributes(void) const
+  {return attributes;}
+
   /** Gets a line of data belonging to an element.
       @param i the index of the data line to return (0 by default).
       @return a string representing the data line requested, or the empty string
@@ -331,6 +338,33 @@ public:
   double DisperseValue(Element *e, double val, const std::string& supplied_units="",
                        const std::string& target_units="");
 
+  /** Draws a dispersed value. This is the computation made by DisperseValue()
+      when the dispersions are enabled.
+      @param val the nominal value.
+      @param disp the magnitude of the dispersion.
+      @param type the type of the dispersion: "gaussian", "gaussiansigned",
+                  "uniform" or "uniformsigned".
+      @param random the stream from which the random number is drawn.
+      @return the dispersed value. A string is thrown if the type is unknown. */
+  static double Disperse(double val, double disp, const std::string& type,
+                         FGRandom& random);
+
+  /// Returns true if the string is the name of a dispersion type.
+  static bool IsDispersionType(const std::string& type);
+
+  /** Selects the random numbers from which DisperseValue() draws the
+      dispersions in the calling thread, for the lifetime of the scope. The FDM
+      executive opens a scope with its own stream while it loads a model so that
+      the dispersions are reproduced from its seed. Outside of any scope, the
+      dispersions are drawn from a stream local to the thread. */
+  class DispersionScope {
+  public:
+    DispersionScope(FGRandom* random) : previous(Random) { Random = random; }
+    ~DispersionScope() { Random = previous; }
+  private:
+    FGRandom* previous;
+  };
+
   /** This function sets the value of the parent class attribute to the supplied
       Element pointer.
       @param p pointer to the parent Element. */
@@ -340,6 +374,11 @@ public:
   *   @param el Child element to add. */
   void AddChildElement(Element* el) {children.push_back(el);}
 
+  /** Determines if an element is one of the children of this element.
+  *   @param el the element to look for.
+  *   @return true if el is a child of this element. */
+  bool HasChildElement(const Element* el) const;
+
   /** Stores an attribute belonging to this element.
   *   @param name The string name of the attribute.
   *   @param value The string value of the attribute. */
@@ -390,8 +429,10 @@ private:
   std::string file_name;
   int line_number;
   typedef std::map <std::string, std::map <std::string, double> > tMapConvert;
-  static tMapConvert convert;
-  static bool converterIsInitialized;
+  static const tMapConvert convert;
+  static thread_local FGRandom* Random;
+
+  static tMapConvert InitConverter(void);
 };
 
 } // namespace JSBSim
@@ -32,12 +32,17 @@ INCLUDES
 #include <iomanip>
 #include <cstdlib>
 #include <cmath>
+#include <algorithm>
 
 #include "FGFunction.h"
 #include "FGTable.h"
 #include "FGPropertyValue.h"
 #include "FGRealValue.h"
+#include "FGRandom.h"
+#include "FGFunctionOptimizer.h"
 #include "input_output/FGXMLElement.h"
+#include "FGFDMExec.h"
+#include "input_output/FGSnapshot.h"
 
 using namespace std;
 
@@ -108,8 +113,26 @@ const std::string FGFunction::ifthen_string = "ifthen";
 const std::string FGFunction::switch_string = "switch";
 const std::string FGFunction::interpolate1d_string = "interpolate1d";
 
-FGFunction::FGFunction(FGPropertyManager* propMan, Element* el, const string& prefix)
-                                      : PropertyManager(propMan), Prefix(prefix)
+FGFunction::FGFunction(FGFDMExec* fdmex, Element* el, const string& prefix)
+  : FGFunction(fdmex->GetPropertyManager(), fdmex->GetRandom("functions"),
+               false, el, prefix)
+{
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+FGFunction::FGFunction(FGPropertyManager* propMan, Element* el,
+                       const string& prefix)
+  : FGFunction(propMan, new FGRandom(0, "functions"), true, el, prefix)
+{
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+FGFunction::FGFunction(FGPropertyManager* propMan, FGRandom* random,
+                       bool ownRandom, Element* el, const string& prefix)
+  : PropertyManager(propMan), OwnedRandom(ownRandom ? random : 0),
+    Random(random), Prefix(prefix)
 {
   Element* element;
   string operation, property_name;
@@ -117,6 +140,13 @@ FGFunction::FGFunction(FGPropertyManager* propMan, Element* el, const string& pr
   cachedValue = -HUGE_VAL;
   invlog2val = 1.0/log10(2.0);
   pCopyTo = 0L;
+  StackSize = 0;
+  FoldedNodes = 0;
+  Folding = false;
+  useProgram = false;
+  Substitutes = 0;
+  Dependencies = 0;
+  lastValue = 0.0;
 
   Name = el->GetAttributeValue("name");
   operation = el->GetName();
@@ -316,7 +346,8 @@ FGFunction::FGFunction(FGPropertyManager* propMan, Element* el, const string& pr
                operation == switch_string ||
                operation == interpolate1d_string)
     {
-      Parameters.push_back(new FGFunction(PropertyManager, element, Prefix));
+      Parameters.push_back(new FGFunction(PropertyManager, Random, false,
+                                          element, Prefix));
     } else if (operation != description_string) {
       cerr << "Bad operation " << operation << " detected in configuration file" << endl;
     }
@@ -325,6 +356,23 @@ FGFunction::FGFunction(FGPropertyManager* propMan, Element* el, const string& pr
 
   bind(); // Allow any function to save its value
 
+  // Only the functions that can be evaluated by other means than their parent
+  // function need to be compiled.
+  if (Type == eTopLevel || !Name.empty()) {
+    Compile();
+
+    char* tree = getenv("JSBSIM_FUNCTION_TREE");
+    if (tree && atoi(tree) != 0) useProgram = false;
+
+    if (FGPropertyDependencies::IsEnabled()) {
+      Dependencies = new FGPropertyDependencies;
+      if (!GetDependencies(this, *Dependencies)) {
+        delete Dependencies;
+        Dependencies = 0;
+      }
+    }
+  }
+
   Debug(0);
 }
 
@@ -333,6 +381,7 @@ FGFunction::FGFunction(FGPropertyManager* propMan, Element* el, const string& pr
 FGFunction::~FGFunction(void)
 {
   for (unsigned int i=0; i<Parameters.size(); i++) delete Parameters[i];
+  delete Dependencies;
 }
 
 //%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
@@ -349,6 +398,17 @@ void FGFunction::cacheValue(bool cache)
 
 //%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
 
+void FGFunction::ArchiveState(FGSnapshot& snapshot)
+{
+  snapshot.Archive(cached);
+  snapshot.Archive(cachedValue);
+
+  // The properties have been restored behind the back of the dependencies.
+  if (!snapshot.IsSaving() && Dependencies) Dependencies->Invalidate();
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
 unsigned int FGFunction::GetBinary(double val) const
 {
   val = fabs(val);
@@ -362,13 +422,35 @@ unsigned int FGFunction::GetBinary(double val) const
 //%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
 
 double FGFunction::GetValue(void) const
+{
+  if (cached) return cachedValue;
+
+  if (Dependencies) {
+    if (Dependencies->Changed()) {
+      lastValue = useProgram ? RunProgram() : GetTreeValue();
+      Dependencies->Validate();
+    }
+    if (pCopyTo) pCopyTo->setDoubleValue(lastValue);
+    return lastValue;
+  }
+
+  if (useProgram) {
+    double temp = RunProgram();
+    if (pCopyTo) pCopyTo->setDoubleValue(temp);
+    return temp;
+  }
+
+  return GetTreeValue();
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+double FGFunction::GetTreeValue(void) const
 {
   unsigned int i;
   double scratch;
   double temp=0;
 
-  if (cached) return cachedValue;
-
   if (   Type != eRandom
       && Type != eUrandom
       && Type != ePi      ) temp = Parameters[0]->GetValue();
@@ -479,10 +561,10 @@ double FGFunction::GetValue(void) const
     temp = scratch;
     break;
   case eRandom:
-    temp = GaussianRandomNumber();
+    temp = Random->GetNormal();
     break;
   case eUrandom:
-    temp = -1.0 + (((double)rand()/double(RAND_MAX))*2.0);
+    temp = Random->GetUniformSigned();
     break;
   case ePi:
     temp = M_PI;
@@ -772,6 +854,559 @@ double FGFunction::GetValue(void) const
   return temp;
 }
 
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+// Lowers the tree of parameters into a flat program. Operations are emitted in
+// post-order so that each sub-tree leaves exactly one value on the stack.
+
+void FGFunction::Compile(const SubstitutionMap* substitutes)
+{
+  Program.clear();
+  Constants.clear();
+  Leaves.clear();
+  StackSize = 0;
+  FoldedNodes = 0;
+  Folding = FGFunctionOptimizer::IsEnabled();
+  useProgram = false;
+
+  if (Parameters.empty()) return;
+
+  Substitutes = substitutes;
+  StackSize = CompileNode(this);
+  Substitutes = 0;
+
+  // A function that calls itself back can not be evaluated by its program.
+  if (Program.size() == 1 && Program[0].op == opCall && Leaves[0] == this) {
+    Program.clear();
+    Leaves.clear();
+    StackSize = 0;
+    return;
+  }
+
+  useProgram = true;
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+unsigned int FGFunction::Emit(opCode op, unsigned int arg)
+{
+  Program.push_back(Instruction(op, arg));
+  return Program.size()-1;
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+// A node is constant if its value does not depend on properties, tables or
+// random numbers.
+
+bool FGFunction::IsConstant(const FGParameter* node)
+{
+  if (dynamic_cast<const FGRealValue*>(node)) return true;
+
+  const FGFunction* f = dynamic_cast<const FGFunction*>(node);
+
+  if (!f || f->Type == eTopLevel || f->Type == eRandom || f->Type == eUrandom)
+    return false;
+
+  for (unsigned int i=0; i<f->Parameters.size(); i++)
+    if (!IsConstant(f->Parameters[i])) return false;
+
+  return true;
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+bool FGFunction::GetDependencies(const FGParameter* node, FGPropertyDependencies& deps)
+{
+  if (dynamic_cast<const FGRealValue*>(node)) return true;
+
+  if (const FGPropertyValue* p = dynamic_cast<const FGPropertyValue*>(node)) {
+    if (p->IsLateBound()) return false;
+    deps.Add(p->GetNode());
+    return true;
+  }
+
+  if (const FGTable* t = dynamic_cast<const FGTable*>(node)) {
+    for (int i=0; i<3; i++) {
+      FGPropertyNode* lookup = t->GetLookupProperty(i);
+      if (lookup) deps.Add(lookup);
+    }
+    return true;
+  }
+
+  const FGFunction* f = dynamic_cast<const FGFunction*>(node);
+
+  if (!f || f->Type == eRandom || f->Type == eUrandom) return false;
+
+  for (unsigned int i=0; i<f->Parameters.size(); i++)
+    if (!GetDependencies(f->Parameters[i], deps)) return false;
+
+  return true;
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+// The shared sub-expressions are only referenced by the leaves of the compiled
+// program, either directly or through the programs of nested functions.
+
+void FGFunction::GetSharedExpressions(set<const FGParameter*>& shared) const
+{
+  for (unsigned int i=0; i<Leaves.size(); i++) {
+    if (dynamic_cast<const FGSharedExpression*>(Leaves[i]))
+      shared.insert(Leaves[i]);
+    else if (Leaves[i] != this) {
+      const FGFunction* f = dynamic_cast<const FGFunction*>(Leaves[i]);
+      if (f) f->GetSharedExpressions(shared);
+    }
+  }
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+unsigned int FGFunction::CountNodes(const FGParameter* node)
+{
+  unsigned int count = 1;
+  const FGFunction* f = dynamic_cast<const FGFunction*>(node);
+
+  if (f) {
+    for (unsigned int i=0; i<f->Parameters.size(); i++)
+      count += CountNodes(f->Parameters[i]);
+  }
+
+  return count;
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+// Compiles the n first parameters of the function f and returns the stack size
+// needed to evaluate them.
+
+unsigned int FGFunction::CompileOperands(const FGFunction* f, unsigned int n)
+{
+  unsigned int depth = 0;
+
+  for (unsigned int i=0; i<n; i++)
+    depth = max(depth, i + CompileNode(f->Parameters[i]));
+
+  return depth;
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+// Compiles the node and returns the stack size needed to evaluate it.
+
+unsigned int FGFunction::CompileNode(const FGParameter* node)
+{
+  // The function itself can not be substituted otherwise the substitute would
+  // call the function back.
+  if (Substitutes && node != this) {
+    SubstitutionMap::const_iterator it = Substitutes->find(node);
+    if (it != Substitutes->end()) {
+      Leaves.push_back(it->second);
+      Emit(opCall, Leaves.size()-1);
+      return 1;
+    }
+  }
+
+  const FGFunction* f = dynamic_cast<const FGFunction*>(node);
+
+  if (f && Folding && IsConstant(f)) {
+    try {
+      double value = f->GetValue();
+      Constants.push_back(value);
+      Emit(opConst, Constants.size()-1);
+      FoldedNodes += CountNodes(f) - 1;
+      return 1;
+    } catch (...) {
+      // The exception will be raised again when the function is evaluated.
+    }
+  }
+
+  if (!f) {
+    if (dynamic_cast<const FGRealValue*>(node)) {
+      Constants.push_back(node->GetValue());
+      Emit(opConst, Constants.size()-1);
+    } else {
+      Leaves.push_back(node);
+      if (dynamic_cast<const FGPropertyValue*>(node))
+        Emit(opProperty, Leaves.size()-1);
+      else if (dynamic_cast<const FGTable*>(node))
+        Emit(opTable, Leaves.size()-1);
+      else
+        Emit(opCall, Leaves.size()-1);
+    }
+    return 1;
+  }
+
+  const vector<FGParameter*>& p = f->Parameters;
+  unsigned int n = p.size();
+  unsigned int depth = 0;
+  opCode op = opCall;
+
+  switch (f->Type) {
+  case eTopLevel:
+    if (n > 0) return CompileNode(p[0]);
+    break;
+  case eSum:
+  case eProduct:
+  case eDifference:
+  case eMin:
+  case eMax:
+  case eAvg:
+    if (n == 0) break;
+    switch (f->Type) {
+    case eSum:        op = opSum; break;
+    case eProduct:    op = opProduct; break;
+    case eDifference: op = opDifference; break;
+    case eMin:        op = opMin; break;
+    case eMax:        op = opMax; break;
+    default:          op = opAvg; break;
+    }
+    depth = CompileOperands(f, n);
+    Emit(op, n);
+    return depth;
+  case eSqrt:      op = opSqrt; break;
+  case eToRadians: op = opToRadians; break;
+  case eToDegrees: op = opToDegrees; break;
+  case eExp:       op = opExp; break;
+  case eLog2:      op = opLog2; break;
+  case eLn:        op = opLn; break;
+  case eLog10:     op = opLog10; break;
+  case eAbs:       op = opAbs; break;
+  case eSign:      op = opSign; break;
+  case eSin:       op = opSin; break;
+  case eCos:       op = opCos; break;
+  case eTan:       op = opTan; break;
+  case eASin:      op = opASin; break;
+  case eACos:      op = opACos; break;
+  case eATan:      op = opATan; break;
+  case eFrac:      op = opFrac; break;
+  case eInteger:   op = opInteger; break;
+  case eNOT:       op = opNot; break;
+  case eQuotient:
+  case ePow:
+  case eATan2:
+  case eMod:
+  case eLT:
+  case eLE:
+  case eGT:
+  case eGE:
+  case eEQ:
+  case eNE:
+    if (n < 2) break;
+    switch (f->Type) {
+    case eQuotient: op = opQuotient; break;
+    case ePow:      op = opPow; break;
+    case eATan2:    op = opATan2; break;
+    case eMod:      op = opMod; break;
+    case eLT:       op = opLT; break;
+    case eLE:       op = opLE; break;
+    case eGT:       op = opGT; break;
+    case eGE:       op = opGE; break;
+    case eEQ:       op = opEQ; break;
+    default:        op = opNE; break;
+    }
+    depth = CompileOperands(f, 2);
+    Emit(op);
+    return depth;
+  case eRandom:
+    Emit(opRandom);
+    return 1;
+  case eUrandom:
+    Emit(opUrandom);
+    return 1;
+  case ePi:
+    Constants.push_back(M_PI);
+    Emit(opConst, Constants.size()-1);
+    return 1;
+  case eAND:
+  case eOR:
+    if (n > 0) {
+      vector<unsigned int> jumps;
+      for (unsigned int i=0; i<n; i++) {
+        depth = max(depth, CompileNode(p[i]));
+        if (i < n-1) jumps.push_back(Emit(f->Type == eAND ? opAndJump : opOrJump));
+      }
+      Emit(opToBinary);
+      for (unsigned int i=0; i<jumps.size(); i++) Program[jumps[i]].arg = Program.size();
+      return depth;
+    }
+    break;
+  case eIfThen:
+    if (n == 3) {
+      depth = CompileNode(p[0]);
+      unsigned int jumpElse = Emit(opJumpIfFalse);
+      depth = max(depth, CompileNode(p[1]));
+      unsigned int jumpEnd = Emit(opJump);
+      Program[jumpElse].arg = Program.size();
+      depth = max(depth, CompileNode(p[2]));
+      Program[jumpEnd].arg = Program.size();
+      return depth;
+    }
+    break;
+  case eSwitch:
+    if (n > 0) {
+      vector<unsigned int> jumps;
+      depth = CompileNode(p[0]);
+      unsigned int table = Emit(opSwitch, n-1) + 1;
+      for (unsigned int i=1; i<n; i++) Emit(opJump);
+      for (unsigned int i=1; i<n; i++) {
+        Program[table+i-1].arg = Program.size();
+        depth = max(depth, CompileNode(p[i]));
+        jumps.push_back(Emit(opJump));
+      }
+      for (unsigned int i=0; i<jumps.size(); i++) Program[jumps[i]].arg = Program.size();
+      return depth;
+    }
+    break;
+  case eInterpolate1D:
+    if (n >= 5) {
+      depth = CompileOperands(f, n);
+      Emit(opInterpolate1D, n);
+      return depth;
+    }
+    break;
+  default:
+    break;
+  }
+
+  // Unary operations only evaluate their first parameter.
+  if (op != opCall && n > 0) {
+    depth = CompileNode(p[0]);
+    Emit(op);
+    return depth;
+  }
+
+  // The operation is not supported by the stack machine: evaluate the
+  // sub-function itself.
+  Leaves.push_back(f);
+  Emit(opCall, Leaves.size()-1);
+  return 1;
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+double FGFunction::RunProgram(void) const
+{
+  double buffer[32];
+  vector<double> heap;
+  double* stack = buffer;
+  double scratch;
+
+  if (StackSize > 32) {
+    heap.resize(StackSize);
+    stack = &heap[0];
+  }
+
+  double* sp = stack; // Points to the first free slot of the stack
+  double* a;
+  unsigned int i, pc = 0;
+  const unsigned int size = Program.size();
+
+  while (pc < size) {
+    const Instruction& ins = Program[pc++];
+
+    switch (ins.op) {
+    case opConst:
+      *sp++ = Constants[ins.arg];
+      break;
+    case opProperty:
+      *sp++ = static_cast<const FGPropertyValue*>(Leaves[ins.arg])->FGPropertyValue::GetValue();
+      break;
+    case opTable:
+      *sp++ = static_cast<const FGTable*>(Leaves[ins.arg])->FGTable::GetValue();
+      break;
+    case opCall:
+      *sp++ = Leaves[ins.arg]->GetValue();
+      break;
+    case opSum:
+      sp -= ins.arg;
+      for (i=1; i<ins.arg; i++) sp[0] += sp[i];
+      sp++;
+      break;
+    case opProduct:
+      sp -= ins.arg;
+      for (i=1; i<ins.arg; i++) sp[0] *= sp[i];
+      sp++;
+      break;
+    case opDifference:
+      sp -= ins.arg;
+      for (i=1; i<ins.arg; i++) sp[0] -= sp[i];
+      sp++;
+      break;
+    case opMin:
+      sp -= ins.arg;
+      for (i=1; i<ins.arg; i++) if (sp[i] < sp[0]) sp[0] = sp[i];
+      sp++;
+      break;
+    case opMax:
+      sp -= ins.arg;
+      for (i=1; i<ins.arg; i++) if (sp[i] > sp[0]) sp[0] = sp[i];
+      sp++;
+      break;
+    case opAvg:
+      sp -= ins.arg;
+      for (i=1; i<ins.arg; i++) sp[0] += sp[i];
+      sp[0] /= ins.arg;
+      sp++;
+      break;
+    case opQuotient:
+      --sp;
+      if (sp[0] != 0.0) sp[-1] /= sp[0];
+      else sp[-1] = HUGE_VAL;
+      break;
+    case opPow:
+      --sp;
+      sp[-1] = pow(sp[-1], sp[0]);
+      break;
+    case opATan2:
+      --sp;
+      sp[-1] = atan2(sp[-1], sp[0]);
+      break;
+    case opMod:
+      --sp;
+      sp[-1] = ((int)sp[-1]) % ((int)sp[0]);
+      break;
+    case opLT:
+      --sp;
+      sp[-1] = (sp[-1] < sp[0])?1:0;
+      break;
+    case opLE:
+      --sp;
+      sp[-1] = (sp[-1] <= sp[0])?1:0;
+      break;
+    case opGT:
+      --sp;
+      sp[-1] = (sp[-1] > sp[0])?1:0;
+      break;
+    case opGE:
+      --sp;
+      sp[-1] = (sp[-1] >= sp[0])?1:0;
+      break;
+    case opEQ:
+      --sp;
+      sp[-1] = (sp[-1] == sp[0])?1:0;
+      break;
+    case opNE:
+      --sp;
+      sp[-1] = (sp[-1] != sp[0])?1:0;
+      break;
+    case opSqrt:
+      sp[-1] = sqrt(sp[-1]);
+      break;
+    case opToRadians:
+      sp[-1] *= M_PI/180.0;
+      break;
+    case opToDegrees:
+      sp[-1] *= 180.0/M_PI;
+      break;
+    case opExp:
+      sp[-1] = exp(sp[-1]);
+      break;
+    case opLog2:
+      if (sp[-1] > 0.00) sp[-1] = log10(sp[-1])*invlog2val;
+      else sp[-1] = -HUGE_VAL;
+      break;
+    case opLn:
+      if (sp[-1] > 0.00) sp[-1] = log(sp[-1]);
+      else sp[-1] = -HUGE_VAL;
+      break;
+    case opLog10:
+      if (sp[-1] > 0.00) sp[-1] = log10(sp[-1]);
+      else sp[-1] = -HUGE_VAL;
+      break;
+    case opAbs:
+      sp[-1] = fabs(sp[-1]);
+      break;
+    case opSign:
+      sp[-1] = sp[-1] < 0 ? -1:1; // 0.0 counts as positive.
+      break;
+    case opSin:
+      sp[-1] = sin(sp[-1]);
+      break;
+    case opCos:
+      sp[-1] = cos(sp[-1]);
+      break;
+    case opTan:
+      sp[-1] = tan(sp[-1]);
+      break;
+    case opASin:
+      sp[-1] = asin(sp[-1]);
+      break;
+    case opACos:
+      sp[-1] = acos(sp[-1]);
+      break;
+    case opATan:
+      sp[-1] = atan(sp[-1]);
+      break;
+    case opFrac:
+      sp[-1] = modf(sp[-1], &scratch);
+      break;
+    case opInteger:
+      modf(sp[-1], &scratch);
+      sp[-1] = scratch;
+      break;
+    case opRandom:
+      *sp++ = Random->GetNormal();
+      break;
+    case opUrandom:
+      *sp++ = Random->GetUniformSigned();
+      break;
+    case opToBinary:
+      sp[-1] = (GetBinary(sp[-1]) != 0) ? 1 : 0;
+      break;
+    case opNot:
+      sp[-1] = (GetBinary(sp[-1]) != 0) ? 0 : 1;
+      break;
+    case opAndJump:
+      if (GetBinary(sp[-1]) == 0) {
+        sp[-1] = 0;
+        pc = ins.arg;
+      } else
+        --sp;
+      break;
+    case opOrJump:
+      if (GetBinary(sp[-1]) != 0) {
+        sp[-1] = 1;
+        pc = ins.arg;
+      } else
+        --sp;
+      break;
+    case opJumpIfFalse:
+      --sp;
+      if (GetBinary(*sp) != 1) pc = ins.arg;
+      break;
+    case opJump:
+      pc = ins.arg;
+      break;
+    case opSwitch:
+      --sp;
+      i = int(*sp+0.5);
+      if (i < ins.arg) {
+        pc += i; // Jump to the i-th entry of the jump table.
+      } else {
+        throw(string("The switch function index selected a value above the range of supplied values"
+                     " - not enough values were supplied."));
+      }
+      break;
+    case opInterpolate1D:
+      a = sp - ins.arg;
+      if (a[0] <= a[1]) {
+        a[0] = a[2];
+      } else if (a[0] >= a[ins.arg-2]) {
+        a[0] = a[ins.arg-1];
+      } else {
+        for (i=1; i<=ins.arg-4; i+=2) {
+          if (a[0] < a[i+2]) {
+            double factor = (a[0] - a[i]) / (a[i+2] - a[i]);
+            a[0] = a[i+1] + factor*(a[i+3] - a[i+1]);
+            break;
+          }
+        }
+      }
+      sp = a + 1;
+      break;
+    }
+  }
+
+  return stack[0];
+}
+
 //%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
 
 string FGFunction::GetValueAsString(void) const
@@ -813,6 +1448,7 @@ void FGFunction::bind(void)
       }
     }
     PropertyManager->Tie( tmp, this, &FGFunction::GetValue);
+    pNode = PropertyManager->GetNode(tmp);
   }
 }
 
@@ -36,6 +36,9 @@ INCLUDES
 
 #include <vector>
 #include <string>
+#include <map>
+#include <memory>
+#include <set>
 #include "FGParameter.h"
 #include "input_output/FGPropertyManager.h"
 
@@ -52,6 +55,9 @@ FORWARD DECLARATIONS
 namespace JSBSim {
 
 class Element;
+class FGFDMExec;
+class FGRandom;
+class FGSnapshot;
 
 /*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
 CLASS DOCUMENTATION
@@ -660,6 +666,9 @@ of the three words refers to one or more instances of a property, value, or tabl
 - @b urandom Takes no arguments and returns a uniformly distributed random number
              between -1 and +1
     @code<urandom/>@endcode
+    The random numbers of all the functions are drawn from the stream
+    "functions" of the FDM executive (see FGFDMExec::GetRandom()) so they are
+    reproduced when the simulation is run again with the same seed.
 - @b pi Takes no argument and returns the value of Pi
     @code<pi/>@endcode
 - @b interpolate1d returns the result from a 1-dimensional interpolation of the
@@ -687,6 +696,29 @@ of the three words refers to one or more instances of a property, value, or tabl
        <v> 0.90 </v>  <v> 0.60 </v>
      </interpolate1d>
      @endcode
+
+<h3>Evaluation</h3>
+
+When a top level (or named) function is built, its tree of operations is
+lowered into a flat program that is run by a small stack machine each time
+GetValue() is called. The leaves of the tree (properties, values and tables)
+are referenced directly from the program so the evaluation does not need to
+walk the tree of FGParameter objects through virtual calls. Operations that
+are not supported by the stack machine are evaluated by calling the
+corresponding sub-function. Sub-trees that only involve constant values are
+folded into a single constant when the program is built.
+
+The original tree walking evaluation can be restored for validation purposes
+by setting the environment variable JSBSIM_FUNCTION_TREE to a non zero value
+before the model is loaded, or by calling UseCompiledProgram(false). The
+folding of the constants, as well as the sharing of the sub-expressions by
+FGFunctionOptimizer, is disabled by setting the environment variable
+JSBSIM_FUNCTION_OPTIMIZER to 0 before the model is loaded.
+
+When the tracking of dependencies is enabled (see FGPropertyDependencies), a
+top level function is only evaluated again when one of the properties it
+depends on has changed. Functions that use random numbers or properties that
+are not defined when the function is loaded are evaluated each time.
 @author Jon Berndt
 */
 
@@ -710,12 +742,28 @@ public:
     in turn may each contain its own list, and so on. At runtime, each object
     evaluates its child parameters, which each may have its own child parameters to
     evaluate.
+    @param fdmex a pointer to the FDM executive which property tree and random
+           numbers are used by the function.
+    @param element a pointer to the Element object containing the function definition.
+    @param prefix an optional prefix to prepend to the name given to the property
+           that represents this function (if given).
+*/
+  FGFunction(FGFDMExec* fdmex, Element* element, const std::string& prefix="");
+
+/** Constructor of a function that does not belong to an FDM executive.
+    The random numbers of the function and of its child functions are drawn
+    from a stream of their own, seeded with 0, instead of the stream
+    "functions" of an FDM executive.
+    @deprecated This constructor is kept for the applications that were built
+                against the former interface. Use the constructor that takes
+                the FDM executive instead.
     @param PropertyManager a pointer to the property manager instance.
     @param element a pointer to the Element object containing the function definition.
     @param prefix an optional prefix to prepend to the name given to the property
            that represents this function (if given).
 */
-  FGFunction(FGPropertyManager* PropertyManager, Element* element, const std::string& prefix="");
+  FGFunction(FGPropertyManager* PropertyManager, Element* element,
+             const std::string& prefix="");
   /// Destructor.
   virtual ~FGFunction();
 
@@ -738,9 +786,81 @@ public:
     @param shouldCache specifies whether the function should cache the computed value. */
   void cacheValue(bool shouldCache);
 
+/** Saves the value cached for the current frame to a snapshot or restores it
+    from a snapshot.
+    @param snapshot the snapshot. */
+  void ArchiveState(FGSnapshot& snapshot);
+
+/** Specifies whether the function is evaluated from its compiled program or
+    by walking its tree of parameters.
+    @param use true to evaluate the compiled program (default), false to walk
+           the tree of parameters. */
+  void UseCompiledProgram(bool use) { useProgram = use && !Program.empty(); }
+
+/// Returns true if the function is evaluated from its compiled program.
+  bool IsCompiled(void) const { return useProgram; }
+
+/// Returns the number of instructions of the compiled program.
+  unsigned int GetProgramSize(void) const { return Program.size(); }
+
+/// Returns the number of nodes that have been folded into constants.
+  unsigned int GetNumFoldedNodes(void) const { return FoldedNodes; }
+
+/// Maps the nodes of a function to the nodes that replace them in its program.
+  typedef std::map<const FGParameter*, const FGParameter*> SubstitutionMap;
+
+/** Collects the properties which the value of a parameter depends on.
+    @param node the parameter.
+    @param deps the set of dependencies to which the properties are added.
+    @return false if the value can change while the properties are unchanged
+            i.e. if it uses random numbers or properties that are not bound. */
+  static bool GetDependencies(const FGParameter* node, FGPropertyDependencies& deps);
+
+/** Collects the sub-expressions shared with other functions (see
+    FGFunctionOptimizer) that the program of the function evaluates.
+    @param shared the set to which the shared sub-expressions are added. */
+  void GetSharedExpressions(std::set<const FGParameter*>& shared) const;
+
+/// Returns the property to which the function is bound (NULL if unnamed).
+  FGPropertyNode* GetBoundProperty(void) const { return pNode; }
+
+/// Returns the property to which the value of the function is copied (if any).
+  FGPropertyNode* GetCopyToProperty(void) const { return pCopyTo; }
+
 private:
+  /// Op codes of the stack machine that evaluates compiled functions.
+  enum opCode {opConst=0, opProperty, opTable, opCall, opSum, opProduct,
+               opDifference, opQuotient, opPow, opSqrt, opToRadians,
+               opToDegrees, opExp, opLog2, opLn, opLog10, opAbs, opSign, opSin,
+               opCos, opTan, opASin, opACos, opATan, opATan2, opMin, opMax,
+               opAvg, opFrac, opInteger, opMod, opRandom, opUrandom, opLT, opLE,
+               opGT, opGE, opEQ, opNE, opToBinary, opNot, opAndJump, opOrJump,
+               opJumpIfFalse, opJump, opSwitch, opInterpolate1D};
+
+  struct Instruction {
+    opCode op;
+    unsigned int arg;
+
+    Instruction(opCode _op, unsigned int _arg = 0) : op(_op), arg(_arg) {}
+  };
+
+  FGFunction(FGPropertyManager* propMan, FGRandom* random, bool ownRandom,
+             Element* element, const std::string& prefix);
+
   std::vector <FGParameter*> Parameters;
+  std::vector <Instruction> Program;
+  std::vector <double> Constants;
+  std::vector <const FGParameter*> Leaves;
+  unsigned int StackSize;
+  unsigned int FoldedNodes;
+  bool Folding;
+  bool useProgram;
+  const SubstitutionMap* Substitutes;
+  FGPropertyDependencies* Dependencies;
+  mutable double lastValue;
   FGPropertyManager* const PropertyManager;
+  std::unique_ptr<FGRandom> OwnedRandom;
+  FGRandom* const Random;
   bool cached;
   double invlog2val;
   std::string Prefix;
@@ -810,10 +930,21 @@ private:
   std::string Name;
   std::string sCopyTo;        // Property name to copy function value to
   FGPropertyNode_ptr pCopyTo; // Property node for CopyTo property string
+  FGPropertyNode_ptr pNode;   // Property node to which the function is bound
 
   unsigned int GetBinary(double) const;
+  double GetTreeValue(void) const;
+  double RunProgram(void) const;
+  void Compile(const SubstitutionMap* substitutes = 0);
+  unsigned int CompileNode(const FGParameter* node);
+  unsigned int CompileOperands(const FGFunction* f, unsigned int n);
+  unsigned int Emit(opCode op, unsigned int arg = 0);
+  static bool IsConstant(const FGParameter* node);
+  static unsigned int CountNodes(const FGParameter* node);
   void bind(void);
   void Debug(int from);
+
+  friend class FGFunctionOptimizer;
 };
 
 } // namespace JSBSim
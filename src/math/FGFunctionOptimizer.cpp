@@ -0,0 +1,275 @@
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+Module: FGFunctionOptimizer.cpp
+Date started: January 2016
+Purpose: Merges the identical sub-expressions of the model functions
+
+ ------------- Copyright (C) 2016  JSBSim development team  -------------
+
+ This program is free software; you can redistribute it and/or modify it under
+ the terms of the GNU Lesser General Public License as published by the Free Software
+ Foundation; either version 2 of the License, or (at your option) any later
+ version.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ details.
+
+ You should have received a copy of the GNU Lesser General Public License along with
+ this program; if not, write to the Free Software Foundation, Inc., 59 Temple
+ Place - Suite 330, Boston, MA  02111-1307, USA.
+
+ Further information about the GNU Lesser General Public License can also be found on
+ the world wide web at http://www.gnu.org.
+
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+INCLUDES
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+#include <sstream>
+#include <iomanip>
+#include <cstdlib>
+#include "FGFunctionOptimizer.h"
+#include "FGTable.h"
+#include "FGPropertyValue.h"
+#include "FGRealValue.h"
+
+using namespace std;
+
+namespace JSBSim {
+
+IDENT(IdSrc,"$Id$");
+IDENT(IdHdr,ID_FUNCTIONOPTIMIZER);
+
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+CLASS IMPLEMENTATION
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+FGSharedExpression::FGSharedExpression(const FGParameter* node)
+  : Node(node), Value(0.0)
+{
+  // Shared expressions are never random nor late bound (see Analyze) so all
+  // their dependencies can be collected.
+  FGFunction::GetDependencies(node, Dependencies);
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+double FGSharedExpression::GetValue(void) const
+{
+  if (Dependencies.Changed()) {
+    Value = Node->GetValue();
+    Dependencies.Validate();
+  }
+
+  return Value;
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+FGFunctionOptimizer::FGFunctionOptimizer(void)
+  : FoldedNodes(0), MergedNodes(0)
+{
+  Debug(0);
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+FGFunctionOptimizer::~FGFunctionOptimizer()
+{
+  for (unsigned int i=0; i<Shared.size(); i++) delete Shared[i];
+
+  Debug(1);
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+bool FGFunctionOptimizer::IsEnabled(void)
+{
+  char* optimizer = getenv("JSBSIM_FUNCTION_OPTIMIZER");
+  return !optimizer || atoi(optimizer) != 0;
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+void FGFunctionOptimizer::AddFunction(FGFunction* function)
+{
+  if (!function || !function->IsCompiled()) return;
+
+  if (Registered.insert(function).second)
+    Functions.push_back(function);
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+// Builds a signature of the node such that two nodes with the same signature
+// always return the same value. The nodes that are worth sharing are recorded
+// in Candidates.
+
+FGFunctionOptimizer::NodeInfo FGFunctionOptimizer::Analyze(const FGParameter* node)
+{
+  NodeInfo info;
+  ostringstream buf;
+
+  info.size = 1;
+  info.pure = true;
+  info.table = false;
+
+  if (const FGRealValue* v = dynamic_cast<const FGRealValue*>(node)) {
+    buf << "v(" << setprecision(17) << v->GetValue() << ")";
+  } else if (const FGPropertyValue* p = dynamic_cast<const FGPropertyValue*>(node)) {
+    // Properties that are not bound yet may resolve to a different node later.
+    info.pure = !p->IsLateBound();
+    buf << "p(" << p->GetNode() << "," << p->GetSign() << ")";
+  } else if (const FGTable* t = dynamic_cast<const FGTable*>(node)) {
+    info.table = true;
+    buf << "t(" << t->GetSignature() << ")";
+    Candidates[buf.str()].push_back(node);
+  } else if (const FGFunction* f = dynamic_cast<const FGFunction*>(node)) {
+    buf << "f" << f->Type << "(";
+    for (unsigned int i=0; i<f->Parameters.size(); i++) {
+      NodeInfo child = Analyze(f->Parameters[i]);
+      buf << child.signature << ",";
+      info.size += child.size;
+      info.pure = info.pure && child.pure;
+      info.table = info.table || child.table;
+    }
+    buf << ")";
+
+    if (f->Type == FGFunction::eRandom || f->Type == FGFunction::eUrandom)
+      info.pure = false;
+
+    // Top level functions are the ones registered by the models: they can be
+    // cached or copy their value to a property so they are never merged.
+    if (f->Type == FGFunction::eTopLevel) {
+      info.pure = false;
+      buf << node;
+    } else if (info.pure && !FGFunction::IsConstant(f)
+               && (info.table || info.size >= 4))
+      Candidates[buf.str()].push_back(node);
+  } else {
+    info.pure = false;
+    buf << "?(" << node << ")";
+  }
+
+  info.signature = buf.str();
+  return info;
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+unsigned int FGFunctionOptimizer::Optimize(void)
+{
+  FGFunction::SubstitutionMap substitutes;
+  map<const FGSharedExpression*, unsigned int> size;
+  vector<FGFunction*> representatives;
+  unsigned int i;
+
+  Candidates.clear();
+  for (i=0; i<Functions.size(); i++)
+    Analyze(Functions[i]);
+
+  map<string, vector<const FGParameter*> >::const_iterator it;
+  for (it = Candidates.begin(); it != Candidates.end(); ++it) {
+    const vector<const FGParameter*>& nodes = it->second;
+    if (nodes.size() < 2) continue;
+
+    FGSharedExpression* expression = new FGSharedExpression(nodes[0]);
+    Shared.push_back(expression);
+    size[expression] = FGFunction::CountNodes(nodes[0]);
+
+    for (unsigned int j=0; j<nodes.size(); j++)
+      substitutes[nodes[j]] = expression;
+
+    const FGFunction* f = dynamic_cast<const FGFunction*>(nodes[0]);
+    if (f) representatives.push_back(const_cast<FGFunction*>(f));
+  }
+
+  Candidates.clear();
+
+  // The representatives are compiled so that the shared expressions nested in
+  // them are also evaluated once.
+  for (i=0; i<representatives.size(); i++)
+    representatives[i]->Compile(&substitutes);
+
+  FoldedNodes = 0;
+  for (i=0; i<Functions.size(); i++) {
+    Functions[i]->Compile(&substitutes);
+    FoldedNodes += Functions[i]->GetNumFoldedNodes();
+  }
+
+  // Each reference to a shared expression beyond the first one removes the
+  // nodes of the sub-expression from the evaluation. Duplicates nested in a
+  // merged sub-expression are not referenced any more and are not counted
+  // twice.
+  map<const FGParameter*, unsigned int> references;
+  vector<FGFunction*> programs(Functions);
+  programs.insert(programs.end(), representatives.begin(), representatives.end());
+
+  for (i=0; i<programs.size(); i++) {
+    const vector<const FGParameter*>& leaves = programs[i]->Leaves;
+    for (unsigned int j=0; j<leaves.size(); j++)
+      references[leaves[j]]++;
+  }
+
+  MergedNodes = 0;
+  for (i=0; i<Shared.size(); i++) {
+    unsigned int count = references[Shared[i]];
+    if (count > 1) MergedNodes += (count-1)*size[Shared[i]];
+  }
+
+  Debug(2);
+
+  return FoldedNodes + MergedNodes;
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+//    The bitmasked value choices are as follows:
+//    unset: In this case (the default) JSBSim would only print
+//       out the normally expected messages, essentially echoing
+//       the config files as they are read. If the environment
+//       variable is not set, debug_lvl is set to 1 internally
+//    0: This requests JSBSim not to output any messages
+//       whatsoever.
+//    1: This value explicity requests the normal JSBSim
+//       startup messages
+//    2: This value asks for a message to be printed out when
+//       a class is instantiated
+//    4: When this value is set, a message is displayed when a
+//       FGModel object executes its Run() method
+//    8: When this value is set, various runtime state variables
+//       are printed out periodically
+//    16: When set various parameters are sanity checked and
+//       a message is printed out when they go out of bounds
+
+void FGFunctionOptimizer::Debug(int from)
+{
+  if (debug_lvl <= 0) return;
+
+  if (debug_lvl & 1) { // Standard console startup message output
+    if (from == 2) { // Optimize
+      cout << endl << "  Function optimizer: " << FoldedNodes
+           << " constant nodes folded, " << MergedNodes
+           << " nodes merged into " << Shared.size()
+           << " shared expressions" << endl;
+    }
+  }
+  if (debug_lvl & 2 ) { // Instantiation/Destruction notification
+    if (from == 0) cout << "Instantiated: FGFunctionOptimizer" << endl;
+    if (from == 1) cout << "Destroyed:    FGFunctionOptimizer" << endl;
+  }
+  if (debug_lvl & 4 ) { // Run() method entry print for FGModel-derived objects
+  }
+  if (debug_lvl & 8 ) { // Runtime state variables
+  }
+  if (debug_lvl & 16) { // Sanity checking
+  }
+  if (debug_lvl & 64) {
+    if (from == 0) { // Constructor
+      cout << IdSrc << endl;
+      cout << IdHdr << endl;
+    }
+  }
+}
+
+}
@@ -0,0 +1,160 @@
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+Header: FGFunctionOptimizer.h
+Date started: January 2016
+
+ ------------- Copyright (C) 2016  JSBSim development team  -------------
+
+ This program is free software; you can redistribute it and/or modify it under
+ the terms of the GNU Lesser General Public License as published by the Free Software
+ Foundation; either version 2 of the License, or (at your option) any later
+ version.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ details.
+
+ You should have received a copy of the GNU Lesser General Public License along with
+ this program; if not, write to the Free Software Foundation, Inc., 59 Temple
+ Place - Suite 330, Boston, MA  02111-1307, USA.
+
+ Further information about the GNU Lesser General Public License can also be found on
+ the world wide web at http://www.gnu.org.
+
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+SENTRY
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+#ifndef FGFUNCTIONOPTIMIZER_H
+#define FGFUNCTIONOPTIMIZER_H
+
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+INCLUDES
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+#include <vector>
+#include <string>
+#include <map>
+#include <set>
+#include "FGFunction.h"
+
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+DEFINITIONS
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+#define ID_FUNCTIONOPTIMIZER "$Id$"
+
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+FORWARD DECLARATIONS
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+namespace JSBSim {
+
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+CLASS DOCUMENTATION
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+/** Represents a sub-expression shared by several functions.
+    The sub-expression is only evaluated when one of the properties it depends
+    on has changed since its last evaluation. Otherwise the value computed at
+    the previous evaluation is returned.
+*/
+
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+DECLARATION: FGSharedExpression
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+class FGSharedExpression : public FGParameter
+{
+public:
+  /** Constructor.
+      @param node the node that evaluates the sub-expression. */
+  FGSharedExpression(const FGParameter* node);
+
+  double GetValue(void) const;
+  std::string GetName(void) const { return Node->GetName(); }
+
+private:
+  const FGParameter* Node;
+  mutable FGPropertyDependencies Dependencies;
+  mutable double Value;
+};
+
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+CLASS DOCUMENTATION
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+/** Optimizes the functions of an aircraft model at load time.
+    The models register their functions to the optimizer which then looks for
+    the sub-expressions that are structurally identical (same operations, same
+    properties, same values and same table data) across all the registered
+    functions. Each set of identical sub-expressions is replaced by a single
+    FGSharedExpression which is evaluated once for all the functions that use
+    it.
+
+    Only the sub-expressions that are worth sharing are merged: tables and
+    operations that involve a table or at least 4 nodes. Sub-expressions that
+    use random numbers or properties that are not yet defined when the model is
+    loaded are never shared.
+
+    The constant sub-expressions are folded by FGFunction itself when its
+    program is compiled, the optimizer only reports the number of nodes that
+    have been folded.
+*/
+
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+DECLARATION: FGFunctionOptimizer
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+class FGFunctionOptimizer : public FGJSBBase
+{
+public:
+  /// Constructor
+  FGFunctionOptimizer(void);
+  /// Destructor
+  ~FGFunctionOptimizer();
+
+  /** Registers a function to the optimizer.
+      @param function a pointer to the function. Functions that are not
+                      compiled are ignored. */
+  void AddFunction(FGFunction* function);
+
+  /** Merges the identical sub-expressions of the registered functions.
+      @return the number of nodes that have been removed from the programs of
+              the registered functions. */
+  unsigned int Optimize(void);
+
+  /// Returns the number of nodes removed by constant folding.
+  unsigned int GetNumFoldedNodes(void) const { return FoldedNodes; }
+  /// Returns the number of nodes removed by merging identical sub-expressions.
+  unsigned int GetNumMergedNodes(void) const { return MergedNodes; }
+  /// Returns the number of shared sub-expressions.
+  unsigned int GetNumSharedExpressions(void) const { return Shared.size(); }
+
+  /** Returns false if the optimization of the functions has been disabled by
+      setting the environment variable JSBSIM_FUNCTION_OPTIMIZER to 0. */
+  static bool IsEnabled(void);
+
+private:
+  struct NodeInfo {
+    std::string signature;
+    unsigned int size;
+    bool pure;
+    bool table;
+  };
+
+  std::vector<FGFunction*> Functions;
+  std::set<FGFunction*> Registered;
+  std::vector<FGSharedExpression*> Shared;
+  std::map<std::string, std::vector<const FGParameter*> > Candidates;
+  unsigned int FoldedNodes;
+  unsigned int MergedNodes;
+
+  NodeInfo Analyze(const FGParameter* node);
+  void Debug(int from);
+};
+
+} // namespace JSBSim
+
+#endif
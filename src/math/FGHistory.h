@@ -0,0 +1,110 @@
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+ Header:       FGHistory.h
+ Date started: May 2016
+
+ ------------- Copyright (C) 2016  JSBSim development team  -------------
+
+ This program is free software; you can redistribute it and/or modify it under
+ the terms of the GNU Lesser General Public License as published by the Free Software
+ Foundation; either version 2 of the License, or (at your option) any later
+ version.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ details.
+
+ You should have received a copy of the GNU Lesser General Public License along with
+ this program; if not, write to the Free Software Foundation, Inc., 59 Temple
+ Place - Suite 330, Boston, MA  02111-1307, USA.
+
+ Further information about the GNU Lesser General Public License can also be found on
+ the world wide web at http://www.gnu.org.
+
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+SENTRY
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+#ifndef FGHISTORY_H
+#define FGHISTORY_H
+
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+INCLUDES
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+DEFINITIONS
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+#define ID_HISTORY "$Id$"
+
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+FORWARD DECLARATIONS
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+namespace JSBSim {
+
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+CLASS DOCUMENTATION
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+/** Stores the N last values of a variable, such as the past derivatives used
+    by the multistep integrators.
+    The values are stored in a circular buffer of fixed size: pushing a new
+    value overwrites the oldest one and never allocates memory. Since the
+    buffer is a plain array, a history is copied (for instance to a snapshot)
+    without any allocation either.
+
+    The index 0 refers to the most recent value, the index 1 to the value
+    before it and so on up to N-1.
+    @code
+    FGHistory<FGColumnVector3, 5> dqValDot;
+    dqValDot.assign(FGColumnVector3());
+    dqValDot.push(ValDot);
+    Val += dt*(1.5*dqValDot[0] - 0.5*dqValDot[1]);
+    @endcode
+ */
+
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+CLASS DECLARATION
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+template <typename T, unsigned int N>
+class FGHistory
+{
+public:
+  /// Constructor. The values are default constructed.
+  FGHistory(void) : Newest(0) {}
+
+  /// Returns the number of values stored in the history.
+  static unsigned int size(void) { return N; }
+
+  /// Sets all the values of the history to the same value.
+  void assign(const T& value) {
+    for (unsigned int i=0; i<N; i++) Values[i] = value;
+    Newest = 0;
+  }
+
+  /** Adds a value to the history. The oldest value is discarded.
+      @param value the new value which is then accessed with the index 0. */
+  void push(const T& value) {
+    Newest = Newest ? Newest-1 : N-1;
+    Values[Newest] = value;
+  }
+
+  /** Accesses a value of the history.
+      @param i the age of the value: 0 for the most recent one. */
+  const T& operator[](unsigned int i) const {
+    unsigned int idx = Newest + i;
+    return Values[idx < N ? idx : idx - N];
+  }
+
+private:
+  T Values[N];
+  unsigned int Newest;
+};
+
+} // namespace JSBSim
+
+#endif
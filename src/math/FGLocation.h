@@ -45,7 +45,6 @@ INCLUDES
 #include "FGJSBBase.h"
 #include "FGColumnVector3.h"
 #include "FGMatrix33.h"
-#include "input_output/FGGroundCallback.h"
 
 /*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
 DEFINITIONS
@@ -322,87 +321,6 @@ public:
   //double GetRadius() const { return mECLoc.Magnitude(); } // may not work with FlightGear
   double GetRadius() const { ComputeDerived(); return mRadius; }
 
-  /** @name Functions that rely on the ground callback
-      The following functions allow to set and get the vehicle position above
-      the sea or the ground. The sea and the ground levels are obtained by
-      interrogating an FGGroundCallback instance. A ground callback must
-      therefore be set with SetGroundCallback() before calling any of these
-      functions. */
-  ///@{
-  /** Set the altitude above sea level.
-      @param altitudeASL altitude above Sea Level in feet.
-      @see SetGroundCallback */
-  void SetAltitudeASL(double altitudeASL)
-  { SetRadius(GetSeaLevelRadius() + altitudeASL); }
-
-  /** Set the altitude above ground level.
-      @param altitudeAGL altitude above Ground Level in feet.
-      @see SetGroundCallback */
-  void SetAltitudeAGL(double altitudeAGL)
-  { SetRadius(GetTerrainRadius() + altitudeAGL); }
-
-  /** Get the local sea level radius
-      @return the sea level radius at the location in feet.
-      @see SetGroundCallback */
-  double GetSeaLevelRadius(void) const
-  { ComputeDerived(); return GroundCallback->GetSeaLevelRadius(*this); }
-
-  /** Get the local terrain radius
-      @return the terrain level radius at the location in feet.
-      @see SetGroundCallback */
-  double GetTerrainRadius(void) const
-  { ComputeDerived(); return GroundCallback->GetTerrainGeoCentRadius(*this); }
-
-  /** Get the altitude above sea level.
-      @return the altitude ASL in feet.
-      @see SetGroundCallback */
-  double GetAltitudeASL(void) const
-  { ComputeDerived(); return GroundCallback->GetAltitude(*this); }
-
-  /** Get the altitude above ground level.
-      @return the altitude AGL in feet.
-      @see SetGroundCallback */
-  double GetAltitudeAGL(void) const {
-    FGLocation c;
-    FGColumnVector3 n,v,w;
-    return GetContactPoint(c,n,v,w);
-  }
-
-  /** Get terrain contact point information below the current location.
-      @param contact Contact point location
-      @param normal  Terrain normal vector in contact point    (ECEF frame)
-      @param v       Terrain linear velocity in contact point  (ECEF frame)
-      @param w       Terrain angular velocity in contact point (ECEF frame)
-      @return Location altitude above contact point (AGL) in feet.
-      @see SetGroundCallback */
-  double GetContactPoint(FGLocation& contact, FGColumnVector3& normal,
-                         FGColumnVector3& v, FGColumnVector3& w) const
-  { ComputeDerived(); return GroundCallback->GetAGLevel(*this, contact, normal, v, w); }
-  ///@}
-
-  /** Sets the ground callback pointer. The FGGroundCallback instance will be
-      interrogated by FGLocation each time some terrain informations are needed.
-      This will mainly occur when altitudes above the sea level or above the
-      ground level are needed. A 'smart pointer' is used internally to prevent
-      the FGGroundCallback instance against accidental deletion. This can only
-      work if the calling application also make use of FGGroundCallback_ptr
-      'smart pointers' to manage their copy of the ground callback.
-      @param gc A pointer to a ground callback object
-      @see FGGroundCallback
-   */
-  static void SetGroundCallback(FGGroundCallback* gc) { GroundCallback = gc; }
-
-  /** Get a pointer to the ground callback currently used. Since the
-      FGGroundcallback instance might have been created outside JSBSim, it is
-      recommanded to store the returned pointer in a 'smart pointer'
-      FGGroundCallback_ptr. This pointer maintains a reference counter and
-      protects the returned pointer against an accidental deletion of the object
-      it is pointing to.
-      @return A pointer to the current ground callback object.
-      @see FGGroundCallback
-   */
-  static FGGroundCallback* GetGroundCallback(void) { return GroundCallback; }
-
   /** Transform matrix from local horizontal to earth centered frame.
       @return a const reference to the rotation matrix of the transform from
       the local horizontal frame to the earth centered frame. */
@@ -669,9 +587,6 @@ private:
       The C++ keyword "mutable" tells the compiler that the data member is
       allowed to change during a const member function. */
   mutable bool mCacheValid;
-
-  /** The ground callback object pointer */
-  static FGGroundCallback_ptr GroundCallback;
 };
 
 /** Scalar multiplication.
@@ -43,7 +43,10 @@ INCLUDES
 
 #include "FGModelFunctions.h"
 #include "FGFunction.h"
+#include "FGFunctionOptimizer.h"
 #include "input_output/FGXMLElement.h"
+#include "FGFDMExec.h"
+#include "input_output/FGSnapshot.h"
 
 using namespace std;
 
@@ -75,17 +78,17 @@ bool FGModelFunctions::InitModel(void)
 
 //%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
 
-bool FGModelFunctions::Load(Element* el, FGPropertyManager* PM, string prefix)
+bool FGModelFunctions::Load(Element* el, FGFDMExec* fdmex, string prefix)
 {
-  LocalProperties.Load(el, PM, false);
-  PreLoad(el, PM, prefix);
+  LocalProperties.Load(el, fdmex->GetPropertyManager(), false);
+  PreLoad(el, fdmex, prefix);
 
   return true; // TODO: Need to make this value mean something.
 }
 
 //%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
 
-void FGModelFunctions::PreLoad(Element* el, FGPropertyManager* PM, string prefix)
+void FGModelFunctions::PreLoad(Element* el, FGFDMExec* fdmex, string prefix)
 {
   // Load model post-functions, if any
 
@@ -94,7 +97,7 @@ void FGModelFunctions::PreLoad(Element* el, FGPropertyManager* PM, string prefix
   while (function) {
     string fType = function->GetAttributeValue("type");
     if (fType.empty() || fType == "pre")
-      PreFunctions.push_back(new FGFunction(PM, function, prefix));
+      PreFunctions.push_back(new FGFunction(fdmex, function, prefix));
 
     function = el->FindNextElement("function");
   }
@@ -102,14 +105,14 @@ void FGModelFunctions::PreLoad(Element* el, FGPropertyManager* PM, string prefix
 
 //%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
 
-void FGModelFunctions::PostLoad(Element* el, FGPropertyManager* PM, string prefix)
+void FGModelFunctions::PostLoad(Element* el, FGFDMExec* fdmex, string prefix)
 {
   // Load model post-functions, if any
 
   Element *function = el->FindElement("function");
   while (function) {
     if (function->GetAttributeValue("type") == "post") {
-      PostFunctions.push_back(new FGFunction(PM, function, prefix));
+      PostFunctions.push_back(new FGFunction(fdmex, function, prefix));
     }
     function = el->FindNextElement("function");
   }
@@ -145,6 +148,16 @@ void FGModelFunctions::RunPostFunctions(void)
 
 //%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
 
+void FGModelFunctions::ArchiveState(FGSnapshot& snapshot)
+{
+  for (unsigned int i=0; i<PreFunctions.size(); i++)
+    PreFunctions[i]->ArchiveState(snapshot);
+  for (unsigned int i=0; i<PostFunctions.size(); i++)
+    PostFunctions[i]->ArchiveState(snapshot);
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
 FGFunction* FGModelFunctions::GetPreFunction(const std::string& name)
 {
   FGFunction* result;
@@ -161,6 +174,27 @@ FGFunction* FGModelFunctions::GetPreFunction(const std::string& name)
 
 //%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
 
+void FGModelFunctions::RegisterFunctions(FGFunctionOptimizer& optimizer) const
+{
+  unsigned int i;
+
+  for (i=0; i<PreFunctions.size(); i++)
+    optimizer.AddFunction(PreFunctions[i]);
+
+  for (i=0; i<PostFunctions.size(); i++)
+    optimizer.AddFunction(PostFunctions[i]);
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+void FGModelFunctions::CollectParameters(vector<const FGParameter*>& params) const
+{
+  params.insert(params.end(), PreFunctions.begin(), PreFunctions.end());
+  params.insert(params.end(), PostFunctions.begin(), PostFunctions.end());
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
 string FGModelFunctions::GetFunctionStrings(const string& delimeter) const
 {
   string FunctionStrings = "";
@@ -54,8 +54,12 @@ FORWARD DECLARATIONS
 namespace JSBSim {
 
 class FGFunction;
+class FGFunctionOptimizer;
+class FGParameter;
 class Element;
 class FGPropertyManager;
+class FGFDMExec;
+class FGSnapshot;
 
 /*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
 CLASS DOCUMENTATION
@@ -84,9 +88,9 @@ public:
   virtual ~FGModelFunctions();
   void RunPreFunctions(void);
   void RunPostFunctions(void);
-  bool Load(Element* el, FGPropertyManager* PropertyManager, std::string prefix="");
-  void PreLoad(Element* el, FGPropertyManager* PropertyManager, std::string prefix="");
-  void PostLoad(Element* el, FGPropertyManager* PropertyManager, std::string prefix="");
+  bool Load(Element* el, FGFDMExec* fdmex, std::string prefix="");
+  void PreLoad(Element* el, FGFDMExec* fdmex, std::string prefix="");
+  void PostLoad(Element* el, FGFDMExec* fdmex, std::string prefix="");
 
   /** Gets the strings for the current set of functions.
       @param delimeter either a tab or comma string depending on output type
@@ -105,6 +109,25 @@ public:
    */
   FGFunction* GetPreFunction(const std::string& name);
 
+  /** Registers the functions of the model to the function optimizer.
+      Models that own other functions than the "pre" and "post" functions
+      should override this method to register them as well.
+      @param optimizer the optimizer to which the functions are registered. */
+  virtual void RegisterFunctions(FGFunctionOptimizer& optimizer) const;
+
+  /** Collects the parameters (functions, tables and properties) that the model
+      evaluates when it is executed. They are used to find the properties that
+      the model reads, see FGFDMExec::SetParallelModels(). Models that evaluate
+      other parameters than the "pre" and "post" functions should override
+      this method to collect them as well.
+      @param params the list to which the parameters are appended. */
+  virtual void CollectParameters(std::vector<const FGParameter*>& params) const;
+
+  /** Saves the values cached by the "pre" and "post" functions to a snapshot
+      or restores them from a snapshot.
+      @param snapshot the snapshot. */
+  virtual void ArchiveState(FGSnapshot& snapshot);
+
 protected:
   std::vector <FGFunction*> PreFunctions;
   std::vector <FGFunction*> PostFunctions;
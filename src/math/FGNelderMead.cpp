@@ -24,7 +24,6 @@
 #include <iostream>
 #include <sstream>
 #include <stdexcept>
-#include <ctime>
 
 namespace JSBSim
 {
@@ -35,8 +34,10 @@ FGNelderMead::FGNelderMead(Function * f, const std::vector<double> & initialGues
                            const std::vector<double> & initialStepSize, int iterMax,
                            double rtol, double abstol, double speed, double randomization,
                            bool showConvergeStatus,
-                           bool showSimplex, bool pause, Callback * callback) :
+                           bool showSimplex, bool pause, Callback * callback,
+                           unsigned int seed) :
         m_f(f), m_callback(callback), m_randomization(randomization),
+        m_random(seed, "trim/simplex"),
         m_lowerBound(lowerBound), m_upperBound(upperBound),
         m_nDim(initialGuess.size()), m_nVert(m_nDim+1),
         m_iMax(1), m_iNextMax(1), m_iMin(1),
@@ -48,7 +49,6 @@ FGNelderMead::FGNelderMead(Function * f, const std::vector<double> & initialGues
         pause(pause), rtolI(), minCostPrevResize(1), minCost(), minCostPrev(), maxCost(),
         nextMaxCost()
 {
-    srand ( time(NULL) ); // seed random number generator
 }
 
 void FGNelderMead::update()
@@ -256,7 +256,7 @@ int FGNelderMead::status()
 
 double FGNelderMead::getRandomFactor()
 {
-    double randFact = 1+(float(rand() % 1000)/500-1)*m_randomization;
+    double randFact = 1+m_random.GetUniformSigned()*m_randomization;
     //std::cout << "random factor: " << randFact << std::endl;;
     return randFact;
 }
@@ -22,6 +22,7 @@
 #include <vector>
 #include <limits>
 #include <cstddef>
+#include "FGRandom.h"
 
 namespace JSBSim
 {
@@ -52,7 +53,8 @@ public:
                  double randomization=0.1,
                  bool showConvergeStatus=true,bool showSimplex=false,
                  bool pause=false,
-                 Callback * callback=NULL);
+                 Callback * callback=NULL,
+                 unsigned int seed=0);
     std::vector<double> getSolution();
 
     void update();
@@ -63,6 +65,7 @@ private:
     Function * m_f;
     Callback * m_callback;
     double m_randomization;
+    FGRandom m_random;
     const std::vector<double> & m_lowerBound;
     const std::vector<double> & m_upperBound;
     size_t m_nDim, m_nVert;
@@ -72,6 +72,9 @@ public:
 
   double GetValue(void) const;
   void SetNode(FGPropertyNode* node) {PropertyNode = node;}
+  FGPropertyNode* GetNode(void) const {return PropertyNode;}
+  bool IsLateBound(void) const {return PropertyNode == 0;}
+  int GetSign(void) const {return Sign;}
 
   std::string GetName(void) const;
 
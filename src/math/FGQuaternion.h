@@ -319,7 +319,6 @@ public:
     data[1] = q.data[1];
     data[2] = q.data[2];
     data[3] = q.data[3];
-    ComputeDerived();
     // .. and copy the derived values if they are valid
     mCacheValid = q.mCacheValid;
     if (mCacheValid) {
@@ -0,0 +1,133 @@
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+Module: FGRandom.cpp
+Date started: February 2016
+Purpose: Counter based pseudo random number generator
+
+ ------------- Copyright (C) 2016  JSBSim development team  -------------
+
+ This program is free software; you can redistribute it and/or modify it under
+ the terms of the GNU Lesser General Public License as published by the Free Software
+ Foundation; either version 2 of the License, or (at your option) any later
+ version.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ details.
+
+ You should have received a copy of the GNU Lesser General Public License along with
+ this program; if not, write to the Free Software Foundation, Inc., 59 Temple
+ Place - Suite 330, Boston, MA  02111-1307, USA.
+
+ Further information about the GNU Lesser General Public License can also be found on
+ the world wide web at http://www.gnu.org.
+
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+INCLUDES
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+#include <cmath>
+#include "FGRandom.h"
+#include "FGJSBBase.h"
+
+using namespace std;
+
+namespace JSBSim {
+
+IDENT(IdSrc,"$Id$");
+IDENT(IdHdr,ID_RANDOM);
+
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+CLASS IMPLEMENTATION
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+FGRandom::FGRandom(unsigned int seed, const string& name)
+{
+  // The id of the stream is the 64 bits FNV-1a hash of its name.
+  uint64_t id = 0xcbf29ce484222325ULL;
+  for (string::const_iterator it=name.begin(); it != name.end(); ++it) {
+    id ^= (unsigned char)*it;
+    id *= 0x100000001b3ULL;
+  }
+
+  Counter[2] = (uint32_t)id;
+  Counter[3] = (uint32_t)(id >> 32);
+
+  Seed(seed);
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+void FGRandom::Seed(unsigned int seed)
+{
+  Key[0] = seed;
+  Key[1] = 0;
+  Counter[0] = Counter[1] = 0;
+  Index = 4;
+  HasSpareNormal = false;
+  SpareNormal = 0.0;
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+// Philox4x32-10: 10 rounds of 2 multiplications of 32 bits by 32 bits.
+
+void FGRandom::NextBlock(void)
+{
+  uint32_t ctr[4] = { Counter[0], Counter[1], Counter[2], Counter[3] };
+  uint32_t k0 = Key[0], k1 = Key[1];
+
+  for (unsigned int round=0; round<10; round++) {
+    uint64_t p0 = (uint64_t)0xD2511F53 * ctr[0];
+    uint64_t p1 = (uint64_t)0xCD9E8D57 * ctr[2];
+    uint32_t c1 = ctr[1], c3 = ctr[3];
+    ctr[0] = (uint32_t)(p1 >> 32) ^ c1 ^ k0;
+    ctr[1] = (uint32_t)p1;
+    ctr[2] = (uint32_t)(p0 >> 32) ^ c3 ^ k1;
+    ctr[3] = (uint32_t)p0;
+    k0 += 0x9E3779B9;
+    k1 += 0xBB67AE85;
+  }
+
+  for (unsigned int i=0; i<4; i++) Block[i] = ctr[i];
+  Index = 0;
+
+  if (++Counter[0] == 0) ++Counter[1];
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+// The 53 bits of the mantissa are drawn from 2 numbers of 32 bits.
+
+double FGRandom::GetUniform(void)
+{
+  uint32_t a = GetUInt32() >> 5;
+  uint32_t b = GetUInt32() >> 6;
+
+  return (a * 67108864.0 + b) * (1.0 / 9007199254740992.0);
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+// Marsaglia polar method: the numbers are generated by pairs.
+
+double FGRandom::GetNormal(void)
+{
+  if (HasSpareNormal) {
+    HasSpareNormal = false;
+    return SpareNormal;
+  }
+
+  double v1, v2, s;
+  do {
+    v1 = GetUniformSigned();
+    v2 = GetUniformSigned();
+    s = v1 * v1 + v2 * v2;
+  } while (s >= 1.0 || s == 0.0);
+
+  double f = sqrt(-2.0 * log(s) / s);
+  SpareNormal = v2 * f;
+  HasSpareNormal = true;
+
+  return v1 * f;
+}
+
+}
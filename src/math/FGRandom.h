@@ -0,0 +1,114 @@
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+Header: FGRandom.h
+Date started: February 2016
+
+ ------------- Copyright (C) 2016  JSBSim development team  -------------
+
+ This program is free software; you can redistribute it and/or modify it under
+ the terms of the GNU Lesser General Public License as published by the Free Software
+ Foundation; either version 2 of the License, or (at your option) any later
+ version.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ details.
+
+ You should have received a copy of the GNU Lesser General Public License along with
+ this program; if not, write to the Free Software Foundation, Inc., 59 Temple
+ Place - Suite 330, Boston, MA  02111-1307, USA.
+
+ Further information about the GNU Lesser General Public License can also be found on
+ the world wide web at http://www.gnu.org.
+
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+SENTRY
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+#ifndef FGRANDOM_H
+#define FGRANDOM_H
+
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+INCLUDES
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+#include <string>
+#include <stdint.h>
+
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+DEFINITIONS
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+#define ID_RANDOM "$Id$"
+
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+FORWARD DECLARATIONS
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+namespace JSBSim {
+
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+CLASS DOCUMENTATION
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+/** A stream of pseudo random numbers.
+    The numbers are produced by the counter based generator Philox4x32-10
+    (Salmon et al., "Parallel Random Numbers: As Easy as 1, 2, 3", SC11). The
+    n-th block of 4 numbers of a stream is a bijection of the 128 bits counter
+    (n, stream id) keyed by the seed, so:
+    - the streams are fully determined by the seed and by their name: they do
+      not depend on the other streams, nor on the order in which the streams
+      are used or on the thread that uses them;
+    - two streams with different names are statistically independent even
+      when they share the same seed.
+
+    Each FGFDMExec instance owns a set of named streams (see
+    FGFDMExec::GetRandom()) so that the random numbers of a subsystem do not
+    change when another subsystem draws more or less numbers.
+*/
+
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+CLASS DECLARATION
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+class FGRandom
+{
+public:
+  /** Constructor.
+      @param seed the seed of the stream.
+      @param name the name of the stream from which its id is computed. */
+  FGRandom(unsigned int seed = 0, const std::string& name = "");
+
+  /** Restarts the stream with a new seed.
+      @param seed the new seed. */
+  void Seed(unsigned int seed);
+  /// Returns the seed of the stream.
+  unsigned int GetSeed(void) const { return Key[0]; }
+
+  /// Returns a random integer uniformly distributed in [0, 2^32-1].
+  uint32_t GetUInt32(void) {
+    if (Index == 4) NextBlock();
+    return Block[Index++];
+  }
+  /// Returns a random number uniformly distributed in [0, 1).
+  double GetUniform(void);
+  /// Returns a random number uniformly distributed in [-1, 1).
+  double GetUniformSigned(void) { return 2.0*GetUniform() - 1.0; }
+  /// Returns a random number with a standard normal distribution.
+  double GetNormal(void);
+
+private:
+  uint32_t Key[2];
+  uint32_t Counter[4];
+  uint32_t Block[4];
+  unsigned int Index;
+  bool HasSpareNormal;
+  double SpareNormal;
+
+  void NextBlock(void);
+};
+
+} // namespace JSBSim
+
+#endif
@@ -18,6 +18,8 @@
 
 #include "initialization/FGInitialCondition.h"
 #include "FGStateSpace.h"
+#include "FGBatchExec.h"
+#include <algorithm>
 #include <limits>
 #include <iomanip>
 #include <string>
@@ -25,6 +27,68 @@
 namespace JSBSim
 {
 
+// a copy of the state space attached to a copy of the fdm
+struct FGStateSpace::Worker
+{
+    Worker(FGFDMExec * fdm) : ss(fdm) {}
+    ~Worker()
+    {
+        deleteComponents(ss.x);
+        deleteComponents(ss.u);
+        deleteComponents(ss.y);
+    }
+    static void deleteComponents(ComponentVector & v)
+    {
+        for (unsigned int i=0;i<v.getSize();i++) delete v.getComp(i);
+    }
+    // returns false if one of the components can not be copied
+    static bool copyComponents(ComponentVector & to, const ComponentVector & from)
+    {
+        for (unsigned int i=0;i<from.getSize();i++)
+        {
+            Component * comp = from.getComp(i)->clone();
+            if (!comp) return false;
+            to.add(comp);
+        }
+        return true;
+    }
+    FGStateSpace ss;
+    FGSnapshot state;
+};
+
+// computes the columns index, index+n, index+2n... of a jacobian on the
+// worker #index, n being the number of workers
+class FGStateSpace::JacobianTask : public FGBatchExec::Task
+{
+public:
+    JacobianTask(std::vector<Worker *> & workers, std::vector< std::vector<double> > & columns,
+                 ComponentVector FGStateSpace::* y, ComponentVector FGStateSpace::* x,
+                 const std::vector<double> & x0, double h, bool computeYDerivative) :
+            m_workers(workers), m_columns(columns), m_y(y), m_x(x), m_x0(x0), m_h(h),
+            m_computeYDerivative(computeYDerivative) {}
+    bool Execute(FGFDMExec *, unsigned int index)
+    {
+        Worker * worker = m_workers[index];
+        for (size_t iX=index;iX<m_columns.size();iX+=m_workers.size())
+            worker->ss.jacobianColumn(m_columns[iX],m_y,m_x,iX,m_x0,worker->state,
+                                      m_h,m_computeYDerivative);
+        return true;
+    }
+private:
+    std::vector<Worker *> & m_workers;
+    std::vector< std::vector<double> > & m_columns;
+    ComponentVector FGStateSpace::* m_y;
+    ComponentVector FGStateSpace::* m_x;
+    const std::vector<double> & m_x0;
+    double m_h;
+    bool m_computeYDerivative;
+};
+
+FGStateSpace::~FGStateSpace()
+{
+    stopWorkers();
+}
+
 void FGStateSpace::linearize(
     std::vector<double> x0,
     std::vector<double> u0,
@@ -36,79 +100,160 @@ void FGStateSpace::linearize(
 {
     double h = 1e-4;
 
-    // A, d(x)/dx
-    numericalJacobian(A,x,x,x0,x0,h,true);
-    // B, d(x)/du
-    numericalJacobian(B,x,u,x0,u0,h,true);
-    // C, d(y)/dx
-    numericalJacobian(C,y,x,y0,x0,h);
-    // D, d(y)/du
-    numericalJacobian(D,y,u,y0,u0,h);
+    // every evaluation starts from the state of the fdm at this point, so
+    // that the result does not depend on the order of the evaluations nor
+    // on the number of threads
+    FGSnapshot state;
+    m_fdm->SaveState(state);
+    startWorkers(state);
+
+    try
+    {
+        // A, d(x)/dx
+        numericalJacobian(A,&FGStateSpace::x,&FGStateSpace::x,x0,state,h,true);
+        // B, d(x)/du
+        numericalJacobian(B,&FGStateSpace::x,&FGStateSpace::u,u0,state,h,true);
+        // C, d(y)/dx
+        numericalJacobian(C,&FGStateSpace::y,&FGStateSpace::x,x0,state,h);
+        // D, d(y)/du
+        numericalJacobian(D,&FGStateSpace::y,&FGStateSpace::u,u0,state,h);
+    }
+    catch (...)
+    {
+        stopWorkers();
+        m_fdm->RestoreState(state);
+        throw;
+    }
 
+    stopWorkers();
+    m_fdm->RestoreState(state);
 }
 
-void FGStateSpace::numericalJacobian(std::vector< std::vector<double> >  & J, ComponentVector & y,
-                                     ComponentVector & x, const std::vector<double> & y0, const std::vector<double> & x0, double h, bool computeYDerivative)
+bool FGStateSpace::startWorkers(FGSnapshot & state)
 {
-    size_t nX = x.getSize();
-    size_t nY = y.getSize();
-    double f1 = 0, f2 = 0, fn1 = 0, fn2 = 0;
+    stopWorkers();
+    if (m_numThreads == 1) return false;
+
+    // the script can not be copied along with the fdm
+    if (m_fdm->GetScript()) return false;
+
+    m_batch = new FGBatchExec(m_numThreads);
+    size_t nX = std::max(x.getSize(),u.getSize());
+    for (unsigned int i=0;i<m_batch->GetNumThreads() && i<nX;i++)
+    {
+        FGFDMExec * fdm = m_batch->AddInstance();
+        Worker * worker = new Worker(fdm);
+        m_workers.push_back(worker);
+        if (!fdm->LoadModel(*m_fdm) || !fdm->RestoreState(state) ||
+                !Worker::copyComponents(worker->ss.x,x) ||
+                !Worker::copyComponents(worker->ss.u,u) ||
+                !Worker::copyComponents(worker->ss.y,y))
+        {
+            if (m_fdm->GetDebugLevel() > 0)
+                std::cerr << "linearization: the fdm can not be copied, "
+                          << "the jacobians are computed by a single thread" << std::endl;
+            stopWorkers();
+            return false;
+        }
+        fdm->SaveState(worker->state);
+    }
+    return true;
+}
+
+void FGStateSpace::stopWorkers()
+{
+    for (unsigned int i=0;i<m_workers.size();i++) delete m_workers[i];
+    m_workers.clear();
+    delete m_batch;
+    m_batch = 0;
+}
+
+void FGStateSpace::numericalJacobian(std::vector< std::vector<double> >  & J, ComponentVector FGStateSpace::* y,
+                                     ComponentVector FGStateSpace::* x, const std::vector<double> & x0,
+                                     FGSnapshot & state, double h, bool computeYDerivative)
+{
+    size_t nX = (this->*x).getSize();
+    size_t nY = (this->*y).getSize();
+    std::vector< std::vector<double> > columns(nX);
+
+    if (m_workers.empty())
+    {
+        for (unsigned int iX=0;iX<nX;iX++)
+            jacobianColumn(columns[iX],y,x,iX,x0,state,h,computeYDerivative);
+    }
+    else
+    {
+        JacobianTask task(m_workers,columns,y,x,x0,h,computeYDerivative);
+        m_batch->ForEach(task);
+        for (unsigned int i=0;i<m_batch->GetNumInstances();i++)
+        {
+            if (!m_batch->IsRunning(i))
+                throw std::string("linearization failed: ") + m_batch->GetError(i);
+        }
+    }
+
     J.resize(nY);
     for (unsigned int iY=0;iY<nY;iY++)
     {
         J[iY].resize(nX);
-        for (unsigned int iX=0;iX<nX;iX++)
+        for (unsigned int iX=0;iX<nX;iX++) J[iY][iX] = columns[iX][iY];
+    }
+}
+
+void FGStateSpace::jacobianColumn(std::vector<double> & column, ComponentVector FGStateSpace::* yMember,
+                                  ComponentVector FGStateSpace::* xMember, unsigned int iX,
+                                  const std::vector<double> & x0, FGSnapshot & state,
+                                  double h, bool computeYDerivative)
+{
+    ComponentVector & x = this->*xMember;
+    ComponentVector & y = this->*yMember;
+    size_t nY = y.getSize();
+
+    // all the outputs are collected by a single evaluation per point
+    const double steps[4] = {1, 2, -1, -2};
+    std::vector<double> f[4];
+    for (unsigned int i=0;i<4;i++)
+    {
+        if (!m_fdm->RestoreState(state))
+            throw std::string("linearization failed: the state of the fdm can not be restored");
+        x.set(x0);
+        x.set(iX,x.get(iX)+steps[i]*h);
+        // the derivatives of all the outputs are computed by a single run
+        // of the fdm from the perturbed state
+        f[i] = computeYDerivative ? y.getDeriv() : y.get();
+    }
+
+    column.resize(nY);
+    for (unsigned int iY=0;iY<nY;iY++)
+    {
+        double f1 = f[0][iY], f2 = f[1][iY], fn1 = f[2][iY], fn2 = f[3][iY];
+        double diff1 = f1-fn1;
+        double diff2 = f2-fn2;
+
+        // correct for angle wrap
+        if (x.getComp(iX)->getUnit().compare("rad") == 0) {
+            while(diff1 > M_PI) diff1 -= 2*M_PI;
+            if(diff1 < -M_PI) diff1 += 2*M_PI;
+            if(diff2 > M_PI) diff2 -= 2*M_PI;
+            if(diff2 < -M_PI) diff2 += 2*M_PI;
+        } else if (x.getComp(iX)->getUnit().compare("deg") == 0) {
+            if(diff1 > 180) diff1 -= 360;
+            if(diff1 < -180) diff1 += 360;
+            if(diff2 > 180) diff2 -= 360;
+            if(diff2 < -180) diff2 += 360;
+        }
+        column[iY] = (8*diff1-diff2)/(12*h); // 3rd order taylor approx from lewis, pg 203
+
+        if (m_fdm->GetDebugLevel() > 1)
         {
-            x.set(x0);
-            x.set(iX,x.get(iX)+h);
-            if (computeYDerivative) f1 = y.getDeriv(iY);
-            else f1 = y.get(iY);
-
-            x.set(x0);
-            x.set(iX,x.get(iX)+2*h);
-            if (computeYDerivative) f2 = y.getDeriv(iY);
-            else f2 = y.get(iY);
-
-            x.set(x0);
-            x.set(iX,x.get(iX)-h);
-            if (computeYDerivative) fn1 = y.getDeriv(iY);
-            else fn1 = y.get(iY);
-
-            x.set(x0);
-            x.set(iX,x.get(iX)-2*h);
-            if (computeYDerivative) fn2 = y.getDeriv(iY);
-            else fn2 = y.get(iY);
-
-			double diff1 = f1-fn1;
-			double diff2 = f2-fn2;
-
-			// correct for angle wrap
-			if (x.getComp(iX)->getUnit().compare("rad") == 0) {
-				while(diff1 > M_PI) diff1 -= 2*M_PI;
-				if(diff1 < -M_PI) diff1 += 2*M_PI;
-				if(diff2 > M_PI) diff2 -= 2*M_PI;
-				if(diff2 < -M_PI) diff2 += 2*M_PI;
-			} else if (x.getComp(iX)->getUnit().compare("deg") == 0) {
-				if(diff1 > 180) diff1 -= 360;
-				if(diff1 < -180) diff1 += 360;
-				if(diff2 > 180) diff2 -= 360;
-				if(diff2 < -180) diff2 += 360;
-			}
-            J[iY][iX] = (8*diff1-diff2)/(12*h); // 3rd order taylor approx from lewis, pg 203
-
-            x.set(x0);
-
-            if (m_fdm->GetDebugLevel() > 1)
-            {
-                std::cout << std::scientific << "\ty:\t" << y.getName(iY) << "\tx:\t"
-                          << x.getName(iX)
-                          << "\tfn2:\t" << fn2 << "\tfn1:\t" << fn1
-                          << "\tf1:\t" << f1 << "\tf2:\t" << f2
-                          << "\tf1-fn1:\t" << f1-fn1
-                          << "\tf2-fn2:\t" << f2-fn2
-                          << "\tdf/dx:\t" << J[iY][iX]
-                          << std::fixed << std::endl;
-            }
+            std::cout << std::scientific << "\ty:\t" << y.getName(iY) << "\tx:\t"
+                      << x.getName(iX)
+                      << "\tfn2:\t" << fn2 << "\tfn1:\t" << fn1
+                      << "\tf1:\t" << f1 << "\tf2:\t" << f2
+                      << "\tf1-fn1:\t" << f1-fn1
+                      << "\tf2-fn2:\t" << f2-fn2
+                      << "\tdf/dx:\t" << column[iY]
+                      << std::fixed << std::endl;
         }
     }
 }
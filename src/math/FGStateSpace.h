@@ -35,6 +35,8 @@
 namespace JSBSim
 {
 
+class FGBatchExec;
+
 class FGStateSpace
 {
 public:
@@ -50,8 +52,14 @@ public:
         Component(const std::string & name, const std::string & unit) :
                 m_stateSpace(), m_fdm(), m_name(name), m_unit(unit) {};
         virtual ~Component() {};
+        // returns a new component of the same kind, not attached to any fdm,
+        // or 0 if the component can not be copied
+        virtual Component * clone() const { return 0; }
         virtual double get() const = 0;
         virtual void set(double val) = 0;
+        // true if getDeriv() is computed from the current state of the fdm,
+        // false if it is approximated by running the fdm
+        virtual bool isDerivAnalytic() const { return false; }
         virtual double getDeriv() const
         {
             // by default should calculate using finite difference approx
@@ -162,15 +170,49 @@ public:
         {
             return m_components[i]->getDeriv();
         };
+        // derivatives of all the components: the fdm is run once for all
+        // the components that are not computed from the current state,
+        // which is restored afterwards
         std::vector<double> getDeriv() const
         {
-            std::vector<double> val;
-            for (unsigned int i=0;i<getSize();i++) val.push_back(m_components[i]->getDeriv());
+            std::vector<double> val(getSize()), f0(getSize());
+            bool numerical = false;
+            for (unsigned int i=0;i<getSize();i++)
+            {
+                if (m_components[i]->isDerivAnalytic())
+                    val[i] = m_components[i]->getDeriv();
+                else
+                {
+                    f0[i] = m_components[i]->get();
+                    numerical = true;
+                }
+            }
+            if (!numerical) return val;
+
+            FGSnapshot state;
+            m_fdm->SaveState(state);
+            double dt0 = m_fdm->GetDeltaT();
+            double time0 = m_fdm->GetSimTime();
+            m_fdm->Setdt(1./120.);
+            m_fdm->DisableOutput();
+            m_fdm->Run();
+            for (unsigned int i=0;i<getSize();i++)
+            {
+                if (!m_components[i]->isDerivAnalytic())
+                    val[i] = (m_components[i]->get()-f0[i])/m_fdm->GetDeltaT();
+            }
+            bool restored = m_fdm->RestoreState(state);
+            m_fdm->Setdt(dt0);
+            m_fdm->Setsim_time(time0);
+            m_fdm->EnableOutput();
+            if (!restored)
+                throw std::string("the state of the fdm can not be restored");
             return val;
         }
         void getDeriv(double * array) const
         {
-            for (unsigned int i=0;i<getSize();i++) array[i] = m_components[i]->getDeriv();
+            std::vector<double> val = getDeriv();
+            for (unsigned int i=0;i<getSize();i++) array[i] = val[i];
         }
         void set(std::vector<double> vals)
         {
@@ -215,10 +257,17 @@ public:
     ComponentVector x, u, y;
 
     // constructor
-    FGStateSpace(FGFDMExec * fdm) : x(fdm,this), u(fdm,this), y(fdm,this), m_fdm(fdm) {};
+    FGStateSpace(FGFDMExec * fdm) : x(fdm,this), u(fdm,this), y(fdm,this), m_fdm(fdm),
+            m_numThreads(1), m_batch(0) {};
 
     void setFdm(FGFDMExec * fdm) { m_fdm = fdm; }
 
+    // number of threads used by linearize: the columns of the jacobians are
+    // spread over copies of the fdm, one per thread. 0 means one thread per
+    // hardware thread and 1 computes the jacobians in the calling thread.
+    void setNumThreads(unsigned int nthreads) { m_numThreads = nthreads; }
+    unsigned int getNumThreads() const { return m_numThreads; }
+
     void run() {
         // initialize
       m_fdm->Initialize(m_fdm->GetIC());
@@ -271,9 +320,10 @@ public:
     }
 
     // deconstructor
-    virtual ~FGStateSpace() {};
+    virtual ~FGStateSpace();
 
-    // linearization function
+    // linearization function, each evaluation of the model starts from the
+    // current state of the fdm, which is restored on return
     void linearize(std::vector<double> x0, std::vector<double> u0, std::vector<double> y0,
                    std::vector< std::vector<double> > & A,
                    std::vector< std::vector<double> > & B,
@@ -283,14 +333,36 @@ public:
 
 private:
 
+    struct Worker;
+    class JacobianTask;
+
     // compute numerical jacobian of a matrix
-    void numericalJacobian(std::vector< std::vector<double> > & J, ComponentVector & y,
-                           ComponentVector & x, const std::vector<double> & y0,
-                           const std::vector<double> & x0, double h=1e-5, bool computeYDerivative = false);
+    void numericalJacobian(std::vector< std::vector<double> > & J, ComponentVector FGStateSpace::* y,
+                           ComponentVector FGStateSpace::* x, const std::vector<double> & x0,
+                           FGSnapshot & state, double h=1e-5, bool computeYDerivative = false);
+
+    // compute the column iX of a numerical jacobian, starting each evaluation from state
+    void jacobianColumn(std::vector<double> & column, ComponentVector FGStateSpace::* y,
+                        ComponentVector FGStateSpace::* x, unsigned int iX,
+                        const std::vector<double> & x0, FGSnapshot & state,
+                        double h, bool computeYDerivative);
+
+    // copies of the state space used to compute the jacobians in parallel
+    bool startWorkers(FGSnapshot & state);
+    void stopWorkers();
+
+    // not copyable
+    FGStateSpace(const FGStateSpace &);
+    FGStateSpace & operator=(const FGStateSpace &);
 
     // flight dynamcis model
     FGFDMExec * m_fdm;
 
+    // parallel linearization
+    unsigned int m_numThreads;
+    FGBatchExec * m_batch;
+    std::vector<Worker *> m_workers;
+
 public:
 
     // components
@@ -299,6 +371,7 @@ public:
     {
     public:
         Vt() : Component("Vt","ft/s") {};
+        Component * clone() const { return new Vt; }
         double get() const
         {
             return m_fdm->GetAuxiliary()->GetVt();
@@ -315,6 +388,7 @@ public:
                     m_fdm->GetPropagate()->GetUVW(3)*m_fdm->GetAccelerations()->GetUVWdot(3))/
                    m_fdm->GetAuxiliary()->GetVt(); // from lewis, vtrue dot
         }
+        bool isDerivAnalytic() const { return true; }
 
     };
 
@@ -322,6 +396,7 @@ public:
     {
     public:
         VGround() : Component("VGround","ft/s") {};
+        Component * clone() const { return new VGround; }
         double get() const
         {
             return m_fdm->GetAuxiliary()->GetVground();
@@ -336,6 +411,7 @@ public:
     {
     public:
         AccelX() : Component("AccelX","ft/s^2") {};
+        Component * clone() const { return new AccelX; }
         double get() const
         {
             return m_fdm->GetAuxiliary()->GetPilotAccel(1);
@@ -350,6 +426,7 @@ public:
     {
     public:
         AccelY() : Component("AccelY","ft/s^2") {};
+        Component * clone() const { return new AccelY; }
         double get() const
         {
             return m_fdm->GetAuxiliary()->GetPilotAccel(2);
@@ -364,6 +441,7 @@ public:
     {
     public:
         AccelZ() : Component("AccelZ","ft/s^2") {};
+        Component * clone() const { return new AccelZ; }
         double get() const
         {
             return m_fdm->GetAuxiliary()->GetPilotAccel(3);
@@ -378,6 +456,7 @@ public:
     {
     public:
         Alpha() : Component("Alpha","rad") {};
+        Component * clone() const { return new Alpha; }
         double get() const
         {
             return m_fdm->GetAuxiliary()->Getalpha();
@@ -396,12 +475,14 @@ public:
         {
             return m_fdm->GetAuxiliary()->Getadot();
         }
+        bool isDerivAnalytic() const { return true; }
     };
 
     class Theta : public Component
     {
     public:
         Theta() : Component("Theta","rad") {};
+        Component * clone() const { return new Theta; }
         double get() const
         {
             return m_fdm->GetPropagate()->GetEuler(2);
@@ -415,12 +496,14 @@ public:
         {
             return m_fdm->GetAuxiliary()->GetEulerRates(2);
         }
+        bool isDerivAnalytic() const { return true; }
     };
 
     class Q : public Component
     {
     public:
         Q() : Component("Q","rad/s") {};
+        Component * clone() const { return new Q; }
         double get() const
         {
             return m_fdm->GetPropagate()->GetPQR(2);
@@ -433,12 +516,14 @@ public:
         {
             return m_fdm->GetAccelerations()->GetPQRdot(2);
         }
+        bool isDerivAnalytic() const { return true; }
     };
 
     class Alt : public Component
     {
     public:
         Alt() : Component("Alt","ft") {};
+        Component * clone() const { return new Alt; }
         double get() const
         {
             return m_fdm->GetPropagate()->GetAltitudeASL();
@@ -451,12 +536,14 @@ public:
         {
             return m_fdm->GetPropagate()->Gethdot();
         }
+        bool isDerivAnalytic() const { return true; }
     };
 
     class Beta : public Component
     {
     public:
         Beta() : Component("Beta","rad") {};
+        Component * clone() const { return new Beta; }
         double get() const
         {
             return m_fdm->GetAuxiliary()->Getbeta();
@@ -471,12 +558,14 @@ public:
         {
             return m_fdm->GetAuxiliary()->Getbdot();
         }
+        bool isDerivAnalytic() const { return true; }
     };
 
     class Phi : public Component
     {
     public:
         Phi() : Component("Phi","rad") {};
+        Component * clone() const { return new Phi; }
         double get() const
         {
             return m_fdm->GetPropagate()->GetEuler(1);
@@ -489,12 +578,14 @@ public:
         {
             return m_fdm->GetAuxiliary()->GetEulerRates(1);
         }
+        bool isDerivAnalytic() const { return true; }
     };
 
     class P : public Component
     {
     public:
         P() : Component("P","rad/s") {};
+        Component * clone() const { return new P; }
         double get() const
         {
             return m_fdm->GetPropagate()->GetPQR(1);
@@ -507,12 +598,14 @@ public:
         {
             return m_fdm->GetAccelerations()->GetPQRdot(1);
         }
+        bool isDerivAnalytic() const { return true; }
     };
 
     class R : public Component
     {
     public:
         R() : Component("R","rad/s") {};
+        Component * clone() const { return new R; }
         double get() const
         {
             return m_fdm->GetPropagate()->GetPQR(3);
@@ -525,12 +618,14 @@ public:
         {
             return m_fdm->GetAccelerations()->GetPQRdot(3);
         }
+        bool isDerivAnalytic() const { return true; }
     };
 
     class Psi : public Component
     {
     public:
         Psi() : Component("Psi","rad") {};
+        Component * clone() const { return new Psi; }
         double get() const
         {
             return m_fdm->GetPropagate()->GetEuler(3);
@@ -543,12 +638,14 @@ public:
         {
             return m_fdm->GetAuxiliary()->GetEulerRates(3);
         }
+        bool isDerivAnalytic() const { return true; }
     };
 
     class ThrottleCmd : public Component
     {
     public:
         ThrottleCmd() : Component("ThtlCmd","norm") {};
+        Component * clone() const { return new ThrottleCmd; }
         double get() const
         {
             return m_fdm->GetFCS()->GetThrottleCmd(0);
@@ -565,6 +662,7 @@ public:
     {
     public:
         ThrottlePos() : Component("ThtlPos","norm") {};
+        Component * clone() const { return new ThrottlePos; }
         double get() const
         {
             return m_fdm->GetFCS()->GetThrottlePos(0);
@@ -580,6 +678,7 @@ public:
     {
     public:
         DaCmd() : Component("DaCmd","norm") {};
+        Component * clone() const { return new DaCmd; }
         double get() const
         {
             return m_fdm->GetFCS()->GetDaCmd();
@@ -595,6 +694,7 @@ public:
     {
     public:
         DaPos() : Component("DaPos","norm") {};
+        Component * clone() const { return new DaPos; }
         double get() const
         {
             return m_fdm->GetFCS()->GetDaLPos();
@@ -610,6 +710,7 @@ public:
     {
     public:
         DeCmd() : Component("DeCmd","norm") {};
+        Component * clone() const { return new DeCmd; }
         double get() const
         {
             return m_fdm->GetFCS()->GetDeCmd();
@@ -625,6 +726,7 @@ public:
     {
     public:
         DePos() : Component("DePos","norm") {};
+        Component * clone() const { return new DePos; }
         double get() const
         {
             return m_fdm->GetFCS()->GetDePos();
@@ -639,6 +741,7 @@ public:
     {
     public:
         DrCmd() : Component("DrCmd","norm") {};
+        Component * clone() const { return new DrCmd; }
         double get() const
         {
             return m_fdm->GetFCS()->GetDrCmd();
@@ -654,6 +757,7 @@ public:
     {
     public:
         DrPos() : Component("DrPos","norm") {};
+        Component * clone() const { return new DrPos; }
         double get() const
         {
             return m_fdm->GetFCS()->GetDrPos();
@@ -668,6 +772,7 @@ public:
     {
     public:
         Rpm0() : Component("Rpm0","rev/min") {};
+        Component * clone() const { return new Rpm0; }
         double get() const
         {
             return m_fdm->GetPropulsion()->GetEngine(0)->GetThruster()->GetRPM();
@@ -682,6 +787,7 @@ public:
     {
     public:
         Rpm1() : Component("Rpm1","rev/min") {};
+        Component * clone() const { return new Rpm1; }
         double get() const
         {
             return m_fdm->GetPropulsion()->GetEngine(1)->GetThruster()->GetRPM();
@@ -696,6 +802,7 @@ public:
     {
     public:
         Rpm2() : Component("Rpm2","rev/min") {};
+        Component * clone() const { return new Rpm2; }
         double get() const
         {
             return m_fdm->GetPropulsion()->GetEngine(2)->GetThruster()->GetRPM();
@@ -710,6 +817,7 @@ public:
     {
     public:
         Rpm3() : Component("Rpm3","rev/min") {};
+        Component * clone() const { return new Rpm3; }
         double get() const
         {
             return m_fdm->GetPropulsion()->GetEngine(3)->GetThruster()->GetRPM();
@@ -724,6 +832,7 @@ public:
     {
     public:
         PropPitch() : Component("Prop Pitch","deg") {};
+        Component * clone() const { return new PropPitch; }
         double get() const
         {
             return m_fdm->GetPropulsion()->GetEngine(0)->GetThruster()->GetPitch();
@@ -739,6 +848,7 @@ public:
     {
     public:
         Longitude() : Component("Longitude","rad") {};
+        Component * clone() const { return new Longitude; }
         double get() const
         {
             return m_fdm->GetPropagate()->GetLongitude();
@@ -751,12 +861,14 @@ public:
         {
             return m_fdm->GetPropagate()->GetVel(2)/(cos(m_fdm->GetPropagate()->GetLatitude())*m_fdm->GetPropagate()->GetRadius());
         }
+        bool isDerivAnalytic() const { return true; }
     };
 
     class Latitude : public Component
     {
     public:
         Latitude() : Component("Latitude","rad") {};
+        Component * clone() const { return new Latitude; }
         double get() const
         {
             return m_fdm->GetPropagate()->GetLatitude();
@@ -769,12 +881,14 @@ public:
         {
             return m_fdm->GetPropagate()->GetVel(1)/(m_fdm->GetPropagate()->GetRadius());
         }
+        bool isDerivAnalytic() const { return true; }
     };
 
     class Pi : public Component
     {
     public:
         Pi() : Component("P inertial","rad/s") {};
+        Component * clone() const { return new Pi; }
         double get() const
         {
             return m_fdm->GetPropagate()->GetPQRi(1);
@@ -790,12 +904,14 @@ public:
         {
             return m_fdm->GetAccelerations()->GetPQRdot(1);
         }
+        bool isDerivAnalytic() const { return true; }
     };
 
     class Qi : public Component
     {
     public:
         Qi() : Component("Q inertial","rad/s") {};
+        Component * clone() const { return new Qi; }
         double get() const
         {
             return m_fdm->GetPropagate()->GetPQRi(2);
@@ -811,12 +927,14 @@ public:
         {
             return m_fdm->GetAccelerations()->GetPQRdot(2);
         }
+        bool isDerivAnalytic() const { return true; }
     };
 
     class Ri : public Component
     {
     public:
         Ri() : Component("R inertial","rad/s") {};
+        Component * clone() const { return new Ri; }
         double get() const
         {
             return m_fdm->GetPropagate()->GetPQRi(3);
@@ -832,12 +950,14 @@ public:
         {
             return m_fdm->GetAccelerations()->GetPQRdot(3);
         }
+        bool isDerivAnalytic() const { return true; }
     };
 
     class Vn : public Component
     {
     public:
         Vn() : Component("Vel north","feet/s") {};
+        Component * clone() const { return new Vn; }
         double get() const
         {
             return m_fdm->GetPropagate()->GetVel(1);
@@ -851,12 +971,14 @@ public:
             //get NED accel from body accel
             return (m_fdm->GetPropagate()->GetTb2l()*m_fdm->GetAccelerations()->GetUVWdot())(1);
         }
+        bool isDerivAnalytic() const { return true; }
     };
 
     class Ve : public Component
     {
     public:
         Ve() : Component("Vel east","feet/s") {};
+        Component * clone() const { return new Ve; }
         double get() const
         {
             return m_fdm->GetPropagate()->GetVel(2);
@@ -870,12 +992,14 @@ public:
             //get NED accel from body accel
             return (m_fdm->GetPropagate()->GetTb2l()*m_fdm->GetAccelerations()->GetUVWdot())(2);
         }
+        bool isDerivAnalytic() const { return true; }
     };
 
     class Vd : public Component
     {
     public:
         Vd() : Component("Vel down","feet/s") {};
+        Component * clone() const { return new Vd; }
         double get() const
         {
             return m_fdm->GetPropagate()->GetVel(3);
@@ -889,12 +1013,14 @@ public:
             //get NED accel from body accel
             return (m_fdm->GetPropagate()->GetTb2l()*m_fdm->GetAccelerations()->GetUVWdot())(3);
         }
+        bool isDerivAnalytic() const { return true; }
     };
 
     class COG : public Component
     {
     public:
         COG() : Component("Course Over Ground","rad") {};
+        Component * clone() const { return new COG; }
         double get() const
         {
             //cog = atan2(Ve,Vn)
@@ -916,6 +1042,7 @@ public:
             //dCOG/dt = dCOG/dVe*dVe/dt + dCOG/dVn*dVn/dt
             return Vn/(Vn*Vn+Ve*Ve)*Vedot - Ve/(Vn*Vn+Ve*Ve)*Vndot;
         }
+        bool isDerivAnalytic() const { return true; }
     };
 
 };
@@ -38,10 +38,13 @@ INCLUDES
 
 #include "FGTable.h"
 #include "input_output/FGXMLElement.h"
+#include "input_output/FGModelCache.h"
 #include "input_output/FGPropertyManager.h"
 #include <iostream>
 #include <sstream>
+#include <iomanip>
 #include <cstdlib>
+#include <cmath>
 
 using namespace std;
 
@@ -54,6 +57,21 @@ IDENT(IdHdr,ID_TABLE);
 CLASS IMPLEMENTATION
 %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
 
+// The block is over-allocated so that the data can be aligned on a cache line.
+
+struct FGTable::DataBlock : public FGModelCache::CachedData {
+  DataBlock(unsigned int size) {
+    Memory = new double[size+7];
+    Data = Memory;
+    while (reinterpret_cast<size_t>(Data) % 64 != 0) Data++;
+  }
+  ~DataBlock() { delete[] Memory; }
+  double* Memory;
+  double* Data;
+};
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
 FGTable::FGTable(int NRows) : nRows(NRows), nCols(1), PropertyManager(0)
 {
   Type = tt1D;
@@ -100,10 +118,10 @@ FGTable::FGTable(const FGTable& t) : PropertyManager(t.PropertyManager)
 
   Tables = t.Tables;
   Data = Allocate();
-  for (unsigned int r=0; r<=nRows; r++) {
-    for (unsigned int c=0; c<=nCols; c++) {
-      Data[r][c] = t.Data[r][c];
-    }
+  for (unsigned int i=0; i<(nRows+1)*Stride; i++) Data[i] = t.Data[i];
+  for (unsigned int i=0; i<2; i++) {
+    Search[i] = t.Search[i];
+    InvStep[i] = t.InvStep[i];
   }
   lastRowIndex = t.lastRowIndex;
   lastColumnIndex = t.lastColumnIndex;
@@ -116,7 +134,6 @@ FGTable::FGTable(FGPropertyManager* propMan, Element* el) : PropertyManager(prop
 {
   unsigned int i;
 
-  stringstream buf;
   string property_string;
   string lookup_axis;
   string call_type;
@@ -130,6 +147,7 @@ FGTable::FGTable(FGPropertyManager* propMan, Element* el) : PropertyManager(prop
                            "pow, abs, sin, cos, asin, acos, tan, atan, table";
 
   nTables = 0;
+  Data = 0;
 
   // Is this an internal lookup table?
 
@@ -229,9 +247,6 @@ FGTable::FGTable(FGPropertyManager* propMan, Element* el) : PropertyManager(prop
     dimension = 2;                             // Currently, infers 2D table
   }
 
-  for (i=0; i<tableData->GetNumDataLines(); i++) {
-    buf << tableData->GetDataLine(i) << string(" ");
-  }
   switch (dimension) {
   case 1:
     nRows = tableData->GetNumDataLines();
@@ -239,10 +254,9 @@ FGTable::FGTable(FGPropertyManager* propMan, Element* el) : PropertyManager(prop
     Type = tt1D;
     colCounter = 0;
     rowCounter = 1;
-    Data = Allocate();
     Debug(0);
     lastRowIndex = lastColumnIndex = 2;
-    *this << buf;
+    ReadData(tableData);
     break;
   case 2:
     nRows = tableData->GetNumDataLines()-1;
@@ -258,9 +272,8 @@ FGTable::FGTable(FGPropertyManager* propMan, Element* el) : PropertyManager(prop
     colCounter = 1;
     rowCounter = 0;
 
-    Data = Allocate();
     lastRowIndex = lastColumnIndex = 2;
-    *this << buf;
+    ReadData(tableData);
     break;
   case 3:
     nTables = el->GetNumElements("tableData");
@@ -276,7 +289,7 @@ FGTable::FGTable(FGPropertyManager* propMan, Element* el) : PropertyManager(prop
     tableData = el->FindElement("tableData");
     for (i=0; i<nTables; i++) {
       Tables.push_back(new FGTable(PropertyManager, tableData));
-      Data[i+1][1] = tableData->GetAttributeValueAsNumber("breakPoint");
+      Data[(i+1)*Stride+1] = tableData->GetAttributeValueAsNumber("breakPoint");
       Tables[i]->SetRowIndexProperty(lookupProperty[eRow]);
       Tables[i]->SetColumnIndexProperty(lookupProperty[eColumn]);
       tableData = el->FindNextElement("tableData");
@@ -301,14 +314,14 @@ FGTable::FGTable(FGPropertyManager* propMan, Element* el) : PropertyManager(prop
   // check breakpoints, if applicable
   if (dimension > 2) {
     for (b=2; b<=nTables; ++b) {
-      if (Data[b][1] <= Data[b-1][1]) {
+      if (Data[b*Stride+1] <= Data[(b-1)*Stride+1]) {
         stringstream errormsg;
         errormsg << fgred << highint << endl
              << "  FGTable: breakpoint lookup is not monotonically increasing" << endl
              << "  in breakpoint " << b;
         if (nameel != 0) errormsg << " of table in " << nameel->GetAttributeValue("name");
         errormsg << ":" << reset << endl
-                 << "  " << Data[b][1] << "<=" << Data[b-1][1] << endl;
+                 << "  " << Data[b*Stride+1] << "<=" << Data[(b-1)*Stride+1] << endl;
         throw(errormsg.str());
       }
     }
@@ -317,14 +330,14 @@ FGTable::FGTable(FGPropertyManager* propMan, Element* el) : PropertyManager(prop
   // check columns, if applicable
   if (dimension > 1) {
     for (c=2; c<=nCols; ++c) {
-      if (Data[0][c] <= Data[0][c-1]) {
+      if (Data[c] <= Data[c-1]) {
         stringstream errormsg;
         errormsg << fgred << highint << endl
              << "  FGTable: column lookup is not monotonically increasing" << endl
              << "  in column " << c;
         if (nameel != 0) errormsg << " of table in " << nameel->GetAttributeValue("name");
         errormsg << ":" << reset << endl
-                 << "  " << Data[0][c] << "<=" << Data[0][c-1] << endl;
+                 << "  " << Data[c] << "<=" << Data[c-1] << endl;
         throw(errormsg.str());
       }
     }
@@ -333,19 +346,20 @@ FGTable::FGTable(FGPropertyManager* propMan, Element* el) : PropertyManager(prop
   // check rows
   if (dimension < 3) { // in 3D tables, check only rows of subtables
     for (r=2; r<=nRows; ++r) {
-      if (Data[r][0]<=Data[r-1][0]) {
+      if (Data[r*Stride]<=Data[(r-1)*Stride]) {
         stringstream errormsg;
         errormsg << fgred << highint << endl
              << "  FGTable: row lookup is not monotonically increasing" << endl
              << "  in row " << r;
         if (nameel != 0) errormsg << " of table in " << nameel->GetAttributeValue("name");
         errormsg << ":" << reset << endl
-                 << "  " << Data[r][0] << "<=" << Data[r-1][0] << endl;
+                 << "  " << Data[r*Stride] << "<=" << Data[(r-1)*Stride] << endl;
         throw(errormsg.str());
       }
     }
   }
 
+  SelectSearch();
   bind();
 
   if (debug_lvl & 1) Print();
@@ -353,18 +367,155 @@ FGTable::FGTable(FGPropertyManager* propMan, Element* el) : PropertyManager(prop
 
 //%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
 
-double** FGTable::Allocate(void)
+double* FGTable::Allocate(void)
 {
-  Data = new double*[nRows+1];
-  for (unsigned int r=0; r<=nRows; r++) {
-    Data[r] = new double[nCols+1];
-    for (unsigned int c=0; c<=nCols; c++) {
-      Data[r][c] = 0.0;
+  unsigned int size;
+
+  Stride = nCols+1;
+  size = (nRows+1)*Stride;
+
+  Block = new DataBlock(size);
+  Data = Block->Data;
+
+  for (unsigned int i=0; i<size; i++) Data[i] = 0.0;
+
+  Search[eRow] = Search[eColumn] = eWalk;
+  InvStep[eRow] = InvStep[eColumn] = 0.0;
+
+  return Data;
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+// Reads the breakpoints and the values of a 1D or 2D table. When a model is
+// loaded, the data is stored in the cache of the model so that the instances
+// which load the same model share it instead of reading it again.
+
+void FGTable::ReadData(Element* tableData)
+{
+  FGModelCache* cache = FGModelCache::GetCurrent();
+
+  if (cache) {
+    DataBlock* block = dynamic_cast<DataBlock*>(cache->GetData(tableData));
+    if (block) {
+      Stride = nCols+1;
+      Block = block;
+      Data = Block->Data;
+      return;
     }
   }
+
+  stringstream buf;
+  for (unsigned int i=0; i<tableData->GetNumDataLines(); i++)
+    buf << tableData->GetDataLine(i) << string(" ");
+
+  Data = Allocate();
+  *this << buf;
+
+  if (cache) cache->SetData(tableData, Block);
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+// Returns the breakpoints of an axis: the n breakpoints are located at
+// k[stride], k[2*stride], ..., k[n*stride].
+
+const double* FGTable::GetBreakpoints(int axis, unsigned int& stride,
+                                      unsigned int& n) const
+{
+  if (axis == eRow) {
+    stride = Stride;
+    n = nRows;
+    // The breakpoints of a 3D table are stored in its second column.
+    return Type == tt3D ? Data+1 : Data;
+  }
+
+  stride = 1;
+  n = Type == tt2D ? nCols : 0;
   return Data;
 }
 
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+// Selects the search strategy of each axis once the table is filled.
+
+void FGTable::SelectSearch(void)
+{
+  for (int axis=eRow; axis<=eColumn; axis++) {
+    unsigned int stride, n;
+    const double* k = GetBreakpoints(axis, stride, n);
+
+    Search[axis] = eWalk;
+    InvStep[axis] = 0.0;
+
+    if (n < 3) continue;
+
+    double step = (k[n*stride] - k[stride]) / (n-1);
+    bool uniform = step > 0.0;
+
+    for (unsigned int i=2; uniform && i<n; i++)
+      uniform = fabs(k[i*stride] - k[stride] - (i-1)*step) <= 1E-6*step;
+
+    if (uniform) {
+      Search[axis] = eUniform;
+      InvStep[axis] = 1.0 / step;
+    } else if (n > 8)
+      Search[axis] = eBinary;
+  }
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+// Returns the index r of the breakpoint such that the key is located between
+// the breakpoints r-1 and r. The index is the same whatever the search
+// strategy: it is the one that would be found by walking from the index of
+// the previous lookup.
+
+unsigned int FGTable::FindIndex(int axis, double key, unsigned int last) const
+{
+  unsigned int stride, n, lo, hi;
+  const double* k = GetBreakpoints(axis, stride, n);
+
+  switch (Search[axis]) {
+  case eUniform:
+    {
+      double x = (key - k[stride])*InvStep[axis];
+
+      if (x >= n-1) lo = n;
+      else if (x > 0.0) lo = (unsigned int)x + 2;
+      else lo = 2;
+
+      // Fix the rounding errors and the breakpoints that are not exactly
+      // evenly spaced.
+      while (lo > 2 && k[(lo-1)*stride] >= key) lo--;
+      while (lo < n && k[lo*stride] < key) lo++;
+    }
+    break;
+  case eBinary:
+    if (last >= 2 && last <= n && k[(last-1)*stride] < key && k[last*stride] > key)
+      return last;
+
+    lo = 2;
+    hi = n;
+    while (lo < hi) {
+      unsigned int mid = (lo+hi)/2;
+      if (k[mid*stride] < key) lo = mid+1;
+      else hi = mid;
+    }
+    break;
+  default:
+    // The walk is particularly efficient if the correct breakpoint has not
+    // changed since last frame or has only changed very little.
+    while (last > 2 && k[(last-1)*stride] > key) last--;
+    while (last < n && k[last*stride] < key) last++;
+    return last;
+  }
+
+  // If the key matches a breakpoint, the intervals on both sides of it are
+  // valid. The walk would then stay on the interval of the previous lookup.
+  hi = (lo < n && k[lo*stride] == key) ? lo+1 : lo;
+
+  if (last < lo) return lo;
+  if (last > hi) return hi;
+  return last;
+}
+
 //%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
 
 FGTable::~FGTable()
@@ -373,8 +524,6 @@ FGTable::~FGTable()
     for (unsigned int i=0; i<nTables; i++) delete Tables[i];
     Tables.clear();
   }
-  for (unsigned int r=0; r<=nRows; r++) delete[] Data[r];
-  delete[] Data;
 
   Debug(1);
 }
@@ -423,40 +572,36 @@ double FGTable::GetValue(void) const
 double FGTable::GetValue(double key) const
 {
   double Factor, Value, Span;
-  unsigned int r = lastRowIndex;
 
   //if the key is off the end of the table, just return the
   //end-of-table value, do not extrapolate
-  if( key <= Data[1][0] ) {
+  if( key <= Data[Stride] ) {
     lastRowIndex=2;
     //cout << "Key underneath table: " << key << endl;
-    return Data[1][1];
-  } else if ( key >= Data[nRows][0] ) {
+    return Data[Stride+1];
+  } else if ( key >= Data[nRows*Stride] ) {
     lastRowIndex=nRows;
     //cout << "Key over table: " << key << endl;
-    return Data[nRows][1];
+    return Data[nRows*Stride+1];
   }
 
   // the key is somewhere in the middle, search for the right breakpoint
-  // The search is particularly efficient if 
-  // the correct breakpoint has not changed since last frame or
-  // has only changed very little
-
-  while (r > 2     && Data[r-1][0] > key) { r--; }
-  while (r < nRows && Data[r][0]   < key) { r++; }
+  unsigned int r = FindIndex(eRow, key, lastRowIndex);
+  const double* lower = Data + (r-1)*Stride;
+  const double* upper = lower + Stride;
 
   lastRowIndex=r;
   // make sure denominator below does not go to zero.
 
-  Span = Data[r][0] - Data[r-1][0];
+  Span = upper[0] - lower[0];
   if (Span != 0.0) {
-    Factor = (key - Data[r-1][0]) / Span;
+    Factor = (key - lower[0]) / Span;
     if (Factor > 1.0) Factor = 1.0;
   } else {
     Factor = 1.0;
   }
 
-  Value = Factor*(Data[r][1] - Data[r-1][1]) + Data[r-1][1];
+  Value = Factor*(upper[1] - lower[1]) + lower[1];
 
   return Value;
 }
@@ -466,20 +611,16 @@ double FGTable::GetValue(double key) const
 double FGTable::GetValue(double rowKey, double colKey) const
 {
   double rFactor, cFactor, col1temp, col2temp, Value;
-  unsigned int r = lastRowIndex;
-  unsigned int c = lastColumnIndex;
-
-  while(r > 2     && Data[r-1][0] > rowKey) { r--; }
-  while(r < nRows && Data[r]  [0] < rowKey) { r++; }
-
-  while(c > 2     && Data[0][c-1] > colKey) { c--; }
-  while(c < nCols && Data[0][c]   < colKey) { c++; }
+  unsigned int r = FindIndex(eRow, rowKey, lastRowIndex);
+  unsigned int c = FindIndex(eColumn, colKey, lastColumnIndex);
+  const double* lower = Data + (r-1)*Stride;
+  const double* upper = lower + Stride;
 
   lastRowIndex=r;
   lastColumnIndex=c;
 
-  rFactor = (rowKey - Data[r-1][0]) / (Data[r][0] - Data[r-1][0]);
-  cFactor = (colKey - Data[0][c-1]) / (Data[0][c] - Data[0][c-1]);
+  rFactor = (rowKey - lower[0]) / (upper[0] - lower[0]);
+  cFactor = (colKey - Data[c-1]) / (Data[c] - Data[c-1]);
 
   if (rFactor > 1.0) rFactor = 1.0;
   else if (rFactor < 0.0) rFactor = 0.0;
@@ -487,8 +628,8 @@ double FGTable::GetValue(double rowKey, double colKey) const
   if (cFactor > 1.0) cFactor = 1.0;
   else if (cFactor < 0.0) cFactor = 0.0;
 
-  col1temp = rFactor*(Data[r][c-1] - Data[r-1][c-1]) + Data[r-1][c-1];
-  col2temp = rFactor*(Data[r][c] - Data[r-1][c]) + Data[r-1][c];
+  col1temp = rFactor*(upper[c-1] - lower[c-1]) + lower[c-1];
+  col2temp = rFactor*(upper[c] - lower[c]) + lower[c];
 
   Value = col1temp + cFactor*(col2temp - col1temp);
 
@@ -500,44 +641,126 @@ double FGTable::GetValue(double rowKey, double colKey) const
 double FGTable::GetValue(double rowKey, double colKey, double tableKey) const
 {
   double Factor, Value, Span;
-  unsigned int r = lastRowIndex;
 
   //if the key is off the end  (or before the beginning) of the table,
   // just return the boundary-table value, do not extrapolate
 
-  if( tableKey <= Data[1][1] ) {
+  if( tableKey <= Data[Stride+1] ) {
     lastRowIndex=2;
     return Tables[0]->GetValue(rowKey, colKey);
-  } else if ( tableKey >= Data[nRows][1] ) {
+  } else if ( tableKey >= Data[nRows*Stride+1] ) {
     lastRowIndex=nRows;
     return Tables[nRows-1]->GetValue(rowKey, colKey);
   }
 
   // the key is somewhere in the middle, search for the right breakpoint
-  // The search is particularly efficient if 
-  // the correct breakpoint has not changed since last frame or
-  // has only changed very little
-
-  while(r > 2     && Data[r-1][1] > tableKey) { r--; }
-  while(r < nRows && Data[r]  [1] < tableKey) { r++; }
+  unsigned int r = FindIndex(eRow, tableKey, lastRowIndex);
+  double lowerKey = Data[(r-1)*Stride+1];
 
   lastRowIndex=r;
   // make sure denominator below does not go to zero.
 
-  Span = Data[r][1] - Data[r-1][1];
+  Span = Data[r*Stride+1] - lowerKey;
   if (Span != 0.0) {
-    Factor = (tableKey - Data[r-1][1]) / Span;
+    Factor = (tableKey - lowerKey) / Span;
     if (Factor > 1.0) Factor = 1.0;
   } else {
     Factor = 1.0;
   }
 
-  Value = Factor*(Tables[r-1]->GetValue(rowKey, colKey) - Tables[r-2]->GetValue(rowKey, colKey))
-                              + Tables[r-2]->GetValue(rowKey, colKey);
+  double lowerValue = Tables[r-2]->GetValue(rowKey, colKey);
+  Value = Factor*(Tables[r-1]->GetValue(rowKey, colKey) - lowerValue) + lowerValue;
 
   return Value;
 }
 
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+// The breakpoint found for a key is the starting point of the search for the
+// next one. It is kept in a local variable rather than in lastRowIndex which,
+// being a member, would be written back to memory at each key.
+
+void FGTable::GetValues(const double* keys, double* values, unsigned int n) const
+{
+  const double* first = Data + Stride;
+  const double* last = Data + nRows*Stride;
+  unsigned int r = lastRowIndex;
+
+  for (unsigned int i=0; i<n; i++) {
+    double key = keys[i];
+
+    // Off the table, the end-of-table value is returned.
+    if (key <= first[0]) {
+      r = 2;
+      values[i] = first[1];
+      continue;
+    } else if (key >= last[0]) {
+      r = nRows;
+      values[i] = last[1];
+      continue;
+    }
+
+    r = FindIndex(eRow, key, r);
+    const double* lower = Data + (r-1)*Stride;
+    const double* upper = lower + Stride;
+
+    double Span = upper[0] - lower[0];
+    double Factor = 1.0;
+    if (Span != 0.0) {
+      Factor = (key - lower[0]) / Span;
+      if (Factor > 1.0) Factor = 1.0;
+    }
+
+    values[i] = Factor*(upper[1] - lower[1]) + lower[1];
+  }
+
+  lastRowIndex = r;
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+void FGTable::GetValues(const double* rowKeys, const double* colKeys,
+                        double* values, unsigned int n) const
+{
+  unsigned int r = lastRowIndex;
+  unsigned int c = lastColumnIndex;
+
+  for (unsigned int i=0; i<n; i++) {
+    double rowKey = rowKeys[i];
+    double colKey = colKeys[i];
+    r = FindIndex(eRow, rowKey, r);
+    c = FindIndex(eColumn, colKey, c);
+
+    const double* lower = Data + (r-1)*Stride;
+    const double* upper = lower + Stride;
+    double rFactor = (rowKey - lower[0]) / (upper[0] - lower[0]);
+    double cFactor = (colKey - Data[c-1]) / (Data[c] - Data[c-1]);
+
+    if (rFactor > 1.0) rFactor = 1.0;
+    else if (rFactor < 0.0) rFactor = 0.0;
+
+    if (cFactor > 1.0) cFactor = 1.0;
+    else if (cFactor < 0.0) cFactor = 0.0;
+
+    double col1temp = rFactor*(upper[c-1] - lower[c-1]) + lower[c-1];
+    double col2temp = rFactor*(upper[c] - lower[c]) + lower[c];
+
+    values[i] = col1temp + cFactor*(col2temp - col1temp);
+  }
+
+  lastRowIndex = r;
+  lastColumnIndex = c;
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+void FGTable::GetValues(const double* rowKeys, const double* colKeys,
+                        const double* tableKeys, double* values,
+                        unsigned int n) const
+{
+  for (unsigned int i=0; i<n; i++)
+    values[i] = GetValue(rowKeys[i], colKeys[i], tableKeys[i]);
+}
+
 //%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
 
 void FGTable::operator<<(istream& in_stream)
@@ -551,10 +774,12 @@ void FGTable::operator<<(istream& in_stream)
   for (unsigned int r=startRow; r<=nRows; r++) {
     for (unsigned int c=startCol; c<=nCols; c++) {
       if (r != 0 || c != 0) {
-        in_stream >> Data[r][c];
+        in_stream >> Data[r*Stride+c];
       }
     }
   }
+
+  SelectSearch();
 }
 
 //%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
@@ -563,10 +788,12 @@ void FGTable::operator<<(istream& in_stream)
 
 FGTable& FGTable::operator<<(const double n)
 {
-  Data[rowCounter][colCounter] = n;
+  Data[rowCounter*Stride+colCounter] = n;
   if (colCounter == (int)nCols) {
     colCounter = 0;
     rowCounter++;
+    // The table is full: the breakpoints are known.
+    if (rowCounter > (int)nRows) SelectSearch();
   } else {
     colCounter++;
   }
@@ -617,7 +844,7 @@ void FGTable::Print(void)
       if (r == 0 && c == 0) {
         cout << "	";
       } else {
-        cout << Data[r][c] << "	";
+        cout << Data[r*Stride+c] << "	";
         if (Type == tt3D) {
           cout << endl;
           Tables[r-1]->Print();
@@ -631,12 +858,35 @@ void FGTable::Print(void)
 
 //%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
 
+string FGTable::GetSignature(void) const
+{
+  ostringstream buf;
+
+  buf << setprecision(17) << Type << ":" << nRows << "x" << nCols << "[";
+  for (unsigned int i=0; i<3; i++)
+    buf << (const FGPropertyNode*)lookupProperty[i] << ",";
+  buf << "]";
+
+  for (unsigned int r=0; r<=nRows; r++) {
+    for (unsigned int c=0; c<=nCols; c++)
+      buf << Data[r*Stride+c] << " ";
+  }
+
+  for (unsigned int i=0; i<Tables.size(); i++)
+    buf << "{" << Tables[i]->GetSignature() << "}";
+
+  return buf.str();
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
 void FGTable::bind(void)
 {
   typedef double (FGTable::*PMF)(void) const;
   if ( !Name.empty() && !internal) {
     string tmp = PropertyManager->mkPropertyName(Name, false); // Allow upper
     PropertyManager->Tie( tmp, this, (PMF)&FGTable::GetValue);
+    pNode = PropertyManager->GetNode(tmp);
   }
 }
 //%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
@@ -232,6 +232,23 @@ referring to combustion efficiency). Later on, the table is used like this:
 combustion_efficiency = Lookup_Combustion_Efficiency->GetValue(equivalence_ratio);
 @endcode
 
+The breakpoints and the values of a table are stored in a single contiguous
+block of memory, aligned on a cache line. Once the table is filled, a search
+strategy is selected for each of its axes:
+- the breakpoints that are evenly spaced are found in constant time,
+- the breakpoints of the small tables are found by walking from the breakpoint
+  found by the previous lookup,
+- the breakpoints of the large tables are found by a binary search.
+Whatever the strategy, the lookup returns exactly the same value.
+
+Several keys can be looked up at once with GetValues():
+
+@code
+double alpha[4] = {0.0, 0.05, 0.1, 0.15};
+double cl[4];
+CLalpha->GetValues(alpha, cl, 4);
+@endcode
+
 @author Jon S. Berndt
 @version $Id$
 */
@@ -258,6 +275,35 @@ public:
   double GetValue(double key) const;
   double GetValue(double rowKey, double colKey) const;
   double GetValue(double rowKey, double colKey, double TableKey) const;
+
+  /** Looks up several keys in a 1D table.
+      The result is the same as calling GetValue(double) for each key in turn.
+      @param keys an array of n keys
+      @param values an array where the n values are returned
+      @param n the number of keys */
+  void GetValues(const double* keys, double* values, unsigned int n) const;
+
+  /** Looks up several pairs of keys in a 2D table.
+      The result is the same as calling GetValue(double,double) for each pair
+      of keys in turn.
+      @param rowKeys an array of n row keys
+      @param colKeys an array of n column keys
+      @param values an array where the n values are returned
+      @param n the number of keys */
+  void GetValues(const double* rowKeys, const double* colKeys, double* values,
+                 unsigned int n) const;
+
+  /** Looks up several triplets of keys in a 3D table.
+      The result is the same as calling GetValue(double,double,double) for
+      each triplet of keys in turn.
+      @param rowKeys an array of n row keys
+      @param colKeys an array of n column keys
+      @param tableKeys an array of n table keys
+      @param values an array where the n values are returned
+      @param n the number of keys */
+  void GetValues(const double* rowKeys, const double* colKeys,
+                 const double* tableKeys, double* values, unsigned int n) const;
+
   /** Read the table in.
       Data in the config file should be in matrix format with the row
       independents as the first column and the column independents in
@@ -284,7 +330,7 @@ public:
   FGTable& operator<<(const double n);
   FGTable& operator<<(const int n);
 
-  inline double GetElement(int r, int c) const {return Data[r][c];}
+  inline double GetElement(int r, int c) const {return Data[r*Stride+c];}
 //  inline double GetElement(int r, int c, int t);
 
   double operator()(unsigned int r, unsigned int c) const {return GetElement(r, c);}
@@ -295,23 +341,50 @@ public:
 
   unsigned int GetNumRows() const {return nRows;}
 
+  /** Returns the property used to lookup the table along an axis.
+      @param axis 0 for the rows, 1 for the columns and 2 for the tables.
+      @return a pointer to the property node or 0 if the axis is not used. */
+  FGPropertyNode* GetLookupProperty(int axis) const
+  {return (axis >= 0 && axis < 3) ? (FGPropertyNode*)lookupProperty[axis] : 0;}
+
+  /** Returns a string that identifies the lookup properties and the data of
+      the table. Two tables with the same signature return the same values. */
+  std::string GetSignature(void) const;
+
   void Print(void);
 
   std::string GetName(void) const {return Name;}
 
+  /// Returns the property to which the table is bound (NULL if unnamed).
+  FGPropertyNode* GetBoundProperty(void) const { return pNode; }
+
 private:
   enum type {tt1D, tt2D, tt3D} Type;
   enum axis {eRow=0, eColumn, eTable};
+  enum search {eWalk, eBinary, eUniform};
   bool internal;
   FGPropertyNode_ptr lookupProperty[3];
-  double** Data;
+  // The memory block of the data. The block of a table that is read from the
+  // files of a model is shared by the instances that load the same model and
+  // must not be modified.
+  struct DataBlock;
+  double* Data;       // (nRows+1)x(nCols+1) elements stored row by row
+  SGSharedPtr<DataBlock> Block;
+  unsigned int Stride;
   std::vector <FGTable*> Tables;
   unsigned int nRows, nCols, nTables, dimension;
   int colCounter, rowCounter, tableCounter;
   mutable int lastRowIndex, lastColumnIndex, lastTableIndex;
-  double** Allocate(void);
+  search Search[2];
+  double InvStep[2];  // Inverse of the breakpoints spacing for eUniform
+  double* Allocate(void);
+  void ReadData(Element* tableData);
+  const double* GetBreakpoints(int axis, unsigned int& stride, unsigned int& n) const;
+  void SelectSearch(void);
+  unsigned int FindIndex(int axis, double key, unsigned int last) const;
   FGPropertyManager* const PropertyManager;
   std::string Name;
+  FGPropertyNode_ptr pNode;
   void bind(void);
 
   unsigned int FindNumColumns(const std::string&);
@@ -55,6 +55,7 @@ INCLUDES
 #include "FGAccelerations.h"
 #include "FGFDMExec.h"
 #include "input_output/FGPropertyManager.h"
+#include "input_output/FGSnapshot.h"
 
 using namespace std;
 
@@ -388,6 +389,26 @@ void FGAccelerations::bind(void)
   PropertyManager->Tie("forces/hold-down", this, &FGAccelerations::GetHoldDown, &FGAccelerations::SetHoldDown);
 }
 
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+void FGAccelerations::ArchiveState(FGSnapshot& snapshot)
+{
+  FGModel::ArchiveState(snapshot);
+  snapshot.Archive(in);
+  snapshot.Archive(vPQRdot);
+  snapshot.Archive(vPQRidot);
+  snapshot.Archive(vUVWdot);
+  snapshot.Archive(vUVWidot);
+  snapshot.Archive(vQtrndot);
+  snapshot.Archive(vBodyAccel);
+  snapshot.Archive(vGravAccel);
+  snapshot.Archive(vFrictionForces);
+  snapshot.Archive(vFrictionMoments);
+  snapshot.Archive(gravType);
+  snapshot.Archive(gravTorque);
+  snapshot.Archive(HoldDown);
+}
+
 //%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
 //    The bitmasked value choices are as follows:
 //    unset: In this case (the default) JSBSim would only print
@@ -58,6 +58,8 @@ FORWARD DECLARATIONS
 
 namespace JSBSim {
 
+class FGSnapshot;
+
 /*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
 CLASS DOCUMENTATION
 %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
@@ -134,6 +136,7 @@ public:
                      "Resume" command to be given.
       @return false if no error */
   bool Run(bool Holding);
+  void ArchiveState(FGSnapshot& snapshot);
 
   /** Retrieves the time derivative of the body orientation quaternion.
       Retrieves the time derivative of the body orientation quaternion based on
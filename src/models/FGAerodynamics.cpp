@@ -45,6 +45,8 @@ INCLUDES
 #include "FGAerodynamics.h"
 #include "input_output/FGPropertyManager.h"
 #include "input_output/FGXMLElement.h"
+#include "math/FGFunctionOptimizer.h"
+#include "input_output/FGSnapshot.h"
 
 using namespace std;
 
@@ -315,7 +317,7 @@ bool FGAerodynamics::Load(Element *document)
 
   if ((temp_element = document->FindElement("aero_ref_pt_shift_x"))) {
     function_element = temp_element->FindElement("function");
-    AeroRPShift = new FGFunction(PropertyManager, function_element);
+    AeroRPShift = new FGFunction(FDMExec, function_element);
   }
 
   axis_element = document->FindElement("axis");
@@ -332,7 +334,7 @@ bool FGAerodynamics::Load(Element *document)
       }
       if (!apply_at_cg) {
       try {
-        ca.push_back( new FGFunction(PropertyManager, function_element) );
+        ca.push_back( new FGFunction(FDMExec, function_element) );
       } catch (string const str) {
         cerr << endl << fgred << "Error loading aerodynamic function in " 
              << current_func_name << ":" << str << " Aborting." << reset << endl;
@@ -340,7 +342,7 @@ bool FGAerodynamics::Load(Element *document)
       }
       } else {
         try {
-          ca_atCG.push_back( new FGFunction(PropertyManager, function_element) );
+          ca_atCG.push_back( new FGFunction(FDMExec, function_element) );
         } catch (string const str) {
           cerr << endl << fgred << "Error loading aerodynamic function in " 
                << current_func_name << ":" << str << " Aborting." << reset << endl;
@@ -354,7 +356,7 @@ bool FGAerodynamics::Load(Element *document)
     axis_element = document->FindNextElement("axis");
   }
 
-  PostLoad(document, PropertyManager); // Perform base class Post-Load
+  PostLoad(document, FDMExec); // Perform base class Post-Load
 
   return true;
 }
@@ -472,6 +474,38 @@ string FGAerodynamics::GetAeroFunctionValues(const string& delimeter) const
 
 //%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
 
+void FGAerodynamics::RegisterFunctions(FGFunctionOptimizer& optimizer) const
+{
+  for (unsigned int axis = 0; axis < 6; axis++) {
+    for (unsigned int sd = 0; sd < AeroFunctions[axis].size(); sd++)
+      optimizer.AddFunction(AeroFunctions[axis][sd]);
+    for (unsigned int sd = 0; sd < AeroFunctionsAtCG[axis].size(); sd++)
+      optimizer.AddFunction(AeroFunctionsAtCG[axis][sd]);
+  }
+
+  optimizer.AddFunction(AeroRPShift);
+
+  FGModelFunctions::RegisterFunctions(optimizer);
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+void FGAerodynamics::CollectParameters(vector<const FGParameter*>& params) const
+{
+  for (unsigned int axis = 0; axis < 6; axis++) {
+    params.insert(params.end(), AeroFunctions[axis].begin(),
+                  AeroFunctions[axis].end());
+    params.insert(params.end(), AeroFunctionsAtCG[axis].begin(),
+                  AeroFunctionsAtCG[axis].end());
+  }
+
+  if (AeroRPShift) params.push_back(AeroRPShift);
+
+  FGModelFunctions::CollectParameters(params);
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
 void FGAerodynamics::bind(void)
 {
   typedef double (FGAerodynamics::*PMF)(int) const;
@@ -497,6 +531,36 @@ void FGAerodynamics::bind(void)
   PropertyManager->Tie("aero/stall-hyst-norm", this, &FGAerodynamics::GetHysteresisParm);
 }
 
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+void FGAerodynamics::ArchiveState(FGSnapshot& snapshot)
+{
+  FGModel::ArchiveState(snapshot);
+  snapshot.Archive(in);
+  snapshot.Archive(vFnative);
+  snapshot.Archive(vFw);
+  snapshot.Archive(vForces);
+  snapshot.Archive(vFwAtCG);
+  snapshot.Archive(vFnativeAtCG);
+  snapshot.Archive(vForcesAtCG);
+  snapshot.Archive(vMoments);
+  snapshot.Archive(vMomentsMRC);
+  snapshot.Archive(vDXYZcg);
+  snapshot.Archive(vDeltaRP);
+  snapshot.Archive(alphaclmax);
+  snapshot.Archive(alphaclmin);
+  snapshot.Archive(alphahystmax);
+  snapshot.Archive(alphahystmin);
+  snapshot.Archive(impending_stall);
+  snapshot.Archive(stall_hyst);
+  snapshot.Archive(bi2vel);
+  snapshot.Archive(ci2vel);
+  snapshot.Archive(alphaw);
+  snapshot.Archive(clsq);
+  snapshot.Archive(lod);
+  snapshot.Archive(qbar_area);
+}
+
 //%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
 //    The bitmasked value choices are as follows:
 //    unset: In this case (the default) JSBSim would only print
@@ -59,6 +59,8 @@ FORWARD DECLARATIONS
 
 namespace JSBSim {
 
+class FGSnapshot;
+
 /*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
 CLASS DOCUMENTATION
 %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
@@ -135,6 +137,7 @@ public:
                      "Resume" command to be given.
       @return false if no error */
   bool Run(bool Holding);
+  void ArchiveState(FGSnapshot& snapshot);
 
   /** Loads the Aerodynamics model.
       The Load function for this class expects the XML parser to
@@ -212,6 +215,14 @@ public:
 
   std::vector <FGFunction*> * GetAeroFunctions(void) const { return AeroFunctions; }
 
+  /** Registers the aerodynamic functions to the function optimizer.
+      @param optimizer the optimizer to which the functions are registered. */
+  void RegisterFunctions(FGFunctionOptimizer& optimizer) const;
+
+  /** Collects the aerodynamic functions.
+      @param params the list to which the functions are appended. */
+  void CollectParameters(std::vector<const FGParameter*>& params) const;
+
   struct Inputs {
     double Alpha;
     double Beta;
@@ -47,6 +47,7 @@ INCLUDES
 #include "FGFDMExec.h"
 #include "input_output/FGPropertyManager.h"
 #include "input_output/FGXMLElement.h"
+#include "input_output/FGSnapshot.h"
 
 using namespace std;
 
@@ -182,7 +183,7 @@ bool FGAircraft::Load(Element* el)
     }
   }
 
-  PostLoad(el, PropertyManager);
+  PostLoad(el, FDMExec);
 
   Debug(2);
 
@@ -218,6 +219,20 @@ void FGAircraft::bind(void)
   PropertyManager->Tie("metrics/visualrefpoint-z-in", this, eZ, (PMF)&FGAircraft::GetXYZvrp);
 }
 
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+void FGAircraft::ArchiveState(FGSnapshot& snapshot)
+{
+  FGModel::ArchiveState(snapshot);
+  snapshot.Archive(in);
+  snapshot.Archive(vMoments);
+  snapshot.Archive(vForces);
+  snapshot.Archive(vXYZrp);
+  snapshot.Archive(vXYZvrp);
+  snapshot.Archive(vXYZep);
+  snapshot.Archive(vDXYZcg);
+}
+
 //%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
 //    The bitmasked value choices are as follows:
 //    unset: In this case (the default) JSBSim would only print
@@ -55,6 +55,8 @@ FORWARD DECLARATIONS
 
 namespace JSBSim {
 
+class FGSnapshot;
+
 /*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
 CLASS DOCUMENTATION
 %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
@@ -125,6 +127,7 @@ public:
       @see JSBSim.cpp documentation
       @return false if no error */
   bool Run(bool Holding);
+  void ArchiveState(FGSnapshot& snapshot);
 
   bool InitModel(void);
 
@@ -47,6 +47,7 @@ INCLUDES
 #include <cstdlib>
 #include "FGFDMExec.h"
 #include "FGAtmosphere.h"
+#include "input_output/FGSnapshot.h"
 
 namespace JSBSim {
 
@@ -64,6 +65,7 @@ FGAtmosphere::FGAtmosphere(FGFDMExec* fdmex) : FGModel(fdmex),
                                                Beta(2.269690E-08)          // slug/(sec ft R^0.5)
 {
   Name = "FGAtmosphere";
+  in.fieldTemperature = 0.0;
 
   bind();
   Debug(0);
@@ -114,9 +116,12 @@ bool FGAtmosphere::Run(bool Holding)
 void FGAtmosphere::Calculate(double altitude)
 {
   FGPropertyNode* node = PropertyManager->GetNode();
-  if (!PropertyManager->HasNode("atmosphere/override/temperature"))
-    Temperature = GetTemperature(altitude);
-  else
+  if (!PropertyManager->HasNode("atmosphere/override/temperature")) {
+    if (in.fieldTemperature > 0.0)
+      Temperature = in.fieldTemperature;
+    else
+      Temperature = GetTemperature(altitude);
+  } else
     Temperature = node->GetDouble("atmosphere/override/temperature");
 
   if (!PropertyManager->HasNode("atmosphere/override/pressure"))
@@ -266,6 +271,30 @@ void FGAtmosphere::bind(void)
   PropertyManager->Tie("atmosphere/pressure-altitude", this, &FGAtmosphere::GetPressureAltitude);
 }
 
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+void FGAtmosphere::ArchiveState(FGSnapshot& snapshot)
+{
+  FGModel::ArchiveState(snapshot);
+  snapshot.Archive(in);
+  snapshot.Archive(SLtemperature);
+  snapshot.Archive(SLdensity);
+  snapshot.Archive(SLpressure);
+  snapshot.Archive(SLsoundspeed);
+  snapshot.Archive(Temperature);
+  snapshot.Archive(Density);
+  snapshot.Archive(Pressure);
+  snapshot.Archive(Soundspeed);
+  snapshot.Archive(rSLtemperature);
+  snapshot.Archive(rSLdensity);
+  snapshot.Archive(rSLpressure);
+  snapshot.Archive(rSLsoundspeed);
+  snapshot.Archive(PressureAltitude);
+  snapshot.Archive(DensityAltitude);
+  snapshot.Archive(Viscosity);
+  snapshot.Archive(KinematicViscosity);
+}
+
 //%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
 //    The bitmasked value choices are as follows:
 //    unset: In this case (the default) JSBSim would only print
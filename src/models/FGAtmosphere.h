@@ -53,6 +53,8 @@ FORWARD DECLARATIONS
 
 namespace JSBSim {
 
+class FGSnapshot;
+
 /*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
 CLASS DOCUMENTATION
 %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
@@ -104,6 +106,7 @@ public:
                      "Resume" command to be given.
       @return false if no error */
   bool Run(bool Holding);
+  void ArchiveState(FGSnapshot& snapshot);
 
   bool InitModel(void);
 
@@ -216,6 +219,7 @@ public:
 
   struct Inputs {
     double altitudeASL;
+    double fieldTemperature; ///< temperature of the wind field, 0 if none
   } in;
 
 protected:
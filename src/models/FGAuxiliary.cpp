@@ -45,7 +45,9 @@ INCLUDES
 #include "FGAuxiliary.h"
 #include "initialization/FGInitialCondition.h"
 #include "FGFDMExec.h"
+#include "FGInertial.h"
 #include "input_output/FGPropertyManager.h"
+#include "input_output/FGSnapshot.h"
 
 using namespace std;
 
@@ -337,11 +339,18 @@ double FGAuxiliary::GetNlf(void) const
 
 //%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
 
+double FGAuxiliary::GethVRP(void) const
+{
+  return FDMExec->GetInertial()->GetAltitudeASL(vLocationVRP);
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
 double FGAuxiliary::GetLongitudeRelativePosition(void) const
 {
   FGLocation source(FDMExec->GetIC()->GetLongitudeRadIC(),
                     FDMExec->GetIC()->GetLatitudeRadIC(),
-                    in.vLocation.GetSeaLevelRadius());
+                    FDMExec->GetInertial()->GetSeaLevelRadius(in.vLocation));
   return source.GetDistanceTo(in.vLocation.GetLongitude(),
                               FDMExec->GetIC()->GetLatitudeRadIC()) * fttom;
 }
@@ -352,7 +361,7 @@ double FGAuxiliary::GetLatitudeRelativePosition(void) const
 {
   FGLocation source(FDMExec->GetIC()->GetLongitudeRadIC(),
                     FDMExec->GetIC()->GetLatitudeRadIC(),
-                    in.vLocation.GetSeaLevelRadius());
+                    FDMExec->GetInertial()->GetSeaLevelRadius(in.vLocation));
   return source.GetDistanceTo(FDMExec->GetIC()->GetLongitudeRadIC(),
                               in.vLocation.GetLatitude()) * fttom;
 }
@@ -363,7 +372,7 @@ double FGAuxiliary::GetDistanceRelativePosition(void) const
 {
   FGLocation source(FDMExec->GetIC()->GetLongitudeRadIC(),
                     FDMExec->GetIC()->GetLatitudeRadIC(),
-                    in.vLocation.GetSeaLevelRadius());
+                    FDMExec->GetInertial()->GetSeaLevelRadius(in.vLocation));
   return source.GetDistanceTo(in.vLocation.GetLongitude(),
                               in.vLocation.GetLatitude()) * fttom;
 }
@@ -441,6 +450,57 @@ double FGAuxiliary::BadUnits(void) const
   cerr << "Bad units" << endl; return 0.0;
 }
 
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+void FGAuxiliary::ArchiveState(FGSnapshot& snapshot)
+{
+  FGModel::ArchiveState(snapshot);
+  snapshot.Archive(in);
+  snapshot.Archive(vcas);
+  snapshot.Archive(veas);
+  snapshot.Archive(vtrue);
+  snapshot.Archive(pt);
+  snapshot.Archive(tat);
+  snapshot.Archive(tatc);
+  snapshot.Archive(mTw2b);
+  snapshot.Archive(mTb2w);
+  snapshot.Archive(mTw2p);
+  snapshot.Archive(vPilotAccel);
+  snapshot.Archive(vPilotAccelN);
+  snapshot.Archive(vNcg);
+  snapshot.Archive(vNwcg);
+  snapshot.Archive(vAeroPQR);
+  snapshot.Archive(vAeroUVW);
+  snapshot.Archive(vEuler);
+  snapshot.Archive(vEulerRates);
+  snapshot.Archive(vMachUVW);
+  snapshot.Archive(vWindUVW);
+  snapshot.Archive(vPitotUVW);
+  snapshot.Archive(vLocationVRP);
+  snapshot.Archive(Vt);
+  snapshot.Archive(Vground);
+  snapshot.Archive(Vpitot);
+  snapshot.Archive(Mach);
+  snapshot.Archive(MachU);
+  snapshot.Archive(MachPitot);
+  snapshot.Archive(qbar);
+  snapshot.Archive(qbarUW);
+  snapshot.Archive(qbarUV);
+  snapshot.Archive(Re);
+  snapshot.Archive(alpha);
+  snapshot.Archive(beta);
+  snapshot.Archive(adot);
+  snapshot.Archive(bdot);
+  snapshot.Archive(psigt);
+  snapshot.Archive(gamma);
+  snapshot.Archive(Nz);
+  snapshot.Archive(Ny);
+  snapshot.Archive(seconds_in_day);
+  snapshot.Archive(day_of_year);
+  snapshot.Archive(hoverbcg);
+  snapshot.Archive(hoverbmac);
+}
+
 //%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
 //    The bitmasked value choices are as follows:
 //    unset: In this case (the default) JSBSim would only print
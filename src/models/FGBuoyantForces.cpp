@@ -42,6 +42,7 @@ INCLUDES
 #include "FGMassBalance.h"
 #include "input_output/FGPropertyManager.h"
 #include "input_output/FGXMLElement.h"
+#include "input_output/FGSnapshot.h"
 
 using namespace std;
 
@@ -104,7 +105,7 @@ bool FGBuoyantForces::Run(bool Holding)
   vTotalMoments.InitMatrix();
 
   for (unsigned int i=0; i<Cells.size(); i++) {
-    Cells[i]->Calculate(FDMExec->GetDeltaT());
+    Cells[i]->Calculate(FDMExec->GetDeltaT()*rate);
     vTotalForces  += Cells[i]->GetBodyForces();
     vTotalMoments += Cells[i]->GetMoments();
   }
@@ -133,7 +134,7 @@ bool FGBuoyantForces::Load(Element *document)
     gas_cell_element = document->FindNextElement("gas_cell");
   }
   
-  PostLoad(document, PropertyManager);
+  PostLoad(document, FDMExec);
 
   if (!NoneDefined) {
     bind();
@@ -263,6 +264,31 @@ void FGBuoyantForces::bind(void)
                        (PGF)&FGBuoyantForces::GetForces, (PSF)0, false);
 }
 
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+void FGBuoyantForces::ArchiveState(FGSnapshot& snapshot)
+{
+  FGModel::ArchiveState(snapshot);
+  snapshot.Archive(in);
+  snapshot.Archive(vTotalForces);
+  snapshot.Archive(vTotalMoments);
+  snapshot.Archive(gasCellJ);
+  snapshot.Archive(vGasCellXYZ);
+  snapshot.Archive(vXYZgasCell_arm);
+
+  for (unsigned int i=0; i<Cells.size(); i++) Cells[i]->ArchiveState(snapshot);
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+void FGBuoyantForces::CollectParameters(vector<const FGParameter*>& params) const
+{
+  for (unsigned int i=0; i<Cells.size(); i++)
+    Cells[i]->CollectParameters(params);
+
+  FGModelFunctions::CollectParameters(params);
+}
+
 //%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
 //    The bitmasked value choices are as follows:
 //    unset: In this case (the default) JSBSim would only print
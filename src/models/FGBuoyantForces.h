@@ -58,6 +58,8 @@ FORWARD DECLARATIONS
 
 namespace JSBSim {
 
+class FGSnapshot;
+
 /*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
 CLASS DOCUMENTATION
 %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
@@ -122,6 +124,11 @@ public:
                      "Resume" command to be given.
       @return false if no error */
   bool Run(bool Holding);
+  void ArchiveState(FGSnapshot& snapshot);
+
+  /** Collects the parameters of the model and of the gas cells.
+      @param params the list to which the parameters are appended. */
+  void CollectParameters(std::vector<const FGParameter*>& params) const;
 
   /** Loads the Buoyant forces model.
       The Load function for this class expects the XML parser to
@@ -54,6 +54,7 @@
 
 #include "FGExternalForce.h"
 #include "input_output/FGXMLElement.h"
+#include "input_output/FGSnapshot.h"
 #include <iostream>
 
 using namespace std;
@@ -89,7 +90,7 @@ FGExternalForce::FGExternalForce(FGFDMExec *FDMExec, Element *el, int index)
 
   function_element = el->FindElement("function");
   if (function_element) {
-    Magnitude_Function = new FGFunction(PropertyManager, function_element);
+    Magnitude_Function = new FGFunction(fdmex, function_element);
   } else {
     PropertyManager->Tie( BasePropertyName + "/magnitude",(FGExternalForce*)this, &FGExternalForce::GetMagnitude, &FGExternalForce::SetMagnitude);
   }
@@ -178,6 +179,23 @@ const FGColumnVector3& FGExternalForce::GetBodyForces(void)
   return FGForce::GetBodyForces();
 }
 
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+void FGExternalForce::ArchiveState(FGSnapshot& snapshot)
+{
+  FGForce::ArchiveState(snapshot);
+  snapshot.Archive(vDirection);
+  snapshot.Archive(magnitude);
+  snapshot.Archive(azimuth);
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+void FGExternalForce::CollectParameters(vector<const FGParameter*>& params) const
+{
+  if (Magnitude_Function) params.push_back(Magnitude_Function);
+}
+
 //%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
 //    The bitmasked value choices are as follows:
 //    unset: In this case (the default) JSBSim would only print
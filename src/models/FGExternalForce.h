@@ -59,6 +59,9 @@ FORWARD DECLARATIONS
 
 namespace JSBSim {
 
+class FGSnapshot;
+class FGParameter;
+
 /*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
 CLASS DOCUMENTATION
 %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
@@ -164,6 +167,12 @@ public:
   void SetAzimuth(double az) {azimuth = az;}
 
   const FGColumnVector3& GetBodyForces(void);
+  void ArchiveState(FGSnapshot& snapshot);
+
+  /** Collects the magnitude function of the force (see FGModelFunctions::CollectParameters).
+      @param params the list to which the parameters are appended. */
+  void CollectParameters(std::vector<const FGParameter*>& params) const;
+
   double GetMagnitude(void) const {return magnitude;}
   double GetAzimuth(void) const {return azimuth;}
   double GetX(void) const {return vDirection(eX);}
@@ -41,6 +41,7 @@ INCLUDES
 
 #include "FGExternalReactions.h"
 #include "input_output/FGXMLElement.h"
+#include "input_output/FGSnapshot.h"
 
 using namespace std;
 
@@ -89,7 +90,7 @@ bool FGExternalReactions::Load(Element* el)
     force_element = el->FindNextElement("force");
   }
 
-  PostLoad(el, PropertyManager);
+  PostLoad(el, FDMExec);
 
   if (!NoneDefined) bind();
 
@@ -155,6 +156,27 @@ void FGExternalReactions::bind(void)
 }
 
 
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+void FGExternalReactions::ArchiveState(FGSnapshot& snapshot)
+{
+  FGModel::ArchiveState(snapshot);
+  snapshot.Archive(vTotalForces);
+  snapshot.Archive(vTotalMoments);
+
+  for (unsigned int i=0; i<Forces.size(); i++) Forces[i]->ArchiveState(snapshot);
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+void FGExternalReactions::CollectParameters(vector<const FGParameter*>& params) const
+{
+  for (unsigned int i=0; i<Forces.size(); i++)
+    Forces[i]->CollectParameters(params);
+
+  FGModelFunctions::CollectParameters(params);
+}
+
 //%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
 //    The bitmasked value choices are as follows:
 //    unset: In this case (the default) JSBSim would only print
@@ -55,6 +55,7 @@ FORWARD DECLARATIONS
 namespace JSBSim {
 
 class Element;
+class FGSnapshot;
 
 /*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
 CLASS DOCUMENTATION
@@ -139,6 +140,12 @@ public:
                      "Resume" command to be given.
       @return true always.  */
   bool Run(bool Holding);
+  void ArchiveState(FGSnapshot& snapshot);
+
+  /** Collects the parameters of the model and of the external forces.
+      @param params the list to which the parameters are appended. */
+  void CollectParameters(std::vector<const FGParameter*>& params) const;
+
   
   /** Loads the external forces from the XML configuration file.
       If the external_reactions section is encountered in the vehicle configuration
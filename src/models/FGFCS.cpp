@@ -65,6 +65,8 @@ INCLUDES
 #include "models/flight_control/FGDistributor.h"
 
 #include "FGFCSChannel.h"
+#include "math/FGFunctionOptimizer.h"
+#include "input_output/FGSnapshot.h"
 
 using namespace std;
 
@@ -82,6 +84,9 @@ FGFCS::FGFCS(FGFDMExec* fdmex) : FGModel(fdmex)
   int i;
   Name = "FGFCS";
   systype = stFCS;
+  SystemRate = ChannelRate = 1;
+  SystemPhase = 0;
+  SystemPhased = false;
 
   DaCmd = DeCmd = DrCmd = DsCmd = DfCmd = DsbCmd = DspCmd = 0;
   PTrimCmd = YTrimCmd = RTrimCmd = 0.0;
@@ -511,6 +516,16 @@ bool FGFCS::Load(Element* document)
 
     string sOnOffProperty = channel_element->GetAttributeValue("execute");
     string sChannelName = channel_element->GetAttributeValue("name");
+
+    unsigned int channelRate = SystemRate, channelPhase = 0;
+    if (!ReadSchedule(channel_element, channelRate, channelPhase)) return false;
+    if (!channel_element->HasAttribute("phase")) {
+      if (SystemPhased)
+        channelPhase = SystemPhase % channelRate;
+      else if (channelRate > 1)
+        channelPhase = ChannelsPerRate[channelRate]++ % channelRate;
+    }
+
     if (sOnOffProperty.length() > 0) {
       FGPropertyNode* OnOffPropertyNode = PropertyManager->GetNode(sOnOffProperty);
       if (OnOffPropertyNode == 0) {
@@ -520,17 +535,26 @@ bool FGFCS::Load(Element* document)
              << "understood. The simulation will abort" << reset << endl;
         throw("Bad system definition");
       } else {
-        newChannel = new FGFCSChannel(sChannelName, OnOffPropertyNode);
+        newChannel = new FGFCSChannel(sChannelName, OnOffPropertyNode,
+                                      channelRate, channelPhase);
       }
     } else {
-      newChannel = new FGFCSChannel(sChannelName);
+      newChannel = new FGFCSChannel(sChannelName, 0, channelRate, channelPhase);
     }
 
     SystemChannels.push_back(newChannel);
 
-    if (debug_lvl > 0)
+    if (debug_lvl > 0) {
       cout << endl << highint << fgblue << "    Channel " 
-         << normint << channel_element->GetAttributeValue("name") << reset << endl;
+         << normint << channel_element->GetAttributeValue("name") << reset;
+      if (channelRate > 1)
+        cout << " (every " << channelRate << " frames, phase " << channelPhase
+             << ")";
+      cout << endl;
+    }
+
+    // The components read the time step when they are created.
+    ChannelRate = channelRate;
   
     Element* component_element = channel_element->GetElement();
     while (component_element) {
@@ -583,14 +607,16 @@ bool FGFCS::Load(Element* document)
       } catch(string& s) {
         cerr << highint << fgred << endl << "  " << s << endl;
         cerr << reset << endl;
+        ChannelRate = 1;
         return false;
       }
       component_element = channel_element->GetNextElement();
     }
+    ChannelRate = 1;
     channel_element = document->FindNextElement("channel");
   }
 
-  PostLoad(document, PropertyManager);
+  PostLoad(document, FDMExec);
 
   return true;
 }
@@ -692,7 +718,50 @@ void FGFCS::AddGear(unsigned int NumGear)
 
 double FGFCS::GetDt(void)
 {
-  return FDMExec->GetDeltaT()*rate;
+  return FDMExec->GetDeltaT()*rate*ChannelRate;
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+// The FCS model is shared by all the <system>, <autopilot> and <flight_control>
+// elements so their rate and phase are those of their channels rather than the
+// rate of the model.
+
+bool FGFCS::LoadSchedule(Element* el)
+{
+  SystemRate = 1;
+  SystemPhase = 0;
+  SystemPhased = el->HasAttribute("phase");
+
+  return ReadSchedule(el, SystemRate, SystemPhase);
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+void FGFCS::RegisterFunctions(FGFunctionOptimizer& optimizer) const
+{
+  for (unsigned int i=0; i<SystemChannels.size(); i++) {
+    for (unsigned int c=0; c<SystemChannels[i]->GetNumComponents(); c++) {
+      FGFCSFunction* component = dynamic_cast<FGFCSFunction*>(SystemChannels[i]->GetComponent(c));
+      if (component) optimizer.AddFunction(component->GetFunction());
+    }
+  }
+
+  FGModelFunctions::RegisterFunctions(optimizer);
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+void FGFCS::CollectParameters(vector<const FGParameter*>& params) const
+{
+  for (unsigned int i=0; i<SystemChannels.size(); i++) {
+    for (unsigned int c=0; c<SystemChannels[i]->GetNumComponents(); c++) {
+      FGFCSFunction* component = dynamic_cast<FGFCSFunction*>(SystemChannels[i]->GetComponent(c));
+      if (component && component->GetFunction())
+        params.push_back(component->GetFunction());
+    }
+  }
+
+  FGModelFunctions::CollectParameters(params);
 }
 
 //%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
@@ -803,6 +872,55 @@ void FGFCS::bindModel(void)
   }
 }
 
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+void FGFCS::SetProfiler(FGProfiler* profiler)
+{
+  for (unsigned int i=0; i<SystemChannels.size(); i++)
+    SystemChannels[i]->SetProfiler(profiler, "fcs");
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+void FGFCS::ArchiveState(FGSnapshot& snapshot)
+{
+  FGModel::ArchiveState(snapshot);
+  snapshot.Archive(DaCmd);
+  snapshot.Archive(DeCmd);
+  snapshot.Archive(DrCmd);
+  snapshot.Archive(DsCmd);
+  snapshot.Archive(DfCmd);
+  snapshot.Archive(DsbCmd);
+  snapshot.Archive(DspCmd);
+  snapshot.Archive(DePos, NForms);
+  snapshot.Archive(DaLPos, NForms);
+  snapshot.Archive(DaRPos, NForms);
+  snapshot.Archive(DrPos, NForms);
+  snapshot.Archive(DfPos, NForms);
+  snapshot.Archive(DsbPos, NForms);
+  snapshot.Archive(DspPos, NForms);
+  snapshot.Archive(PTrimCmd);
+  snapshot.Archive(YTrimCmd);
+  snapshot.Archive(RTrimCmd);
+  snapshot.Archive(ThrottleCmd);
+  snapshot.Archive(ThrottlePos);
+  snapshot.Archive(MixtureCmd);
+  snapshot.Archive(MixturePos);
+  snapshot.Archive(PropAdvanceCmd);
+  snapshot.Archive(PropAdvance);
+  snapshot.Archive(PropFeatherCmd);
+  snapshot.Archive(PropFeather);
+  snapshot.Archive(SteerPosDeg);
+  snapshot.Archive(BrakePos);
+  snapshot.Archive(GearCmd);
+  snapshot.Archive(GearPos);
+  snapshot.Archive(TailhookPos);
+  snapshot.Archive(WingFoldPos);
+
+  for (unsigned int i=0; i<SystemChannels.size(); i++)
+    SystemChannels[i]->ArchiveState(snapshot);
+}
+
 //%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
 //    The bitmasked value choices are as follows:
 //    unset: In this case (the default) JSBSim would only print
@@ -39,6 +39,7 @@ INCLUDES
 %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
 
 #include <iosfwd>
+#include <map>
 #include <vector>
 #include <string>
 
@@ -58,6 +59,7 @@ FORWARD DECLARATIONS
 namespace JSBSim {
 
 class FGFCSChannel;
+class FGSnapshot;
 typedef enum { ofRad=0, ofDeg, ofNorm, ofMag , NForms} OutputForm;
 
 /*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
@@ -123,6 +125,15 @@ CLASS DOCUMENTATION
 
     In this case, the FCS would be read in from another file.
 
+    The attributes rate and phase of the <system>, <autopilot> or
+    <flight_control> element set the rate at which its channels are executed
+    (see FGFCSChannel). Slow systems can then run at a few Hz while the
+    flight controls run at the rate of the simulation:
+
+    @code
+    <system name="Electrical" rate="10">
+    @endcode
+
     <h2>Properties</h2>
     @property fcs/aileron-cmd-norm normalized aileron command
     @property fcs/elevator-cmd-norm normalized elevator command
@@ -209,6 +220,9 @@ public:
                      "Resume" command to be given.
       @return false if no error */
   bool Run(bool Holding);
+  void ArchiveState(FGSnapshot& snapshot);
+  /// Measures each channel and each component under profiling/fcs.
+  void SetProfiler(FGProfiler* profiler);
 
   /// @name Pilot input command retrieval
   //@{
@@ -563,6 +577,15 @@ public:
 
   bool GetTrimStatus(void) const { return FDMExec->GetTrimStatus(); }
 
+  /** Registers the functions of the fcs_function components to the function
+      optimizer.
+      @param optimizer the optimizer to which the functions are registered. */
+  void RegisterFunctions(FGFunctionOptimizer& optimizer) const;
+
+  /** Collects the functions of the fcs_function components.
+      @param params the list to which the functions are appended. */
+  void CollectParameters(std::vector<const FGParameter*>& params) const;
+
 private:
   double DaCmd, DeCmd, DrCmd, DsCmd, DfCmd, DsbCmd, DspCmd;
   double DePos[NForms], DaLPos[NForms], DaRPos[NForms], DrPos[NForms];
@@ -585,6 +608,16 @@ private:
 
   typedef std::vector <FGFCSChannel*> Channels;
   Channels SystemChannels;
+
+  // Default rate and phase of the channels of the system being loaded.
+  unsigned int SystemRate, SystemPhase;
+  bool SystemPhased;
+  // Rate of the channel being loaded: scales the time step of its components.
+  unsigned int ChannelRate;
+  // Number of channels loaded for each rate, used to stagger their phases.
+  std::map<unsigned int, unsigned int> ChannelsPerRate;
+
+  bool LoadSchedule(Element* el);
   void bind(void);
   void bindModel(void);
   void bindThrottle(unsigned int);
@@ -40,6 +40,9 @@ INCLUDES
 
 #include <iostream>
 
+#include "input_output/FGSnapshot.h"
+#include "FGProfiler.h"
+
 /*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
 DEFINITIONS
 %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
@@ -59,7 +62,26 @@ CLASS DOCUMENTATION
   /** Represents a <channel> in a control system definition.
       The <channel> may be defined within a <system>, <autopilot> or <flight_control>
       element. Channels are a way to group sets of components that perform
-      a specific purpose or algorithm. */
+      a specific purpose or algorithm.
+
+      A channel can be executed less often than the simulation with the
+      attributes rate (in Hz) and phase (in frames):
+      @code
+      <system name="Fuel management" rate="10">
+        <channel name="Transfer">
+          ...
+        </channel>
+        <channel name="Gauges" rate="2" phase="3">
+          ...
+        </channel>
+      </system>
+      @endcode
+      The rate and the phase given to the <system>, <autopilot> or
+      <flight_control> element apply to all its channels unless a channel
+      overrides them. When no phase is given, the channels that run at the same
+      rate are given successive phases so that their executions are spread
+      over several frames. The components of a channel use a time step scaled
+      by the rate of their channel. */
 
 /*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
 CLASS DECLARATION
@@ -70,8 +92,10 @@ typedef std::vector <FGFCSComponent*> FCSCompVec;
 class FGFCSChannel {
 public:
   /// Constructor
-  FGFCSChannel(std::string name, FGPropertyNode* node=0) :
-  OnOffNode(node), Name(name)
+  FGFCSChannel(std::string name, FGPropertyNode* node=0, unsigned int rate=1,
+               unsigned int phase=0) :
+  OnOffNode(node), Name(name), ExecRate(rate), ExecPhase(phase), ExecCtr(0),
+  Profile(0)
   {
   }
   /// Destructor
@@ -81,6 +105,10 @@ public:
   }
   /// Retrieves the name of the channel
   std::string GetName() {return Name;}
+  /// Retrieves the rate of the channel in frames.
+  unsigned int GetRate() const {return ExecRate;}
+  /// Retrieves the frame offset at which the channel is executed.
+  unsigned int GetPhase() const {return ExecPhase;}
 
   /// Adds a component to a channel
   void Add(FGFCSComponent* comp) {FCSComponents.push_back(comp);}
@@ -99,6 +127,27 @@ public:
   void Reset() {
     for (unsigned int i=0; i<FCSComponents.size(); i++)
       FCSComponents[i]->ResetPastStates();
+    ExecCtr = 0;
+  }
+  /// Saves or restores the state of the components of the channel.
+  void ArchiveState(FGSnapshot& snapshot) {
+    snapshot.Archive(ExecCtr);
+    for (unsigned int i=0; i<FCSComponents.size(); i++)
+      FCSComponents[i]->ArchiveState(snapshot);
+  }
+  /** Creates the sections that measure the execution of the channel and of
+      its components, or removes them if profiler is null.
+      @param profiler the profiler in which the sections are created.
+      @param parent the path of the parent section. */
+  void SetProfiler(FGProfiler* profiler, const std::string& parent) {
+    ComponentProfiles.clear();
+    Profile = 0;
+    if (!profiler) return;
+
+    Profile = profiler->AddSection(parent, Name);
+    for (unsigned int i=0; i<FCSComponents.size(); i++)
+      ComponentProfiles.push_back(profiler->AddSection(Profile->GetPath(),
+                                               FCSComponents[i]->GetName()));
   }
   /// Executes all the components in a channel.
   void Execute() {
@@ -108,13 +157,38 @@ public:
     if (OnOffNode != 0)
       if (!OnOffNode->getBoolValue()) return;
 
-    for (unsigned int i=0; i<FCSComponents.size(); i++) FCSComponents[i]->Run();
+    // The channel is executed on the first frame that follows a reset, then
+    // once every ExecRate frames after a delay of ExecPhase frames (see
+    // FGModel::Run).
+    if (ExecRate > 1) {
+      if (ExecCtr > 1) {
+        ExecCtr--;
+        return;
+      }
+      ExecCtr = ExecCtr ? ExecRate : ExecRate + ExecPhase;
+    }
+
+    if (!Profile) {
+      for (unsigned int i=0; i<FCSComponents.size(); i++) FCSComponents[i]->Run();
+      return;
+    }
+
+    FGProfiler::Timer timer(Profile);
+    for (unsigned int i=0; i<FCSComponents.size(); i++) {
+      FGProfiler::Timer componentTimer(ComponentProfiles[i]);
+      FCSComponents[i]->Run();
+    }
   }
 
   private:
     FCSCompVec FCSComponents;
     FGConstPropertyNode_ptr OnOffNode;
     std::string Name;
+    unsigned int ExecRate;
+    unsigned int ExecPhase;
+    unsigned int ExecCtr;
+    FGProfiler::Section* Profile;
+    std::vector<FGProfiler::Section*> ComponentProfiles;
 };
 
 }
@@ -39,6 +39,7 @@ INCLUDES
 #include "models/FGMassBalance.h"
 #include "FGGasCell.h"
 #include "input_output/FGXMLElement.h"
+#include "input_output/FGSnapshot.h"
 #include <iostream>
 #include <cstdlib>
 
@@ -223,7 +224,7 @@ FGGasCell::FGGasCell(FGFDMExec* exec, Element* el, unsigned int num,
   if (Element* heat = el->FindElement("heat")) {
     Element* function_element = heat->FindElement("function");
     while (function_element) {
-      HeatTransferCoeff.push_back(new FGFunction(PropertyManager,
+      HeatTransferCoeff.push_back(new FGFunction(exec,
                                                  function_element));
       function_element = heat->FindNextElement("function");
     }
@@ -430,6 +431,34 @@ void FGGasCell::Calculate(double dt)
   }
 }
 
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+void FGGasCell::ArchiveState(FGSnapshot& snapshot)
+{
+  FGForce::ArchiveState(snapshot);
+  snapshot.Archive(Pressure);
+  snapshot.Archive(Contents);
+  snapshot.Archive(Volume);
+  snapshot.Archive(dVolumeIdeal);
+  snapshot.Archive(Temperature);
+  snapshot.Archive(Buoyancy);
+  snapshot.Archive(Mass);
+  snapshot.Archive(gasCellJ);
+  snapshot.Archive(gasCellM);
+
+  for (unsigned int i=0; i<Ballonet.size(); i++) Ballonet[i]->ArchiveState(snapshot);
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+void FGGasCell::CollectParameters(vector<const FGParameter*>& params) const
+{
+  params.insert(params.end(), HeatTransferCoeff.begin(), HeatTransferCoeff.end());
+
+  for (unsigned int i=0; i<Ballonet.size(); i++)
+    Ballonet[i]->CollectParameters(params);
+}
+
 //%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
 //    The bitmasked value choices are as follows:
 //    unset: In this case (the default) JSBSim would only print
@@ -659,7 +688,7 @@ FGBallonet::FGBallonet(FGFDMExec* exec, Element* el, unsigned int num,
   if (Element* heat = el->FindElement("heat")) {
     Element* function_element = heat->FindElement("function");
     while (function_element) {
-      HeatTransferCoeff.push_back(new FGFunction(PropertyManager,
+      HeatTransferCoeff.push_back(new FGFunction(exec,
                                                  function_element));
       function_element = heat->FindNextElement("function");
     }
@@ -667,7 +696,7 @@ FGBallonet::FGBallonet(FGFDMExec* exec, Element* el, unsigned int num,
   // Read blower input function
   if (Element* blower = el->FindElement("blower_input")) {
     Element* function_element = blower->FindElement("function");
-    BlowerInput = new FGFunction(PropertyManager,
+    BlowerInput = new FGFunction(exec,
                                  function_element);
   }
 }
@@ -784,6 +813,27 @@ void FGBallonet::Calculate(double dt)
   ballonetJ += MassBalance->GetPointmassInertia(GetMass(), GetXYZ());
 }
 
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+void FGBallonet::ArchiveState(FGSnapshot& snapshot)
+{
+  snapshot.Archive(Pressure);
+  snapshot.Archive(Contents);
+  snapshot.Archive(Volume);
+  snapshot.Archive(dVolumeIdeal);
+  snapshot.Archive(dU);
+  snapshot.Archive(Temperature);
+  snapshot.Archive(ballonetJ);
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+void FGBallonet::CollectParameters(vector<const FGParameter*>& params) const
+{
+  params.insert(params.end(), HeatTransferCoeff.begin(), HeatTransferCoeff.end());
+  if (BlowerInput) params.push_back(BlowerInput);
+}
+
 //%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
 //    The bitmasked value choices are as follows:
 //    unset: In this case (the default) JSBSim would only print
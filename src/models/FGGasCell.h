@@ -60,6 +60,8 @@ namespace JSBSim {
 
 class FGBallonet;
 class Element;
+class FGSnapshot;
+class FGParameter;
 
 /*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
 CLASS DOCUMENTATION
@@ -190,6 +192,12 @@ public:
   /** Runs the gas cell model; called by BuoyantForces
    */
   void Calculate(double dt);
+  void ArchiveState(FGSnapshot& snapshot);
+
+  /** Collects the functions of the gas cell and of its ballonets (see
+      FGModelFunctions::CollectParameters).
+      @param params the list to which the functions are appended. */
+  void CollectParameters(std::vector<const FGParameter*>& params) const;
 
   /** Get the index of this gas cell
       @return gas cell index. */
@@ -315,6 +323,12 @@ public:
   /** Runs the ballonet model; called by FGGasCell
    */
   void Calculate(double dt);
+  void ArchiveState(FGSnapshot& snapshot);
+
+  /** Collects the functions of the ballonet (see
+      FGModelFunctions::CollectParameters).
+      @param params the list to which the functions are appended. */
+  void CollectParameters(std::vector<const FGParameter*>& params) const;
 
 
   /** Get the center of gravity location of the ballonet
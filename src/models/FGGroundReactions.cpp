@@ -43,6 +43,7 @@ INCLUDES
 #include "FGAccelerations.h"
 #include "input_output/FGPropertyManager.h"
 #include "input_output/FGXMLElement.h"
+#include "input_output/FGSnapshot.h"
 
 using namespace std;
 
@@ -160,7 +161,7 @@ bool FGGroundReactions::Load(Element* document)
 
   for (unsigned int i=0; i<lGear.size();i++) lGear[i]->bind();
 
-  PostLoad(document, PropertyManager);
+  PostLoad(document, FDMExec);
 
   return true;
 }
@@ -260,6 +261,29 @@ void FGGroundReactions::bind(void)
   PropertyManager->Tie("gear/wow", this, &FGGroundReactions::GetWOW);
 }
 
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+void FGGroundReactions::ArchiveState(FGSnapshot& snapshot)
+{
+  FGModel::ArchiveState(snapshot);
+  FGSurface::ArchiveState(snapshot);
+  snapshot.Archive(in);
+  snapshot.Archive(vForces);
+  snapshot.Archive(vMoments);
+
+  for (unsigned int i=0; i<lGear.size(); i++) lGear[i]->ArchiveState(snapshot);
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+void FGGroundReactions::CollectParameters(vector<const FGParameter*>& params) const
+{
+  for (unsigned int i=0; i<lGear.size(); i++)
+    lGear[i]->CollectParameters(params);
+
+  FGModelFunctions::CollectParameters(params);
+}
+
 //%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
 //    The bitmasked value choices are as follows:
 //    unset: In this case (the default) JSBSim would only print
@@ -37,6 +37,7 @@ INCLUDES
 
 #include "FGInertial.h"
 #include "FGFDMExec.h"
+#include "input_output/FGSnapshot.h"
 #include <iostream>
 
 using namespace std;
@@ -81,6 +82,8 @@ FGInertial::FGInertial(FGFDMExec* fgex) : FGModel(fgex)
   gAccelReference = GM/(RadiusReference*RadiusReference);
   gAccel          = GM/(RadiusReference*RadiusReference);
 
+  GroundCallback = new FGDefaultGroundCallback(RadiusReference);
+
   bind();
 
   Debug(0);
@@ -95,6 +98,15 @@ FGInertial::~FGInertial(void)
 
 //%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
 
+double FGInertial::GetAltitudeAGL(const FGLocation& location) const
+{
+  FGLocation contact;
+  FGColumnVector3 normal, v, w;
+  return GroundCallback->GetAGLevel(location, contact, normal, v, w);
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
 bool FGInertial::InitModel(void)
 {
   return FGModel::InitModel();
@@ -156,6 +168,16 @@ void FGInertial::bind(void)
   PropertyManager->Tie("inertial/sea-level-radius_ft", this, &FGInertial::GetRefRadius);
 }
 
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+void FGInertial::ArchiveState(FGSnapshot& snapshot)
+{
+  FGModel::ArchiveState(snapshot);
+  snapshot.Archive(in);
+  snapshot.Archive(gAccel);
+  GroundCallback->ArchiveState(snapshot);
+}
+
 //%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
 //    The bitmasked value choices are as follows:
 //    unset: In this case (the default) JSBSim would only print
@@ -42,6 +42,8 @@ INCLUDES
 
 #include "FGModel.h"
 #include "math/FGColumnVector3.h"
+#include "math/FGLocation.h"
+#include "input_output/FGGroundCallback.h"
 
 /*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
 DEFINITIONS
@@ -55,6 +57,8 @@ FORWARD DECLARATIONS
 
 namespace JSBSim {
 
+class FGSnapshot;
+
 /*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
 CLASS DOCUMENTATION
 %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
@@ -83,6 +87,8 @@ public:
                      "Resume" command to be given.
       @return false if no error */
   bool Run(bool Holding);
+  void ArchiveState(FGSnapshot& snapshot);
+
   double SLgravity(void) const {return gAccelReference;}
   double gravity(void) const {return gAccel;}
   double omega(void) const {return RotationRate;}
@@ -97,6 +103,70 @@ public:
   double GetSemimajor(void) const {return a;}
   double GetSemiminor(void) const {return b;}
 
+  /** @name Functions that rely on the ground callback
+      The following functions allow to set and get the altitude of a location
+      above the sea or the ground. The sea and the ground levels are obtained
+      by interrogating the FGGroundCallback instance of this FDM. */
+  ///@{
+  /** Get the local sea level radius
+      @param location the location at which the radius is requested.
+      @return the sea level radius at the location in feet. */
+  double GetSeaLevelRadius(const FGLocation& location) const
+  { return GroundCallback->GetSeaLevelRadius(location); }
+
+  /** Get the local terrain radius
+      @param location the location at which the radius is requested.
+      @return the terrain level radius at the location in feet. */
+  double GetTerrainRadius(const FGLocation& location) const
+  { return GroundCallback->GetTerrainGeoCentRadius(location); }
+
+  /** Get the altitude above sea level.
+      @param location the location which altitude is requested.
+      @return the altitude ASL in feet. */
+  double GetAltitudeASL(const FGLocation& location) const
+  { return GroundCallback->GetAltitude(location); }
+
+  /** Get the altitude above ground level.
+      @param location the location which altitude is requested.
+      @return the altitude AGL in feet. */
+  double GetAltitudeAGL(const FGLocation& location) const;
+
+  /** Get terrain contact point information below a location.
+      @param location the location below which the terrain is interrogated.
+      @param contact Contact point location
+      @param normal  Terrain normal vector in contact point    (ECEF frame)
+      @param v       Terrain linear velocity in contact point  (ECEF frame)
+      @param w       Terrain angular velocity in contact point (ECEF frame)
+      @return Location altitude above contact point (AGL) in feet. */
+  double GetContactPoint(const FGLocation& location, FGLocation& contact,
+                         FGColumnVector3& normal, FGColumnVector3& v,
+                         FGColumnVector3& w) const
+  { return GroundCallback->GetAGLevel(location, contact, normal, v, w); }
+
+  /** Set the altitude above sea level of a location.
+      @param location the location to modify.
+      @param altitudeASL altitude above Sea Level in feet. */
+  void SetAltitudeASL(FGLocation& location, double altitudeASL) const
+  { location.SetRadius(GetSeaLevelRadius(location) + altitudeASL); }
+
+  /** Set the altitude above ground level of a location.
+      @param location the location to modify.
+      @param altitudeAGL altitude above Ground Level in feet. */
+  void SetAltitudeAGL(FGLocation& location, double altitudeAGL) const
+  { location.SetRadius(GetTerrainRadius(location) + altitudeAGL); }
+  ///@}
+
+  /** Sets the ground callback pointer. The ground callback belongs to this
+      FDM instance so that several instances can use different terrains.
+      @param gc A pointer to a ground callback object
+      @see FGGroundCallback */
+  void SetGroundCallback(FGGroundCallback* gc) { GroundCallback = gc; }
+
+  /** Get a pointer to the ground callback currently used.
+      @return A pointer to the current ground callback object.
+      @see FGGroundCallback */
+  FGGroundCallback* GetGroundCallback(void) const { return GroundCallback; }
+
   struct Inputs {
     double Radius;
     double Latitude;
@@ -113,6 +183,7 @@ private:
   double J2;   // WGS84 value for J2
   double a;    // WGS84 semimajor axis length in feet 
   double b;    // WGS84 semiminor axis length in feet
+  FGGroundCallback_ptr GroundCallback;
 
   void bind(void);
   void Debug(int from);
@@ -38,10 +38,13 @@ HISTORY
 INCLUDES
 %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
 
+#include <sstream>
+
 #include "FGInput.h"
 #include "FGFDMExec.h"
 #include "input_output/FGInputSocket.h"
 #include "input_output/FGUDPInputSocket.h"
+#include "input_output/FGInputServer.h"
 #include "input_output/FGXMLFileRead.h"
 #include "input_output/FGXMLElement.h"
 #include "input_output/FGModelLoader.h"
@@ -90,7 +93,7 @@ bool FGInput::Load(Element* el)
 
   if (!element) return false;
   
-  FGModel::PreLoad(element, PropertyManager);
+  FGModel::PreLoad(element, FDMExec);
 
   size_t idx = InputTypes.size();
   string type = element->GetAttributeValue("type");
@@ -102,6 +105,8 @@ bool FGInput::Load(Element* el)
 
   if (type.empty() || type == "SOCKET") {
     Input = new FGInputSocket(FDMExec);
+  } else if (type == "SERVER") {
+    Input = new FGInputServer(FDMExec);
   } else if (type == "QTJSBSIM") {
     Input = new FGUDPInputSocket(FDMExec);
   } else if (type != string("NONE")) {
@@ -113,7 +118,7 @@ bool FGInput::Load(Element* el)
 
   Input->SetIdx(idx);
   Input->Load(element);
-  PostLoad(element, PropertyManager);
+  PostLoad(element, FDMExec);
 
   InputTypes.push_back(Input);
 
@@ -144,15 +149,37 @@ bool FGInput::Run(bool Holding)
   if (FGModel::Run(Holding)) return true;
   if (!enabled) return true;
 
-  vector<FGInputType*>::iterator it;
-  for (it = InputTypes.begin(); it != InputTypes.end(); ++it)
-    (*it)->Run(Holding);
+  if (InputProfiles.empty()) {
+    vector<FGInputType*>::iterator it;
+    for (it = InputTypes.begin(); it != InputTypes.end(); ++it)
+      (*it)->Run(Holding);
+  } else {
+    // The instances added after the profiler has been set are not measured.
+    for (unsigned int i=0; i<InputTypes.size(); i++) {
+      FGProfiler::Timer timer(i < InputProfiles.size() ? InputProfiles[i] : 0);
+      InputTypes[i]->Run(Holding);
+    }
+  }
 
   return false;
 }
 
 //%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
 
+void FGInput::SetProfiler(FGProfiler* profiler)
+{
+  InputProfiles.clear();
+  if (!profiler) return;
+
+  for (unsigned int i=0; i<InputTypes.size(); i++) {
+    ostringstream path;
+    path << "input/input[" << i << "]";
+    InputProfiles.push_back(profiler->AddSection(path.str()));
+  }
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
 bool FGInput::SetDirectivesFile(const std::string& fname)
 {
   FGXMLFileRead XMLFile;
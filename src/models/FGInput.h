@@ -41,6 +41,7 @@ INCLUDES
 
 #include "FGModel.h"
 #include "input_output/FGInputType.h"
+#include "FGProfiler.h"
 
 /*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
 DEFINITIONS
@@ -69,6 +70,8 @@ CLASS DOCUMENTATION
       SOCKET      Will eventually send data to a socket input, where NAME
                   would then be the IP address of the machine the data should
                   be sent to. DON'T USE THIS YET!
+      SERVER      Accepts several telnet clients at the same time. The
+                  commands are the same as for SOCKET.
       NONE        Specifies to do nothing. This setting makes it easy to turn on and
                   off the data input without having to mess with anything else.
 
@@ -116,6 +119,8 @@ public:
                      "Resume" command to be given.
       @return false if no error */
   bool Run(bool Holding);
+  /// Measures each input instance under profiling/input.
+  void SetProfiler(FGProfiler* profiler);
 
   /** Adds a new input instance to the Input Manager. The definition of the
       new input instance is read from a file.
@@ -152,6 +157,7 @@ public:
 
 private:
   std::vector<FGInputType*> InputTypes;
+  std::vector<FGProfiler::Section*> InputProfiles;
   bool enabled;
 
   void Debug(int from);
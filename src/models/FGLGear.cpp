@@ -46,8 +46,11 @@ INCLUDES
 #include "math/FGFunction.h"
 #include "FGLGear.h"
 #include "models/FGGroundReactions.h"
+#include "models/FGInertial.h"
+#include "FGFDMExec.h"
 #include "math/FGTable.h"
 #include "input_output/FGXMLElement.h"
+#include "input_output/FGSnapshot.h"
 
 using namespace std;
 
@@ -113,7 +116,7 @@ FGLGear::FGLGear(Element* el, FGFDMExec* fdmex, int number, const struct Inputs&
   Element* strutForce = el->FindElement("strut_force");
   if (strutForce) {
     Element* springFunc = strutForce->FindElement("function");
-    fStrutForce = new FGFunction(PropertyManager, springFunc);
+    fStrutForce = new FGFunction(fdmex, springFunc);
   }
   else {
     if (el->FindElement("spring_coeff"))
@@ -306,7 +309,9 @@ const FGColumnVector3& FGLGear::GetBodyForces(FGSurface *surface)
 
     // Compute the height of the theoretical location of the wheel (if strut is
     // not compressed) with respect to the ground level
-    double height = gearLoc.GetContactPoint(contact, normal, terrainVel, dummy);
+    double height = fdmex->GetInertial()->GetContactPoint(gearLoc, contact,
+                                                          normal, terrainVel,
+                                                          dummy);
 
     // Does this surface contact point interact with another surface?
     if (surface) {
@@ -888,6 +893,56 @@ void FGLGear::Report(ReportType repType)
   }
 }
 
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+void FGLGear::ArchiveState(FGSnapshot& snapshot)
+{
+  FGForce::ArchiveState(snapshot);
+  FGSurface::ArchiveState(snapshot);
+  snapshot.Archive(mTGear);
+  snapshot.Archive(vLocalGear);
+  snapshot.Archive(vWhlVelVec);
+  snapshot.Archive(vGroundWhlVel);
+  snapshot.Archive(vGroundNormal);
+  snapshot.Archive(SteerAngle);
+  snapshot.Archive(kSpring);
+  snapshot.Archive(bDamp);
+  snapshot.Archive(bDampRebound);
+  snapshot.Archive(compressLength);
+  snapshot.Archive(compressSpeed);
+  snapshot.Archive(rollingFCoeff);
+  snapshot.Archive(BrakeFCoeff);
+  snapshot.Archive(SinkRate);
+  snapshot.Archive(GroundSpeed);
+  snapshot.Archive(TakeoffDistanceTraveled);
+  snapshot.Archive(TakeoffDistanceTraveled50ft);
+  snapshot.Archive(LandingDistanceTraveled);
+  snapshot.Archive(MaximumStrutForce);
+  snapshot.Archive(StrutForce);
+  snapshot.Archive(FCoeff);
+  snapshot.Archive(WheelSlip);
+  snapshot.Archive(GearPos);
+  snapshot.Archive(WOW);
+  snapshot.Archive(lastWOW);
+  snapshot.Archive(FirstContact);
+  snapshot.Archive(StartedGroundRun);
+  snapshot.Archive(LandingReported);
+  snapshot.Archive(TakeoffReported);
+  snapshot.Archive(ReportEnable);
+  snapshot.Archive(StaticFriction);
+  snapshot.Archive(maxSteerAngle);
+  snapshot.Archive(useFCSGearPos);
+  snapshot.Archive(LMultiplier, 3);
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+void FGLGear::CollectParameters(vector<const FGParameter*>& params) const
+{
+  if (fStrutForce) params.push_back(fStrutForce);
+  if (ForceY_Table) params.push_back(ForceY_Table);
+}
+
 //%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
 //    The bitmasked value choices are as follows:
 //    unset: In this case (the default) JSBSim would only print
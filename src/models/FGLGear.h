@@ -60,6 +60,8 @@ namespace JSBSim {
 class FGTable;
 class Element;
 class FGPropertyManager;
+class FGSnapshot;
+class FGParameter;
 
 /*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
 CLASS DOCUMENTATION
@@ -319,6 +321,11 @@ public:
   const struct Inputs& in;
 
   void ResetToIC(void);
+  void ArchiveState(FGSnapshot& snapshot);
+
+  /** Collects the functions and the tables of the gear (see FGModelFunctions::CollectParameters).
+      @param params the list to which the parameters are appended. */
+  void CollectParameters(std::vector<const FGParameter*>& params) const;
   void bind(void);
 
 private:
@@ -46,6 +46,7 @@ INCLUDES
 #include "FGFDMExec.h"
 #include "input_output/FGPropertyManager.h"
 #include "input_output/FGXMLElement.h"
+#include "input_output/FGSnapshot.h"
 
 using namespace std;
 
@@ -168,7 +169,7 @@ bool FGMassBalance::Load(Element* document)
 
   Mass = lbtoslug*Weight;
 
-  PostLoad(document, PropertyManager);
+  PostLoad(document, FDMExec);
 
   Debug(2);
   return true;
@@ -472,6 +473,35 @@ void FGMassBalance::GetMassPropertiesReport(int i)
   cout.setf(ios_base::fixed);
 }
 
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+void FGMassBalance::ArchiveState(FGSnapshot& snapshot)
+{
+  FGModel::ArchiveState(snapshot);
+  snapshot.Archive(in);
+  snapshot.Archive(Weight);
+  snapshot.Archive(EmptyWeight);
+  snapshot.Archive(Mass);
+  snapshot.Archive(mJ);
+  snapshot.Archive(mJinv);
+  snapshot.Archive(pmJ);
+  snapshot.Archive(baseJ);
+  snapshot.Archive(vXYZcg);
+  snapshot.Archive(vLastXYZcg);
+  snapshot.Archive(vDeltaXYZcg);
+  snapshot.Archive(vDeltaXYZcgBody);
+  snapshot.Archive(vXYZtank);
+  snapshot.Archive(vbaseXYZcg);
+  snapshot.Archive(vPMxyz);
+  snapshot.Archive(PointMassCG);
+
+  for (unsigned int i=0; i<PointMasses.size(); i++) {
+    snapshot.Archive(PointMasses[i]->Location);
+    snapshot.Archive(PointMasses[i]->Weight);
+    snapshot.Archive(PointMasses[i]->mPMInertia);
+  }
+}
+
 //%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
 //    The bitmasked value choices are as follows:
 //    unset: In this case (the default) JSBSim would only print
@@ -41,6 +41,8 @@ INCLUDES
 #include "FGModel.h"
 #include "FGFDMExec.h"
 #include "input_output/FGModelLoader.h"
+#include "input_output/FGSnapshot.h"
+#include "input_output/FGXMLElement.h"
 
 using namespace std;
 
@@ -66,8 +68,9 @@ FGModel::FGModel(FGFDMExec* fdmex)
   //must be brought up now.
   PropertyManager = FDMExec->GetPropertyManager();
 
-  exe_ctr     = 1;
+  exe_ctr     = 0;
   rate        = 1;
+  phase       = 0;
 
   if (debug_lvl & 2) cout << "              FGModel Base Class" << endl;
 }
@@ -83,7 +86,7 @@ FGModel::~FGModel()
 
 bool FGModel::InitModel(void)
 {
-  exe_ctr = 1;
+  exe_ctr = 0;
   return FGModelFunctions::InitModel();
 }
 
@@ -95,10 +98,25 @@ bool FGModel::Run(bool Holding)
 
   if (rate == 1) return false; // Fast exit if nothing to do
 
-  if (exe_ctr >= rate) exe_ctr = 0;
+  // exe_ctr is the number of frames left until the model is run again. It is
+  // null until the first frame that follows the initialization of the model:
+  // the model is then run and its next execution is delayed by its phase.
+  if (exe_ctr > 1) {
+    exe_ctr--;
+    return true;
+  }
+
+  exe_ctr = exe_ctr ? rate : rate + phase;
+  return false;
+}
 
-  if (exe_ctr++ == 1) return false;
-  else              return true;
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+void FGModel::ArchiveState(FGSnapshot& snapshot)
+{
+  FGModelFunctions::ArchiveState(snapshot);
+  snapshot.Archive(exe_ctr);
+  snapshot.Archive(rate);
 }
 
 //%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
@@ -124,7 +142,7 @@ bool FGModel::Load(Element* el)
     return false;
   }
 
-  bool result = FGModelFunctions::Load(document, PropertyManager);
+  bool result = FGModelFunctions::Load(document, FDMExec);
 
   if (document != el) {
     el->MergeAttributes(document);
@@ -136,17 +154,64 @@ bool FGModel::Load(Element* el)
 
     LocalProperties.Load(el, PropertyManager, true);
 
+    // The elements of a shared document may already have been appended to the
+    // element by a previous load of the model. The interface properties of the
+    // document have already been read so they are not appended: otherwise
+    // they would override the local properties when the model is loaded again.
     Element* element = document->FindElement();
     while (element) {
-      el->AddChildElement(element);
-      element->SetParent(el);
+      if (element->GetName() != "property") {
+        if (!el->HasChildElement(element)) el->AddChildElement(element);
+        element->SetParent(el);
+      }
       element = document->FindNextElement();
     }
   }
 
+  if (!LoadSchedule(el)) return false;
+
   return result;
 }
 
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+bool FGModel::LoadSchedule(Element* el)
+{
+  return ReadSchedule(el, rate, phase);
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+bool FGModel::ReadSchedule(Element* el, unsigned int& frames,
+                           unsigned int& offset) const
+{
+  if (el->HasAttribute("rate")) {
+    double rateHz = el->GetAttributeValueAsNumber("rate");
+    if (rateHz <= 0.0) {
+      cerr << el->ReadFrom() << fgred
+           << "The rate of the element '" << el->GetName()
+           << "' must be positive." << reset << endl;
+      return false;
+    }
+    // The rate can not be faster than the simulation.
+    frames = max(1U, (unsigned int)(0.5 + 1.0/(FDMExec->GetDeltaT()*rateHz)));
+  }
+
+  if (el->HasAttribute("phase")) {
+    double p = el->GetAttributeValueAsNumber("phase");
+    if (p < 0.0 || p >= frames || p != (unsigned int)p) {
+      cerr << el->ReadFrom() << fgred
+           << "The phase of the element '" << el->GetName()
+           << "' must be an integer number of frames less than " << frames
+           << "." << reset << endl;
+      return false;
+    }
+    offset = (unsigned int)p;
+  }
+
+  return true;
+}
+
 //%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
 //    The bitmasked value choices are as follows:
 //    unset: In this case (the default) JSBSim would only print
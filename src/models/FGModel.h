@@ -57,12 +57,33 @@ namespace JSBSim {
 class FGFDMExec;
 class Element;
 class FGPropertyManager;
+class FGSnapshot;
+class FGProfiler;
 
 /*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
 CLASS DOCUMENTATION
 %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
 
 /** Base class for all scheduled JSBSim models
+
+    By default a model is executed at each time step. The attributes rate and
+    phase of the model element in the aircraft configuration file run it less
+    often:
+    @code
+    <propulsion rate="20" phase="2">
+      ...
+    </propulsion>
+    @endcode
+    The rate is given in Hz and is converted to a number of frames when the
+    model is loaded, so the time step must be set before the model is loaded.
+    The phase, given in frames, offsets the frames at which the model is
+    executed, which spreads the execution of slow models over several frames.
+    Whatever its phase, a model is always executed on the first frame that
+    follows its initialization so that its outputs are defined.
+
+    The models which integrate a quantity must scale their time step by the
+    rate of the model, as FGFDMExec does for the time step that it passes to
+    FGPropulsion and FGGroundReactions.
     @author Jon S. Berndt
   */
 
@@ -93,11 +114,25 @@ public:
   virtual bool Run(bool Holding);
 
   virtual bool InitModel(void);
+  /** Saves the state of the model to a snapshot or restores it from a
+      snapshot, depending on the direction of the snapshot. The derived models
+      that have a state must call the method of their base class.
+      @param snapshot the snapshot. */
+  virtual void ArchiveState(FGSnapshot& snapshot);
+  /** Creates the sections that measure the parts of the model, or removes
+      them if profiler is null. The time spent in the whole model is measured
+      by the executive.
+      @param profiler the profiler in which the sections are created. */
+  virtual void SetProfiler(FGProfiler*) {}
   /// Set the ouput rate for the model in frames
   void SetRate(unsigned int tt) {rate = tt;}
   /// Get the output rate for the model in frames
   unsigned int GetRate(void)   {return rate;}
-  FGFDMExec* GetExec(void)     {return FDMExec;}
+  /// Set the frame offset at which the model is executed.
+  void SetPhase(unsigned int p) {phase = p;}
+  /// Get the frame offset at which the model is executed.
+  unsigned int GetPhase(void)  {return phase;}
+  FGFDMExec* GetExec(void) const {return FDMExec;}
 
   void SetPropertyManager(FGPropertyManager *fgpm) { PropertyManager=fgpm;}
   virtual std::string FindFullPathName(const std::string& filename) const;
@@ -105,12 +140,29 @@ public:
 protected:
   unsigned int exe_ctr;
   unsigned int rate;
+  unsigned int phase;
 
   /** Loads this model.
       @param el a pointer to the element
       @return true if model is successfully loaded*/
   virtual bool Load(Element* el);
 
+  /** Reads the rate and the phase of the model from the attributes of its
+      element. It is called by Load() once the attributes of the element have
+      been merged with those of the file that defines the model.
+      @param el a pointer to the element
+      @return false if the attributes are invalid. */
+  virtual bool LoadSchedule(Element* el);
+
+  /** Reads the attributes rate (in Hz) and phase (in frames) of an element.
+      The variables are left unchanged if the attributes are missing.
+      @param el a pointer to the element
+      @param frames the rate converted to a number of frames
+      @param offset the phase
+      @return false if the attributes are invalid. */
+  bool ReadSchedule(Element* el, unsigned int& frames,
+                    unsigned int& offset) const;
+
   virtual void Debug(int from);
 
   FGFDMExec*         FDMExec;
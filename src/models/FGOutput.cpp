@@ -39,10 +39,14 @@ HISTORY
 INCLUDES
 %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
 
+#include <sstream>
+
 #include "FGOutput.h"
 #include "FGFDMExec.h"
 #include "input_output/FGOutputSocket.h"
 #include "input_output/FGOutputTextFile.h"
+#include "input_output/FGOutputBinaryFile.h"
+#include "input_output/FGOutputBinarySocket.h"
 #include "input_output/FGOutputFG.h"
 #include "input_output/FGUDPOutputSocket.h"
 #include "input_output/FGXMLFileRead.h"
@@ -107,15 +111,37 @@ bool FGOutput::Run(bool Holding)
   if (Holding) return false;
   if (!enabled) return true;
 
-  vector<FGOutputType*>::iterator it;
-  for (it = OutputTypes.begin(); it != OutputTypes.end(); ++it)
-    (*it)->Run();
+  if (OutputProfiles.empty()) {
+    vector<FGOutputType*>::iterator it;
+    for (it = OutputTypes.begin(); it != OutputTypes.end(); ++it)
+      (*it)->Run();
+  } else {
+    // The instances added after the profiler has been set are not measured.
+    for (unsigned int i=0; i<OutputTypes.size(); i++) {
+      FGProfiler::Timer timer(i < OutputProfiles.size() ? OutputProfiles[i] : 0);
+      OutputTypes[i]->Run();
+    }
+  }
 
   return false;
 }
 
 //%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
 
+void FGOutput::SetProfiler(FGProfiler* profiler)
+{
+  OutputProfiles.clear();
+  if (!profiler) return;
+
+  for (unsigned int i=0; i<OutputTypes.size(); i++) {
+    ostringstream path;
+    path << "output/output[" << i << "]";
+    OutputProfiles.push_back(profiler->AddSection(path.str()));
+  }
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
 void FGOutput::Print(void)
 {
   vector<FGOutputType*>::iterator it;
@@ -215,9 +241,14 @@ bool FGOutput::Load(int subSystems, std::string protocol, std::string type,
     FGOutputTextFile* OutputTextFile = new FGOutputTextFile(FDMExec);
     OutputTextFile->SetDelimiter("\t");
     Output = OutputTextFile;
+  } else if (type == "BINARY") {
+    Output = new FGOutputBinaryFile(FDMExec);
   } else if (type == "SOCKET") {
     Output = new FGOutputSocket(FDMExec);
     name += ":" + port + "/" + protocol;
+  } else if (type == "BINARY_SOCKET") {
+    Output = new FGOutputBinarySocket(FDMExec);
+    name += ":" + port + "/" + protocol;
   } else if (type == "FLIGHTGEAR") {
     Output = new FGOutputFG(FDMExec);
     name += ":" + port + "/" + protocol;
@@ -258,7 +289,7 @@ bool FGOutput::Load(Element* el)
 
   if (!element) return false;
 
-  FGModel::PreLoad(element, PropertyManager);
+  FGModel::PreLoad(element, FDMExec);
 
   size_t idx = OutputTypes.size();
   string type = element->GetAttributeValue("type");
@@ -272,8 +303,12 @@ bool FGOutput::Load(Element* el)
     Output = new FGOutputTextFile(FDMExec);
   } else if (type == "TABULAR") {
     Output = new FGOutputTextFile(FDMExec);
+  } else if (type == "BINARY") {
+    Output = new FGOutputBinaryFile(FDMExec);
   } else if (type == "SOCKET") {
     Output = new FGOutputSocket(FDMExec);
+  } else if (type == "BINARY_SOCKET") {
+    Output = new FGOutputBinarySocket(FDMExec);
   } else if (type == "FLIGHTGEAR") {
     Output = new FGOutputFG(FDMExec);
   } else if (type == "QTJSBSIM") {
@@ -288,7 +323,7 @@ bool FGOutput::Load(Element* el)
 
   Output->SetIdx(idx);
   Output->Load(element);
-  PostLoad(element, PropertyManager);
+  PostLoad(element, FDMExec);
 
   OutputTypes.push_back(Output);
 
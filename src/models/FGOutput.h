@@ -42,6 +42,7 @@ INCLUDES
 
 #include "FGModel.h"
 #include "input_output/FGOutputType.h"
+#include "FGProfiler.h"
 
 /*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
 DEFINITIONS
@@ -78,6 +79,13 @@ CLASS DOCUMENTATION
                   an external instance of FlightGear for visuals.  Parameters
                   defining the socket are given on the \<output> line.
       TABULAR     Columnar data.
+      BINARY      Binary file holding the simulation time and the listed
+                  properties in fixed size records (see FGOutputBinaryFile).
+                  It is much faster to write and much smaller than a CSV file.
+      BINARY_SOCKET  Binary records of the simulation time and the listed
+                  properties sent to a socket (see FGOutputBinarySocket).
+                  Parameters defining the socket are given on the \<output>
+                  line.
       TERMINAL    Output to terminal. NOT IMPLEMENTED YET!
       NONE        Specifies to do nothing. This setting makes it easy to turn on and
                   off the data output without having to mess with anything else.
@@ -150,6 +158,8 @@ public:
                      on a socket for the "Resume" command to be given.
       @return false if no error */
   bool Run(bool Holding);
+  /// Measures each output instance under profiling/output.
+  void SetProfiler(FGProfiler* profiler);
   /** Makes all the output instances to generate their ouput. This method does
       not check that the time step at which the output is requested is
       consistent with the output rate RATE_IN_HZ. Although Print is not a
@@ -224,6 +234,7 @@ public:
 
 private:
   std::vector<FGOutputType*> OutputTypes;
+  std::vector<FGProfiler::Section*> OutputProfiles;
   bool enabled;
 
   void Debug(int from);
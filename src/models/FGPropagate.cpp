@@ -73,7 +73,9 @@ INCLUDES
 #include "FGPropagate.h"
 #include "FGGroundReactions.h"
 #include "FGFDMExec.h"
+#include "FGInertial.h"
 #include "input_output/FGPropertyManager.h"
+#include "input_output/FGSnapshot.h"
 
 using namespace std;
 
@@ -101,10 +103,16 @@ FGPropagate::FGPropagate(FGFDMExec* fdmex)
   integrator_rotational_position = eRectEuler;
   integrator_translational_position = eAdamsBashforth3;
 
-  VState.dqPQRidot.resize(5, FGColumnVector3(0.0,0.0,0.0));
-  VState.dqUVWidot.resize(5, FGColumnVector3(0.0,0.0,0.0));
-  VState.dqInertialVelocity.resize(5, FGColumnVector3(0.0,0.0,0.0));
-  VState.dqQtrndot.resize(5, FGQuaternion(0.0,0.0,0.0));
+  integration_method = eSingleStage;
+  substeps = 1;
+  max_substeps = 100;
+  tolerance = 1E-9;
+  SubstepSize = 0.0;
+
+  VState.dqPQRidot.assign(FGColumnVector3(0.0,0.0,0.0));
+  VState.dqUVWidot.assign(FGColumnVector3(0.0,0.0,0.0));
+  VState.dqInertialVelocity.assign(FGColumnVector3(0.0,0.0,0.0));
+  VState.dqQtrndot.assign(FGQuaternion(0.0,0.0,0.0));
 
   bind();
   Debug(0);
@@ -125,18 +133,20 @@ bool FGPropagate::InitModel(void)
 
   // For initialization ONLY:
   VState.vLocation.SetEllipse(in.SemiMajor, in.SemiMinor);
-  VState.vLocation.SetAltitudeAGL(4.0);
+  FDMExec->GetInertial()->SetAltitudeAGL(VState.vLocation, 4.0);
 
-  VState.dqPQRidot.resize(5, FGColumnVector3(0.0,0.0,0.0));
-  VState.dqUVWidot.resize(5, FGColumnVector3(0.0,0.0,0.0));
-  VState.dqInertialVelocity.resize(5, FGColumnVector3(0.0,0.0,0.0));
-  VState.dqQtrndot.resize(5, FGColumnVector3(0.0,0.0,0.0));
+  VState.dqPQRidot.assign(FGColumnVector3(0.0,0.0,0.0));
+  VState.dqUVWidot.assign(FGColumnVector3(0.0,0.0,0.0));
+  VState.dqInertialVelocity.assign(FGColumnVector3(0.0,0.0,0.0));
+  VState.dqQtrndot.assign(FGQuaternion(0.0,0.0,0.0));
 
   integrator_rotational_rate = eRectEuler;
   integrator_translational_rate = eAdamsBashforth2;
   integrator_rotational_position = eRectEuler;
   integrator_translational_position = eAdamsBashforth3;
 
+  SubstepSize = 0.0;
+
   return true;
 }
 
@@ -184,14 +194,14 @@ void FGPropagate::SetInitialState(const FGInitialCondition *FGIC)
 }
 
 //%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
-// Initialize the past value deques
+// Initialize the past value histories
 
 void FGPropagate::InitializeDerivatives()
 {
-  VState.dqPQRidot.assign(5, in.vPQRidot);
-  VState.dqUVWidot.assign(5, in.vUVWidot);
-  VState.dqInertialVelocity.assign(5, VState.vInertialVelocity);
-  VState.dqQtrndot.assign(5, in.vQtrndot);
+  VState.dqPQRidot.assign(in.vPQRidot);
+  VState.dqUVWidot.assign(in.vUVWidot);
+  VState.dqInertialVelocity.assign(VState.vInertialVelocity);
+  VState.dqQtrndot.assign(in.vQtrndot);
 }
 
 //%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
@@ -221,18 +231,47 @@ bool FGPropagate::Run(bool Holding)
 
   double dt = in.DeltaT * rate;  // The 'stepsize'
 
-  // Propagate rotational / translational velocity, angular /translational position, respectively.
+  if (integration_method != eSingleStage && dt > 0.0) {
+    // The past derivatives are recorded so that the single stage integrators
+    // can take over if the integration method is changed.
+    VState.dqQtrndot.push(in.vQtrndot);
+    VState.dqPQRidot.push(in.vPQRidot);
+    VState.dqInertialVelocity.push(VState.vInertialVelocity);
+    VState.dqUVWidot.push(in.vUVWidot);
+
+    // The multistage integrators also update the Earth position angle.
+    if (integration_method == eDormandPrince)
+      IntegrateDormandPrince(dt);
+    else
+      IntegrateRungeKutta4(dt);
+  } else {
+    // Propagate rotational / translational velocity, angular /translational position, respectively.
+
+    Integrate(VState.qAttitudeECI,      in.vQtrndot,          VState.dqQtrndot,          dt, integrator_rotational_position);
+    Integrate(VState.vPQRi,             in.vPQRidot,          VState.dqPQRidot,          dt, integrator_rotational_rate);
+    Integrate(VState.vInertialPosition, VState.vInertialVelocity, VState.dqInertialVelocity, dt, integrator_translational_position);
+    Integrate(VState.vInertialVelocity, in.vUVWidot,          VState.dqUVWidot,          dt, integrator_translational_rate);
+
+    // Update the Earth position angle (EPA)
+    VState.vLocation.IncrementEarthPositionAngle(in.vOmegaPlanet(eZ)*(in.DeltaT*rate));
+  }
+
+  UpdateFromInertialState();
+
+  Debug(2);
+  return false;
+}
 
-  Integrate(VState.qAttitudeECI,      in.vQtrndot,          VState.dqQtrndot,          dt, integrator_rotational_position);
-  Integrate(VState.vPQRi,             in.vPQRidot,          VState.dqPQRidot,          dt, integrator_rotational_rate);
-  Integrate(VState.vInertialPosition, VState.vInertialVelocity, VState.dqInertialVelocity, dt, integrator_translational_position);
-  Integrate(VState.vInertialVelocity, in.vUVWidot,          VState.dqUVWidot,          dt, integrator_translational_rate);
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+// Computes the location, the transformation matrices and the velocities from
+// the inertial state of the vehicle and the Earth position angle.
 
+void FGPropagate::UpdateFromInertialState(void)
+{
   // CAUTION : the order of the operations below is very important to get transformation
   // matrices that are consistent with the new state of the vehicle
 
-  // 1. Update the Earth position angle (EPA)
-  VState.vLocation.IncrementEarthPositionAngle(in.vOmegaPlanet(eZ)*(in.DeltaT*rate));
+  // 1. The Earth position angle (EPA) must have been updated by the caller
 
   // 2. Update the Ti2ec and Tec2i transforms from the updated EPA
   Ti2ec = VState.vLocation.GetTi2ec(); // ECI to ECEF transform
@@ -262,9 +301,185 @@ bool FGPropagate::Run(bool Holding)
 
   // Compute vehicle velocity wrt ECEF frame, expressed in Local horizontal frame.
   vVel = Tb2l * VState.vUVW;
+}
 
-  Debug(2);
-  return false;
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+// Classical Runge-Kutta 4 integration of the inertial state. The time step is
+// split in 'substeps' equal substeps.
+
+void FGPropagate::IntegrateRungeKutta4(double dt)
+{
+  static const double a2[] = {0.5};
+  static const double a3[] = {0.0, 0.5};
+  static const double a4[] = {0.0, 0.0, 1.0};
+  static const double b[]  = {1.0/6.0, 1.0/3.0, 1.0/3.0, 1.0/6.0};
+
+  const double omega = in.vOmegaPlanet(eZ);
+  const int n = substeps > 1 ? substeps : 1;
+  const double h = dt / n;
+  double EPA = VState.vLocation.GetEPA();
+  InertialState y, yi, k[4];
+
+  GetInertialState(y);
+  GetDerivatives(k[0]); // Computed at the end of the previous time step
+
+  for (int i=0; i<n; i++) {
+    if (i > 0) EvaluateDerivatives(y, EPA, k[0]);
+
+    Combine(y, k, a2, 1, h, yi);
+    EvaluateDerivatives(yi, EPA + 0.5*h*omega, k[1]);
+    Combine(y, k, a3, 2, h, yi);
+    EvaluateDerivatives(yi, EPA + 0.5*h*omega, k[2]);
+    Combine(y, k, a4, 3, h, yi);
+    EvaluateDerivatives(yi, EPA + h*omega, k[3]);
+    Combine(y, k, b, 4, h, yi);
+
+    y = yi;
+    EPA += h*omega;
+  }
+
+  SetInertialState(y, EPA);
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+// Dormand-Prince 5(4) integration of the inertial state with adaptive substeps.
+// The coefficients are from J.R. Dormand and P.J. Prince, "A family of embedded
+// Runge-Kutta formulae", J. Comp. Appl. Math. 6 (1980), pp. 19-26. The last
+// stage is evaluated at the end of the substep (FSAL) so it gives the first
+// stage of the next substep.
+
+void FGPropagate::IntegrateDormandPrince(double dt)
+{
+  static const double c[] = {0.0, 1.0/5.0, 3.0/10.0, 4.0/5.0, 8.0/9.0, 1.0, 1.0};
+  static const double a[7][6] = {
+    {0.0},
+    {1.0/5.0},
+    {3.0/40.0, 9.0/40.0},
+    {44.0/45.0, -56.0/15.0, 32.0/9.0},
+    {19372.0/6561.0, -25360.0/2187.0, 64448.0/6561.0, -212.0/729.0},
+    {9017.0/3168.0, -355.0/33.0, 46732.0/5247.0, 49.0/176.0, -5103.0/18656.0},
+    {35.0/384.0, 0.0, 500.0/1113.0, 125.0/192.0, -2187.0/6784.0, 11.0/84.0}
+  };
+  // Difference between the 5th and the 4th order solutions
+  static const double e[] = {71.0/57600.0, 0.0, -71.0/16695.0, 71.0/1920.0,
+                             -17253.0/339200.0, 22.0/525.0, -1.0/40.0};
+
+  const double omega = in.vOmegaPlanet(eZ);
+  const double hmin = dt / (max_substeps > 1 ? max_substeps : 1);
+  double EPA = VState.vLocation.GetEPA();
+  double t = 0.0;
+  InertialState y, y1, k[7];
+
+  GetInertialState(y);
+  GetDerivatives(k[0]); // Computed at the end of the previous time step
+
+  double h = SubstepSize > 0.0 ? min(SubstepSize, dt) : dt;
+
+  while (t < dt) {
+    if (h < hmin) h = hmin;
+    // The last substep is stretched rather than leaving a tiny one
+    const double hproposed = h;
+    const bool last = t + 1.01*h >= dt;
+    if (last) h = dt - t;
+
+    for (unsigned int i=1; i<7; i++) {
+      Combine(y, k, a[i], i, h, y1);
+      EvaluateDerivatives(y1, EPA + c[i]*h*omega, k[i]);
+    }
+
+    // Estimate the error of the substep with a mixed absolute/relative norm
+    double err = 0.0;
+    for (unsigned int i=0; i<13; i++) {
+      double delta = 0.0;
+      for (unsigned int j=0; j<7; j++) delta += e[j]*k[j].v[i];
+      double ratio = h*delta / (tolerance*(1.0 + max(fabs(y.v[i]), fabs(y1.v[i]))));
+      err += ratio*ratio;
+    }
+    err = sqrt(err / 13.0);
+
+    // The substep size is changed by a factor between 0.2 and 5.0
+    double factor = err > 0.0 ? 0.9*pow(err, -0.2) : 5.0;
+    factor = min(5.0, max(0.2, factor));
+
+    if (err <= 1.0 || h <= hmin) { // The substep is accepted
+      t = last ? dt : t + h;
+      EPA += h*omega;
+      y = y1;
+      k[0] = k[6];
+      // A substep shortened to end the time step does not reduce the size
+      // of the substeps of the next time step.
+      SubstepSize = h < hproposed ? max(h*factor, hproposed) : h*factor;
+      h = SubstepSize;
+    } else
+      h *= factor;
+  }
+
+  SetInertialState(y, EPA);
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+void FGPropagate::GetInertialState(InertialState& y) const
+{
+  for (unsigned int i=0; i<4; i++) y.v[i] = VState.qAttitudeECI(i+1);
+  for (unsigned int i=0; i<3; i++) {
+    y.v[4+i]  = VState.vPQRi(i+1);
+    y.v[7+i]  = VState.vInertialPosition(i+1);
+    y.v[10+i] = VState.vInertialVelocity(i+1);
+  }
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+void FGPropagate::GetDerivatives(InertialState& ydot) const
+{
+  for (unsigned int i=0; i<4; i++) ydot.v[i] = in.vQtrndot(i+1);
+  for (unsigned int i=0; i<3; i++) {
+    ydot.v[4+i]  = in.vPQRidot(i+1);
+    ydot.v[7+i]  = VState.vInertialVelocity(i+1);
+    ydot.v[10+i] = in.vUVWidot(i+1);
+  }
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+void FGPropagate::SetInertialState(const InertialState& y, double EPA)
+{
+  for (unsigned int i=0; i<4; i++) VState.qAttitudeECI(i+1) = y.v[i];
+  VState.qAttitudeECI.Normalize();
+  for (unsigned int i=0; i<3; i++) {
+    VState.vPQRi(i+1)             = y.v[4+i];
+    VState.vInertialPosition(i+1) = y.v[7+i];
+    VState.vInertialVelocity(i+1) = y.v[10+i];
+  }
+  VState.vLocation.SetEarthPositionAngle(EPA);
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+// Computes the derivatives of the inertial state y at an intermediate stage.
+
+void FGPropagate::EvaluateDerivatives(const InertialState& y, double EPA,
+                                      InertialState& ydot)
+{
+  SetInertialState(y, EPA);
+  UpdateFromInertialState();
+  FDMExec->EvaluateDerivatives();
+  GetDerivatives(ydot);
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+// Computes y = y0 + h * sum(a[j]*k[j]) for j = 0..n-1
+
+void FGPropagate::Combine(const InertialState& y0, const InertialState* k,
+                          const double* a, unsigned int n, double h,
+                          InertialState& y)
+{
+  y = y0;
+  for (unsigned int j=0; j<n; j++) {
+    if (a[j] == 0.0) continue;
+    double ha = h*a[j];
+    for (unsigned int i=0; i<13; i++) y.v[i] += ha*k[j].v[i];
+  }
 }
 
 //%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
@@ -293,12 +508,11 @@ void FGPropagate::CalculateUVW(void)
 
 void FGPropagate::Integrate( FGColumnVector3& Integrand,
                              FGColumnVector3& Val,
-                             deque <FGColumnVector3>& ValDot,
+                             FGHistory <FGColumnVector3, 5>& ValDot,
                              double dt,
                              eIntegrateType integration_type)
 {
-  ValDot.push_front(Val);
-  ValDot.pop_back();
+  ValDot.push(Val);
 
   switch(integration_type) {
   case eRectEuler:       Integrand += dt*ValDot[0];
@@ -328,12 +542,11 @@ void FGPropagate::Integrate( FGColumnVector3& Integrand,
 
 void FGPropagate::Integrate( FGQuaternion& Integrand,
                              FGQuaternion& Val,
-                             deque <FGQuaternion>& ValDot,
+                             FGHistory <FGQuaternion, 5>& ValDot,
                              double dt,
                              eIntegrateType integration_type)
 {
-  ValDot.push_front(Val);
-  ValDot.pop_back();
+  ValDot.push(Val);
 
   switch(integration_type) {
   case eRectEuler:       Integrand += dt*ValDot[0];
@@ -483,15 +696,16 @@ void FGPropagate::RecomputeLocalTerrainVelocity()
 {
   FGLocation contact;
   FGColumnVector3 normal;
-  VState.vLocation.GetContactPoint(contact, normal, LocalTerrainVelocity,
-                                   LocalTerrainAngularVelocity);
+  FDMExec->GetInertial()->GetContactPoint(VState.vLocation, contact, normal,
+                                          LocalTerrainVelocity,
+                                          LocalTerrainAngularVelocity);
 }
 
 //%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
 
 void FGPropagate::SetTerrainElevation(double terrainElev)
 {
-  double radius = terrainElev + VState.vLocation.GetSeaLevelRadius();
+  double radius = terrainElev + FDMExec->GetInertial()->GetSeaLevelRadius(VState.vLocation);
   FDMExec->GetGroundCallback()->SetTerrainGeoCentRadius(radius);
 }
 
@@ -507,28 +721,51 @@ void FGPropagate::SetSeaLevelRadius(double tt)
 
 double FGPropagate::GetLocalTerrainRadius(void) const
 {
-  return VState.vLocation.GetTerrainRadius();
+  return FDMExec->GetInertial()->GetTerrainRadius(VState.vLocation);
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+double FGPropagate::GetTerrainElevation(void) const
+{
+  return GetLocalTerrainRadius()
+       - FDMExec->GetInertial()->GetSeaLevelRadius(VState.vLocation);
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+double FGPropagate::GetAltitudeASL(void) const
+{
+  return FDMExec->GetInertial()->GetAltitudeASL(VState.vLocation);
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+void FGPropagate::SetAltitudeASL(double altASL)
+{
+  FDMExec->GetInertial()->SetAltitudeASL(VState.vLocation, altASL);
+  UpdateVehicleState();
 }
 
 //%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
 
 double FGPropagate::GetDistanceAGL(void) const
 {
-  return VState.vLocation.GetAltitudeAGL();
+  return FDMExec->GetInertial()->GetAltitudeAGL(VState.vLocation);
 }
 
 //%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
 
 double FGPropagate::GetDistanceAGLKm(void) const
 {
-  return VState.vLocation.GetAltitudeAGL()*0.0003048;
+  return GetDistanceAGL()*0.0003048;
 }
 
 //%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
 
 void FGPropagate::SetDistanceAGL(double tt)
 {
-  VState.vLocation.SetAltitudeAGL(tt);
+  FDMExec->GetInertial()->SetAltitudeAGL(VState.vLocation, tt);
   UpdateVehicleState();
 }
 
@@ -536,7 +773,7 @@ void FGPropagate::SetDistanceAGL(double tt)
 
 void FGPropagate::SetDistanceAGLKm(double tt)
 {
-  VState.vLocation.SetAltitudeAGL(tt*3280.8399);
+  FDMExec->GetInertial()->SetAltitudeAGL(VState.vLocation, tt*3280.8399);
   UpdateVehicleState();
 }
 
@@ -778,10 +1015,41 @@ void FGPropagate::bind(void)
   PropertyManager->Tie("simulation/integrator/rate/translational", (int*)&integrator_translational_rate);
   PropertyManager->Tie("simulation/integrator/position/rotational", (int*)&integrator_rotational_position);
   PropertyManager->Tie("simulation/integrator/position/translational", (int*)&integrator_translational_position);
+  PropertyManager->Tie("simulation/integrator/method", (int*)&integration_method);
+  PropertyManager->Tie("simulation/integrator/substeps", &substeps);
+  PropertyManager->Tie("simulation/integrator/max-substeps", &max_substeps);
+  PropertyManager->Tie("simulation/integrator/tolerance", &tolerance);
 
   PropertyManager->Tie("simulation/write-state-file", this, (iPMF)0, &FGPropagate::WriteStateFile);
 }
 
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+void FGPropagate::ArchiveState(FGSnapshot& snapshot)
+{
+  FGModel::ArchiveState(snapshot);
+  snapshot.Archive(in);
+  snapshot.Archive(VState);
+  snapshot.Archive(vVel);
+  snapshot.Archive(Tec2b);
+  snapshot.Archive(Tb2ec);
+  snapshot.Archive(Tl2b);
+  snapshot.Archive(Tb2l);
+  snapshot.Archive(Tl2ec);
+  snapshot.Archive(Tec2l);
+  snapshot.Archive(Tec2i);
+  snapshot.Archive(Ti2ec);
+  snapshot.Archive(Ti2b);
+  snapshot.Archive(Tb2i);
+  snapshot.Archive(Ti2l);
+  snapshot.Archive(Tl2i);
+  snapshot.Archive(Qec2b);
+  snapshot.Archive(VehicleRadius);
+  snapshot.Archive(LocalTerrainVelocity);
+  snapshot.Archive(LocalTerrainAngularVelocity);
+  snapshot.Archive(SubstepSize);
+}
+
 //%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
 //    The bitmasked value choices are as follows:
 //    unset: In this case (the default) JSBSim would only print
@@ -43,7 +43,7 @@ INCLUDES
 #include "math/FGLocation.h"
 #include "math/FGQuaternion.h"
 #include "math/FGMatrix33.h"
-#include <deque>
+#include "math/FGHistory.h"
 
 /*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
 DEFINITIONS
@@ -58,6 +58,7 @@ FORWARD DECLARATIONS
 namespace JSBSim {
 
 class FGInitialCondition;
+class FGSnapshot;
 
 /*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
 CLASS DOCUMENTATION
@@ -91,6 +92,26 @@ CLASS DOCUMENTATION
     5: Adams Bashforth 4
     @endcode
 
+    The integrators above use the derivatives computed once per time step by
+    the other models. A multistage integrator can be selected instead with
+    the property simulation/integrator/method:
+
+    @code
+    0: The integrators selected by the four properties above (default)
+    1: Runge-Kutta 4
+    2: Dormand-Prince 5(4) with adaptive substeps
+    @endcode
+
+    A multistage integrator integrates the attitude, the angular rate, the
+    position and the velocity together. At each intermediate stage, FGFDMExec
+    evaluates again the models that compute the forces, the moments and the
+    accelerations (see FGFDMExec::EvaluateDerivatives()). The time step can be
+    split in simulation/integrator/substeps equal substeps with Runge-Kutta 4.
+    With Dormand-Prince, the size of the substeps is adjusted so that the
+    error estimated at each substep stays below
+    simulation/integrator/tolerance (relative and absolute), and the time
+    step is split in at most simulation/integrator/max-substeps substeps.
+
     @author Jon S. Berndt, Mathias Froehlich, Bertrand Coconnier
     @version $Id: FGPropagate.h,v 1.82 2015/08/22 18:09:00 bcoconni Exp $
   */
@@ -137,10 +158,12 @@ public:
 
     FGColumnVector3 vInertialPosition;
 
-    std::deque <FGColumnVector3> dqPQRidot;
-    std::deque <FGColumnVector3> dqUVWidot;
-    std::deque <FGColumnVector3> dqInertialVelocity;
-    std::deque <FGQuaternion>    dqQtrndot;
+    /** The past values of the derivatives used by the Adams-Bashforth
+        integrators. The highest order (5) sets the length of the histories. */
+    FGHistory <FGColumnVector3, 5> dqPQRidot;
+    FGHistory <FGColumnVector3, 5> dqUVWidot;
+    FGHistory <FGColumnVector3, 5> dqInertialVelocity;
+    FGHistory <FGQuaternion, 5>    dqQtrndot;
   };
 
   /** Constructor.
@@ -160,6 +183,9 @@ public:
   enum eIntegrateType {eNone = 0, eRectEuler, eTrapezoidal, eAdamsBashforth2,
                        eAdamsBashforth3, eAdamsBashforth4, eBuss1, eBuss2, eLocalLinearization, eAdamsBashforth5};
 
+  /// These define the indices use to select the multistage integrators.
+  enum eIntegrationMethod {eSingleStage = 0, eRungeKutta4, eDormandPrince};
+
   /** Initializes the FGPropagate class after instantiation and prior to first execution.
       The base class FGModel::InitModel is called first, initializing pointers to the
       other FGModel objects (and others).  */
@@ -175,6 +201,7 @@ public:
                      "Resume" command to be given.
       @return false if no error */
   bool Run(bool Holding);
+  void ArchiveState(FGSnapshot& snapshot);
 
   /** Retrieves the velocity vector.
       The vector returned is represented by an FGColumnVector reference. The vector
@@ -321,7 +348,7 @@ public:
       units ft
       @return The current altitude above sea level in feet.
   */
-  double GetAltitudeASL(void) const { return VState.vLocation.GetAltitudeASL(); }
+  double GetAltitudeASL(void) const;
 
   /** Returns the current altitude above sea level.
       This function returns the altitude above sea level.
@@ -427,7 +454,7 @@ public:
   const FGColumnVector3& GetTerrainAngularVelocity(void) const { return LocalTerrainAngularVelocity; }
   void RecomputeLocalTerrainVelocity();
 
-  double GetTerrainElevation(void) const { return GetLocalTerrainRadius() - VState.vLocation.GetSeaLevelRadius(); }
+  double GetTerrainElevation(void) const;
   double GetDistanceAGL(void)  const;
   double GetDistanceAGLKm(void)  const;
   double GetRadius(void) const {
@@ -554,11 +581,7 @@ public:
     VState.vInertialPosition = Tec2i * VState.vLocation;
   }
 
-  void SetAltitudeASL(double altASL)
-  {
-    VState.vLocation.SetAltitudeASL(altASL);
-    UpdateVehicleState();
-  }
+  void SetAltitudeASL(double altASL);
   void SetAltitudeASLmeters(double altASL) { SetAltitudeASL(altASL/fttom); }
 
   void SetSeaLevelRadius(double tt);
@@ -626,24 +649,49 @@ private:
   eIntegrateType integrator_rotational_position;
   eIntegrateType integrator_translational_position;
 
+  eIntegrationMethod integration_method;
+  int substeps;
+  int max_substeps;
+  double tolerance;
+  double SubstepSize; // Last substep size selected by Dormand-Prince
+
+  // The state integrated by the multistage integrators, or its derivative:
+  // the components of the attitude quaternion, of the angular rate, of the
+  // position and of the velocity in the ECI frame.
+  struct InertialState {
+    double v[13];
+  };
+
   void CalculateInertialVelocity(void);
   void CalculateUVW(void);
 
   void Integrate( FGColumnVector3& Integrand,
                   FGColumnVector3& Val,
-                  std::deque <FGColumnVector3>& ValDot,
+                  FGHistory <FGColumnVector3, 5>& ValDot,
                   double dt,
                   eIntegrateType integration_type);
 
   void Integrate( FGQuaternion& Integrand,
                   FGQuaternion& Val,
-                  std::deque <FGQuaternion>& ValDot,
+                  FGHistory <FGQuaternion, 5>& ValDot,
                   double dt,
                   eIntegrateType integration_type);
 
+  void IntegrateRungeKutta4(double dt);
+  void IntegrateDormandPrince(double dt);
+  void GetInertialState(InertialState& y) const;
+  void SetInertialState(const InertialState& y, double EPA);
+  void EvaluateDerivatives(const InertialState& y, double EPA,
+                           InertialState& ydot);
+  void GetDerivatives(InertialState& ydot) const;
+  static void Combine(const InertialState& y0, const InertialState* k,
+                      const double* a, unsigned int n, double h,
+                      InertialState& y);
+
   void UpdateLocationMatrices(void);
   void UpdateBodyMatrices(void);
   void UpdateVehicleState(void);
+  void UpdateFromInertialState(void);
 
   void WriteStateFile(int num);
   void bind(void);
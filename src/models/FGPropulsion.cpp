@@ -60,6 +60,8 @@ INCLUDES
 #include "models/propulsion/FGTank.h"
 #include "input_output/FGModelLoader.h"
 #include "math/FGColumnVector3.h"
+#include "math/FGFunctionOptimizer.h"
+#include "input_output/FGSnapshot.h"
 
 using namespace std;
 
@@ -144,7 +146,12 @@ bool FGPropulsion::Run(bool Holding)
   vMoments.InitMatrix();
 
   for (i=0; i<numEngines; i++) {
-    Engines[i]->Calculate();
+    if (EngineProfiles.empty())
+      Engines[i]->Calculate();
+    else {
+      FGProfiler::Timer timer(EngineProfiles[i]);
+      Engines[i]->Calculate();
+    }
     ConsumeFuel(Engines[i]);
     vForces  += Engines[i]->GetBodyForces();  // sum body frame forces
     vMoments += Engines[i]->GetMoments();     // sum body frame moments
@@ -447,7 +454,7 @@ bool FGPropulsion::Load(Element* el)
   }
 
 
-  PostLoad(el, PropertyManager);
+  PostLoad(el, FDMExec);
 
   return true;
 }
@@ -746,6 +753,29 @@ void FGPropulsion::SetFuelFreeze(bool f)
 
 //%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
 
+void FGPropulsion::RegisterFunctions(FGFunctionOptimizer& optimizer) const
+{
+  for (unsigned int i=0; i<Engines.size(); i++)
+    Engines[i]->RegisterFunctions(optimizer);
+
+  FGModelFunctions::RegisterFunctions(optimizer);
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+void FGPropulsion::CollectParameters(vector<const FGParameter*>& params) const
+{
+  for (unsigned int i=0; i<Engines.size(); i++)
+    Engines[i]->CollectParameters(params);
+
+  for (unsigned int i=0; i<Tanks.size(); i++)
+    Tanks[i]->CollectParameters(params);
+
+  FGModelFunctions::CollectParameters(params);
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
 void FGPropulsion::bind(void)
 {
   typedef double (FGPropulsion::*PMF)(int) const;
@@ -778,6 +808,45 @@ void FGPropulsion::bind(void)
   PropertyManager->Tie("moments/n-prop-lbsft", this, eZ, (PMF)&FGPropulsion::GetMoments);
 }
 
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+void FGPropulsion::SetProfiler(FGProfiler* profiler)
+{
+  EngineProfiles.clear();
+  if (!profiler) return;
+
+  for (unsigned int i=0; i<numEngines; i++) {
+    ostringstream path;
+    path << "propulsion/engine[" << i << "]";
+    EngineProfiles.push_back(profiler->AddSection(path.str()));
+  }
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+void FGPropulsion::ArchiveState(FGSnapshot& snapshot)
+{
+  FGModel::ArchiveState(snapshot);
+  snapshot.Archive(in);
+  snapshot.Archive(numSelectedFuelTanks);
+  snapshot.Archive(numSelectedOxiTanks);
+  snapshot.Archive(ActiveEngine);
+  snapshot.Archive(vForces);
+  snapshot.Archive(vMoments);
+  snapshot.Archive(vTankXYZ);
+  snapshot.Archive(vXYZtank_arm);
+  snapshot.Archive(tankJ);
+  snapshot.Archive(refuel);
+  snapshot.Archive(dump);
+  snapshot.Archive(FuelFreeze);
+  snapshot.Archive(TotalFuelQuantity);
+  snapshot.Archive(DumpRate);
+  snapshot.Archive(RefuelRate);
+
+  for (unsigned int i=0; i<Engines.size(); i++) Engines[i]->ArchiveState(snapshot);
+  for (unsigned int i=0; i<Tanks.size(); i++) Tanks[i]->ArchiveState(snapshot);
+}
+
 //%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
 //    The bitmasked value choices are as follows:
 //    unset: In this case (the default) JSBSim would only print
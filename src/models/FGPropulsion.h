@@ -44,6 +44,7 @@ INCLUDES
 #include "FGModel.h"
 #include "propulsion/FGEngine.h"
 #include "math/FGMatrix33.h"
+#include "FGProfiler.h"
 
 /*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
 DEFINITIONS
@@ -59,6 +60,7 @@ namespace JSBSim {
 
 class FGTank;
 class FGEngine;
+class FGSnapshot;
 
 /*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
 CLASS DOCUMENTATION
@@ -120,6 +122,9 @@ public:
                      "Resume" command to be given.
       @return false if no error */
   bool Run(bool Holding);
+  void ArchiveState(FGSnapshot& snapshot);
+  /// Measures FGEngine::Calculate() for each engine under profiling/propulsion.
+  void SetProfiler(FGProfiler* profiler);
 
   bool InitModel(void);
 
@@ -140,6 +145,16 @@ public:
                       if (index < Engines.size()) return Engines[index];
                       else                        return 0L;      }
 
+  /** Registers the functions of the propulsion system and of its engines to
+      the function optimizer.
+      @param optimizer the optimizer to which the functions are registered. */
+  void RegisterFunctions(FGFunctionOptimizer& optimizer) const;
+
+  /** Collects the parameters of the propulsion system, of its engines and of
+      its tanks.
+      @param params the list to which the parameters are appended. */
+  void CollectParameters(std::vector<const FGParameter*>& params) const;
+
   /// Retrieves the number of tanks defined for the aircraft.
   unsigned int GetNumTanks(void) const {return (unsigned int)Tanks.size();}
 
@@ -200,6 +215,7 @@ public:
 private:
   std::vector <FGEngine*>   Engines;
   std::vector <FGTank*>     Tanks;
+  std::vector <FGProfiler::Section*> EngineProfiles;
   unsigned int numSelectedFuelTanks;
   unsigned int numSelectedOxiTanks;
   unsigned int numFuelTanks;
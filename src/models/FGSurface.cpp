@@ -40,6 +40,7 @@ INCLUDES
 
 #include "input_output/FGPropertyManager.h"
 #include "models/FGSurface.h"
+#include "input_output/FGSnapshot.h"
 
 using namespace std;
 
@@ -83,6 +84,20 @@ void FGSurface::resetValues(void)
 
 //%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
 
+void FGSurface::ArchiveState(FGSnapshot& snapshot)
+{
+  snapshot.Archive(staticFFactor);
+  snapshot.Archive(rollingFFactor);
+  snapshot.Archive(maximumForce);
+  snapshot.Archive(bumpiness);
+  snapshot.Archive(isSolid);
+  snapshot.Archive(staticFCoeff);
+  snapshot.Archive(dynamicFCoeff);
+  snapshot.Archive(pos, 3);
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
 void FGSurface::bind(void)
 {
   if (!_PropertyManager) return;
@@ -52,6 +52,8 @@ FORWARD DECLARATIONS
 
 namespace JSBSim {
 
+class FGSnapshot;
+
 /*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
 CLASS DOCUMENTATION
 %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
@@ -81,6 +83,9 @@ public:
   /// Reset all surface values to a default
   void resetValues(void);
 
+  /// Saves or restores the surface values in a snapshot
+  void ArchiveState(FGSnapshot& snapshot);
+
   /// Sets the static friction factor of the surface area
   void SetStaticFFactor(double friction) { staticFFactor = friction; }
 
@@ -59,6 +59,7 @@ INCLUDES
 
 #include "FGMSIS.h"
 #include "models/FGAuxiliary.h"
+#include <algorithm>
 #include <cmath>          /* maths functions */
 #include <iostream>        // for cout, endl
 
@@ -91,11 +92,24 @@ EXTERNAL GLOBAL DATA
 CLASS IMPLEMENTATION
 %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
 
+const double MSIS::LowerStep = 1.0;  // km, up to 200 km
+const double MSIS::UpperStep = 5.0;  // km, up to 1000 km
+
+// The profile of the next cell is prefetched when the vehicle is expected to
+// reach it within that time (seconds).
+static const double PrefetchHorizon = 60.0;
 
 MSIS::MSIS(FGFDMExec* fdmex) : FGAtmosphere(fdmex)
 {
   Name = "MSIS";
 
+  CellLat = CellLon = 0.25;
+  CellSec = 60.0;
+  Current = new Profile;
+  Prefetched = new Profile;
+  Current->Key.Day = Prefetched->Key.Day = -1;
+  PrevTime = PrevLat = PrevLon = PrevSec = 0.0;
+
   for (int i=0; i<9; i++) output.d[i] = 0.0;
   for (int i=0; i<2; i++) output.t[i] = 0.0;
 
@@ -115,6 +129,10 @@ MSIS::MSIS(FGFDMExec* fdmex) : FGAtmosphere(fdmex)
 
 MSIS::~MSIS()
 {
+  WaitRefresh();
+  delete Current;
+  delete Prefetched;
+
   Debug(1);
 }
 
@@ -124,6 +142,12 @@ bool MSIS::InitModel(void)
 {
   unsigned int i;
 
+  if (!FGModel::InitModel()) return false;
+
+  WaitRefresh();
+  Current->Key.Day = Prefetched->Key.Day = -1;
+  PrevTime = -1.0;
+
   flags.switches[0] = 0;
   flags.sw[0] = 0;
   flags.swc[0] = 0;
@@ -151,6 +175,9 @@ bool MSIS::InitModel(void)
 //  rSLdensity     = 1.0/intDensity;
 //  rSLsoundspeed  = 1.0/SLsoundspeed;
 
+  in.altitudeASL = FDMExec->GetPropagate()->GetAltitudeASL();
+  Compute();
+
   return true;
 }
 
@@ -161,41 +188,221 @@ bool MSIS::Run(bool Holding)
   if (FGModel::Run(Holding)) return true;
   if (Holding) return false;
 
-  double h = FDMExec->GetPropagate()->GetAltitudeASL();
-
-  //do temp, pressure, and density first
-  //if (!useExternal) {
-    // get sea-level values
-    Calculate(FDMExec->GetAuxiliary()->GetDayOfYear(),
-              FDMExec->GetAuxiliary()->GetSecondsInDay(),
-              0.0,
-              FDMExec->GetPropagate()->GetLocation().GetLatitudeDeg(),
-              FDMExec->GetPropagate()->GetLocation().GetLongitudeDeg());
-    SLtemperature = output.t[1] * 1.8;
-    SLdensity     = output.d[5] * 1.940321;
-    SLpressure    = 1716.488 * SLdensity * SLtemperature;
-    SLsoundspeed  = sqrt(2403.0832 * SLtemperature);
+  Compute();
+
+  Debug(2);
+
+  return false;
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+void MSIS::Compute(void)
+{
+  const FGLocation& location = FDMExec->GetPropagate()->GetLocation();
+
+  Cell cell = Current->Key;
+
+  UpdateProfile(FDMExec->GetAuxiliary()->GetDayOfYear(),
+                FDMExec->GetAuxiliary()->GetSecondsInDay(),
+                location.GetGeodLatitudeDeg(),
+                location.GetLongitudeDeg());
+
+  // get sea-level values, which only change with the profile
+  if (!(cell == Current->Key)) {
+    SLtemperature = GetTemperature(0.0);
+    SLdensity     = GetDensity(0.0);
+    SLpressure    = GetPressure(0.0);
+    SLsoundspeed  = sqrt(SHRatio * Reng * SLtemperature);
     rSLtemperature = 1.0/SLtemperature;
     rSLpressure    = 1.0/SLpressure;
     rSLdensity     = 1.0/SLdensity;
     rSLsoundspeed  = 1.0/SLsoundspeed;
+  }
 
-    // get at-altitude values
-    Calculate(FDMExec->GetAuxiliary()->GetDayOfYear(),
-              FDMExec->GetAuxiliary()->GetSecondsInDay(),
-              h,
-              FDMExec->GetPropagate()->GetLocation().GetLatitudeDeg(),
-              FDMExec->GetPropagate()->GetLocation().GetLongitudeDeg());
-    //intTemperature = output.t[1] * 1.8;
-    //intDensity     = output.d[5] * 1.940321;
-    //intPressure    = 1716.488 * intDensity * intTemperature;
-    //cout << "T=" << intTemperature << " D=" << intDensity << " P=";
-    //cout << intPressure << " a=" << soundspeed << endl;
-  //}
+  // get at-altitude values
+  FGAtmosphere::Calculate(in.altitudeASL);
+}
 
-  Debug(2);
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
 
-  return false;
+void MSIS::SetCellSize(double lat, double lon, double sec)
+{
+  if (lat <= 0.0 || lon <= 0.0 || sec <= 0.0) {
+    cerr << "The size of the MSIS cells must be positive" << endl;
+    return;
+  }
+
+  WaitRefresh();
+  CellLat = lat;
+  CellLon = lon;
+  CellSec = sec;
+  Current->Key.Day = Prefetched->Key.Day = -1;
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+MSIS::Cell MSIS::GetCell(int day, double sec, double lat, double lon) const
+{
+  Cell cell;
+  cell.Day = day;
+  cell.Sec = (long)floor(sec / CellSec);
+  cell.Lat = (long)floor(max(-90.0, min(lat, 90.0)) / CellLat);
+  cell.Lon = (long)floor((lon - 360.0*floor((lon + 180.0)/360.0)) / CellLon);
+  return cell;
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+// Makes the profile of the current cell available: it has either been
+// prefetched or it is computed immediately.
+
+void MSIS::UpdateProfile(int day, double sec, double lat, double lon)
+{
+  Cell cell = GetCell(day, sec, lat, lon);
+
+  if (!(cell == Current->Key)) {
+    WaitRefresh();
+    if (cell == Prefetched->Key)
+      swap(Current, Prefetched);
+    else {
+      Current->Key = cell;
+      ComputeProfile(Current);
+    }
+  }
+
+  Prefetch(cell, sec, lat, lon);
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+// Extrapolates the motion of the vehicle to find the next cell that it will
+// enter and computes its profile in the background.
+
+void MSIS::Prefetch(const Cell& cell, double sec, double lat, double lon)
+{
+  double t = FDMExec->GetSimTime();
+  double dt = t - PrevTime;
+  double dlon = lon - PrevLon;
+  double x[3] = {sec, lat, lon};
+  double delta[3] = {sec - PrevSec, lat - PrevLat,
+                     dlon - 360.0*floor((dlon + 180.0)/360.0)};
+  bool valid = PrevTime >= 0.0 && dt > 0.0;
+
+  PrevTime = t;
+  PrevSec = sec;
+  PrevLat = lat;
+  PrevLon = lon;
+
+  // Release the result of the last refresh once it is completed.
+  if (Refresh.valid()) {
+    if (Refresh.wait_for(std::chrono::seconds(0)) != std::future_status::ready)
+      return;
+    Refresh.get();
+  }
+
+  if (!valid) return;
+
+  // Time after which the vehicle leaves the current cell.
+  double size[3] = {CellSec, CellLat, CellLon};
+  double rates[3];
+  double exit = PrefetchHorizon;
+  for (int i=0; i<3; i++) {
+    rates[i] = delta[i] / dt;
+    if (rates[i] == 0.0) continue;
+    double lower = size[i]*floor(x[i]/size[i]);
+    double bound = rates[i] > 0.0 ? lower + size[i] : lower;
+    exit = min(exit, (bound - x[i]) / rates[i]);
+  }
+  if (exit >= PrefetchHorizon) return;
+
+  // Step a bit further to cross the boundary.
+  exit += 1E-3;
+  Cell next = GetCell(cell.Day, sec + rates[0]*exit, lat + rates[1]*exit,
+                      lon + rates[2]*exit);
+  if (next == cell || next == Prefetched->Key) return;
+
+  Prefetched->Key = next;
+  Refresh = std::async(std::launch::async, &MSIS::ComputeProfile, this,
+                       Prefetched);
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+// The NRLMSISE-00 model uses the members of the class as scratch data so a
+// profile must not be computed while another one is computed in the
+// background.
+
+void MSIS::ComputeProfile(Profile* profile)
+{
+  const Cell& cell = profile->Key;
+  double sec = (cell.Sec + 0.5) * CellSec;
+  double lat = (cell.Lat + 0.5) * CellLat;
+  double lon = (cell.Lon + 0.5) * CellLon;
+
+  for (int i=0; i<NumNodes; i++) {
+    double alt = i < LowerNodes ? i*LowerStep
+                                : (LowerNodes-1)*LowerStep + (i-LowerNodes+1)*UpperStep;
+    Calculate(cell.Day, sec, alt*3281, lat, lon);
+    profile->Temperature[i] = output.t[1] * 1.8;
+    profile->LogDensity[i] = log(output.d[5] * 1.940321);
+  }
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+void MSIS::WaitRefresh(void)
+{
+  if (Refresh.valid()) Refresh.get();
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+// The values beyond the ends of the grid are extrapolated from the closest
+// interval.
+
+double MSIS::Interpolate(const double* values, double altitude) const
+{
+  const double top = (LowerNodes-1)*LowerStep;
+  double alt = altitude / 3281;  //feet to kilometers
+  double pos = alt < top ? alt / LowerStep
+                         : LowerNodes - 1 + (alt - top) / UpperStep;
+  int i = max(0, min((int)floor(pos), NumNodes-2));
+  double f = pos - i;
+
+  return values[i] + f*(values[i+1] - values[i]);
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+double MSIS::GetTemperature(double altitude) const
+{
+  return Interpolate(Current->Temperature, altitude);
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+double MSIS::GetDensity(double altitude) const
+{
+  return exp(Interpolate(Current->LogDensity, altitude));
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+double MSIS::GetPressure(double altitude) const
+{
+  return Reng * GetDensity(altitude) * GetTemperature(altitude);
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+void MSIS::CalculateDirect(double& temperature, double& density)
+{
+  const FGLocation& location = FDMExec->GetPropagate()->GetLocation();
+
+  // The scratch data of the model are shared with the background refresh.
+  WaitRefresh();
+  Calculate(FDMExec->GetAuxiliary()->GetDayOfYear(),
+            FDMExec->GetAuxiliary()->GetSecondsInDay(), in.altitudeASL,
+            location.GetGeodLatitudeDeg(), location.GetLongitudeDeg());
+  temperature = output.t[1] * 1.8;
+  density = output.d[5] * 1.940321;
 }
 
 //%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
@@ -40,6 +40,8 @@ SENTRY
 INCLUDES
 %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
 
+#include <future>
+
 #include "models/FGAtmosphere.h"
 #include "FGFDMExec.h"
 
@@ -74,6 +76,17 @@ CLASS DOCUMENTATION
     reach him at devel@brodo.de. See the file "DOCUMENTATION" for details,
     and check http://www.brodo.de/english/pub/nrlmsise/index.html for
     updated releases of this package.
+
+    The model is too expensive to be evaluated at every frame. Instead the
+    temperature and the density are tabulated on an altitude grid (every km up
+    to 200 km, then every 5 km up to 1000 km) for a cell of day of year, time
+    of day, latitude and longitude. The values at the current altitude are
+    interpolated in this profile: linearly for the temperature and the
+    logarithm of the density. The profile only depends on the cell (it is
+    computed at its center) so the results do not depend on the history of
+    the simulation. The profile of the next cell that the vehicle is about to
+    enter is computed in the background so that it is ready when the vehicle
+    reaches it. The size of the cells is set by SetCellSize().
     @author David Culp
     @version $Id: FGMSIS.h,v 1.9 2011/05/20 03:18:36 jberndt Exp $
 */
@@ -248,7 +261,66 @@ public:
   /// Does nothing. External control is not allowed.
   void UseExternal(void);
 
+  /** Sets the size of the cells within which the profile of the atmosphere
+      is considered constant. The default is 0.25 degree of latitude and of
+      longitude and 60 seconds which keeps the temperature and the density
+      within 0.1% of a direct evaluation of the model.
+      @param lat the size of the cells in latitude, degrees
+      @param lon the size of the cells in longitude, degrees
+      @param sec the size of the cells in time of day, seconds */
+  void SetCellSize(double lat, double lon, double sec);
+
+  /// Returns the temperature in degrees Rankine at the given altitude (feet).
+  double GetTemperature(double altitude) const;
+  /// Returns the pressure in psf at the given altitude (feet).
+  double GetPressure(double altitude) const;
+  /// Returns the density in slugs/ft^3 at the given altitude (feet).
+  double GetDensity(double altitude) const;
+  /// Does nothing. The temperature can not be modified.
+  void SetTemperature(double, double, eTemperature=eFahrenheit) {}
+
+  /** Evaluates the NRLMSISE-00 model at the current location and time of the
+      vehicle, without the tabulated profile. It is much slower than the
+      interpolation and meant to check it.
+      @param temperature receives the temperature in degrees Rankine
+      @param density receives the density in slugs/ft^3 */
+  void CalculateDirect(double& temperature, double& density);
+
 private:
+  // Altitude grid of the profiles, in km.
+  static const int LowerNodes = 201;
+  static const int NumNodes = LowerNodes + 160;
+  static const double LowerStep;
+  static const double UpperStep;
+
+  struct Cell {
+    int Day;
+    long Sec, Lat, Lon;
+    bool operator==(const Cell& c) const {
+      return Day == c.Day && Sec == c.Sec && Lat == c.Lat && Lon == c.Lon;
+    }
+  };
+
+  struct Profile {
+    Cell Key;
+    double Temperature[NumNodes];  // Rankine
+    double LogDensity[NumNodes];   // log(slugs/ft^3)
+  };
+
+  double CellLat, CellLon, CellSec;
+  Profile* Current;
+  Profile* Prefetched;
+  std::future<void> Refresh;
+  double PrevTime, PrevLat, PrevLon, PrevSec;
+
+  void Compute(void);
+  Cell GetCell(int day, double sec, double lat, double lon) const;
+  void UpdateProfile(int day, double sec, double lat, double lon);
+  void Prefetch(const Cell& cell, double sec, double lat, double lon);
+  void ComputeProfile(Profile* profile);
+  void WaitRefresh(void);
+  double Interpolate(const double* values, double altitude) const;
+
 
   void Calculate(int day,      // day of year (1 to 366) 
                  double sec,   // seconds in day (0.0 to 86400.0)
@@ -47,6 +47,7 @@ INCLUDES
 #include <cstdlib>
 #include "FGFDMExec.h"
 #include "FGStandardAtmosphere.h"
+#include "input_output/FGSnapshot.h"
 
 namespace JSBSim {
 
@@ -443,6 +444,18 @@ void FGStandardAtmosphere::bind(void)
                                    (PMF)&FGStandardAtmosphere::SetPressureSL);
 }
 
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+void FGStandardAtmosphere::ArchiveState(FGSnapshot& snapshot)
+{
+  FGAtmosphere::ArchiveState(snapshot);
+  snapshot.Archive(TemperatureBias);
+  snapshot.Archive(TemperatureDeltaGradient);
+  snapshot.Archive(GradientFadeoutAltitude);
+  snapshot.Archive(LapseRateVector);
+  snapshot.Archive(PressureBreakpointVector);
+}
+
 //%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
 //    The bitmasked value choices are as follows:
 //    unset: In this case (the default) JSBSim would only print
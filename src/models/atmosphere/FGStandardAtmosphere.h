@@ -54,6 +54,8 @@ FORWARD DECLARATIONS
 
 namespace JSBSim {
 
+class FGSnapshot;
+
 /*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
 CLASS DOCUMENTATION
 %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
@@ -109,6 +111,7 @@ public:
   virtual ~FGStandardAtmosphere();
 
   bool InitModel(void);
+  void ArchiveState(FGSnapshot& snapshot);
 
   //  *************************************************************************
   /// @name Temperature access functions.
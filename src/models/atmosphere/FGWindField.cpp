@@ -0,0 +1,401 @@
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+Module: FGWindField.cpp
+Date started: June 2016
+Purpose: Wind and temperature field gridded in a memory mapped file
+
+ ------------- Copyright (C) 2016  JSBSim development team  -------------
+
+ This program is free software; you can redistribute it and/or modify it under
+ the terms of the GNU Lesser General Public License as published by the Free Software
+ Foundation; either version 2 of the License, or (at your option) any later
+ version.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ details.
+
+ You should have received a copy of the GNU Lesser General Public License along with
+ this program; if not, write to the Free Software Foundation, Inc., 59 Temple
+ Place - Suite 330, Boston, MA  02111-1307, USA.
+
+ Further information about the GNU Lesser General Public License can also be found on
+ the world wide web at http://www.gnu.org.
+
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+INCLUDES
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <map>
+#include <mutex>
+#include <stdint.h>
+
+#ifdef _WIN32
+#  include <windows.h>
+#else
+#  include <fcntl.h>
+#  include <sys/mman.h>
+#  include <sys/stat.h>
+#  include <unistd.h>
+#endif
+
+#include "FGWindField.h"
+
+using namespace std;
+
+namespace JSBSim {
+
+IDENT(IdSrc,"$Id$");
+IDENT(IdHdr,ID_WINDFIELD);
+
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+CLASS IMPLEMENTATION
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+struct FileHeader {
+  char Magic[8];
+  uint32_t Version;
+  uint32_t Variables;
+  uint32_t Count[4];
+  double Axis[8];
+};
+
+static const char Magic[8] = {'J', 'S', 'B', 'W', 'I', 'N', 'D', '\0'};
+
+// The fields that are currently mapped, indexed by the canonical path of their
+// file so that the different spellings of a path share the same mapping.
+static mutex RegistryLock;
+static map<string, weak_ptr<const FGWindField> > Registry;
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+// Returns the absolute path of a file with the symbolic links resolved, or the
+// file name itself when it can not be resolved (the file does not exist, for
+// instance, in which case it can not be opened either).
+
+static string CanonicalPath(const string& filename)
+{
+#ifdef _WIN32
+  char path[MAX_PATH];
+  DWORD length = GetFullPathNameA(filename.c_str(), MAX_PATH, path, 0);
+  if (length == 0 || length >= MAX_PATH) return filename;
+  return string(path);
+#else
+  char* path = realpath(filename.c_str(), 0);
+  if (!path) return filename;
+  string result(path);
+  free(path);
+  return result;
+#endif
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+shared_ptr<const FGWindField> FGWindField::Open(const string& filename)
+{
+  string key = CanonicalPath(filename);
+  lock_guard<mutex> guard(RegistryLock);
+
+  // The entries of the fields that have been released are removed.
+  map<string, weak_ptr<const FGWindField> >::iterator it = Registry.begin();
+  while (it != Registry.end()) {
+    if (it->second.expired())
+      Registry.erase(it++);
+    else
+      ++it;
+  }
+
+  shared_ptr<const FGWindField> field = Registry[key].lock();
+  if (!field) {
+    field.reset(new FGWindField(filename));
+    Registry[key] = field;
+  }
+
+  return field;
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+FGWindField::FGWindField(const string& filename)
+  : FileName(filename), NumVariables(0), Values(0), Address(0), Length(0)
+{
+#ifdef _WIN32
+  Mapping = 0;
+  File = CreateFileA(filename.c_str(), GENERIC_READ, FILE_SHARE_READ, 0,
+                     OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, 0);
+  if (File == INVALID_HANDLE_VALUE)
+    throw("Could not open the wind field file " + filename);
+
+  LARGE_INTEGER size;
+  if (GetFileSizeEx(File, &size)) {
+    Length = (size_t)size.QuadPart;
+    Mapping = CreateFileMappingA(File, 0, PAGE_READONLY, 0, 0, 0);
+  }
+  if (Mapping) Address = MapViewOfFile(Mapping, FILE_MAP_READ, 0, 0, 0);
+  if (!Address) {
+    if (Mapping) CloseHandle(Mapping);
+    CloseHandle(File);
+    throw("Could not map the wind field file " + filename);
+  }
+#else
+  int fd = open(filename.c_str(), O_RDONLY);
+  if (fd < 0)
+    throw("Could not open the wind field file " + filename);
+
+  struct stat st;
+  if (fstat(fd, &st) == 0 && st.st_size > 0) {
+    Length = (size_t)st.st_size;
+    Address = mmap(0, Length, PROT_READ, MAP_SHARED, fd, 0);
+    if (Address == MAP_FAILED) Address = 0;
+  }
+  // The mapping remains valid once the file is closed.
+  close(fd);
+  if (!Address)
+    throw("Could not map the wind field file " + filename);
+#endif
+
+  // From here on, the destructor is not run if an exception is thrown.
+  try {
+    FileHeader header;
+    if (Length < sizeof(header))
+      throw("The wind field file " + filename + " is too short.");
+    memcpy(&header, Address, sizeof(header));
+
+    if (memcmp(header.Magic, Magic, sizeof(Magic)) != 0 || header.Version != 1)
+      throw(filename + " is not a wind field file.");
+    if (header.Variables != 3 && header.Variables != 4)
+      throw("The wind field file " + filename
+            + " must contain 3 or 4 variables.");
+    NumVariables = header.Variables;
+
+    double nodes = 1.0;
+    for (unsigned int i=0; i<4; i++) {
+      Axis& axis = Axes[i];
+      axis.Count = header.Count[i];
+      axis.Origin = header.Axis[2*i];
+      axis.Step = header.Axis[2*i+1];
+      axis.Periodic = i == eLongitude && axis.Count > 1
+                      && axis.Count*axis.Step >= 360.0 - 1E-6;
+      if (axis.Count == 0 || (axis.Count > 1 && !(axis.Step > 0.0)))
+        throw("The grid of the wind field file " + filename + " is invalid.");
+      nodes *= axis.Count;
+    }
+
+    if (sizeof(header) + nodes*NumVariables*sizeof(float) != (double)Length)
+      throw("The size of the wind field file " + filename
+            + " does not match its grid.");
+
+    Values = (const float*)((const char*)Address + sizeof(header));
+  }
+  catch (...) {
+#ifdef _WIN32
+    UnmapViewOfFile(Address);
+    CloseHandle(Mapping);
+    CloseHandle(File);
+#else
+    munmap(Address, Length);
+#endif
+    throw;
+  }
+
+  Debug(0);
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+FGWindField::~FGWindField()
+{
+#ifdef _WIN32
+  UnmapViewOfFile(Address);
+  CloseHandle(Mapping);
+  CloseHandle(File);
+#else
+  munmap(Address, Length);
+#endif
+
+  Debug(1);
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+const float* FGWindField::GetNode(unsigned int ilat, unsigned int ilon,
+                                  unsigned int ialt, unsigned int itime) const
+{
+  size_t node = ((size_t)itime*Axes[eAltitude].Count + ialt)
+                * Axes[eLatitude].Count + ilat;
+  return Values + (node*Axes[eLongitude].Count + ilon)*NumVariables;
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+// Returns the index of the node that precedes x and the position of x between
+// this node and the next one. A periodic axis is wrapped every 360 degrees so
+// that the last node is followed by the first one. A coordinate that is not
+// finite is located at the first node.
+
+void FGWindField::Axis::Locate(double x, unsigned int& index,
+                               double& fraction) const
+{
+  index = 0;
+  fraction = 0.0;
+  if (Count == 1) return;
+
+  double u = (x - Origin) / Step;
+  if (!std::isfinite(u)) return;
+
+  if (Periodic) {
+    double period = 360.0 / Step;
+    u = fmod(u, period);
+    if (u < 0.0) u += period;
+  } else if (u <= 0.0)
+    return;
+  else if (u >= Count - 1) {
+    index = Count - 2;
+    fraction = 1.0;
+    return;
+  }
+
+  index = (unsigned int)u;
+  if (index >= Count) index = Count - 1;
+  fraction = u - index;
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+unsigned int FGWindField::Axis::Next(unsigned int index) const
+{
+  return index + 1 < Count ? index + 1 : 0;
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+FGWindField::Sampler::Sampler(void)
+  : CellLoads(0), Temperature(0.0)
+{
+  Cell[0] = Cell[1] = Cell[2] = Cell[3] = 0;
+  memset(Nodes, 0, sizeof(Nodes));
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+void FGWindField::Sampler::SetField(shared_ptr<const FGWindField> field)
+{
+  Field = field;
+  CellLoads = 0;
+  vWindNED.InitMatrix();
+  Temperature = 0.0;
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+// The bit i of the index of a node in the cache tells whether it is the first
+// (0) or the second (1) node of the cell along the axis i.
+
+void FGWindField::Sampler::LoadCell(const unsigned int cell[4])
+{
+  const Axis* axes = Field->Axes;
+
+  for (unsigned int n=0; n<16; n++) {
+    unsigned int index[4];
+    for (unsigned int i=0; i<4; i++)
+      index[i] = (n >> i) & 1 ? axes[i].Next(cell[i]) : cell[i];
+
+    const float* node = Field->GetNode(index[eLatitude], index[eLongitude],
+                                       index[eAltitude], index[eTime]);
+    for (unsigned int k=0; k<4; k++)
+      Nodes[n][k] = k < Field->NumVariables ? node[k] : 0.0;
+  }
+
+  memcpy(Cell, cell, sizeof(Cell));
+  CellLoads++;
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+void FGWindField::Sampler::Sample(double latitude, double longitude,
+                                  double altitude, double time)
+{
+  if (!Field) return;
+
+  const Axis* axes = Field->Axes;
+  unsigned int cell[4];
+  double fraction[4];
+
+  axes[eLatitude].Locate(latitude*radtodeg, cell[eLatitude],
+                         fraction[eLatitude]);
+  axes[eLongitude].Locate(longitude*radtodeg, cell[eLongitude],
+                          fraction[eLongitude]);
+  axes[eAltitude].Locate(altitude, cell[eAltitude], fraction[eAltitude]);
+  axes[eTime].Locate(time, cell[eTime], fraction[eTime]);
+
+  if (CellLoads == 0 || memcmp(cell, Cell, sizeof(Cell)) != 0)
+    LoadCell(cell);
+
+  double value[4] = {0.0, 0.0, 0.0, 0.0};
+  for (unsigned int n=0; n<16; n++) {
+    double weight = 1.0;
+    for (unsigned int i=0; i<4; i++)
+      weight *= (n >> i) & 1 ? fraction[i] : 1.0 - fraction[i];
+    if (weight == 0.0) continue;
+    for (unsigned int k=0; k<4; k++)
+      value[k] += weight*Nodes[n][k];
+  }
+
+  vWindNED(eNorth) = value[0];
+  vWindNED(eEast) = value[1];
+  vWindNED(eDown) = value[2];
+  Temperature = value[3];
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+//    The bitmasked value choices are as follows:
+//    unset: In this case (the default) JSBSim would only print
+//       out the normally expected messages, essentially echoing
+//       the config files as they are read. If the environment
+//       variable is not set, debug_lvl is set to 1 internally
+//    0: This requests JSBSim not to output any messages
+//       whatsoever.
+//    1: This value explicity requests the normal JSBSim
+//       startup messages
+//    2: This value asks for a message to be printed out when
+//       a class is instantiated
+//    4: When this value is set, a message is displayed when a
+//       FGModel object executes its Run() method
+//    8: When this value is set, various runtime state variables
+//       are printed out periodically
+//    16: When set various parameters are sanity checked and
+//       a message is printed out when they go out of bounds
+
+void FGWindField::Debug(int from)
+{
+  if (debug_lvl <= 0) return;
+
+  if (debug_lvl & 1) { // Standard console startup message output
+    if (from == 0) { // Constructor
+      cout << "    Wind field: " << FileName << " ("
+           << Axes[eLatitude].Count << " x " << Axes[eLongitude].Count
+           << " x " << Axes[eAltitude].Count << " x " << Axes[eTime].Count
+           << " nodes" << (HasTemperature() ? ", with temperature" : "")
+           << ")" << endl;
+    }
+  }
+  if (debug_lvl & 2 ) { // Instantiation/Destruction notification
+    if (from == 0) cout << "Instantiated: FGWindField" << endl;
+    if (from == 1) cout << "Destroyed:    FGWindField" << endl;
+  }
+  if (debug_lvl & 4 ) { // Run() method entry print for FGModel-derived objects
+  }
+  if (debug_lvl & 8 ) { // Runtime state variables
+  }
+  if (debug_lvl & 16) { // Sanity checking
+  }
+  if (debug_lvl & 64) {
+    if (from == 0) { // Constructor
+      cout << IdSrc << endl;
+      cout << IdHdr << endl;
+    }
+  }
+}
+}
@@ -0,0 +1,184 @@
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+ Header: FGWindField.h
+ Date started: June 2016
+
+ ------------- Copyright (C) 2016  JSBSim development team  -------------
+
+ This program is free software; you can redistribute it and/or modify it under
+ the terms of the GNU Lesser General Public License as published by the Free Software
+ Foundation; either version 2 of the License, or (at your option) any later
+ version.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ details.
+
+ You should have received a copy of the GNU Lesser General Public License along with
+ this program; if not, write to the Free Software Foundation, Inc., 59 Temple
+ Place - Suite 330, Boston, MA  02111-1307, USA.
+
+ Further information about the GNU Lesser General Public License can also be found on
+ the world wide web at http://www.gnu.org.
+
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+SENTRY
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+#ifndef FGWINDFIELD_H
+#define FGWINDFIELD_H
+
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+INCLUDES
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+#include <memory>
+#include <string>
+
+#include "FGJSBBase.h"
+#include "math/FGColumnVector3.h"
+
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+DEFINITIONS
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+#define ID_WINDFIELD "$Id$"
+
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+FORWARD DECLARATIONS
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+namespace JSBSim {
+
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+CLASS DOCUMENTATION
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+/** A wind and temperature field gridded in latitude, longitude, altitude and
+    time, read from a memory mapped binary file.
+
+    The file is mapped read only and shared by all the instances that open it:
+    Open() returns the mapping that already exists for the file, whatever the
+    spelling of its path, and the file is unmapped when the last instance
+    releases it. The values are
+    interpolated by a Sampler which caches the nodes of the grid cell that
+    surrounds the last position.
+
+    The file starts with a header of 96 bytes, in the byte order of the
+    machine:
+    - <tt>char magic[8]</tt>: "JSBWIND" followed by a null character.
+    - <tt>uint32 version</tt>: 1.
+    - <tt>uint32 variables</tt>: 3 for the wind only, 4 if the temperature is
+      also given.
+    - <tt>uint32 count[4]</tt>: the number of nodes along the latitude, the
+      longitude, the altitude and the time axes.
+    - <tt>double origin[4], step[4]</tt> interleaved (origin then step for each
+      axis): the first node and the spacing of the axes, in degrees for the
+      latitude (geodetic) and the longitude, feet above sea level for the
+      altitude and seconds for the time.
+
+    It is followed by the values, stored as <tt>float</tt>: the wind north,
+    east and down in ft/sec and then the temperature in degrees Rankine, for
+    each node. The longitude varies the fastest, then the latitude, the
+    altitude and the time.
+
+    The values are clamped at the boundaries of the grid except along a
+    longitude axis that covers 360 degrees, which wraps around.
+ */
+
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+CLASS DECLARATION
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+class FGWindField : public FGJSBBase
+{
+public:
+  enum eAxis {eLatitude=0, eLongitude, eAltitude, eTime};
+
+  /** Returns the field stored in a file. The file is only mapped the first
+      time it is opened.
+      @param filename the name of the file.
+      @throw string if the file can not be mapped or is not a valid field. */
+  static std::shared_ptr<const FGWindField> Open(const std::string& filename);
+
+  /// Destructor. Unmaps the file.
+  ~FGWindField();
+
+  const std::string& GetFileName(void) const { return FileName; }
+  bool HasTemperature(void) const { return NumVariables > 3; }
+  unsigned int GetNumNodes(eAxis axis) const { return Axes[axis].Count; }
+
+  /** Interpolates a field and caches the nodes of the current grid cell. A
+      sampler belongs to a single simulation: it is not thread safe, contrary
+      to the field that it reads. */
+  class Sampler {
+  public:
+    Sampler(void);
+
+    void SetField(std::shared_ptr<const FGWindField> field);
+    const FGWindField* GetField(void) const { return Field.get(); }
+
+    /** Interpolates the field.
+        @param latitude the geodetic latitude in radians.
+        @param longitude the longitude in radians.
+        @param altitude the altitude above sea level in feet.
+        @param time the time in seconds. */
+    void Sample(double latitude, double longitude, double altitude,
+                double time);
+
+    /// Returns the interpolated wind in the local NED frame (ft/sec).
+    const FGColumnVector3& GetWindNED(void) const { return vWindNED; }
+    /** Returns the interpolated temperature in degrees Rankine, or 0 if the
+        field does not give the temperature. */
+    double GetTemperature(void) const { return Temperature; }
+    /// Returns the number of times that the nodes of a cell were loaded.
+    unsigned int GetCellLoads(void) const { return CellLoads; }
+
+  private:
+    std::shared_ptr<const FGWindField> Field;
+    unsigned int Cell[4];
+    double Nodes[16][4];
+    unsigned int CellLoads;
+    FGColumnVector3 vWindNED;
+    double Temperature;
+
+    void LoadCell(const unsigned int cell[4]);
+  };
+
+private:
+  struct Axis {
+    unsigned int Count;
+    double Origin;
+    double Step;
+    bool Periodic;
+
+    void Locate(double x, unsigned int& index, double& fraction) const;
+    unsigned int Next(unsigned int index) const;
+  };
+
+  std::string FileName;
+  unsigned int NumVariables;
+  Axis Axes[4];
+  const float* Values;
+
+  void* Address;
+  size_t Length;
+#ifdef _WIN32
+  void* File;
+  void* Mapping;
+#endif
+
+  FGWindField(const std::string& filename);
+  const float* GetNode(unsigned int ilat, unsigned int ilon, unsigned int ialt,
+                       unsigned int itime) const;
+
+  FGWindField(const FGWindField&);
+  FGWindField& operator=(const FGWindField&);
+
+  void Debug(int from);
+};
+
+} // namespace JSBSim
+
+#endif
@@ -46,6 +46,8 @@ INCLUDES
 #include <cstdlib>
 #include "FGWinds.h"
 #include "FGFDMExec.h"
+#include "math/FGRandom.h"
+#include "input_output/FGSnapshot.h"
 
 using namespace std;
 
@@ -84,15 +86,24 @@ FGWinds::FGWinds(FGFDMExec* fdmex) : FGModel(fdmex)
   TurbRate = 10.0;
   Rhythmicity = 0.1;
   spike = target_time = strength = 0.0;
+  Random = fdmex->GetRandom("atmosphere/turbulence");
   wind_from_clockwise = 0.0;
   psiw = 0.0;
 
   vGustNED.InitMatrix();
   vTurbulenceNED.InitMatrix();
   vCosineGust.InitMatrix();
+  vFieldWindNED.InitMatrix();
+  FieldTemperature = 0.0;
+  FieldTimeOffset = 0.0;
 
   // Milspec turbulence model
   windspeed_at_20ft = 0.;
+  xi_u_km1 = nu_u_km1 = 0.0;
+  xi_v_km1 = xi_v_km2 = nu_v_km1 = nu_v_km2 = 0.0;
+  xi_w_km1 = xi_w_km2 = nu_w_km1 = nu_w_km2 = 0.0;
+  xi_p_km1 = nu_p_km1 = 0.0;
+  xi_q_km1 = xi_r_km1 = 0.0;
   probability_of_exceedence_index = 0;
   POE_Table = new FGTable(7,12);
   // this is Figure 7 from p. 49 of MIL-F-8785C
@@ -147,7 +158,15 @@ bool FGWinds::Run(bool Holding)
   if (turbType != ttNone) Turbulence(in.AltitudeASL);
   if (oneMinusCosineGust.gustProfile.Running) CosineGust();
 
-  vTotalWindNED = vWindNED + vGustNED + vCosineGust + vTurbulenceNED;
+  if (FieldSampler.GetField()) {
+    FieldSampler.Sample(in.latitude, in.longitude, in.AltitudeASL,
+                        FDMExec->GetSimTime() + FieldTimeOffset);
+    vFieldWindNED = FieldSampler.GetWindNED();
+    FieldTemperature = FieldSampler.GetTemperature();
+  }
+
+  vTotalWindNED = vWindNED + vGustNED + vCosineGust + vTurbulenceNED
+                + vFieldWindNED;
 
    // psiw (Wind heading) is the direction the wind is blowing towards
   if (vWindNED(eX) != 0.0) psiw = atan2( vWindNED(eY), vWindNED(eX) );
@@ -157,6 +176,22 @@ bool FGWinds::Run(bool Holding)
   return false;
 }
 
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+void FGWinds::LoadWindField(const string& filename)
+{
+  FieldSampler.SetField(FGWindField::Open(filename));
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+void FGWinds::ClearWindField(void)
+{
+  FieldSampler.SetField(shared_ptr<const FGWindField>());
+  vFieldWindNED.InitMatrix();
+  FieldTemperature = 0.0;
+}
+
 //%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
 //
 // psi is the angle that the wind is blowing *towards*
@@ -216,7 +251,7 @@ void FGWinds::Turbulence(double h)
 
     double random = 0.0;
     if (target_time == 0.0) {
-      strength = random = 1 - 2.0*(double(rand())/double(RAND_MAX));
+      strength = random = 1 - 2.0*Random->GetUniform();
       target_time = time + 0.71 + (random * 0.5);
     }
     if (time > target_time) {
@@ -281,16 +316,6 @@ void FGWinds::Turbulence(double h)
       sig_u = sig_w = POE_Table->GetValue(probability_of_exceedence_index, h);
     }
 
-    // keep values from last timesteps
-    // TODO maybe use deque?
-    static double
-      xi_u_km1 = 0, nu_u_km1 = 0,
-      xi_v_km1 = 0, xi_v_km2 = 0, nu_v_km1 = 0, nu_v_km2 = 0,
-      xi_w_km1 = 0, xi_w_km2 = 0, nu_w_km1 = 0, nu_w_km2 = 0,
-      xi_p_km1 = 0, nu_p_km1 = 0,
-      xi_q_km1 = 0, xi_r_km1 = 0;
-
-
     double
       T_V = in.totalDeltaT, // for compatibility of nomenclature
       sig_p = 1.9/sqrt(L_w*b_w)*sig_w, // Yeager1998, eq. (8)
@@ -302,10 +327,10 @@ void FGWinds::Turbulence(double h)
       tau_p = L_p/in.V, // eq. (9)
       tau_q = 4*b_w/M_PI/in.V, // eq. (13)
       tau_r =3*b_w/M_PI/in.V, // eq. (17)
-      nu_u = GaussianRandomNumber(),
-      nu_v = GaussianRandomNumber(),
-      nu_w = GaussianRandomNumber(),
-      nu_p = GaussianRandomNumber(),
+      nu_u = Random->GetNormal(),
+      nu_v = Random->GetNormal(),
+      nu_w = Random->GetNormal(),
+      nu_p = Random->GetNormal(),
       xi_u=0, xi_v=0, xi_w=0, xi_p=0, xi_q=0, xi_r=0;
 
     // values of turbulence NED velocities
@@ -565,9 +590,71 @@ void FGWinds::bind(void)
   PropertyManager->Tie("atmosphere/total-wind-north-fps", this, eNorth, (PMF)&FGWinds::GetTotalWindNED);
   PropertyManager->Tie("atmosphere/total-wind-east-fps",  this, eEast,  (PMF)&FGWinds::GetTotalWindNED);
   PropertyManager->Tie("atmosphere/total-wind-down-fps",  this, eDown,  (PMF)&FGWinds::GetTotalWindNED);
+  // Gridded wind field (local navigational/geographic frame: N-E-D). Read only, except the time offset.
+  PropertyManager->Tie("atmosphere/wind-field/wind-north-fps", this, eNorth, (PMF)&FGWinds::GetFieldWindNED);
+  PropertyManager->Tie("atmosphere/wind-field/wind-east-fps",  this, eEast,  (PMF)&FGWinds::GetFieldWindNED);
+  PropertyManager->Tie("atmosphere/wind-field/wind-down-fps",  this, eDown,  (PMF)&FGWinds::GetFieldWindNED);
+  PropertyManager->Tie("atmosphere/wind-field/temperature-R", this, &FGWinds::GetFieldTemperature);
+  PropertyManager->Tie("atmosphere/wind-field/time-offset-sec", this, &FGWinds::GetFieldTimeOffset,
+                                                                      &FGWinds::SetFieldTimeOffset);
 
 }
 
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+void FGWinds::ArchiveState(FGSnapshot& snapshot)
+{
+  FGModel::ArchiveState(snapshot);
+  snapshot.Archive(in);
+  snapshot.Archive(turbType);
+  snapshot.Archive(MagnitudedAccelDt);
+  snapshot.Archive(MagnitudeAccel);
+  snapshot.Archive(Magnitude);
+  snapshot.Archive(TurbDirection);
+  snapshot.Archive(TurbGain);
+  snapshot.Archive(TurbRate);
+  snapshot.Archive(Rhythmicity);
+  snapshot.Archive(wind_from_clockwise);
+  snapshot.Archive(spike);
+  snapshot.Archive(target_time);
+  snapshot.Archive(strength);
+  snapshot.Archive(vTurbulenceGrad);
+  snapshot.Archive(vBodyTurbGrad);
+  snapshot.Archive(vTurbPQR);
+  snapshot.Archive(oneMinusCosineGust);
+  snapshot.Archive(windspeed_at_20ft);
+  snapshot.Archive(probability_of_exceedence_index);
+  snapshot.Archive(xi_u_km1);
+  snapshot.Archive(nu_u_km1);
+  snapshot.Archive(xi_v_km1);
+  snapshot.Archive(xi_v_km2);
+  snapshot.Archive(nu_v_km1);
+  snapshot.Archive(nu_v_km2);
+  snapshot.Archive(xi_w_km1);
+  snapshot.Archive(xi_w_km2);
+  snapshot.Archive(nu_w_km1);
+  snapshot.Archive(nu_w_km2);
+  snapshot.Archive(xi_p_km1);
+  snapshot.Archive(nu_p_km1);
+  snapshot.Archive(xi_q_km1);
+  snapshot.Archive(xi_r_km1);
+  snapshot.Archive(psiw);
+  snapshot.Archive(vTotalWindNED);
+  snapshot.Archive(vWindNED);
+  snapshot.Archive(vGustNED);
+  snapshot.Archive(vCosineGust);
+  snapshot.Archive(vBurstGust);
+  snapshot.Archive(vTurbulenceNED);
+  snapshot.Archive(vFieldWindNED);
+  snapshot.Archive(FieldTemperature);
+  snapshot.Archive(FieldTimeOffset);
+
+  unsigned int cells = UpDownBurstCells.size();
+  snapshot.Archive(cells);
+  if (cells != UpDownBurstCells.size()) NumberOfUpDownburstCells(cells);
+  for (unsigned int i=0; i<cells; i++) snapshot.Archive(*UpDownBurstCells[i]);
+}
+
 //%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
 //    The bitmasked value choices are as follows:
 //    unset: In this case (the default) JSBSim would only print
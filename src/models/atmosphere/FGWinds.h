@@ -42,6 +42,7 @@ INCLUDES
 #include "math/FGColumnVector3.h"
 #include "math/FGMatrix33.h"
 #include "math/FGTable.h"
+#include "FGWindField.h"
 
 /*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
 DEFINITIONS
@@ -55,6 +56,9 @@ FORWARD DECLARATIONS
 
 namespace JSBSim {
 
+class FGRandom;
+class FGSnapshot;
+
 /*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
 CLASS DOCUMENTATION
 %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
@@ -103,6 +107,17 @@ CLASS DOCUMENTATION
           <td>6</td></tr>
     </table>
 
+    A wind field gridded in latitude, longitude, altitude and time can be
+    loaded from a file with LoadWindField() (see FGWindField for the format of
+    the file). The wind interpolated at the location of the vehicle is added
+    to the total wind and, if the field gives the temperature, it replaces the
+    temperature of the atmosphere model. Since the atmosphere is run before
+    the winds, the temperature is the one sampled at the previous frame. The
+    simulation time is offset by <tt>atmosphere/wind-field/time-offset-sec</tt>
+    to give the time of the field, and the interpolated values are published
+    under <tt>atmosphere/wind-field/</tt>. The simulations that load the same
+    file share a single read only mapping of it.
+
     @see Yeager, Jessie C.: "Implementation and Testing of Turbulence Models for
          the F18-HARV" (<a
          href="http://ntrs.nasa.gov/archive/nasa/casi.ntrs.nasa.gov/19980028448_1998081596.pdf">
@@ -131,6 +146,7 @@ public:
                      "Resume" command to be given.
       @return false if no error */
   bool Run(bool Holding);
+  void ArchiveState(FGSnapshot& snapshot);
   bool InitModel(void);
   enum tType {ttNone, ttStandard, ttCulp, ttMilspec, ttTustin} turbType;
 
@@ -196,6 +212,33 @@ public:
   /// Retrieves the gust components in NED frame.
   virtual const FGColumnVector3& GetGustNED(void) const {return vGustNED;}
 
+  // WIND FIELD access functions
+
+  /** Loads a gridded wind field. The file is only mapped once for all the
+      simulations that load it.
+      @param filename the name of the file, see FGWindField for its format.
+      @throw string if the file is not a valid wind field. */
+  void LoadWindField(const std::string& filename);
+
+  /// Removes the wind field.
+  void ClearWindField(void);
+
+  /// Returns the wind field or 0 if none has been loaded.
+  const FGWindField* GetWindField(void) const { return FieldSampler.GetField(); }
+
+  /// Retrieves the components of the wind field in NED frame.
+  const FGColumnVector3& GetFieldWindNED(void) const { return vFieldWindNED; }
+
+  /// Retrieves a component of the wind field in NED frame.
+  double GetFieldWindNED(int idx) const { return vFieldWindNED(idx); }
+
+  /** Retrieves the temperature of the wind field in degrees Rankine.
+      @return 0 if the wind field does not give the temperature. */
+  double GetFieldTemperature(void) const { return FieldTemperature; }
+
+  void   SetFieldTimeOffset(double offset) { FieldTimeOffset = offset; }
+  double GetFieldTimeOffset(void) const { return FieldTimeOffset; }
+
   /** Turbulence models available: ttNone, ttStandard, ttBerndt, ttCulp, ttMilspec, ttTustin */
   virtual void   SetTurbType(tType tt) {turbType = tt;}
   virtual tType  GetTurbType() const {return turbType;}
@@ -325,6 +368,7 @@ private:
   double Rhythmicity;
   double wind_from_clockwise;
   double spike, target_time, strength;
+  FGRandom* Random; ///< random numbers of the turbulence models
   FGColumnVector3 vTurbulenceGrad;
   FGColumnVector3 vBodyTurbGrad;
   FGColumnVector3 vTurbPQR;
@@ -336,6 +380,12 @@ private:
   double windspeed_at_20ft; ///< in ft/s
   int probability_of_exceedence_index; ///< this is bound as the severity property
   FGTable *POE_Table; ///< probability of exceedence table
+  // values from the last timesteps
+  double xi_u_km1, nu_u_km1;
+  double xi_v_km1, xi_v_km2, nu_v_km1, nu_v_km2;
+  double xi_w_km1, xi_w_km2, nu_w_km1, nu_w_km2;
+  double xi_p_km1, nu_p_km1;
+  double xi_q_km1, xi_r_km1;
 
   double psiw;
   FGColumnVector3 vTotalWindNED;
@@ -345,6 +395,11 @@ private:
   FGColumnVector3 vBurstGust;
   FGColumnVector3 vTurbulenceNED;
 
+  FGWindField::Sampler FieldSampler;
+  FGColumnVector3 vFieldWindNED;
+  double FieldTemperature;
+  double FieldTimeOffset;
+
   void Turbulence(double h);
   void UpDownBurst();
 
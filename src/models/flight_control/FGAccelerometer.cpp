@@ -46,6 +46,7 @@ INCLUDES
 #include "models/FGMassBalance.h"
 #include "input_output/FGXMLElement.h"
 #include "models/FGFCS.h"
+#include "input_output/FGSnapshot.h"
 
 using namespace std;
 
@@ -107,6 +108,14 @@ bool FGAccelerometer::Run(void )
   return true;
 }
 
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+void FGAccelerometer::ArchiveState(FGSnapshot& snapshot)
+{
+  FGSensor::ArchiveState(snapshot);
+  snapshot.Archive(vAccel);
+}
+
 //%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
 //    The bitmasked value choices are as follows:
 //    unset: In this case (the default) JSBSim would only print
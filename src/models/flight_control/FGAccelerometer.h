@@ -57,6 +57,7 @@ class FGFCS;
 class FGPropagate;
 class FGAccelerations;
 class FGMassBalance;
+class FGSnapshot;
 
 /*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
 CLASS DOCUMENTATION
@@ -140,6 +141,7 @@ public:
   ~FGAccelerometer();
 
   bool Run (void);
+  void ArchiveState(FGSnapshot& snapshot);
 
 private:
   FGPropagate* Propagate;
@@ -43,6 +43,7 @@ INCLUDES
 #include "input_output/FGXMLElement.h"
 #include "math/FGRealValue.h"
 #include "models/FGFCS.h"
+#include "input_output/FGSnapshot.h"
 
 using namespace std;
 
@@ -298,6 +299,29 @@ void FGActuator::bind(void)
   PropertyManager->Tie( tmp_sat, this, &FGActuator::IsSaturated);
 }
 
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+void FGActuator::ArchiveState(FGSnapshot& snapshot)
+{
+  FGFCSComponent::ArchiveState(snapshot);
+  snapshot.Archive(bias);
+  snapshot.Archive(hysteresis_width);
+  snapshot.Archive(deadband_width);
+  snapshot.Archive(lag);
+  snapshot.Archive(ca);
+  snapshot.Archive(cb);
+  snapshot.Archive(PreviousOutput);
+  snapshot.Archive(PreviousHystOutput);
+  snapshot.Archive(PreviousRateLimOutput);
+  snapshot.Archive(PreviousLagInput);
+  snapshot.Archive(PreviousLagOutput);
+  snapshot.Archive(fail_zero);
+  snapshot.Archive(fail_hardover);
+  snapshot.Archive(fail_stuck);
+  snapshot.Archive(initialized);
+  snapshot.Archive(saturated);
+}
+
 //%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
 //    The bitmasked value choices are as follows:
 //    unset: In this case (the default) JSBSim would only print
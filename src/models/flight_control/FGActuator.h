@@ -52,6 +52,7 @@ FORWARD DECLARATIONS
 namespace JSBSim {
 
 class FGFCS;
+class FGSnapshot;
 
 /*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
 CLASS DOCUMENTATION
@@ -139,6 +140,7 @@ public:
       limiting, etc. functions. */
   bool Run (void);
   void ResetPastStates(void);
+  void ArchiveState(FGSnapshot& snapshot);
 
   // these may need to have the bool argument replaced with a double
   /** This function fails the actuator to zero. The motion to zero
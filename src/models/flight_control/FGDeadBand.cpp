@@ -82,6 +82,9 @@ FGDeadBand::FGDeadBand(FGFCS* fcs, Element* element) : FGFCSComponent(fcs, eleme
   }
 
   FGFCSComponent::bind();
+  if (TrackDependencies() && WidthPropertyNode != 0)
+    Dependencies->Add(WidthPropertyNode);
+
   Debug(0);
 }
 
@@ -96,6 +99,8 @@ FGDeadBand::~FGDeadBand()
 
 bool FGDeadBand::Run(void )
 {
+  if (IsUpToDate()) return true;
+
   Input = InputNodes[0]->getDoubleValue() * InputSigns[0];
 
   if (WidthPropertyNode != 0) {
@@ -112,6 +117,7 @@ bool FGDeadBand::Run(void )
 
   Clip();
   if (IsOutput) SetOutput();
+  UpdateDependencies();
 
   return true;
 }
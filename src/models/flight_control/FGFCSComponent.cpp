@@ -44,6 +44,7 @@ INCLUDES
 #include "input_output/FGXMLElement.h"
 #include "math/FGPropertyValue.h"
 #include "models/FGFCS.h"
+#include "input_output/FGSnapshot.h"
 
 using namespace std;
 
@@ -63,6 +64,7 @@ FGFCSComponent::FGFCSComponent(FGFCS* _fcs, Element* element) : fcs(_fcs)
   treenode = 0;
   delay = index = 0;
   ClipMinPropertyNode = ClipMaxPropertyNode = 0;
+  Dependencies = 0;
   clipMinSign = clipMaxSign = 1.0;
   IsOutput   = clip = false;
   string input,init, clip_string;
@@ -233,6 +235,7 @@ FGFCSComponent::~FGFCSComponent()
   for (unsigned int i=0; i<InputNodes.size(); i++) {
     delete InputNodes[i];
   }
+  delete Dependencies;
 }
 
 //%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
@@ -242,6 +245,49 @@ void FGFCSComponent::ResetPastStates(void)
   index = 0;
   for (unsigned int i = 0; i < output_array.size(); ++i)
     output_array[i] = 0.0;
+  if (Dependencies) Dependencies->Invalidate();
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+bool FGFCSComponent::TrackDependencies(void)
+{
+  if (!FGPropertyDependencies::IsEnabled() || delay > 0) return false;
+
+  for (unsigned int i=0; i<InputNodes.size(); i++) {
+    if (InputNodes[i]->IsLateBound()) return false;
+
+    // A component that reads its own output is not stateless.
+    FGPropertyNode* node = InputNodes[i]->GetNode();
+    if (node == treenode) return false;
+    for (unsigned int j=0; j<OutputNodes.size(); j++)
+      if (node == OutputNodes[j]) return false;
+  }
+
+  Dependencies = new FGPropertyDependencies;
+
+  for (unsigned int i=0; i<InputNodes.size(); i++)
+    Dependencies->Add(InputNodes[i]->GetNode());
+
+  if (ClipMinPropertyNode) Dependencies->Add(ClipMinPropertyNode);
+  if (ClipMaxPropertyNode) Dependencies->Add(ClipMaxPropertyNode);
+
+  // The outputs must be written again if another component modified them.
+  for (unsigned int i=0; i<OutputNodes.size(); i++)
+    Dependencies->Add(OutputNodes[i]);
+
+  return true;
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+void FGFCSComponent::UpdateDependencies(void)
+{
+  if (!Dependencies) return;
+
+  // Acknowledge the changes of the outputs made by the component itself.
+  Dependencies->Changed();
+  Dependencies->Validate();
 }
 
 //%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
@@ -297,6 +343,21 @@ void FGFCSComponent::bind(void)
     tmp = Name;
   }
   PropertyManager->Tie( tmp, this, &FGFCSComponent::GetOutput);
+  treenode = PropertyManager->GetNode(tmp);
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+void FGFCSComponent::ArchiveState(FGSnapshot& snapshot)
+{
+  snapshot.Archive(Input);
+  snapshot.Archive(Output);
+  snapshot.Archive(output_array);
+  snapshot.Archive(index);
+
+  // The output that is restored does not match the properties that the
+  // component has read last.
+  if (!snapshot.IsSaving() && Dependencies) Dependencies->Invalidate();
 }
 
 //%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
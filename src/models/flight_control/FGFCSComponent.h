@@ -57,6 +57,7 @@ namespace JSBSim {
 
 class FGFCS;
 class Element;
+class FGSnapshot;
 
 /*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
 CLASS DOCUMENTATION
@@ -82,6 +83,11 @@ CLASS DOCUMENTATION
     - FGWwaypoint
     - FGAngle
 
+    The stateless components (FGSummer, FGGain, FGDeadBand and FGFCSFunction)
+    skip their computation when the tracking of dependencies is enabled (see
+    FGPropertyDependencies) and none of the properties they read or write has
+    changed since their last execution.
+
     @author Jon S. Berndt
     @version $Id: FGFCSComponent.h,v 1.27 2015/07/12 19:34:08 bcoconni Exp $
     @see Documentation for the FGFCS class, and for the configuration file class
@@ -106,6 +112,10 @@ public:
   std::string GetType(void) const { return Type; }
   virtual double GetOutputPct(void) const { return 0; }
   virtual void ResetPastStates(void);
+  /** Saves the state of the component to a snapshot or restores it from a
+      snapshot.
+      @param snapshot the snapshot. */
+  virtual void ArchiveState(FGSnapshot& snapshot);
 
 protected:
   FGFCS* fcs;
@@ -133,9 +143,21 @@ protected:
   double dt;
   bool IsOutput;
   bool clip;
+  FGPropertyDependencies* Dependencies;
 
   void Delay(void);
   void Clip(void);
+  /** Starts the tracking of the properties read and written by the component.
+      The tracking is not started if it is disabled, if the output is delayed,
+      if an input is not bound yet or if the component reads its own output.
+      It must be called after bind().
+      @return true if the dependencies are tracked. The derived classes can
+              then add the properties which their output depends on. */
+  bool TrackDependencies(void);
+  /// Returns true if the output of the component is up to date.
+  bool IsUpToDate(void) { return Dependencies && !Dependencies->Changed(); }
+  /// Flags the output as up to date once it has been computed.
+  void UpdateDependencies(void);
   virtual void bind();
   virtual void Debug(int from);
 };
@@ -41,6 +41,7 @@ INCLUDES
 #include <iostream>
 
 #include "FGFCSFunction.h"
+#include "models/FGFCS.h"
 #include "input_output/FGXMLElement.h"
 
 using namespace std;
@@ -61,13 +62,20 @@ FGFCSFunction::FGFCSFunction(FGFCS* fcs, Element* element) : FGFCSComponent(fcs,
   Element *function_element = element->FindElement("function");
 
   if (function_element)
-    function = new FGFunction(PropertyManager, function_element);
+    function = new FGFunction(fcs->GetExec(), function_element);
   else {
     cerr << "FCS Function should contain a \"function\" element" << endl;
     exit(-1);
   }
 
   FGFCSComponent::bind();
+
+  if (TrackDependencies()
+      && !FGFunction::GetDependencies(function, *Dependencies)) {
+    delete Dependencies;
+    Dependencies = 0;
+  }
+
   Debug(0);
 }
 
@@ -83,6 +91,8 @@ FGFCSFunction::~FGFCSFunction()
 
 bool FGFCSFunction::Run(void )
 {
+  if (IsUpToDate()) return true;
+
   Output = function->GetValue();
 
   if (InputNodes.size() > 0) {
@@ -92,6 +102,7 @@ bool FGFCSFunction::Run(void )
 
   Clip();
   if (IsOutput) SetOutput();
+  UpdateDependencies();
 
   return true;
 }
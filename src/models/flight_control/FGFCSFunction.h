@@ -119,6 +119,9 @@ public:
 
   bool Run(void);
 
+  /// Returns the function computed by the component.
+  FGFunction* GetFunction(void) const { return function; }
+
 private:
   FGFunction* function;
 
@@ -40,6 +40,7 @@ INCLUDES
 #include "FGFilter.h"
 #include "input_output/FGXMLElement.h"
 #include "input_output/FGPropertyManager.h"
+#include "input_output/FGSnapshot.h"
 
 #include <iostream>
 #include <string>
@@ -239,6 +240,24 @@ bool FGFilter::Run(void)
   return true;
 }
 
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+void FGFilter::ArchiveState(FGSnapshot& snapshot)
+{
+  FGFCSComponent::ArchiveState(snapshot);
+  snapshot.Archive(ca);
+  snapshot.Archive(cb);
+  snapshot.Archive(cc);
+  snapshot.Archive(cd);
+  snapshot.Archive(ce);
+  snapshot.Archive(C, 7);
+  snapshot.Archive(PreviousInput1);
+  snapshot.Archive(PreviousInput2);
+  snapshot.Archive(PreviousOutput1);
+  snapshot.Archive(PreviousOutput2);
+  snapshot.Archive(Initialize);
+}
+
 //%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
 //    The bitmasked value choices are as follows:
 //    unset: In this case (the default) JSBSim would only print
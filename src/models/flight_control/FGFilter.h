@@ -54,6 +54,7 @@ namespace JSBSim {
 class Element;
 class FGPropertyManager;
 class FGFCS;
+class FGSnapshot;
 
 /*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
 CLASS DOCUMENTATION
@@ -248,6 +249,8 @@ public:
       is particularly useful for first pass. */
   bool Initialize;
   void ResetPastStates(void);
+  void ArchiveState(FGSnapshot& snapshot);
+
   
   enum {eLag, eLeadLag, eOrder2, eWashout, eIntegrator, eUnknown} FilterType;
 
@@ -39,6 +39,7 @@ INCLUDES
 
 #include "FGGain.h"
 #include "input_output/FGXMLElement.h"
+#include "input_output/FGSnapshot.h"
 #include <iostream>
 #include <string>
 #include <cstdlib>
@@ -129,6 +130,16 @@ FGGain::FGGain(FGFCS* fcs, Element* element) : FGFCSComponent(fcs, element)
 
   FGFCSComponent::bind();
 
+  if (TrackDependencies()) {
+    if (GainPropertyNode != 0) Dependencies->Add(GainPropertyNode);
+    if (Table) {
+      for (int i=0; i<3; i++) {
+        FGPropertyNode* lookup = Table->GetLookupProperty(i);
+        if (lookup) Dependencies->Add(lookup);
+      }
+    }
+  }
+
   Debug(0);
 }
 
@@ -147,6 +158,8 @@ bool FGGain::Run(void )
 {
   double SchedGain = 1.0;
 
+  if (IsUpToDate()) return true;
+
   Input = InputNodes[0]->getDoubleValue() * InputSigns[0];
 
   if (GainPropertyNode != 0) Gain = GainPropertyNode->getDoubleValue() * GainPropertySign;
@@ -179,10 +192,19 @@ bool FGGain::Run(void )
 
   Clip();
   if (IsOutput) SetOutput();
+  UpdateDependencies();
 
   return true;
 }
 
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+void FGGain::ArchiveState(FGSnapshot& snapshot)
+{
+  FGFCSComponent::ArchiveState(snapshot);
+  snapshot.Archive(Gain);
+}
+
 //%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
 //    The bitmasked value choices are as follows:
 //    unset: In this case (the default) JSBSim would only print
@@ -54,6 +54,7 @@ namespace JSBSim {
 
 class FGFCS;
 class Element;
+class FGSnapshot;
 
 /*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
 CLASS DOCUMENTATION
@@ -222,6 +223,7 @@ public:
   ~FGGain();
 
   bool Run (void);
+  void ArchiveState(FGSnapshot& snapshot);
 
 private:
   FGTable* Table;
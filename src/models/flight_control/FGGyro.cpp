@@ -43,6 +43,7 @@ INCLUDES
 #include "models/FGAccelerations.h"
 #include "input_output/FGXMLElement.h"
 #include "models/FGFCS.h"
+#include "input_output/FGSnapshot.h"
 
 using namespace std;
 
@@ -88,6 +89,14 @@ bool FGGyro::Run(void )
   return true;
 }
 
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+void FGGyro::ArchiveState(FGSnapshot& snapshot)
+{
+  FGSensor::ArchiveState(snapshot);
+  snapshot.Archive(vAccel);
+}
+
 //%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
 //    The bitmasked value choices are as follows:
 //    unset: In this case (the default) JSBSim would only print
@@ -56,6 +56,7 @@ namespace JSBSim {
 
 class FGFCS;
 class FGAccelerations;
+class FGSnapshot;
 
 /*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
 CLASS DOCUMENTATION
@@ -117,6 +118,7 @@ public:
   ~FGGyro();
 
   bool Run (void);
+  void ArchiveState(FGSnapshot& snapshot);
 
 private:
   FGAccelerations* Accelerations;
@@ -39,6 +39,7 @@ INCLUDES
 
 #include "FGKinemat.h"
 #include "input_output/FGXMLElement.h"
+#include "input_output/FGSnapshot.h"
 #include <iostream>
 #include <cstdlib>
 
@@ -163,6 +164,14 @@ bool FGKinemat::Run(void )
   return true;
 }
 
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+void FGKinemat::ArchiveState(FGSnapshot& snapshot)
+{
+  FGFCSComponent::ArchiveState(snapshot);
+  snapshot.Archive(OutputPct);
+}
+
 //%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
 //    The bitmasked value choices are as follows:
 //    unset: In this case (the default) JSBSim would only print
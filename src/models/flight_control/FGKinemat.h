@@ -52,6 +52,8 @@ FORWARD DECLARATIONS
 
 namespace JSBSim {
 
+class FGSnapshot;
+
 /*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
 CLASS DOCUMENTATION
 %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
@@ -127,6 +129,7 @@ public:
       @return false on success, true on failure.
       The routine doing the work.  */
   bool Run (void);
+  void ArchiveState(FGSnapshot& snapshot);
 
 private:
   std::vector<double> Detents;
@@ -45,6 +45,7 @@ INCLUDES
 #include "simgear/magvar/coremag.hxx"
 #include "input_output/FGXMLElement.h"
 #include "models/FGFCS.h"
+#include "input_output/FGSnapshot.h"
 
 using namespace std;
 
@@ -143,6 +144,19 @@ bool FGMagnetometer::Run(void )
   return true;
 }
 
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+void FGMagnetometer::ArchiveState(FGSnapshot& snapshot)
+{
+  FGSensor::ArchiveState(snapshot);
+  snapshot.Archive(vMag);
+  snapshot.Archive(field, 6);
+  snapshot.Archive(usedLat);
+  snapshot.Archive(usedLon);
+  snapshot.Archive(usedAlt);
+  snapshot.Archive(counter);
+}
+
 //%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
 //    The bitmasked value choices are as follows:
 //    unset: In this case (the default) JSBSim would only print
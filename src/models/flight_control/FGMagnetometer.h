@@ -58,6 +58,7 @@ FORWARD DECLARATIONS
 namespace JSBSim {
 
 class FGFCS;
+class FGSnapshot;
 
 /*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
 CLASS DOCUMENTATION
@@ -131,6 +132,7 @@ public:
   ~FGMagnetometer();
 
   bool Run (void);
+  void ArchiveState(FGSnapshot& snapshot);
 
 private:
   FGPropagate* Propagate;
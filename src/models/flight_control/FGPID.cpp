@@ -37,6 +37,7 @@ INCLUDES
 
 #include "FGPID.h"
 #include "input_output/FGXMLElement.h"
+#include "input_output/FGSnapshot.h"
 #include <string>
 #include <iostream>
 
@@ -230,6 +231,19 @@ bool FGPID::Run(void )
   return true;
 }
 
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+void FGPID::ArchiveState(FGSnapshot& snapshot)
+{
+  FGFCSComponent::ArchiveState(snapshot);
+  snapshot.Archive(Kp);
+  snapshot.Archive(Ki);
+  snapshot.Archive(Kd);
+  snapshot.Archive(I_out_total);
+  snapshot.Archive(Input_prev);
+  snapshot.Archive(Input_prev2);
+}
+
 //%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
 //    The bitmasked value choices are as follows:
 //    unset: In this case (the default) JSBSim would only print
@@ -54,6 +54,7 @@ namespace JSBSim {
 
 class FGFCS;
 class Element;
+class FGSnapshot;
 
 /*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
 CLASS DOCUMENTATION
@@ -131,6 +132,7 @@ public:
 
   bool Run (void);
   void ResetPastStates(void);
+  void ArchiveState(FGSnapshot& snapshot);
 
     /// These define the indices use to select the various integrators.
   enum eIntegrateType {eNone = 0, eRectEuler, eTrapezoidal, eAdamsBashforth2, eAdamsBashforth3};
@@ -41,7 +41,11 @@ INCLUDES
 #include <cstdlib>
 
 #include "FGSensor.h"
+#include "FGFDMExec.h"
+#include "models/FGFCS.h"
+#include "math/FGRandom.h"
 #include "input_output/FGXMLElement.h"
+#include "input_output/FGSnapshot.h"
 
 using namespace std;
 
@@ -65,6 +69,7 @@ FGSensor::FGSensor(FGFCS* fcs, Element* element) : FGFCSComponent(fcs, element)
   granularity = 0.0;
   noise_type = 0;
   fail_low = fail_high = fail_stuck = false;
+  Random = fcs->GetExec()->GetRandom("fcs/sensor/" + Name);
 
   Element* quantization_element = element->FindElement("quantization");
   if ( quantization_element) {
@@ -191,9 +196,9 @@ void FGSensor::Noise(void)
   double random_value=0.0;
 
   if (DistributionType == eUniform) {
-    random_value = 2.0*(((double)rand()/(double)RAND_MAX) - 0.5);
+    random_value = Random->GetUniformSigned();
   } else {
-    random_value = GaussianRandomNumber();
+    random_value = Random->GetNormal();
   }
 
   switch( NoiseType ) {
@@ -276,6 +281,26 @@ void FGSensor::bind(void)
 
 }
 
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+void FGSensor::ArchiveState(FGSnapshot& snapshot)
+{
+  FGFCSComponent::ArchiveState(snapshot);
+  snapshot.Archive(bias);
+  snapshot.Archive(gain);
+  snapshot.Archive(drift_rate);
+  snapshot.Archive(drift);
+  snapshot.Archive(noise_variance);
+  snapshot.Archive(lag);
+  snapshot.Archive(ca);
+  snapshot.Archive(cb);
+  snapshot.Archive(PreviousOutput);
+  snapshot.Archive(PreviousInput);
+  snapshot.Archive(fail_low);
+  snapshot.Archive(fail_high);
+  snapshot.Archive(fail_stuck);
+}
+
 //%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
 //    The bitmasked value choices are as follows:
 //    unset: In this case (the default) JSBSim would only print
@@ -54,6 +54,8 @@ namespace JSBSim {
 
 class FGFCS;
 class Element;
+class FGRandom;
+class FGSnapshot;
 
 /*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
 CLASS DOCUMENTATION
@@ -120,6 +122,10 @@ If the type is ABSOLUTE, then the noise number times the random number is
 added to the input signal instead of being multiplied against it as with the
 PERCENT type of noise.
 
+Each sensor draws its random numbers from its own stream "fcs/sensor/<name>"
+of the FDM executive (see FGFDMExec::GetRandom()): the noise of a sensor is
+reproduced when the simulation is run again with the same seed.
+
 The delay element can specify a frame delay. The integer number provided is
 the number of frames to delay the output signal.
 
@@ -148,6 +154,7 @@ public:
 
   virtual bool Run (void);
   void ResetPastStates(void);
+  void ArchiveState(FGSnapshot& snapshot);
 
 protected:
   enum eNoiseType {ePercent=0, eAbsolute} NoiseType;
@@ -173,6 +180,7 @@ protected:
   bool fail_high;
   bool fail_stuck;
   std::string quant_property;
+  FGRandom* Random;
 
   void ProcessSensorSignal(void);
   void Noise(void);
@@ -59,6 +59,7 @@ FGSummer::FGSummer(FGFCS* fcs, Element* element) : FGFCSComponent(fcs, element)
   if (element->FindElement("bias")) Bias = element->FindElementValueAsNumber("bias");
 
   FGFCSComponent::bind();
+  TrackDependencies();
 
   Debug(0);
 }
@@ -76,6 +77,8 @@ bool FGSummer::Run(void )
 {
   unsigned int idx;
 
+  if (IsUpToDate()) return true;
+
   Output = 0.0;
 
   for (idx=0; idx<InputNodes.size(); idx++) {
@@ -86,6 +89,7 @@ bool FGSummer::Run(void )
 
   Clip();
   if (IsOutput) SetOutput();
+  UpdateDependencies();
 
   return true;
 }
@@ -45,6 +45,7 @@ INCLUDES
 #include "FGElectric.h"
 #include "FGPropeller.h"
 #include "input_output/FGXMLElement.h"
+#include "input_output/FGSnapshot.h"
 
 using namespace std;
 
@@ -135,6 +136,15 @@ string FGElectric::GetEngineValues(const string& delimiter)
   return buf.str();
 }
 
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+void FGElectric::ArchiveState(FGSnapshot& snapshot)
+{
+  FGEngine::ArchiveState(snapshot);
+  snapshot.Archive(RPM);
+  snapshot.Archive(HP);
+}
+
 //%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
 //
 //    The bitmasked value choices are as follows:
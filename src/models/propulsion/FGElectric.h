@@ -52,6 +52,8 @@ FORWARD DECLARATIONS
 
 namespace JSBSim {
 
+class FGSnapshot;
+
 /*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
 CLASS DOCUMENTATION
 %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
@@ -80,6 +82,8 @@ public:
   ~FGElectric();
 
   void Calculate(void);
+  void ArchiveState(FGSnapshot& snapshot);
+
   double GetPowerAvailable(void) {return (HP * hptoftlbssec);}
   double getRPM(void) {return RPM;}
   std::string GetEngineLabels(const std::string& delimiter);
@@ -48,6 +48,7 @@ INCLUDES
 #include "FGRotor.h"
 #include "input_output/FGXMLElement.h"
 #include "math/FGColumnVector3.h"
+#include "input_output/FGSnapshot.h"
 
 using namespace std;
 
@@ -205,7 +206,7 @@ bool FGEngine::Load(FGFDMExec *exec, Element *engine_element)
 
   Name = engine_element->GetAttributeValue("name");
 
-  FGModelFunctions::Load(engine_element, PropertyManager, to_string((int)EngineNumber)); // Call ModelFunctions loader
+  FGModelFunctions::Load(engine_element, exec, to_string((int)EngineNumber)); // Call ModelFunctions loader
 
 // Find and set engine location
 
@@ -257,13 +258,34 @@ bool FGEngine::Load(FGFDMExec *exec, Element *engine_element)
   property_name = base_property_name + "/fuel-used-lbs";
   PropertyManager->Tie( property_name.c_str(), this, &FGEngine::GetFuelUsedLbs);
 
-  PostLoad(engine_element, PropertyManager, to_string((int)EngineNumber));
+  PostLoad(engine_element, exec, to_string((int)EngineNumber));
 
   Debug(0);
 
   return true;
 }
 
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+void FGEngine::ArchiveState(FGSnapshot& snapshot)
+{
+  FGModelFunctions::ArchiveState(snapshot);
+  snapshot.Archive(FuelExpended);
+  snapshot.Archive(FuelFlowRate);
+  snapshot.Archive(PctPower);
+  snapshot.Archive(Starter);
+  snapshot.Archive(Starved);
+  snapshot.Archive(Running);
+  snapshot.Archive(Cranking);
+  snapshot.Archive(FuelFreeze);
+  snapshot.Archive(FuelFlow_gph);
+  snapshot.Archive(FuelFlow_pph);
+  snapshot.Archive(FuelUsedLbs);
+  snapshot.Archive(FuelDensity);
+  snapshot.Archive(SourceTanks);
+  Thruster->ArchiveState(snapshot);
+}
+
 //%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
 //    The bitmasked value choices are as follows:
 //    unset: In this case (the default) JSBSim would only print
@@ -65,6 +65,7 @@ class FGFDMExec;
 class FGThruster;
 class Element;
 class FGPropertyManager;
+class FGSnapshot;
 
 /*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
 CLASS DOCUMENTATION
@@ -185,6 +186,11 @@ public:
   /** Resets the Engine parameters to the initial conditions */
   virtual void ResetToIC(void);
 
+  /** Saves the state of the engine and of its thruster to a snapshot or
+      restores it from a snapshot.
+      @param snapshot the snapshot. */
+  virtual void ArchiveState(FGSnapshot& snapshot);
+
   /** Calculates the thrust of the engine, and other engine functions. */
   virtual void Calculate(void) = 0;
 
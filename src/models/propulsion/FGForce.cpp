@@ -48,6 +48,7 @@ and the cg.
 #include "models/FGPropagate.h"
 #include "models/FGMassBalance.h"
 #include "models/FGAuxiliary.h"
+#include "input_output/FGSnapshot.h"
 
 using namespace std;
 
@@ -163,6 +164,23 @@ void FGForce::SetAnglesToBody(double broll, double bpitch, double byaw)
   }
 }
 
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+void FGForce::ArchiveState(FGSnapshot& snapshot)
+{
+  snapshot.Archive(vFn);
+  snapshot.Archive(vMn);
+  snapshot.Archive(vH);
+  snapshot.Archive(vOrient);
+  snapshot.Archive(ttype);
+  snapshot.Archive(vXYZn);
+  snapshot.Archive(vActingXYZn);
+  snapshot.Archive(mT);
+  snapshot.Archive(vFb);
+  snapshot.Archive(vM);
+  snapshot.Archive(vDXYZ);
+}
+
 //%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
 //    The bitmasked value choices are as follows:
 //    unset: In this case (the default) JSBSim would only print
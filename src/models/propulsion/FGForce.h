@@ -74,6 +74,8 @@ FORWARD DECLARATIONS
 
 namespace JSBSim {
 
+class FGSnapshot;
+
 /*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
 CLASS DOCUMENTATION
 %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
@@ -312,6 +314,11 @@ public:
 
   const FGMatrix33& Transform(void) const;
 
+  /** Saves the state of the force to a snapshot or restores it from a
+      snapshot.
+      @param snapshot the snapshot. */
+  virtual void ArchiveState(FGSnapshot& snapshot);
+
 protected:
   FGFDMExec *fdmex;
   FGColumnVector3 vFn;
@@ -46,6 +46,7 @@ INCLUDES
 #include "FGPiston.h"
 #include "FGPropeller.h"
 #include "input_output/FGXMLElement.h"
+#include "input_output/FGSnapshot.h"
 
 using namespace std;
 
@@ -986,6 +987,48 @@ string FGPiston::GetEngineValues(const string& delimiter)
   return buf.str();
 }
 
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+void FGPiston::ArchiveState(FGSnapshot& snapshot)
+{
+  FGEngine::ArchiveState(snapshot);
+  snapshot.Archive(crank_counter);
+  snapshot.Archive(IndicatedHorsePower);
+  snapshot.Archive(PMEP);
+  snapshot.Archive(FMEP);
+  snapshot.Archive(FMEPDynamic);
+  snapshot.Archive(FMEPStatic);
+  snapshot.Archive(BoostSpeed);
+  snapshot.Archive(MAP);
+  snapshot.Archive(TMAP);
+  snapshot.Archive(p_amb);
+  snapshot.Archive(p_ram);
+  snapshot.Archive(T_amb);
+  snapshot.Archive(RPM);
+  snapshot.Archive(IAS);
+  snapshot.Archive(Cooling_Factor);
+  snapshot.Archive(Magneto_Left);
+  snapshot.Archive(Magneto_Right);
+  snapshot.Archive(Magnetos);
+  snapshot.Archive(rho_air);
+  snapshot.Archive(volumetric_efficiency);
+  snapshot.Archive(volumetric_efficiency_reduced);
+  snapshot.Archive(m_dot_air);
+  snapshot.Archive(v_dot_air);
+  snapshot.Archive(equivalence_ratio);
+  snapshot.Archive(m_dot_fuel);
+  snapshot.Archive(HP);
+  snapshot.Archive(BoostLossHP);
+  snapshot.Archive(combustion_efficiency);
+  snapshot.Archive(ExhaustGasTemp_degK);
+  snapshot.Archive(EGT_degC);
+  snapshot.Archive(ManifoldPressure_inHg);
+  snapshot.Archive(CylinderHeadTemp_degK);
+  snapshot.Archive(OilPressure_psi);
+  snapshot.Archive(OilTemp_degK);
+  snapshot.Archive(MeanPistonSpeed_fps);
+}
+
 //%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
 //
 //    The bitmasked value choices are as follows:
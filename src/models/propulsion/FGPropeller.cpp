@@ -40,6 +40,7 @@ INCLUDES
 
 #include "FGPropeller.h"
 #include "input_output/FGXMLElement.h"
+#include "input_output/FGSnapshot.h"
 
 using namespace std;
 
@@ -418,6 +419,25 @@ string FGPropeller::GetThrusterValues(int id, const string& delimeter)
   return buf.str();
 }
 
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+void FGPropeller::ArchiveState(FGSnapshot& snapshot)
+{
+  FGThruster::ArchiveState(snapshot);
+  snapshot.Archive(J);
+  snapshot.Archive(RPM);
+  snapshot.Archive(Pitch);
+  snapshot.Archive(Advance);
+  snapshot.Archive(ExcessTorque);
+  snapshot.Archive(HelicalTipMach);
+  snapshot.Archive(Vinduced);
+  snapshot.Archive(vTorque);
+  snapshot.Archive(CtFactor);
+  snapshot.Archive(CpFactor);
+  snapshot.Archive(Reversed);
+  snapshot.Archive(Feathered);
+}
+
 //%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
 //    The bitmasked value choices are as follows:
 //    unset: In this case (the default) JSBSim would only print
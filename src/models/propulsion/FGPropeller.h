@@ -53,6 +53,8 @@ FORWARD DECLARATIONS
 
 namespace JSBSim {
 
+class FGSnapshot;
+
 /*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
 CLASS DOCUMENTATION
 %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
@@ -255,6 +257,8 @@ public:
       would be slowed.
       @return the thrust in pounds */
   double Calculate(double EnginePower);
+  void ArchiveState(FGSnapshot& snapshot);
+
   FGColumnVector3 GetPFactor(void) const;
   std::string GetThrusterLabels(int id, const std::string& delimeter);
   std::string GetThrusterValues(int id, const std::string& delimeter);
@@ -44,6 +44,7 @@ INCLUDES
 #include "FGRocket.h"
 #include "FGThruster.h"
 #include "input_output/FGXMLElement.h"
+#include "input_output/FGSnapshot.h"
 
 using namespace std;
 
@@ -96,7 +97,7 @@ FGRocket::FGRocket(FGFDMExec* exec, Element *el, int engine_number, struct Input
   if (isp_el) {
     Element* isp_func_el = isp_el->FindElement("function");
     if (isp_func_el) {
-      isp_function = new FGFunction(exec->GetPropertyManager(),isp_func_el, strEngineNumber.str());
+      isp_function = new FGFunction(exec, isp_func_el, strEngineNumber.str());
     } else {
     Isp = el->FindElementValueAsNumber("isp");
     }
@@ -315,6 +316,34 @@ void FGRocket::bindmodel(FGPropertyManager* PropertyManager)
   }
 }
 
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+void FGRocket::ArchiveState(FGSnapshot& snapshot)
+{
+  FGEngine::ArchiveState(snapshot);
+  snapshot.Archive(It);
+  snapshot.Archive(ItVac);
+  snapshot.Archive(ThrustVariation);
+  snapshot.Archive(TotalIspVariation);
+  snapshot.Archive(VacThrust);
+  snapshot.Archive(previousFuelNeedPerTank);
+  snapshot.Archive(previousOxiNeedPerTank);
+  snapshot.Archive(OxidizerExpended);
+  snapshot.Archive(TotalPropellantExpended);
+  snapshot.Archive(OxidizerFlowRate);
+  snapshot.Archive(PropellantFlowRate);
+  snapshot.Archive(Flameout);
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+void FGRocket::CollectParameters(vector<const FGParameter*>& params) const
+{
+  if (isp_function) params.push_back(isp_function);
+
+  FGEngine::CollectParameters(params);
+}
+
 //%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
 //    The bitmasked value choices are as follows:
 //    unset: In this case (the default) JSBSim would only print
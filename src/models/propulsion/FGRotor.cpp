@@ -50,6 +50,7 @@ INCLUDES
 #include "models/FGMassBalance.h"
 #include "models/FGPropulsion.h" // to get the GearRatio from a linked rotor
 #include "input_output/FGXMLElement.h"
+#include "input_output/FGSnapshot.h"
 
 using std::cerr;
 using std::cout;
@@ -106,7 +107,7 @@ FGRotor::FGRotor(FGFDMExec *exec, Element* rotor_element, int num)
   Type = ttRotor;
   GearRatio = 1.0;
 
-  dt = exec->GetDeltaT();
+  dt = exec->GetDeltaT() * exec->GetPropulsion()->GetRate();
   for (int i=0; i<5; i++) R[i] = 0.0;
   for (int i=0; i<5; i++) B[i] = 0.0;
 
@@ -812,6 +813,35 @@ string FGRotor::GetThrusterValues(int id, const string& delimeter)
 
 }
 
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+void FGRotor::ArchiveState(FGSnapshot& snapshot)
+{
+  FGThruster::ArchiveState(snapshot);
+  snapshot.Archive(rho);
+  snapshot.Archive(damp_hagl);
+  snapshot.Archive(RPM);
+  snapshot.Archive(Omega);
+  snapshot.Archive(a_1);
+  snapshot.Archive(b_1);
+  snapshot.Archive(a_dw);
+  snapshot.Archive(H_drag);
+  snapshot.Archive(J_side);
+  snapshot.Archive(Torque);
+  snapshot.Archive(C_T);
+  snapshot.Archive(lambda);
+  snapshot.Archive(mu);
+  snapshot.Archive(nu);
+  snapshot.Archive(v_induced);
+  snapshot.Archive(theta_downwash);
+  snapshot.Archive(phi_downwash);
+  snapshot.Archive(CollectiveCtrl);
+  snapshot.Archive(LateralCtrl);
+  snapshot.Archive(LongitudinalCtrl);
+  snapshot.Archive(EngineRPM);
+  if (Transmission) Transmission->ArchiveState(snapshot);
+}
+
 //%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
 //    The bitmasked value choices are as follows:
 //    unset: In this case (the default) JSBSim would only print
@@ -43,6 +43,7 @@ INCLUDES
 #include "input_output/FGXMLElement.h"
 #include "input_output/FGPropertyManager.h"
 #include "input_output/string_utilities.h"
+#include "input_output/FGSnapshot.h"
 
 using namespace std;
 
@@ -75,6 +76,7 @@ FGTank::FGTank(FGFDMExec* exec, Element* el, int tank_number)
   vXYZ.InitMatrix();
   vXYZ_drain.InitMatrix();
   ixx_unit = iyy_unit = izz_unit = 1.0;
+  function_ixx = function_iyy = function_izz = 0;
   grainType = gtUNKNOWN; // This is the default
 
   type = el->GetAttributeValue("type");
@@ -143,7 +145,7 @@ FGTank::FGTank(FGFDMExec* exec, Element* el, int tank_number)
         Element* element_ixx = element_Grain->FindElement("ixx");
         if (element_ixx->GetAttributeValue("unit") == "KG*M2") ixx_unit = 1.0/1.35594;
         if (element_ixx->FindElement("function") != 0) {
-          function_ixx = new FGFunction(PropertyManager, element_ixx->FindElement("function"));
+          function_ixx = new FGFunction(exec, element_ixx->FindElement("function"));
         }
       } else {
         throw("For tank "+to_string(TankNumber)+" and when grain_config is specified an ixx must be specified when the FUNCTION grain type is specified.");
@@ -153,7 +155,7 @@ FGTank::FGTank(FGFDMExec* exec, Element* el, int tank_number)
         Element* element_iyy = element_Grain->FindElement("iyy");
         if (element_iyy->GetAttributeValue("unit") == "KG*M2") iyy_unit = 1.0/1.35594;
         if (element_iyy->FindElement("function") != 0) {
-          function_iyy = new FGFunction(PropertyManager, element_iyy->FindElement("function"));
+          function_iyy = new FGFunction(exec, element_iyy->FindElement("function"));
         }
       } else {
         throw("For tank "+to_string(TankNumber)+" and when grain_config is specified an iyy must be specified when the FUNCTION grain type is specified.");
@@ -163,7 +165,7 @@ FGTank::FGTank(FGFDMExec* exec, Element* el, int tank_number)
         Element* element_izz = element_Grain->FindElement("izz");
         if (element_izz->GetAttributeValue("unit") == "KG*M2") izz_unit = 1.0/1.35594;
         if (element_izz->FindElement("function") != 0) {
-          function_izz = new FGFunction(PropertyManager, element_izz->FindElement("function"));
+          function_izz = new FGFunction(exec, element_izz->FindElement("function"));
         }
       } else {
         throw("For tank "+to_string(TankNumber)+" and when grain_config is specified an izz must be specified when the FUNCTION grain type is specified.");
@@ -458,6 +460,41 @@ void FGTank::bind(FGPropertyManager* PropertyManager)
   PropertyManager->Tie( property_name.c_str(), (FGTank*)this, &FGTank::GetIzz);
 }
 
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+void FGTank::ArchiveState(FGSnapshot& snapshot)
+{
+  snapshot.Archive(vXYZ);
+  snapshot.Archive(vXYZ_drain);
+  snapshot.Archive(Capacity);
+  snapshot.Archive(Radius);
+  snapshot.Archive(InnerRadius);
+  snapshot.Archive(Length);
+  snapshot.Archive(Volume);
+  snapshot.Archive(Density);
+  snapshot.Archive(Ixx);
+  snapshot.Archive(Iyy);
+  snapshot.Archive(Izz);
+  snapshot.Archive(InertiaFactor);
+  snapshot.Archive(PctFull);
+  snapshot.Archive(Contents);
+  snapshot.Archive(Area);
+  snapshot.Archive(Temperature);
+  snapshot.Archive(Standpipe);
+  snapshot.Archive(ExternalFlow);
+  snapshot.Archive(Selected);
+  snapshot.Archive(Priority);
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+void FGTank::CollectParameters(vector<const FGParameter*>& params) const
+{
+  if (function_ixx) params.push_back(function_ixx);
+  if (function_iyy) params.push_back(function_iyy);
+  if (function_izz) params.push_back(function_izz);
+}
+
 //%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
 //    The bitmasked value choices are as follows:
 //    unset: In this case (the default) JSBSim would only print
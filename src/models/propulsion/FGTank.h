@@ -64,6 +64,8 @@ namespace JSBSim {
 class Element;
 class FGPropertyManager;
 class FGFDMExec;
+class FGSnapshot;
+class FGParameter;
 
 /*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
 CLASS DOCUMENTATION
@@ -236,6 +238,11 @@ public:
 
   /** Resets the tank parameters to the initial conditions */
   void ResetToIC(void);
+  void ArchiveState(FGSnapshot& snapshot);
+
+  /** Collects the functions of the tank (see FGModelFunctions::CollectParameters).
+      @param params the list to which the parameters are appended. */
+  void CollectParameters(std::vector<const FGParameter*>& params) const;
 
   /** If the tank is set to supply fuel, this function returns true.
       @return true if this tank is set to a non-zero priority.*/
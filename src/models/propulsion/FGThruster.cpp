@@ -40,6 +40,7 @@ INCLUDES
 
 #include "FGThruster.h"
 #include "input_output/FGXMLElement.h"
+#include "input_output/FGSnapshot.h"
 
 using namespace std;
 
@@ -155,6 +156,19 @@ string FGThruster::GetThrusterValues(int id, const string& delimeter)
   return buf.str();
 }
 
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+void FGThruster::ArchiveState(FGSnapshot& snapshot)
+{
+  FGForce::ArchiveState(snapshot);
+  snapshot.Archive(in);
+  snapshot.Archive(Thrust);
+  snapshot.Archive(PowerRequired);
+  snapshot.Archive(GearRatio);
+  snapshot.Archive(ThrustCoeff);
+  snapshot.Archive(ReverserAngle);
+}
+
 //%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
 //    The bitmasked value choices are as follows:
 //    unset: In this case (the default) JSBSim would only print
@@ -41,6 +41,7 @@ INCLUDES
 
 
 #include "FGTransmission.h"
+#include "input_output/FGSnapshot.h"
 
 using std::string;
 using std::cout;
@@ -158,6 +159,18 @@ bool FGTransmission::BindModel(int num)
   return true;
 }
 
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+void FGTransmission::ArchiveState(FGSnapshot& snapshot)
+{
+  snapshot.Archive(FreeWheelLag);
+  snapshot.Archive(FreeWheelTransmission);
+  snapshot.Archive(ClutchCtrlNorm);
+  snapshot.Archive(BrakeCtrlNorm);
+  snapshot.Archive(EngineRPM);
+  snapshot.Archive(ThrusterRPM);
+}
+
 //%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
 //    The bitmasked value choices are as follows:
 //    unset: In this case (the default) JSBSim would only print
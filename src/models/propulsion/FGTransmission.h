@@ -59,6 +59,8 @@ FORWARD DECLARATIONS
 
 namespace JSBSim {
 
+class FGSnapshot;
+
 /*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
 CLASS DOCUMENTATION
 %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
@@ -124,6 +126,7 @@ public:
   ~FGTransmission();
 
   void Calculate(double EnginePower, double ThrusterTorque, double dt);
+  void ArchiveState(FGSnapshot& snapshot);
 
   void   SetMaxBrakePower(double x) {MaxBrakePower=x;}
   double GetMaxBrakePower() const {return MaxBrakePower;}
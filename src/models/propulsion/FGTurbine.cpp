@@ -46,6 +46,7 @@ INCLUDES
 #include "FGTurbine.h"
 #include "FGThruster.h"
 #include "input_output/FGXMLElement.h"
+#include "input_output/FGSnapshot.h"
 
 using namespace std;
 
@@ -572,6 +573,39 @@ int FGTurbine::InitRunning(void)
   return phase=tpRun;
 }
 
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+void FGTurbine::ArchiveState(FGSnapshot& snapshot)
+{
+  FGEngine::ArchiveState(snapshot);
+  snapshot.Archive(phase);
+  snapshot.Archive(N1);
+  snapshot.Archive(N2);
+  snapshot.Archive(ThrottlePos);
+  snapshot.Archive(Stalled);
+  snapshot.Archive(Seized);
+  snapshot.Archive(Overtemp);
+  snapshot.Archive(Fire);
+  snapshot.Archive(Injection);
+  snapshot.Archive(Augmentation);
+  snapshot.Archive(Reversed);
+  snapshot.Archive(Cutoff);
+  snapshot.Archive(Ignition);
+  snapshot.Archive(AugMethod);
+  snapshot.Archive(EGT_degC);
+  snapshot.Archive(EPR);
+  snapshot.Archive(OilPressure_psi);
+  snapshot.Archive(OilTemp_degK);
+  snapshot.Archive(BleedDemand);
+  snapshot.Archive(InletPosition);
+  snapshot.Archive(NozzlePosition);
+  snapshot.Archive(correctedTSFC);
+  snapshot.Archive(InjectionTimer);
+  snapshot.Archive(InjWaterNorm);
+  snapshot.Archive(InjN1increment);
+  snapshot.Archive(InjN2increment);
+}
+
 //%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
 //    The bitmasked value choices are as follows:
 //    unset: In this case (the default) JSBSim would only print
@@ -52,6 +52,7 @@ namespace JSBSim {
 
 class Element;
 class FGFunction;
+class FGSnapshot;
 
 /*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
 CLASS DOCUMENTATION
@@ -173,6 +174,8 @@ public:
   enum phaseType { tpOff, tpRun, tpSpinUp, tpStart, tpStall, tpSeize, tpTrim };
 
   void Calculate(void);
+  void ArchiveState(FGSnapshot& snapshot);
+
   double CalcFuelNeed(void);
   double GetPowerAvailable(void);
   /** A lag filter.
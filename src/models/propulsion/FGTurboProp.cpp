@@ -50,6 +50,7 @@ INCLUDES
 #include "FGRotor.h"
 #include "math/FGFunction.h"
 #include "input_output/FGXMLElement.h"
+#include "input_output/FGSnapshot.h"
 
 using namespace std;
 
@@ -581,6 +582,39 @@ void FGTurboProp::bindmodel(FGPropertyManager* PropertyManager)
   PropertyManager->Tie( property_name.c_str(), &CombustionEfficiency);
 }
 
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+void FGTurboProp::ArchiveState(FGSnapshot& snapshot)
+{
+  FGEngine::ArchiveState(snapshot);
+  snapshot.Archive(phase);
+  snapshot.Archive(N1);
+  snapshot.Archive(N2);
+  snapshot.Archive(ThrottlePos);
+  snapshot.Archive(Stalled);
+  snapshot.Archive(Seized);
+  snapshot.Archive(Overtemp);
+  snapshot.Archive(Fire);
+  snapshot.Archive(Reversed);
+  snapshot.Archive(Cutoff);
+  snapshot.Archive(Ignition);
+  snapshot.Archive(EPR);
+  snapshot.Archive(OilPressure_psi);
+  snapshot.Archive(OilTemp_degK);
+  snapshot.Archive(InletPosition);
+  snapshot.Archive(NozzlePosition);
+  snapshot.Archive(Ielu_intervent);
+  snapshot.Archive(OldThrottle);
+  snapshot.Archive(RPM);
+  snapshot.Archive(CombustionEfficiency);
+  snapshot.Archive(HP);
+  snapshot.Archive(Eng_ITT_degC);
+  snapshot.Archive(Eng_Temperature);
+  snapshot.Archive(EngStarting);
+  snapshot.Archive(GeneratorPower);
+  snapshot.Archive(Condition);
+}
+
 //%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
 //    The bitmasked value choices are as follows:
 //    unset: In this case (the default) JSBSim would only print
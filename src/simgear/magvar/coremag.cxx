@@ -159,15 +159,29 @@ static double htnm_wmm2005[13][13]=
 
 static const int nmax = 12;
 
-static double P[13][13];
-static double DP[13][13];
-static double gnm[13][13];
-static double hnm[13][13];
-static double sm[13];
-static double cm[13];
+// these values do not change between function calls: they are computed once
+// and shared by all the threads.
+struct LegendreRoots {
+    double root[13];
+    double roots[13][13][2];
+
+    LegendreRoots() {
+      int n, m;
+      for ( n = 2; n <= nmax; n++ ) {
+          root[n] = sqrt((2.0*n-1) / (2.0*n));
+      }
+
+      for ( m = 0; m <= nmax; m++ ) {
+          double mm = m*m;
+          for ( n = MAX(m + 1, 2); n <= nmax; n++ ) {
+            roots[m][n][0] = sqrt((n-1)*(n-1) - mm);
+            roots[m][n][1] = 1.0 / sqrt( n*n - mm);
+          }
+      }
+    }
+};
 
-static double root[13];
-static double roots[13][13][2];
+static const LegendreRoots legendre;
 
 /* Convert date to Julian day    1950-2049 */
 unsigned long int yymmdd_to_julian_days( int yy, int mm, int dd )
@@ -200,7 +214,16 @@ double calc_magvar( double lat, double lon, double h, long dat, double* field )
     double yearfrac,sr,r,theta,c,s,psi,fn,fn_0,B_r,B_theta,B_phi,X,Y,Z;
     double sinpsi, cospsi, inv_s;
 
-    static int been_here = 0;
+    // the scratch arrays are local so that calc_magvar can be called
+    // concurrently. The upper triangle of P and DP is read as zero.
+    double P[13][13] = {{0}};
+    double DP[13][13] = {{0}};
+    double gnm[13][13];
+    double hnm[13][13];
+    double sm[13];
+    double cm[13];
+    const double (&root)[13] = legendre.root;
+    const double (&roots)[13][13][2] = legendre.roots;
 
     double sinlat = sin(lat);
     double coslat = cos(lat);
@@ -241,22 +264,6 @@ double calc_magvar( double lat, double lon, double h, long dat, double* field )
     P[1][0] = c ;
     DP[1][0] = -s;
 
-    // these values will not change for subsequent function calls
-    if( !been_here ) {
-      for ( n = 2; n <= nmax; n++ ) {
-          root[n] = sqrt((2.0*n-1) / (2.0*n));
-      }
-
-      for ( m = 0; m <= nmax; m++ ) {
-          double mm = m*m;
-          for ( n = MAX(m + 1, 2); n <= nmax; n++ ) {
-            roots[m][n][0] = sqrt((n-1)*(n-1) - mm);
-            roots[m][n][1] = 1.0 / sqrt( n*n - mm);
-          }
-      }
-      been_here = 1;
-    }
-
     for ( n=2; n <= nmax; n++ ) {
       // double root = sqrt((2.0*n-1) / (2.0*n));
       P[n][n] = P[n-1][n-1] * s * root[n];
@@ -318,6 +318,14 @@ compare_strings (const char * s1, const char * s2)
   return !strncmp(s1, s2, SGPropertyNode::MAX_STRING_LEN);
 }
 
+template<typename Itr>
+static bool
+equal_names (const std::string& name, Itr begin, Itr end)
+{
+  return name.size() == static_cast<size_t>(std::distance(begin, end))
+    && std::equal(begin, end, name.begin());
+}
+
 /**
  * Locate a child node by name and index.
  */
@@ -327,10 +335,11 @@ find_child (Itr begin, Itr end, int index, const PropertyList& nodes)
 {
   size_t nNodes = nodes.size();
 #if PROPS_STANDALONE
-  for (int i = 0; i < nNodes; i++) {
+  for (size_t i = 0; i < nNodes; i++) {
     SGPropertyNode * node = nodes[i];
-    if (node->getIndex() == index && compare_strings(node->getName(), begin))
-      return i;
+    if (node->getIndex() == index
+        && equal_names(node->getNameString(), begin, end))
+      return static_cast<int>(i);
   }
 #else
   boost::iterator_range<Itr> name(begin, end);
@@ -371,14 +380,12 @@ find_last_child (const char * name, const PropertyList& nodes)
  */
 static int
 first_unused_index( const char * name,
-                    const PropertyList& nodes,
+                    const SGPropertyNode * parent,
                     int min_index )
 {
-  const char* nameEnd = name + strlen(name);
-
   for( int index = min_index; index < std::numeric_limits<int>::max(); ++index )
   {
-    if( find_child(name, nameEnd, index, nodes) < 0 )
+    if( !parent->getChild(name, index) )
       return index;
   }
 
@@ -386,16 +393,112 @@ first_unused_index( const char * name,
   return -1;
 }
 
+/**
+ * The nodes which have at least this number of children keep an index of
+ * their children. The smaller nodes are searched linearly.
+ */
+static const size_t CHILD_INDEX_MIN_SIZE = 16;
+
+typedef std::unordered_multimap<size_t, SGPropertyNode*> ChildIndex;
+
+/**
+ * Hash of the name and the index of a child (FNV-1a).
+ */
 template<typename Itr>
-inline SGPropertyNode*
-SGPropertyNode::getExistingChild (Itr begin, Itr end, int index)
+static size_t
+hash_child (Itr begin, Itr end, int index)
 {
+  size_t hash = 2166136261u;
+  for (Itr it = begin; it != end; ++it) {
+    hash ^= static_cast<unsigned char>(*it);
+    hash *= 16777619u;
+  }
+  return hash ^ (static_cast<size_t>(index) * 0x9e3779b9u);
+}
+
+template<typename Itr>
+inline SGPropertyNode*
+SGPropertyNode::getExistingChild (Itr begin, Itr end, int index) const
+{
+  if (_child_index) {
+    std::pair<ChildIndex::const_iterator, ChildIndex::const_iterator> range
+      = _child_index->equal_range(hash_child(begin, end, index));
+    for (ChildIndex::const_iterator it = range.first; it != range.second; ++it) {
+      SGPropertyNode * node = it->second;
+      if (node->getIndex() == index
+          && equal_names(node->getNameString(), begin, end))
+        return node;
+    }
+    return 0;
+  }
+
   int pos = find_child(begin, end, index, _children);
   if (pos >= 0)
     return _children[pos];
   return 0;
 }
 
+void
+SGPropertyNode::indexChild (SGPropertyNode * node)
+{
+  const std::string& name = node->getNameString();
+  int index = node->getIndex();
+
+  // When several children have the same name and index, the lookups return
+  // the first one, as the linear search does.
+  if (!getExistingChild(name.begin(), name.end(), index))
+    _child_index->insert(std::make_pair(hash_child(name.begin(), name.end(),
+                                                   index), node));
+}
+
+void
+SGPropertyNode::unindexChild (SGPropertyNode * node)
+{
+  const std::string& name = node->getNameString();
+  int index = node->getIndex();
+  size_t hash = hash_child(name.begin(), name.end(), index);
+  std::pair<ChildIndex::iterator, ChildIndex::iterator> range
+    = _child_index->equal_range(hash);
+
+  for (ChildIndex::iterator it = range.first; it != range.second; ++it) {
+    if (it->second == node) {
+      _child_index->erase(it);
+      // The next child with the same name and index, if any, is now the one
+      // that the lookups return.
+      int pos = find_child(name.begin(), name.end(), index, _children);
+      if (pos >= 0)
+        _child_index->insert(std::make_pair(hash, _children[pos]));
+      return;
+    }
+  }
+}
+
+void
+SGPropertyNode::appendChild (SGPropertyNode * node)
+{
+  _children.push_back(node);
+
+  if (_child_index)
+    indexChild(node);
+  else if (_children.size() >= CHILD_INDEX_MIN_SIZE)
+    rebuildChildIndex();
+}
+
+void
+SGPropertyNode::rebuildChildIndex ()
+{
+  delete _child_index;
+  _child_index = 0;
+
+  if (_children.size() < CHILD_INDEX_MIN_SIZE)
+    return;
+
+  _child_index = new ChildIndex;
+  _child_index->reserve(_children.size());
+  for (size_t i = 0; i < _children.size(); ++i)
+    indexChild(_children[i]);
+}
+
 template<typename Itr>
 SGPropertyNode *
 SGPropertyNode::getChildImpl (Itr begin, Itr end, int index, bool create)
@@ -406,7 +509,7 @@ SGPropertyNode::getChildImpl (Itr begin, Itr end, int index, bool create)
       return node;
     } else if (create) {
       node = new SGPropertyNode(begin, end, index, this);
-      _children.push_back(node);
+      appendChild(node);
       fireChildAdded(node);
       return node;
     } else {
@@ -620,6 +723,7 @@ SGPropertyNode::set_bool (bool val)
       return false;
     }
   } else {
+    if (memcmp(&_local_val.bool_val, &val, sizeof(val)) != 0) _change_stamp++;
     _local_val.bool_val = val;
     fireValueChanged();
     return true;
@@ -637,6 +741,7 @@ SGPropertyNode::set_int (int val)
       return false;
     }
   } else {
+    if (memcmp(&_local_val.int_val, &val, sizeof(val)) != 0) _change_stamp++;
     _local_val.int_val = val;
     fireValueChanged();
     return true;
@@ -654,6 +759,7 @@ SGPropertyNode::set_long (long val)
       return false;
     }
   } else {
+    if (memcmp(&_local_val.long_val, &val, sizeof(val)) != 0) _change_stamp++;
     _local_val.long_val = val;
     fireValueChanged();
     return true;
@@ -671,6 +777,7 @@ SGPropertyNode::set_float (float val)
       return false;
     }
   } else {
+    if (memcmp(&_local_val.float_val, &val, sizeof(val)) != 0) _change_stamp++;
     _local_val.float_val = val;
     fireValueChanged();
     return true;
@@ -688,6 +795,7 @@ SGPropertyNode::set_double (double val)
       return false;
     }
   } else {
+    if (memcmp(&_local_val.double_val, &val, sizeof(val)) != 0) _change_stamp++;
     _local_val.double_val = val;
     fireValueChanged();
     return true;
@@ -707,6 +815,7 @@ SGPropertyNode::set_string (const char * val)
   } else {
     delete [] _local_val.string_val;
     _local_val.string_val = copy_string(val);
+    _change_stamp++;
     fireValueChanged();
     return true;
   }
@@ -750,6 +859,7 @@ SGPropertyNode::clearValue ()
     }
     _tied = false;
     _type = props::NONE;
+    _change_stamp++;
 }
 
 
@@ -840,9 +950,11 @@ const int SGPropertyNode::LAST_USED_ATTRIBUTE = PRESERVE;
 SGPropertyNode::SGPropertyNode ()
   : _index(0),
     _parent(0),
+    _child_index(0),
     _type(props::NONE),
     _tied(false),
     _attr(READ|WRITE),
+    _change_stamp(0),
     _listeners(0)
 {
   _local_val.string_val = 0;
@@ -858,9 +970,11 @@ SGPropertyNode::SGPropertyNode (const SGPropertyNode &node)
     _index(node._index),
     _name(node._name),
     _parent(0),			// don't copy the parent
+    _child_index(0),
     _type(node._type),
     _tied(node._tied),
     _attr(node._attr),
+    _change_stamp(0),
     _listeners(0)		// CHECK!!
 {
   _local_val.string_val = 0;
@@ -913,9 +1027,11 @@ SGPropertyNode::SGPropertyNode (Itr begin, Itr end,
   : _index(index),
     _name(begin, end),
     _parent(parent),
+    _child_index(0),
     _type(props::NONE),
     _tied(false),
     _attr(READ|WRITE),
+    _change_stamp(0),
     _listeners(0)
 {
   _local_val.string_val = 0;
@@ -930,9 +1046,11 @@ SGPropertyNode::SGPropertyNode( const std::string& name,
   : _index(index),
     _name(name),
     _parent(parent),
+    _child_index(0),
     _type(props::NONE),
     _tied(false),
     _attr(READ|WRITE),
+    _change_stamp(0),
     _listeners(0)
 {
   _local_val.string_val = 0;
@@ -949,6 +1067,7 @@ SGPropertyNode::~SGPropertyNode ()
   // zero out all parent pointers, else they might be dangling
   for (unsigned i = 0; i < _children.size(); ++i)
     _children[i]->_parent = 0;
+  delete _child_index;
   clearValue();
 
   if (_listeners) {
@@ -1048,11 +1167,11 @@ SGPropertyNode::addChild(const char * name, int min_index, bool append)
 {
   int pos = append
           ? std::max(find_last_child(name, _children) + 1, min_index)
-          : first_unused_index(name, _children, min_index);
+          : first_unused_index(name, this, min_index);
 
   SGPropertyNode_ptr node;
   node = new SGPropertyNode(name, name + strlen(name), pos, this);
-  _children.push_back(node);
+  appendChild(node);
   fireChildAdded(node);
   return node;
 }
@@ -1095,7 +1214,7 @@ SGPropertyNode::addChildren( const std::string& name,
     {
       SGPropertyNode_ptr node;
       node = new SGPropertyNode(name, index, this);
-      _children.push_back(node);
+      appendChild(node);
       fireChildAdded(node);
       nodes.push_back(node);
     }
@@ -1143,19 +1262,12 @@ SGPropertyNode::getChild (const char * name, int index, bool create)
 SGPropertyNode *
 SGPropertyNode::getChild (const std::string& name, int index, bool create)
 {
-#if PROPS_STANDALONE
-  const char *n = name.c_str();
-  int pos = find_child(n, n + strlen(n), index, _children);
-  if (pos >= 0) {
-    return _children[pos];
-#else
   SGPropertyNode* node = getExistingChild(name.begin(), name.end(), index);
   if (node) {
       return node;
-#endif
     } else if (create) {
       SGPropertyNode* node = new SGPropertyNode(name, index, this);
-      _children.push_back(node);
+      appendChild(node);
       fireChildAdded(node);
       return node;
     } else {
@@ -1169,11 +1281,7 @@ SGPropertyNode::getChild (const std::string& name, int index, bool create)
 const SGPropertyNode *
 SGPropertyNode::getChild (const char * name, int index) const
 {
-  int pos = find_child(name, name + strlen(name), index, _children);
-  if (pos >= 0)
-    return _children[pos];
-  else
-    return 0;
+  return getExistingChild(name, name + strlen(name), index);
 }
 
 
@@ -1262,6 +1370,7 @@ SGPropertyNode::removeAllChildren()
   }
 
   _children.clear();
+  rebuildChildIndex();
 }
 
 std::string
@@ -2481,6 +2590,12 @@ SGPropertyNode::eraseChild(simgear::PropertyList::iterator child)
   fireChildRemoved(node);
 
   _children.erase(child);
+  if (_child_index) {
+    if (_children.size() < CHILD_INDEX_MIN_SIZE)
+      rebuildChildIndex();
+    else
+      unindexChild(node);
+  }
   return node;
 }
 
@@ -19,6 +19,7 @@
 #include <vector>
 #include <string>
 #include <iostream>
+#include <unordered_map>
 #include <sstream>
 #include <typeinfo>
 
@@ -451,6 +452,11 @@ public:
     return new SGRawValuePointer(_ptr);
   }
 
+  /**
+   * Get the address of the variable to which this raw value is bound.
+   */
+  T * getPointer () const { return _ptr; }
+
 private:
   T * _ptr;
 };
@@ -1358,6 +1364,31 @@ public:
    */
   bool isTied () const { return _tied; }
 
+  /**
+   * Get the address of the external variable this node is bound to.
+   *
+   * Returns 0 unless the node is tied to a variable of type T through a
+   * pointer (SGRawValuePointer). Reading or writing the variable directly
+   * bypasses the attributes and the listeners of the node.
+   */
+  template<typename T>
+  T* getTiedPointer() const;
+
+  /**
+   * Get the change stamp of this node.
+   *
+   * The stamp is incremented each time the value stored in the node is
+   * modified. Two reads of the stamp that return the same number guarantee
+   * that the value has not been modified in between, unless the node is
+   * tied: the external data source can then be modified without the node
+   * being notified.
+   */
+  unsigned int getChangeStamp () const
+  {
+    return _type == simgear::props::ALIAS ? _value.alias->getChangeStamp()
+                                          : _change_stamp;
+  }
+
     /**
      * Bind this node to an external source.
      */
@@ -1801,10 +1832,14 @@ private:
   /// counted pointer
   SGPropertyNode * _parent;
   simgear::PropertyList _children;
+  /// Hash table of the children indexed by their name and index. It is only
+  /// built for the nodes that have many children.
+  std::unordered_multimap<size_t, SGPropertyNode*> * _child_index;
   mutable std::string _buffer;
   simgear::props::Type _type;
   bool _tied;
   int _attr;
+  unsigned int _change_stamp;
 
   // The right kind of pointer...
   union {
@@ -1828,7 +1863,15 @@ private:
   SGPropertyNode * getChildImpl (Itr begin, Itr end, int index = 0, bool create = false);
   // very internal method
   template<typename Itr>
-  SGPropertyNode* getExistingChild (Itr begin, Itr end, int index);
+  SGPropertyNode* getExistingChild (Itr begin, Itr end, int index) const;
+  // Appends a child and keeps the index of the children up to date
+  void appendChild (SGPropertyNode * node);
+  // Adds a child to the index of the children
+  void indexChild (SGPropertyNode * node);
+  // Removes a child, which is no longer in the list of children, from the index
+  void unindexChild (SGPropertyNode * node);
+  // Builds the index of the children again, if there are enough of them
+  void rebuildChildIndex ();
   // very internal path parsing function
   template<typename SplitItr>
   friend SGPropertyNode* find_node_aux(SGPropertyNode * current, SplitItr& itr,
@@ -1995,6 +2038,15 @@ template<>
 bool SGPropertyNode::tie (const SGRawValue<const char *> &rawValue,
                           bool useDefault);
 
+template<typename T>
+T* SGPropertyNode::getTiedPointer() const
+{
+    if (!_tied || _type != simgear::props::PropertyTraits<T>::type_tag)
+        return 0;
+    SGRawValuePointer<T>* raw = dynamic_cast<SGRawValuePointer<T>*>(_value.val);
+    return raw ? raw->getPointer() : 0;
+}
+
 template<typename T>
 T SGPropertyNode::getValue(typename boost::disable_if_c<simgear::props
                            ::PropertyTraits<T>::Internal>::type* dummy) const
@@ -21,10 +21,14 @@
 #ifndef SGReferenced_HXX
 #define SGReferenced_HXX
 
+#include <atomic>
+
 /// Base class for all reference counted SimGear objects
 /// Classes derived from this one are meant to be managed with
 /// the SGSharedPtr class.
 /// For more info see @SGSharedPtr.
+/// The reference count is atomic so that the objects can be shared by
+/// several threads.
 
 class SGReferenced {
 public:
@@ -47,7 +51,7 @@ public:
   { if (ref) return 1u < ref->_refcount; else return false; }
 
 private:
-  mutable unsigned _refcount;
+  mutable std::atomic<unsigned> _refcount;
 };
 
 #endif
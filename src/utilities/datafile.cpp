@@ -16,6 +16,7 @@
  ***************************************************************************/
 
 #include "datafile.h"
+#include "input_output/FGOutputBinaryFormat.h"
 
 DataFile::DataFile() {
 
@@ -30,11 +31,7 @@ DataFile::~DataFile() {
 /** This overloaded constructor opens the requested file. */
 
 DataFile::DataFile(string fname) {
-  int count=0;
-  unsigned short start, end;
-  string var;
-
-  f.open(fname.c_str());
+  f.open(fname.c_str(), ios::in | ios::binary);
   f.setf(ios::skipws);
   if ( !f ) {
     cout << "fileopen failed for file " << fname << endl << endl;
@@ -43,6 +40,64 @@ DataFile::DataFile(string fname) {
     cout << "File " << fname << " successfully opened." << endl;
   }
 
+  if (!ReadBinary()) ReadCSV(fname);
+
+  for (int i=0;i<GetNumFields();i++) {
+    Max.push_back(0.0);
+    Min.push_back(0.0);
+  }
+
+  for (int fld=0; fld<GetNumFields(); fld++) {
+    Max[fld] = Data[0][fld];
+    Min[fld] = Data[0][fld];
+    for (int rec=1;rec<GetNumRecords();rec++) {
+      if (Data[rec][fld] > Max[fld]) Max[fld] = Data[rec][fld];
+      else if (Data[rec][fld] < Min[fld]) Min[fld] = Data[rec][fld];
+    }
+  }
+
+  StartIdx = 0;
+  EndIdx = GetNumRecords()-1;
+
+  cout << endl << "Done Reading data ..." << endl;
+
+}
+
+
+/** Reads a file written by the BINARY output of JSBSim.
+    @return false if the file is not a binary output file. */
+
+bool DataFile::ReadBinary(void) {
+  JSBSim::FGOutputBinaryFormat format;
+
+  if (!format.ReadHeader(f)) return false;
+
+  for (unsigned int i=0; i<format.Columns.size(); i++)
+    names.push_back(format.Columns[i].Name);
+
+  cout << "Done parsing names. Reading data ..." << endl;
+
+  vector<double> values;
+  while (format.ReadRecord(f, values))
+    Data.push_back(Row(values.begin(), values.end()));
+
+  return true;
+}
+
+
+/** Reads a comma separated file. */
+
+void DataFile::ReadCSV(const string& fname) {
+  int count=0;
+  unsigned short start, end;
+  string var;
+
+  // The file is opened again in text mode.
+  f.close();
+  f.clear();
+  f.open(fname.c_str());
+  f.setf(ios::skipws);
+
   getline(f, data_str);
   end = 0;
 
@@ -84,26 +139,6 @@ DataFile::DataFile(string fname) {
     row++;
     if (f.eof()) break;
   }
-
-  for (int i=0;i<GetNumFields();i++) {
-    Max.push_back(0.0);
-    Min.push_back(0.0);
-  }
-
-  for (int fld=0; fld<GetNumFields(); fld++) {
-    Max[fld] = Data[0][fld];
-    Min[fld] = Data[0][fld];
-    for (int rec=1;rec<GetNumRecords();rec++) {
-      if (Data[rec][fld] > Max[fld]) Max[fld] = Data[rec][fld];
-      else if (Data[rec][fld] < Min[fld]) Min[fld] = Data[rec][fld];
-    }
-  }
-
-  StartIdx = 0;
-  EndIdx = GetNumRecords()-1;
-
-  cout << endl << "Done Reading data ..." << endl;
-
 }
 
 
@@ -58,6 +58,9 @@ public:
   int GetEndIdx(void)         {return EndIdx;}
 
 private: // Private attributes
+  bool ReadBinary(void);
+  void ReadCSV(const string& fname);
+
   string buff_str;
   ifstream f;
   Row Max;
@@ -94,11 +94,13 @@ INCLUDES
 #include <string>
 #include <fstream>
 #include <vector>
+#include <map>
 #include <sstream>
 #include <cstdlib>
 #include <cstdio>
 #include <cmath>
 #include "input_output/string_utilities.h"
+#include "input_output/FGOutputBinaryFormat.h"
 #include "plotXMLVisitor.h"
 
 using namespace std;
@@ -110,6 +112,7 @@ string DEFAULT_FONT, TITLE_FONT, LABEL_FONT, AXIS_FONT, TIMESTAMP_FONT, TICS_FON
 typedef vector <string> string_array;
 typedef vector <string_array> multi_string_array;
 multi_string_array NamesArray;
+map <string, string> DataSources;
 bool multiplot=false;
 
 string HaveTerm(const vector <string>&, const string); 
@@ -123,6 +126,8 @@ bool MakeArbitraryPlot(
   string Title,
   stringstream& plot);
 void PrintNames(const vector <string>&);
+bool ReadNames(const string&, string_array&);
+string DataSource(const string&);
 string itostr(int number)
 {
   stringstream ss;  // create a stringstream
@@ -137,7 +142,6 @@ int main(int argc, char **argv)
   string_array plotspecfiles;
   string_array files;
   int ctr=1, next_comma=0, len=0, start=0, file_ctr=0;
-  ifstream infile2;
   char num[8];
   bool comprehensive=false;
   bool pdf=false;
@@ -167,6 +171,7 @@ int main(int argc, char **argv)
          << endl << endl;
     cout << "If only the input data file name is given, all of the parameters available in that plot file" << endl;
     cout << "are given." << endl << endl;
+    cout << "The data file is either a comma separated file or a file written by the BINARY output." << endl << endl;
     exit(-1);
   }
 
@@ -179,13 +184,11 @@ int main(int argc, char **argv)
       new_filename=filename;
       sprintf(num,"%d",file_ctr);
       new_filename.replace(new_filename.find("#"),1,num);
-      infile2.open(new_filename.c_str());
-      if (!infile2.is_open()) {
+      string_array file_names;
+      if (!ReadNames(new_filename, file_names)) {
         break;
       } else {
-        getline(infile2, in_string, '\n');
-        NamesArray.push_back(split(in_string, ','));
-        infile2.close();
+        NamesArray.push_back(file_names);
         files.push_back(new_filename);
         file_ctr++;
       }
@@ -195,13 +198,11 @@ int main(int argc, char **argv)
     files.push_back(filename);
   }
 
-  ifstream infile(files[0].c_str());
-  if (!infile.is_open()) {
+  string_array names;
+  if (!ReadNames(files[0], names)) {
     cerr << "Could not open file: " << files[0] << endl;
     exit(-1);
   }
-  getline(infile, in_string, '\n');
-  string_array names = split(in_string, ',');
   unsigned int num_names=names.size();
   
   // Read command line args
@@ -621,28 +622,28 @@ bool MakeArbitraryPlot(
         newPlot << "set y2tics font \"" << TICS_FONT << "\"" << endl;
       }
 
-      newPlot << "plot " << time_range << " \"" << files[0] << "\" using " << GetTermIndex(names, XAxisName)
+      newPlot << "plot " << time_range << " " << DataSource(files[0]) << " using " << GetTermIndex(names, XAxisName)
            << ":" << GetTermIndex(names, LeftYAxisNames[0]) << " with " << plotType << " title \""
            << LeftYAxisNames[0] << "\"";
       if (numLeftYAxisNames > 1) {
         newPlot << ", \\" << endl;
         for (i=1; i<numLeftYAxisNames-1; i++) {
-          newPlot << "     \"" << files[0] << "\" using " << GetTermIndex(names, XAxisName)
+          newPlot << "     " << DataSource(files[0]) << " using " << GetTermIndex(names, XAxisName)
                << ":" << GetTermIndex(names, LeftYAxisNames[i]) << " with " << plotType << " title \"" 
                << LeftYAxisNames[i] << "\", \\" << endl;
         }
-        newPlot << "     \"" << files[0] << "\" using " << GetTermIndex(names, XAxisName)<< ":" 
+        newPlot << "     " << DataSource(files[0]) << " using " << GetTermIndex(names, XAxisName)<< ":" 
              << GetTermIndex(names, LeftYAxisNames[numLeftYAxisNames-1]) << " with " << plotType << " title \"" 
              << LeftYAxisNames[numLeftYAxisNames-1] << "\"";
       }
       if (numRightYAxisNames > 0) {
         newPlot << ", \\" << endl;
         for (i=0; i<numRightYAxisNames-1; i++) {
-          newPlot << "     \"" << files[0] << "\" using " << GetTermIndex(names, XAxisName)
+          newPlot << "     " << DataSource(files[0]) << " using " << GetTermIndex(names, XAxisName)
                << ":" << GetTermIndex(names, RightYAxisNames[i]) << " with " << plotType << " axes x1y2 title \""
                << RightYAxisNames[i] << "\", \\" << endl;
         }
-        newPlot << "     \"" << files[0] << "\" using " << GetTermIndex(names, XAxisName)
+        newPlot << "     " << DataSource(files[0]) << " using " << GetTermIndex(names, XAxisName)
              << ":" << GetTermIndex(names, RightYAxisNames[numRightYAxisNames-1]) << " with " << plotType << " axes x1y2 title \""
              << RightYAxisNames[numRightYAxisNames-1] << "\"";
       }
@@ -679,28 +680,28 @@ bool MakeArbitraryPlot(
           newPlot << "     ";
         }
 
-        newPlot << "\"" << files[f] << "\" using " << GetTermIndex(NamesArray[f], XAxisName)
+        newPlot << "" << DataSource(files[f]) << " using " << GetTermIndex(NamesArray[f], XAxisName)
              << ":" << GetTermIndex(NamesArray[f], LeftYAxisNames[0]) << " with " << plotType << " title \""
              << LeftYAxisNames[0] << ": " << f << "\"";
         if (numLeftYAxisNames > 1) {
           newPlot << ", \\" << endl;
           for (i=1; i<numLeftYAxisNames-1; i++) {
-            newPlot << "     \"" << files[f] << "\" using " << GetTermIndex(NamesArray[f], XAxisName)
+            newPlot << "     " << DataSource(files[f]) << " using " << GetTermIndex(NamesArray[f], XAxisName)
                  << ":" << GetTermIndex(NamesArray[f], LeftYAxisNames[i]) << " with " << plotType << " title \"" 
                  << LeftYAxisNames[i] << ": " << f << "\", \\" << endl;
           }
-          newPlot << "     \"" << files[f] << "\" using " << GetTermIndex(NamesArray[f], XAxisName)<< ":" 
+          newPlot << "     " << DataSource(files[f]) << " using " << GetTermIndex(NamesArray[f], XAxisName)<< ":" 
                << GetTermIndex(NamesArray[f], LeftYAxisNames[numLeftYAxisNames-1]) << " with " << plotType << " title \"" 
                << LeftYAxisNames[numLeftYAxisNames-1] << ": " << f << "\"";
         }
         if (numRightYAxisNames > 0) {
           newPlot << ", \\" << endl;
           for (i=0; i<numRightYAxisNames-2; i++) {
-            newPlot << "     \"" << files[f] << "\" using " << GetTermIndex(NamesArray[f], XAxisName)
+            newPlot << "     " << DataSource(files[f]) << " using " << GetTermIndex(NamesArray[f], XAxisName)
                  << ":" << GetTermIndex(NamesArray[f], RightYAxisNames[i]) << " with " << plotType << " axes x1y2 title \""
                  << RightYAxisNames[i] << ": " << f << "\", \\" << endl;
           }
-          newPlot << "     \"" << files[f] << "\" using " << GetTermIndex(NamesArray[f], XAxisName)
+          newPlot << "     " << DataSource(files[f]) << " using " << GetTermIndex(NamesArray[f], XAxisName)
                << ":" << GetTermIndex(NamesArray[f], RightYAxisNames[numRightYAxisNames-1]) << " with " << plotType << " axes x1y2 title \""
                << RightYAxisNames[numRightYAxisNames-1] << ": " << f << "\"";
         }
@@ -721,7 +722,7 @@ bool MakeArbitraryPlot(
 void EmitSinglePlot(const string filename, const int index, const string linetitle )
 {
   cout << "print \"Processing parameter plot: " << linetitle << "\"" << endl;
-  cout << "plot " << plot_range << " \"" << filename << "\" using 1:" << index << " with lines title \"" << linetitle << "\"" << endl;
+  cout << "plot " << plot_range << " " << DataSource(filename) << " using 1:" << index << " with lines title \"" << linetitle << "\"" << endl;
 }
 
 // ############################################################################
@@ -742,17 +743,62 @@ void EmitComparisonPlot(const vector <string>& filenames, const int index, const
   cout << "##" << endl << "##" << endl;
   cout << "print \"Processing parameter plot: " << linetitle << "\"" << endl;
   cout << "##" << endl << "##" << endl;
-    cout << "plot " << plot_range <<  " \"" << filenames[0] << "\" using 1:" << GetTermIndex(NamesArray[0],varname) << " with lines title \"" << linetitle << ": 1" << "\", \\" << endl;
+    cout << "plot " << plot_range <<  " " << DataSource(filenames[0]) << " using 1:" << GetTermIndex(NamesArray[0],varname) << " with lines title \"" << linetitle << ": 1" << "\", \\" << endl;
   for (unsigned int f=1;f<filenames.size()-1;f++){
-      cout << "\"" << filenames[f] << "\" using 1:" << GetTermIndex(NamesArray[f],varname) << " with lines title \"" << linetitle << ": " << f+1 << "\", \\" << endl;
+      cout << "" << DataSource(filenames[f]) << " using 1:" << GetTermIndex(NamesArray[f],varname) << " with lines title \"" << linetitle << ": " << f+1 << "\", \\" << endl;
   }
-    cout << "\"" << filenames[filenames.size()-1] << "\" using 1:" << GetTermIndex(NamesArray[filenames.size()-1],varname) << " with lines title \"" << linetitle << ": " << filenames.size() << "\"" << endl;
+    cout << "" << DataSource(filenames[filenames.size()-1]) << " using 1:" << GetTermIndex(NamesArray[filenames.size()-1],varname) << " with lines title \"" << linetitle << ": " << filenames.size() << "\"" << endl;
   }
 
 }
 
 // ############################################################################
 
+/** Reads the names of the columns of a data file, which is either a comma
+    separated file or a file written by the BINARY output. */
+
+bool ReadNames(const string& filename, string_array& names)
+{
+  ifstream infile(filename.c_str(), ios::in | ios::binary);
+  if (!infile.is_open()) return false;
+
+  JSBSim::FGOutputBinaryFormat format;
+  if (format.ReadHeader(infile)) {
+    names.clear();
+    for (unsigned int i=0; i<format.Columns.size(); i++)
+      names.push_back(format.Columns[i].Name);
+
+    // gnuplot must be told the layout of the binary files.
+    ostringstream source;
+    source << "\"" << filename << "\" binary skip=" << format.HeaderSize
+           << " format=\"" << format.GetGnuplotFormat() << "\"";
+    DataSources[filename] = source.str();
+  } else {
+    string in_string;
+    infile.close();
+    infile.clear();
+    infile.open(filename.c_str());
+    getline(infile, in_string, '\n');
+    names = split(in_string, ',');
+    DataSources[filename] = "\"" + filename + "\"";
+  }
+
+  return true;
+}
+
+// ############################################################################
+
+/// Returns the data source of a plot command for a data file.
+
+string DataSource(const string& filename)
+{
+  map <string, string>::const_iterator it = DataSources.find(filename);
+  if (it != DataSources.end()) return it->second;
+  return "\"" + filename + "\"";
+}
+
+// ############################################################################
+
 void PrintNames(const vector <string>& names)
 {
   for (int i=0; i<names.size(); i++) {
@@ -0,0 +1,69 @@
+# CheckFunctionProgram.py
+#
+# Check that the functions evaluated by their compiled program give the same
+# results than the functions evaluated by walking their tree of parameters.
+#
+# Copyright (c) 2016 JSBSim development team
+#
+# This program is free software; you can redistribute it and/or modify it under
+# the terms of the GNU General Public License as published by the Free Software
+# Foundation; either version 3 of the License, or (at your option) any later
+# version.
+#
+# This program is distributed in the hope that it will be useful, but WITHOUT
+# ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+# FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+# details.
+#
+# You should have received a copy of the GNU General Public License along with
+# this program; if not, see <http://www.gnu.org/licenses/>
+#
+
+import os, sys, unittest
+from JSBSim_utils import CreateFDM, Table, SandBox, ExecuteUntil
+
+
+class CheckFunctionProgram(unittest.TestCase):
+    def setUp(self):
+        self.sandbox = SandBox()
+
+    def tearDown(self):
+        if 'JSBSIM_FUNCTION_TREE' in os.environ:
+            del os.environ['JSBSIM_FUNCTION_TREE']
+        self.sandbox.erase()
+
+    def RunScript(self, script, output):
+        fdm = CreateFDM(self.sandbox)
+        fdm.load_script(self.sandbox.path_to_jsbsim_file('scripts', script))
+        fdm.set_output_directive(self.sandbox.path_to_jsbsim_file('tests',
+                                                                  'output.xml'))
+        fdm.run_ic()
+        ExecuteUntil(fdm, 30.0)
+        del fdm
+
+        os.rename(self.sandbox('output.csv'), self.sandbox(output))
+
+        result = Table()
+        result.ReadCSV(self.sandbox(output))
+        return result
+
+    def CompareEvaluations(self, script):
+        os.environ['JSBSIM_FUNCTION_TREE'] = '1'
+        ref = self.RunScript(script, 'tree.csv')
+        os.environ['JSBSIM_FUNCTION_TREE'] = '0'
+        current = self.RunScript(script, 'program.csv')
+
+        diff = ref.compare(current, 0.0)
+        self.longMessage = True
+        self.assertTrue(diff.empty(), msg='\n'+repr(diff))
+
+    def test_c172(self):
+        self.CompareEvaluations('c1723.xml')
+
+    def test_737(self):
+        self.CompareEvaluations('737_cruise.xml')
+
+suite = unittest.TestLoader().loadTestsFromTestCase(CheckFunctionProgram)
+test_result = unittest.TextTestRunner(verbosity=2).run(suite)
+if test_result.failures:
+    sys.exit(-1) # 'make test' will report the test failed.
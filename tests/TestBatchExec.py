@@ -0,0 +1,109 @@
+# TestBatchExec.py
+#
+# Check that the instances run in parallel by the batch executor give exactly
+# the same results than the same instances run one after the other.
+#
+# Copyright (c) 2016 JSBSim development team
+#
+# This program is free software; you can redistribute it and/or modify it under
+# the terms of the GNU General Public License as published by the Free Software
+# Foundation; either version 3 of the License, or (at your option) any later
+# version.
+#
+# This program is distributed in the hope that it will be useful, but WITHOUT
+# ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+# FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+# details.
+#
+# You should have received a copy of the GNU General Public License along with
+# this program; if not, see <http://www.gnu.org/licenses/>
+#
+
+import os, sys, unittest
+import jsbsim
+from JSBSim_utils import CreateFDM, SandBox
+
+
+class TestBatchExec(unittest.TestCase):
+    scripts = ['c1723.xml', 'Short_S23_1.xml', 'ball_orbit.xml', 'J2460.xml']
+    properties = ['simulation/sim-time-sec', 'position/h-sl-ft',
+                  'position/lat-gc-deg', 'position/long-gc-deg',
+                  'attitude/phi-rad', 'attitude/theta-rad', 'attitude/psi-rad',
+                  'velocities/u-fps', 'velocities/v-fps', 'velocities/w-fps',
+                  'velocities/p-rad_sec', 'velocities/q-rad_sec',
+                  'velocities/r-rad_sec']
+    steps = 2000
+
+    def setUp(self):
+        os.environ['JSBSIM_DEBUG'] = str(0)
+        self.sandbox = SandBox()
+
+    def tearDown(self):
+        self.sandbox.erase()
+
+    def RunSerial(self, script):
+        fdm = CreateFDM(self.sandbox)
+        fdm.load_script(self.sandbox.path_to_jsbsim_file('scripts', script))
+        fdm.do_disable_output()
+        fdm.run_ic()
+
+        for i in xrange(self.steps):
+            if not fdm.run():
+                break
+
+        result = [fdm.get_property_value(p) for p in self.properties]
+        del fdm
+        return result
+
+    def CreateBatch(self, num_instances, num_threads):
+        batch = jsbsim.FGBatchExec(num_threads)
+        path = self.sandbox.path_to_jsbsim_file()
+
+        for i in xrange(num_instances):
+            idx = batch.add_instance(os.path.join(self.sandbox(), ''),
+                                     os.path.join(path, 'aircraft'),
+                                     os.path.join(path, 'engine'),
+                                     os.path.join(path, 'systems'))
+            script = self.scripts[i % len(self.scripts)]
+            batch.load_script(idx,
+                              self.sandbox.path_to_jsbsim_file('scripts',
+                                                               script))
+            batch.do_disable_output(idx)
+
+        return batch
+
+    def CheckBatch(self, num_instances, num_threads):
+        ref = {}
+        for script in self.scripts:
+            ref[script] = self.RunSerial(script)
+
+        batch = self.CreateBatch(num_instances, num_threads)
+        self.assertEqual(batch.get_num_instances(), num_instances)
+        batch.run_ic()
+
+        # Mix long and short parallel sections
+        batch.run(self.steps / 2)
+        for i in xrange(self.steps / 2):
+            batch.run()
+
+        for i in xrange(num_instances):
+            self.assertEqual(batch.get_error(i), '')
+            result = [batch.get_property_value(i, p) for p in self.properties]
+            script = self.scripts[i % len(self.scripts)]
+            # The results must be strictly identical.
+            self.assertEqual(result, ref[script],
+                             msg='Instance #%d (%s)' % (i, script))
+
+    def test_single_thread(self):
+        self.CheckBatch(len(self.scripts), 1)
+
+    def test_multiple_threads(self):
+        self.CheckBatch(4*len(self.scripts), 4)
+
+    def test_more_threads_than_instances(self):
+        self.CheckBatch(2, 8)
+
+suite = unittest.TestLoader().loadTestsFromTestCase(TestBatchExec)
+test_result = unittest.TextTestRunner(verbosity=2).run(suite)
+if test_result.failures or test_result.errors:
+    sys.exit(-1) # 'make test' will report the test failed.
@@ -0,0 +1,115 @@
+# TestBinaryCache.py
+#
+# Check that the binary form of the model files stored in the cache directory
+# gives the same model as the XML files and that it is rebuilt when the XML
+# files are modified.
+#
+# Copyright (c) 2016 JSBSim development team
+#
+# This program is free software; you can redistribute it and/or modify it under
+# the terms of the GNU General Public License as published by the Free Software
+# Foundation; either version 3 of the License, or (at your option) any later
+# version.
+#
+# This program is distributed in the hope that it will be useful, but WITHOUT
+# ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+# FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+# details.
+#
+# You should have received a copy of the GNU General Public License along with
+# this program; if not, see <http://www.gnu.org/licenses/>
+#
+
+import os, sys, shutil, unittest
+import xml.etree.ElementTree as et
+from JSBSim_utils import CreateFDM, SandBox
+import jsbsim
+
+
+class TestBinaryCache(unittest.TestCase):
+    properties = ['velocities/u-fps', 'velocities/v-fps', 'velocities/w-fps',
+                  'position/h-sl-ft', 'attitude/phi-rad',
+                  'attitude/theta-rad', 'propulsion/engine/thrust-lbs',
+                  'simulation/sim-time-sec']
+
+    def setUp(self):
+        os.environ['JSBSIM_DEBUG'] = str(0)
+        self.sandbox = SandBox()
+        self.cachedir = self.sandbox('cache')
+        os.mkdir(self.cachedir)
+
+    def tearDown(self):
+        self.sandbox.erase()
+
+    def CacheFiles(self):
+        return sorted(os.listdir(self.cachedir))
+
+    def RunScript(self, script, cache):
+        fdm = CreateFDM(self.sandbox)
+        if cache:
+            fdm.set_cache_dir(self.cachedir)
+        fdm.load_script(self.sandbox.path_to_jsbsim_file('scripts', script))
+        fdm.do_disable_output()
+        fdm.run_ic()
+        history = []
+        for i in xrange(500):
+            if not fdm.run():
+                break
+            history.append([fdm.get_property_value(p)
+                            for p in self.properties])
+        del fdm
+        return history
+
+    def test_same_results(self):
+        ref = self.RunScript('c1723.xml', False)
+        self.assertEqual(self.CacheFiles(), [])
+
+        # The first run builds the binary files, the second one reads them.
+        self.assertEqual(self.RunScript('c1723.xml', True), ref)
+        files = self.CacheFiles()
+        self.assertTrue(len(files) > 1)
+        mtimes = [os.path.getmtime(os.path.join(self.cachedir, f))
+                  for f in files]
+
+        self.assertEqual(self.RunScript('c1723.xml', True), ref)
+        self.assertEqual(self.CacheFiles(), files)
+        self.assertEqual([os.path.getmtime(os.path.join(self.cachedir, f))
+                          for f in files], mtimes)
+
+    def LoadBall(self):
+        fdm = CreateFDM(self.sandbox)
+        fdm.set_aircraft_path('aircraft')
+        fdm.set_cache_dir(self.cachedir)
+        self.assertTrue(fdm.load_model('ball'))
+        weight = fdm.get_property_value('inertia/empty-weight-lbs')
+        del fdm
+        return weight
+
+    def test_modified_file(self):
+        shutil.copytree(self.sandbox.path_to_jsbsim_file('aircraft', 'ball'),
+                        self.sandbox('aircraft', 'ball'))
+        self.assertEqual(self.LoadBall(), 40.0)
+        self.assertEqual(len(self.CacheFiles()), 1)
+
+        # Modify the empty weight of the ball.
+        filename = self.sandbox('aircraft', 'ball', 'ball.xml')
+        tree = et.parse(filename)
+        tree.getroot().find('mass_balance/emptywt').text = '50.0'
+        tree.write(filename)
+
+        self.assertEqual(self.LoadBall(), 50.0)
+        self.assertEqual(self.LoadBall(), 50.0)
+
+        # A corrupted binary file is ignored and rebuilt.
+        binfile = os.path.join(self.cachedir, self.CacheFiles()[0])
+        size = os.path.getsize(binfile)
+        with open(binfile, 'r+b') as f:
+            f.truncate(size/2)
+        self.assertEqual(self.LoadBall(), 50.0)
+        self.assertEqual(os.path.getsize(binfile), size)
+        self.assertEqual(self.LoadBall(), 50.0)
+
+suite = unittest.TestLoader().loadTestsFromTestCase(TestBinaryCache)
+test_result = unittest.TextTestRunner(verbosity=2).run(suite)
+if test_result.failures or test_result.errors:
+    sys.exit(-1) # 'make test' will report the test failed.
@@ -0,0 +1,141 @@
+# TestBinaryOutput.py
+#
+# Check that the BINARY output stores the same values as the CSV output and
+# that the files follow the documented format.
+#
+# Copyright (c) 2016 JSBSim development team
+#
+# This program is free software; you can redistribute it and/or modify it under
+# the terms of the GNU General Public License as published by the Free Software
+# Foundation; either version 3 of the License, or (at your option) any later
+# version.
+#
+# This program is distributed in the hope that it will be useful, but WITHOUT
+# ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+# FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+# details.
+#
+# You should have received a copy of the GNU General Public License along with
+# this program; if not, see <http://www.gnu.org/licenses/>
+#
+
+import os, sys, struct, unittest
+from JSBSim_utils import CreateFDM, SandBox, ExecuteUntil, Table
+
+
+def ReadBinaryOutput(filename):
+    f = open(filename, 'rb')
+    data = f.read()
+    f.close()
+
+    if data[:8] != 'JSBSIMBO':
+        raise IOError('Not a binary output file')
+
+    version, bom, ncols, recordsize, headersize = struct.unpack_from('=5I',
+                                                                     data, 8)
+    if version != 1 or bom != 0x01020304:
+        raise IOError('Unsupported binary output file')
+
+    offset = 28
+    columns = []
+    for i in xrange(ncols):
+        t, = struct.unpack_from('=I', data, offset)
+        offset += 4
+        strings = []
+        for j in xrange(2):
+            length, = struct.unpack_from('=I', data, offset)
+            offset += 4
+            strings.append(data[offset:offset+length])
+            offset += length
+        columns.append((chr(t), strings[0], strings[1]))
+
+    fmt = '=' + ''.join([c[0] for c in columns])
+    assert struct.calcsize(fmt) == recordsize
+
+    records = []
+    for start in xrange(headersize, len(data)-recordsize+1, recordsize):
+        records.append(struct.unpack_from(fmt, data, start))
+
+    return columns, records
+
+
+class TestBinaryOutput(unittest.TestCase):
+    properties = ['velocities/u-fps', 'position/h-sl-ft', 'attitude/phi-rad',
+                  'velocities/vc-kts', 'propulsion/engine/thrust-lbs']
+
+    def setUp(self):
+        self.sandbox = SandBox()
+
+    def tearDown(self):
+        self.sandbox.erase()
+
+    def WriteDirective(self, name, output_type, attributes=''):
+        f = open(self.sandbox(name+'.xml'), 'w')
+        f.write('<output name="%s" type="%s" rate="20" %s>\n' % (name,
+                                                                 output_type,
+                                                                 attributes))
+        f.write('  <property caption="Altitude"> position/h-agl-ft </property>\n')
+        for p in self.properties:
+            f.write('  <property> %s </property>\n' % p)
+        f.write('</output>\n')
+        f.close()
+
+    def RunScript(self):
+        fdm = CreateFDM(self.sandbox)
+        fdm.set_output_directive('out_csv.xml')
+        fdm.set_output_directive('out_bin.xml')
+        fdm.load_script(self.sandbox.path_to_jsbsim_file('scripts',
+                                                         'c1723.xml'))
+        fdm.run_ic()
+        ExecuteUntil(fdm, 10.0)
+        del fdm
+
+    def test_same_values(self):
+        self.WriteDirective('out_csv', 'CSV')
+        self.WriteDirective('out_bin', 'BINARY')
+        self.RunScript()
+
+        ref = Table()
+        ref.ReadCSV(self.sandbox('out_csv'))
+        columns, records = ReadBinaryOutput(self.sandbox('out_bin'))
+
+        self.assertEqual(columns[0], ('d', 'Time', 'sec'))
+        self.assertEqual(columns[1], ('d', 'Altitude', 'ft'))
+        self.assertEqual(len(columns), len(self.properties)+2)
+        for c, p in zip(columns[2:], self.properties):
+            self.assertEqual(c[1], '/fdm/jsbsim/' + p)
+        self.assertEqual(columns[-1][2], 'lbs')
+
+        values = [ref.get_column(col)[1:] for col in xrange(len(columns))]
+        self.assertEqual(len(records), len(values[0]))
+        for i, r in enumerate(records):
+            self.assertAlmostEqual(r[0], values[0][i], delta=1E-8)
+            for col in xrange(1, len(columns)):
+                value = values[col][i]
+                self.assertAlmostEqual(r[col], value,
+                                       delta=1E-6*max(abs(value), 1.0))
+
+    def test_single_precision(self):
+        self.WriteDirective('out_csv', 'CSV')
+        self.WriteDirective('out_bin', 'BINARY', 'precision="single"')
+        self.RunScript()
+
+        columns, records = ReadBinaryOutput(self.sandbox('out_bin'))
+        self.assertEqual(columns[0][0], 'd')
+        for c in columns[1:]:
+            self.assertEqual(c[0], 'f')
+
+        ref = Table()
+        ref.ReadCSV(self.sandbox('out_csv'))
+        values = [ref.get_column(col)[1:] for col in xrange(len(columns))]
+        self.assertEqual(len(records), len(values[0]))
+        for i, r in enumerate(records):
+            for col in xrange(1, len(columns)):
+                value = values[col][i]
+                self.assertAlmostEqual(r[col], value,
+                                       delta=1E-5*max(abs(value), 1.0))
+
+suite = unittest.TestLoader().loadTestsFromTestCase(TestBinaryOutput)
+test_result = unittest.TextTestRunner(verbosity=2).run(suite)
+if test_result.failures or test_result.errors:
+    sys.exit(-1) # 'make test' will report the test failed.
@@ -0,0 +1,176 @@
+# TestBinarySocketOutput.py
+#
+# Check that the records sent by the BINARY_SOCKET output are described by the
+# schema message and that they hold the same values as the CSV output.
+#
+# Copyright (c) 2016 JSBSim development team
+#
+# This program is free software; you can redistribute it and/or modify it under
+# the terms of the GNU General Public License as published by the Free Software
+# Foundation; either version 3 of the License, or (at your option) any later
+# version.
+#
+# This program is distributed in the hope that it will be useful, but WITHOUT
+# ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+# FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+# details.
+#
+# You should have received a copy of the GNU General Public License along with
+# this program; if not, see <http://www.gnu.org/licenses/>
+#
+
+import socket, struct, sys, unittest
+from JSBSim_utils import CreateFDM, SandBox, ExecuteUntil, Table
+
+
+def DecodeMessages(datagrams):
+    columns = []
+    records = []
+    sequence = []
+    for data in datagrams:
+        magic, version, kind, size, seq, count = struct.unpack_from('<4sHHIII',
+                                                                    data)
+        if magic != 'JSBS' or version != 1 or size != len(data):
+            raise IOError('Not a binary output message')
+        sequence.append(seq)
+
+        if kind == 1:
+            recordsize, = struct.unpack_from('<I', data, 20)
+            offset = 24
+            columns = []
+            for i in xrange(count):
+                t = data[offset]
+                offset += 1
+                strings = []
+                for j in xrange(2):
+                    length, = struct.unpack_from('<H', data, offset)
+                    offset += 2
+                    strings.append(data[offset:offset+length])
+                    offset += length
+                columns.append((t, strings[0], strings[1]))
+            fmt = '<' + ''.join([c[0] for c in columns])
+            assert struct.calcsize(fmt) == recordsize
+        elif kind == 2:
+            for i in xrange(count):
+                records.append(struct.unpack_from(fmt, data,
+                                                  20 + i*recordsize))
+
+    return columns, records, sequence
+
+
+class TestBinarySocketOutput(unittest.TestCase):
+    properties = ['velocities/u-fps', 'position/h-sl-ft', 'attitude/phi-rad',
+                  'velocities/vc-kts']
+
+    def setUp(self):
+        self.sandbox = SandBox()
+        self.receiver = socket.socket(socket.AF_INET, socket.SOCK_DGRAM)
+        self.receiver.bind(('127.0.0.1', 0))
+        self.receiver.settimeout(1.0)
+        self.port = self.receiver.getsockname()[1]
+
+    def tearDown(self):
+        self.receiver.close()
+        self.sandbox.erase()
+
+    def WriteDirective(self, filename, name, output_type, attributes=''):
+        f = open(self.sandbox(filename+'.xml'), 'w')
+        f.write('<output name="%s" type="%s" rate="20" %s>\n' % (name,
+                                                                 output_type,
+                                                                 attributes))
+        for p in self.properties:
+            f.write('  <property> %s </property>\n' % p)
+        f.write('</output>\n')
+        f.close()
+
+    def RunScript(self):
+        fdm = CreateFDM(self.sandbox)
+        fdm.set_output_directive('out_csv.xml')
+        fdm.set_output_directive('out_sock.xml')
+        fdm.load_script(self.sandbox.path_to_jsbsim_file('scripts',
+                                                         'c1723.xml'))
+        fdm.run_ic()
+        ExecuteUntil(fdm, 10.0)
+        del fdm
+
+        datagrams = []
+        try:
+            while True:
+                datagrams.append(self.receiver.recv(65536))
+        except socket.timeout:
+            pass
+
+        return datagrams
+
+    def CheckValues(self, columns, records, precision):
+        ref = Table()
+        ref.ReadCSV(self.sandbox('out_csv'))
+        values = [ref.get_column(col)[1:] for col in xrange(len(columns))]
+        self.assertEqual(len(records), len(values[0]))
+        for i, r in enumerate(records):
+            self.assertAlmostEqual(r[0], values[0][i], delta=1E-8)
+            for col in xrange(1, len(columns)):
+                value = values[col][i]
+                self.assertAlmostEqual(r[col], value,
+                                       delta=precision*max(abs(value), 1.0))
+
+    def test_batched_records(self):
+        self.WriteDirective('out_csv', 'out_csv', 'CSV')
+        self.WriteDirective('out_sock', 'localhost', 'BINARY_SOCKET',
+                            'port="%d" protocol="UDP"' % self.port)
+        datagrams = self.RunScript()
+        columns, records, sequence = DecodeMessages(datagrams)
+
+        self.assertEqual(columns[0], ('d', 'Time', 'sec'))
+        self.assertEqual(len(columns), len(self.properties)+1)
+        for c, p in zip(columns[1:], self.properties):
+            self.assertEqual(c[1], '/fdm/jsbsim/' + p)
+        self.assertEqual(columns[2][2], 'ft')
+
+        # No datagram is lost on the loopback and the simulation runs much
+        # faster than real time so the records are batched.
+        self.assertEqual(sequence, range(len(sequence)))
+        self.assertTrue(len(datagrams) < len(records) / 10)
+        self.CheckValues(columns, records, 1E-6)
+
+    def test_frames_per_message(self):
+        self.WriteDirective('out_csv', 'out_csv', 'CSV')
+        self.WriteDirective('out_sock', 'localhost', 'BINARY_SOCKET',
+                            'port="%d" protocol="UDP" frames="3" '
+                            'precision="single"' % self.port)
+        datagrams = self.RunScript()
+        columns, records, sequence = DecodeMessages(datagrams)
+
+        self.assertEqual(columns[0][0], 'd')
+        for c in columns[1:]:
+            self.assertEqual(c[0], 'f')
+
+        for data in datagrams:
+            kind, size, seq, count = struct.unpack_from('<HIII', data, 6)
+            if kind == 2:
+                self.assertTrue(count <= 3)
+        self.CheckValues(columns, records, 1E-5)
+
+    def test_frames_clamped(self):
+        # The number of frames is too large for a UDP datagram so it is
+        # limited and no record is lost.
+        self.WriteDirective('out_csv', 'out_csv', 'CSV')
+        self.WriteDirective('out_sock', 'localhost', 'BINARY_SOCKET',
+                            'port="%d" protocol="UDP" frames="100000"'
+                            % self.port)
+        datagrams = self.RunScript()
+        columns, records, sequence = DecodeMessages(datagrams)
+
+        recordsize = 8*len(columns)
+        for data in datagrams:
+            self.assertTrue(len(data) <= 65507)
+            kind, size, seq, count = struct.unpack_from('<HIII', data, 6)
+            if kind == 2:
+                self.assertTrue(count <= (65507-20) // recordsize)
+        self.assertEqual(sequence, range(len(sequence)))
+        self.CheckValues(columns, records, 1E-6)
+
+suite = unittest.TestLoader().loadTestsFromTestCase(TestBinarySocketOutput)
+test_result = unittest.TextTestRunner(verbosity=2).run(suite)
+if test_result.failures or test_result.errors:
+    sys.exit(-1) # 'make test' will report the test failed.
@@ -0,0 +1,164 @@
+# TestFunctionOptimizer.py
+#
+# Check that the optimizer of the functions folds the constant sub-expressions
+# and merges the duplicated ones, but neither of them when they use random
+# numbers, and that it does not change the results of the functions.
+#
+# Copyright (c) 2016 JSBSim development team
+#
+# This program is free software; you can redistribute it and/or modify it under
+# the terms of the GNU General Public License as published by the Free Software
+# Foundation; either version 3 of the License, or (at your option) any later
+# version.
+#
+# This program is distributed in the hope that it will be useful, but WITHOUT
+# ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+# FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+# details.
+#
+# You should have received a copy of the GNU General Public License along with
+# this program; if not, see <http://www.gnu.org/licenses/>
+#
+
+import os, random, sys, unittest
+import xml.etree.ElementTree as et
+from JSBSim_utils import CreateFDM, SandBox, CopyAircraftDef
+
+# product(x, y, sin(x)) has 5 nodes and is used twice: it is merged into a
+# shared expression. The same product with random instead of sin is not. The
+# sum 1+2 (3 nodes) and the quotient 1/2^3 (5 nodes) are folded, the sum of a
+# value and of urandom is not.
+TestSystem = """<?xml version="1.0"?>
+<system name="optimizer">
+  <property value="0.5">test/x</property>
+  <property value="0.25">test/y</property>
+  <channel name="test">
+    <fcs_function name="test/folded">
+      <function>
+        <product>
+          <property>test/x</property>
+          <sum><value>1.0</value><value>2.0</value></sum>
+          <quotient>
+            <value>1.0</value>
+            <pow><value>2.0</value><value>3.0</value></pow>
+          </quotient>
+        </product>
+      </function>
+    </fcs_function>
+    <fcs_function name="test/shared-1">
+      <function>
+        <sum>
+          <value>1.5</value>
+          <product>
+            <property>test/x</property>
+            <property>test/y</property>
+            <sin><property>test/x</property></sin>
+          </product>
+        </sum>
+      </function>
+    </fcs_function>
+    <fcs_function name="test/shared-2">
+      <function>
+        <difference>
+          <product>
+            <property>test/x</property>
+            <property>test/y</property>
+            <sin><property>test/x</property></sin>
+          </product>
+          <property>test/y</property>
+        </difference>
+      </function>
+    </fcs_function>
+    <fcs_function name="test/random-1">
+      <function>
+        <sum>
+          <product>
+            <property>test/x</property>
+            <property>test/y</property>
+            <random/>
+          </product>
+          <sum><value>1.0</value><urandom/></sum>
+        </sum>
+      </function>
+    </fcs_function>
+    <fcs_function name="test/random-2">
+      <function>
+        <sum>
+          <product>
+            <property>test/x</property>
+            <property>test/y</property>
+            <random/>
+          </product>
+          <sum><value>1.0</value><urandom/></sum>
+        </sum>
+      </function>
+    </fcs_function>
+  </channel>
+</system>
+"""
+
+Outputs = ['test/folded', 'test/shared-1', 'test/shared-2', 'test/random-1',
+           'test/random-2']
+
+
+class TestFunctionOptimizer(unittest.TestCase):
+    def setUp(self):
+        self.sandbox = SandBox()
+        script_path = self.sandbox.path_to_jsbsim_file('scripts', 'ball.xml')
+        tree, aircraft_name, b = CopyAircraftDef(script_path, self.sandbox)
+        aircraft_file = self.sandbox('aircraft', aircraft_name,
+                                     aircraft_name+'.xml')
+        # The reference counts are those of the unmodified aircraft.
+        tree.write(aircraft_file)
+        fdm = self.CreateFDM()
+        self.ref = fdm.get_function_optimizer_stats()
+        del fdm
+
+        tree.getroot().append(et.fromstring(TestSystem))
+        tree.write(aircraft_file)
+
+    def tearDown(self):
+        if 'JSBSIM_FUNCTION_OPTIMIZER' in os.environ:
+            del os.environ['JSBSIM_FUNCTION_OPTIMIZER']
+        self.sandbox.erase()
+
+    def CreateFDM(self):
+        fdm = CreateFDM(self.sandbox)
+        fdm.set_aircraft_path('aircraft')
+        fdm.load_model('ball')
+        fdm.load_ic('reset00', True)
+        fdm.run_ic()
+        return fdm
+
+    def test_optimizer(self):
+        fdm = self.CreateFDM()
+        folded, merged, shared = fdm.get_function_optimizer_stats()
+        self.assertEqual(folded - self.ref[0], 6)
+        self.assertEqual(merged - self.ref[1], 5)
+        self.assertEqual(shared - self.ref[2], 1)
+
+        os.environ['JSBSIM_FUNCTION_OPTIMIZER'] = '0'
+        ref_fdm = self.CreateFDM()
+        self.assertEqual(ref_fdm.get_function_optimizer_stats(), None)
+
+        # Both instances draw the same random numbers, so the results are
+        # identical as long as the random nodes are evaluated as many times.
+        random.seed(0)
+        for i in range(200):
+            x = random.uniform(-2.0, 2.0)
+            y = random.uniform(-2.0, 2.0)
+            for f in (fdm, ref_fdm):
+                f['test/x'] = x
+                f['test/y'] = y
+                f.run()
+            for name in Outputs:
+                self.assertEqual(fdm[name], ref_fdm[name], msg=name)
+            self.assertNotEqual(fdm['test/random-1'], fdm['test/random-2'])
+
+        del fdm
+        del ref_fdm
+
+suite = unittest.TestLoader().loadTestsFromTestCase(TestFunctionOptimizer)
+test_result = unittest.TextTestRunner(verbosity=2).run(suite)
+if test_result.failures or test_result.errors:
+    sys.exit(-1)  # 'make test' will report the test failed.
@@ -0,0 +1,215 @@
+# TestInputServer.py
+#
+# A test case that checks that several telnet clients can send commands to
+# JSBSim at the same time via the input server.
+#
+# Copyright (c) 2016 JSBSim development team
+#
+# This program is free software; you can redistribute it and/or modify it under
+# the terms of the GNU General Public License as published by the Free Software
+# Foundation; either version 3 of the License, or (at your option) any later
+# version.
+#
+# This program is distributed in the hope that it will be useful, but WITHOUT
+# ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+# FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+# details.
+#
+# You should have received a copy of the GNU General Public License along with
+# this program; if not, see <http://www.gnu.org/licenses/>
+#
+
+import sys, unittest, telnetlib, time, string, threading, socket
+import xml.etree.ElementTree as et
+from JSBSim_utils import CreateFDM, SandBox
+
+prompt = 'JSBSim> '
+
+
+class JSBSimThread(threading.Thread):
+    def __init__(self, fdm):
+        threading.Thread.__init__(self)
+        self.quit = False
+        self._fdm = fdm
+
+    def run(self):
+        while not self.quit:
+            self._fdm.run()
+            self._fdm.check_incremental_hold()
+            time.sleep(0.001)
+
+
+class TestInputServer(unittest.TestCase):
+    def setUp(self):
+        self.sandbox = SandBox()
+        script_path = self.sandbox.path_to_jsbsim_file('scripts', 'c1722.xml')
+        tree = et.parse(self.sandbox.elude(script_path))
+        input_tag = et.SubElement(tree.getroot(), 'input')
+        input_tag.attrib['type'] = 'SERVER'
+        input_tag.attrib['port'] = '1139'
+        tree.write(self.sandbox('c1722_server.xml'))
+
+        self.fdm = CreateFDM(self.sandbox)
+        self.fdm.load_script('c1722_server.xml')
+        self.fdm.run_ic()
+        self.fdm.hold()
+
+        self.thread = JSBSimThread(self.fdm)
+        self.thread.start()
+
+    def tearDown(self):
+        self.thread.quit = True
+        self.thread.join()
+        del self.fdm
+        self.sandbox.erase()
+
+    def connect(self):
+        tn = telnetlib.Telnet("localhost", 1139, 2.0)
+        greeting = tn.read_until(prompt, 2.0)
+        self.assertEqual(string.split(greeting, '\n')[0],
+                         'Connected to JSBSim server')
+        return tn
+
+    def sendCommand(self, tn, command):
+        tn.write(command+"\n")
+        return tn.read_until(prompt, 2.0)[:-len(prompt)]
+
+    def getPropertyValue(self, tn, prop):
+        msg = self.sendCommand(tn, "get "+prop)
+        return float(string.split(msg, '=')[1])
+
+    def test_several_clients(self):
+        clients = [self.connect() for i in xrange(4)]
+
+        # Each client modifies the property and reads it back. The commands of
+        # a client are executed in the order in which they have been sent.
+        for i in xrange(20):
+            for k, tn in enumerate(clients):
+                value = 0.01 * (i + k)
+                self.sendCommand(tn, "set fcs/throttle-cmd-norm "+str(value))
+                self.assertAlmostEqual(self.getPropertyValue(tn, "fcs/throttle-cmd-norm"),
+                                       value)
+
+        # The changes made by a client are seen by the others.
+        self.sendCommand(clients[0], "set fcs/mixture-cmd-norm 0.75")
+        for tn in clients:
+            self.assertAlmostEqual(self.getPropertyValue(tn, "fcs/mixture-cmd-norm"),
+                                   0.75)
+
+        # Errors are reported to the client which issued the command only.
+        self.assertEqual(string.strip(self.sendCommand(clients[1], "get foo/bar")),
+                         'Unknown property')
+        self.assertEqual(string.strip(self.sendCommand(clients[2], "foo")),
+                         'Unknown command: foo')
+
+        # A client quitting does not disturb the others.
+        clients[3].write("quit\n")
+        self.assertEqual(clients[3].read_all(), prompt)
+        clients[3].close()
+        for tn in clients[:3]:
+            self.assertAlmostEqual(self.getPropertyValue(tn, "fcs/mixture-cmd-norm"),
+                                   0.75)
+
+        # Commands sent in a burst are all executed in order.
+        tn = clients[0]
+        tn.write(''.join(["set fcs/throttle-cmd-norm %d\nget fcs/throttle-cmd-norm\n" % i
+                          for i in xrange(2000)]))
+        for i in xrange(2000):
+            tn.read_until(prompt, 2.0)
+            msg = tn.read_until(prompt, 2.0)
+            self.assertEqual(float(string.split(msg, '=')[1][:-len(prompt)]), i)
+
+        # The hold and resume commands are shared by all the clients.
+        self.sendCommand(clients[1], "resume")
+        time.sleep(0.2)
+        t = self.getPropertyValue(clients[2], "simulation/sim-time-sec")
+        time.sleep(0.2)
+        self.assertGreater(self.getPropertyValue(clients[0], "simulation/sim-time-sec"), t)
+        self.sendCommand(clients[2], "hold")
+        t = self.getPropertyValue(clients[0], "simulation/sim-time-sec")
+        time.sleep(0.2)
+        self.assertEqual(self.getPropertyValue(clients[1], "simulation/sim-time-sec"), t)
+
+        for tn in clients[:3]:
+            tn.close()
+
+    def test_input_limit(self):
+        tn1 = self.connect()
+        tn2 = self.connect()
+
+        # A burst much larger than the command queue and the input buffer is
+        # held back by the server instead of being dropped.
+        tn1.write(''.join(["set fcs/throttle-cmd-norm %d\n" % i
+                           for i in xrange(10000)]))
+        for i in xrange(10000):
+            tn1.read_until(prompt, 2.0)
+        self.assertEqual(self.getPropertyValue(tn1, "fcs/throttle-cmd-norm"),
+                         9999)
+
+        # A line longer than the input buffer closes the connection. The
+        # connection is reset since the server does not read the end of the
+        # line.
+        tn2.write('get ' + 'x'*100000)
+        try:
+            self.assertEqual(tn2.read_all(), '')
+        except socket.error:
+            pass
+        tn2.close()
+
+        self.assertEqual(self.getPropertyValue(tn1, "fcs/throttle-cmd-norm"),
+                         9999)
+        tn1.close()
+
+    def test_output_limit(self):
+        tn1 = self.connect()
+        tn2 = self.connect()
+
+        # A client which sends commands without ever reading the replies is
+        # held back by the server once the replies pile up: the server stops
+        # reading it so its sends stall instead of the server memory growing.
+        sock = tn1.get_socket()
+        sock.setblocking(0)
+        data = b'help\n'*20000
+        sent = 0
+        stalls = 0
+        while stalls < 20 and sent < 20000000:
+            try:
+                sent += sock.send(data[sent % 5:])
+                stalls = 0
+            except socket.error:
+                stalls += 1
+                time.sleep(0.05)
+        self.assertEqual(stalls, 20)
+
+        # The other clients are still served.
+        self.sendCommand(tn2, "set fcs/mixture-cmd-norm 0.25")
+        self.assertAlmostEqual(self.getPropertyValue(tn2, "fcs/mixture-cmd-norm"),
+                               0.25)
+
+        # The commands are executed again once the client reads its replies.
+        received = 0
+        stalls = 0
+        while received < 10000000 and stalls < 20:
+            try:
+                received += len(sock.recv(65536))
+                stalls = 0
+            except socket.error:
+                stalls += 1
+                time.sleep(0.05)
+        resumed = False
+        for i in xrange(20):
+            try:
+                sock.send(data[sent % 5:])
+                resumed = True
+                break
+            except socket.error:
+                time.sleep(0.05)
+        self.assertTrue(resumed)
+
+        tn1.close()
+        tn2.close()
+
+suite = unittest.TestLoader().loadTestsFromTestCase(TestInputServer)
+test_result = unittest.TextTestRunner(verbosity=2).run(suite)
+if test_result.failures or test_result.errors:
+    sys.exit(-1)  # 'make test' will report the test failed.
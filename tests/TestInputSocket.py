@@ -242,6 +242,34 @@ class TestInputSocket(unittest.TestCase):
         tn = TelnetInterface(fdm, 5., 1138)
         self.sanityCheck(tn)
 
+    def test_input_rate(self):
+        # The rate attribute of the input does not reduce the rate at which the
+        # socket is polled.
+        tree, aircraft_name, b = CopyAircraftDef(self.script_path, self.sandbox)
+        input_tag = et.SubElement(tree.getroot(), 'input')
+        input_tag.attrib['port'] = '1139'
+        input_tag.attrib['rate'] = '1'
+        tree.write(self.sandbox('aircraft', aircraft_name,
+                                aircraft_name+'.xml'))
+
+        fdm = CreateFDM(self.sandbox)
+        fdm.set_aircraft_path('aircraft')
+        fdm.load_script(self.script_path)
+        fdm.run_ic()
+
+        s = socket.create_connection(('localhost', 1139), 2.0)
+        try:
+            fdm.run()
+            s.sendall(b'set fcs/rudder-cmd-norm 0.5\n')
+            time.sleep(0.1)
+            fdm.run()
+            fdm.run()
+            self.assertEqual(fdm.get_property_value('fcs/rudder-cmd-norm'), 0.5)
+        finally:
+            s.close()
+
+        del fdm
+
 suite = unittest.TestLoader().loadTestsFromTestCase(TestInputSocket)
 test_result = unittest.TextTestRunner(verbosity=2).run(suite)
 if test_result.failures or test_result.errors:
@@ -0,0 +1,132 @@
+# TestLinearization.py
+#
+# Check the linearization of a trimmed c172x (FGStateSpace::linearize): the
+# jacobians do not depend on the number of threads, they match the values
+# computed element by element and the state of the FDM is left unchanged.
+#
+# Copyright (c) 2016 JSBSim development team
+#
+# This program is free software; you can redistribute it and/or modify it under
+# the terms of the GNU General Public License as published by the Free Software
+# Foundation; either version 3 of the License, or (at your option) any later
+# version.
+#
+# This program is distributed in the hope that it will be useful, but WITHOUT
+# ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+# FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+# details.
+#
+# You should have received a copy of the GNU General Public License along with
+# this program; if not, see <http://www.gnu.org/licenses/>
+#
+
+import math, sys, unittest
+import jsbsim
+from JSBSim_utils import CreateFDM, SandBox
+
+# Properties that make up the state of the FDM.
+StateProperties = ['simulation/sim-time-sec', 'velocities/u-fps',
+                   'velocities/v-fps', 'velocities/w-fps',
+                   'velocities/p-rad_sec', 'velocities/q-rad_sec',
+                   'velocities/r-rad_sec', 'attitude/phi-rad',
+                   'attitude/theta-rad', 'attitude/psi-rad',
+                   'position/lat-gc-rad', 'position/long-gc-rad',
+                   'position/h-sl-ft', 'propulsion/engine/propeller-rpm',
+                   'fcs/throttle-cmd-norm', 'fcs/aileron-cmd-norm',
+                   'fcs/elevator-cmd-norm', 'fcs/rudder-cmd-norm',
+                   'ic/vt-fps', 'ic/alpha-rad', 'ic/theta-rad',
+                   'ic/h-sl-ft']
+
+
+class TestLinearization(unittest.TestCase):
+    def setUp(self):
+        self.sandbox = SandBox()
+        self.fdm = CreateFDM(self.sandbox)
+        self.fdm.load_model('c172x')
+        self.fdm.load_ic('reset01', True)
+        self.fdm.run_ic()
+        self.fdm['fcs/mixture-cmd-norm'] = 1.0
+        self.fdm['fcs/throttle-cmd-norm'] = 0.5
+        self.fdm['propulsion/set-running'] = -1
+        for i in range(100):
+            self.fdm.run()
+        self.fdm.do_trim(1)
+        self.ss = jsbsim.FGStateSpace(self.fdm)
+
+    def tearDown(self):
+        del self.ss
+        del self.fdm
+        self.sandbox.erase()
+
+    def GetState(self):
+        return [self.fdm[name] for name in StateProperties]
+
+    # The jacobian of y (or of its derivative) with respect to x computed one
+    # element at a time, as FGStateSpace did before the jacobians were
+    # computed column by column. Each evaluation starts from the trimmed
+    # state: without that, the elements drift with the state left over by the
+    # previous evaluations (C is then off the identity by up to 5%).
+    def ElementJacobian(self, y, x, derivative, h=1e-4):
+        ss = self.ss
+        x0 = ss.get(x)
+        units = ss.get_units(x)
+        J = []
+        for iY in range(ss.get_size(y)):
+            row = []
+            for iX in range(ss.get_size(x)):
+                f = []
+                for step in (h, 2*h, -h, -2*h):
+                    self.fdm.restore_state(self.trimmed)
+                    ss.set(x, x0)
+                    ss.set_element(x, iX, ss.get_element(x, iX)+step)
+                    if derivative:
+                        f.append(ss.get_deriv(y, iY))
+                    else:
+                        f.append(ss.get_element(y, iY))
+                diff1 = f[0] - f[2]
+                diff2 = f[1] - f[3]
+                if units[iX] == 'rad':
+                    period = 2*math.pi
+                elif units[iX] == 'deg':
+                    period = 360.
+                else:
+                    period = None
+                if period:
+                    diff1 -= period*round(diff1/period)
+                    diff2 -= period*round(diff2/period)
+                row.append((8*diff1-diff2)/(12*h))
+            J.append(row)
+        self.fdm.restore_state(self.trimmed)
+        return J
+
+    def CheckJacobian(self, J, ref, name):
+        self.assertEqual(len(J), len(ref))
+        for iY, (row, ref_row) in enumerate(zip(J, ref)):
+            self.assertEqual(len(row), len(ref_row))
+            for iX, (v, ref_v) in enumerate(zip(row, ref_row)):
+                self.assertAlmostEqual(v, ref_v, delta=1E-12+1E-9*abs(ref_v),
+                                       msg='{0}[{1}][{2}]'.format(name, iY, iX))
+
+    def test_linearize(self):
+        state = self.GetState()
+        self.trimmed = jsbsim.FGSnapshot()
+        self.fdm.save_state(self.trimmed)
+        A, B, C, D = self.ss.linearize(1)
+        self.assertEqual(self.GetState(), state)
+        self.assertEqual(len(A), self.ss.get_size('x'))
+        self.assertEqual(len(B[0]), self.ss.get_size('u'))
+
+        # The jacobians are identical whatever the number of threads.
+        for num_threads in (2, 4):
+            self.assertEqual(self.ss.linearize(num_threads), (A, B, C, D))
+            self.assertEqual(self.GetState(), state)
+
+        self.CheckJacobian(A, self.ElementJacobian('x', 'x', True), 'A')
+        self.CheckJacobian(B, self.ElementJacobian('x', 'u', True), 'B')
+        self.CheckJacobian(C, self.ElementJacobian('y', 'x', False), 'C')
+        self.CheckJacobian(D, self.ElementJacobian('y', 'u', False), 'D')
+
+suite = unittest.TestLoader().loadTestsFromTestCase(TestLinearization)
+test_result = unittest.TextTestRunner(verbosity=2).run(suite)
+if test_result.failures or test_result.errors:
+    sys.exit(-1)  # 'make test' will report the test failed.
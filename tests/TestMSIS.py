@@ -0,0 +1,86 @@
+# TestMSIS.py
+#
+# Check that the temperature and the density interpolated by MSIS in its
+# altitude profile agree with a direct evaluation of NRLMSISE-00 at the
+# current location, including when the aircraft moves from one latitude and
+# longitude cell of the profile to the next.
+#
+# Copyright (c) 2016 JSBSim development team
+#
+# This program is free software; you can redistribute it and/or modify it under
+# the terms of the GNU General Public License as published by the Free Software
+# Foundation; either version 3 of the License, or (at your option) any later
+# version.
+#
+# This program is distributed in the hope that it will be useful, but WITHOUT
+# ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+# FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+# details.
+#
+# You should have received a copy of the GNU General Public License along with
+# this program; if not, see <http://www.gnu.org/licenses/>
+#
+
+import math, sys, unittest
+from JSBSim_utils import CreateFDM, SandBox
+
+
+class TestMSIS(unittest.TestCase):
+    def setUp(self):
+        self.sandbox = SandBox()
+
+    def tearDown(self):
+        self.sandbox.erase()
+
+    def CheckProfile(self, fdm):
+        T, rho = fdm.get_msis_direct()
+        self.assertAlmostEqual(fdm.get_property_value('atmosphere/T-R')/T, 1.0,
+                               delta=2E-3)
+        self.assertAlmostEqual(fdm.get_property_value('atmosphere/rho-slugs_ft3')/rho,
+                               1.0, delta=2E-3)
+
+    # The cells of the profile are 0.25 degree wide in latitude and longitude.
+    def Cell(self, fdm):
+        return (math.floor(4.0*fdm.get_property_value('position/lat-geod-deg')),
+                math.floor(4.0*fdm.get_property_value('position/long-gc-deg')))
+
+    def test_selection(self):
+        fdm = CreateFDM(self.sandbox)
+        self.assertEqual(fdm.get_atmosphere_model(), 'standard')
+        self.assertRaises(RuntimeError, fdm.get_msis_direct)
+        self.assertTrue(fdm.set_atmosphere_model('msis'))
+        self.assertEqual(fdm.get_atmosphere_model(), 'msis')
+        fdm.load_script(self.sandbox.path_to_jsbsim_file('scripts',
+                                                         'ball_orbit.xml'))
+        # The model can no longer be changed once the aircraft is loaded.
+        self.assertFalse(fdm.set_atmosphere_model('standard'))
+        self.assertEqual(fdm.get_atmosphere_model(), 'msis')
+        self.assertTrue(fdm.set_atmosphere_model('msis'))
+        del fdm
+
+    def test_profile(self):
+        fdm = CreateFDM(self.sandbox)
+        fdm.set_atmosphere_model('msis')
+        fdm.load_script(self.sandbox.path_to_jsbsim_file('scripts',
+                                                         'ball_orbit.xml'))
+        fdm.run_ic()
+        self.CheckProfile(fdm)
+
+        # The ball crosses several cells, so the profiles of the next cells are
+        # used once they have been computed in the background.
+        cell = self.Cell(fdm)
+        crossings = 0
+        while fdm.get_property_value('simulation/sim-time-sec') < 60.0:
+            fdm.run()
+            self.CheckProfile(fdm)
+            if self.Cell(fdm) != cell:
+                cell = self.Cell(fdm)
+                crossings += 1
+
+        self.assertGreaterEqual(crossings, 10)
+        del fdm
+
+suite = unittest.TestLoader().loadTestsFromTestCase(TestMSIS)
+test_result = unittest.TextTestRunner(verbosity=2).run(suite)
+if test_result.failures or test_result.errors:
+    sys.exit(-1)  # 'make test' will report the test failed.
@@ -0,0 +1,94 @@
+# TestModelCopy.py
+#
+# Check that an instance loading its model from another instance behaves
+# exactly as an instance that has read the model files itself.
+#
+# Copyright (c) 2016 JSBSim development team
+#
+# This program is free software; you can redistribute it and/or modify it under
+# the terms of the GNU General Public License as published by the Free Software
+# Foundation; either version 3 of the License, or (at your option) any later
+# version.
+#
+# This program is distributed in the hope that it will be useful, but WITHOUT
+# ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+# FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+# details.
+#
+# You should have received a copy of the GNU General Public License along with
+# this program; if not, see <http://www.gnu.org/licenses/>
+#
+
+import os, sys, unittest
+from JSBSim_utils import CreateFDM, SandBox
+import jsbsim
+
+
+class TestModelCopy(unittest.TestCase):
+    properties = ['velocities/u-fps', 'velocities/v-fps', 'velocities/w-fps',
+                  'velocities/p-rad_sec', 'velocities/q-rad_sec',
+                  'velocities/r-rad_sec', 'position/h-sl-ft',
+                  'attitude/phi-rad', 'attitude/theta-rad',
+                  'attitude/psi-rad', 'simulation/sim-time-sec']
+
+    def setUp(self):
+        os.environ['JSBSIM_DEBUG'] = str(0)
+        self.sandbox = SandBox()
+
+    def tearDown(self):
+        self.sandbox.erase()
+
+    def Run(self, fdm, steps):
+        history = []
+        for i in xrange(steps):
+            if not fdm.run():
+                break
+            history.append([fdm.get_property_value(p)
+                            for p in self.properties])
+        return history
+
+    def CheckScript(self, script_name, steps):
+        script = self.sandbox.path_to_jsbsim_file('scripts', script_name)
+
+        fdm = CreateFDM(self.sandbox)
+        fdm.load_script(script)
+        fdm.do_disable_output()
+        fdm.run_ic()
+
+        copy = CreateFDM(self.sandbox)
+        self.assertTrue(copy.load_model_from(fdm))
+        copy.load_script(script)
+        copy.do_disable_output()
+        copy.run_ic()
+
+        ref = self.Run(fdm, steps)
+        self.assertEqual(self.Run(copy, steps), ref)
+
+        # The copy remains valid once the original instance is deleted.
+        del fdm
+        copy2 = CreateFDM(self.sandbox)
+        self.assertTrue(copy2.load_model_from(copy))
+        copy2.load_script(script)
+        copy2.do_disable_output()
+        copy2.run_ic()
+        del copy
+        self.assertEqual(self.Run(copy2, steps), ref)
+        del copy2
+
+    def test_piston_engine(self):
+        self.CheckScript('c1723.xml', 1000)
+
+    def test_turbine_engines(self):
+        self.CheckScript('B737_Runway.xml', 1000)
+
+    def test_unloaded_model(self):
+        fdm = CreateFDM(self.sandbox)
+        copy = CreateFDM(self.sandbox)
+        self.assertFalse(copy.load_model_from(fdm))
+        del copy
+        del fdm
+
+suite = unittest.TestLoader().loadTestsFromTestCase(TestModelCopy)
+test_result = unittest.TextTestRunner(verbosity=2).run(suite)
+if test_result.failures or test_result.errors:
+    sys.exit(-1) # 'make test' will report the test failed.
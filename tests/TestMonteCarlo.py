@@ -0,0 +1,176 @@
+# TestMonteCarlo.py
+#
+# Check that the runs of a Monte Carlo campaign only depend on the seed of the
+# campaign and that each of them can be reproduced by a single instance.
+#
+# Copyright (c) 2016 JSBSim development team
+#
+# This program is free software; you can redistribute it and/or modify it under
+# the terms of the GNU General Public License as published by the Free Software
+# Foundation; either version 3 of the License, or (at your option) any later
+# version.
+#
+# This program is distributed in the hope that it will be useful, but WITHOUT
+# ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+# FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+# details.
+#
+# You should have received a copy of the GNU General Public License along with
+# this program; if not, see <http://www.gnu.org/licenses/>
+#
+
+import os, sys, csv, unittest
+import jsbsim
+from JSBSim_utils import CreateFDM, SandBox
+
+
+class TestMonteCarlo(unittest.TestCase):
+    script = 'c1721.xml'
+    dispersions = [('ic/psi-true-deg', 'gaussian', 10.0),
+                   ('ic/vc-kts', 'uniform', 5.0)]
+    summary = ['attitude/phi-deg', 'position/h-sl-ft', 'velocities/vc-kts']
+
+    def setUp(self):
+        os.environ['JSBSIM_DEBUG'] = str(0)
+        self.sandbox = SandBox()
+
+    def tearDown(self):
+        self.sandbox.erase()
+
+    def CreateCampaign(self, num_threads):
+        campaign = jsbsim.FGMonteCarlo(num_threads)
+        path = self.sandbox.path_to_jsbsim_file()
+        campaign.set_paths(os.path.join(self.sandbox(), ''),
+                           os.path.join(path, 'aircraft'),
+                           os.path.join(path, 'engine'),
+                           os.path.join(path, 'systems'))
+        return campaign
+
+    def RunCampaign(self, num_threads, runs, seed):
+        campaign = self.CreateCampaign(num_threads)
+        campaign.set_script(self.sandbox.path_to_jsbsim_file('scripts',
+                                                             self.script))
+        campaign.set_num_runs(runs)
+        campaign.set_seed(seed)
+        campaign.set_results_file(self.sandbox('results.csv'))
+        for prop, dispersion_type, dispersion in self.dispersions:
+            self.assertTrue(campaign.add_dispersion(prop, dispersion_type,
+                                                    dispersion))
+        for prop in self.summary:
+            campaign.add_summary(prop)
+
+        self.assertTrue(campaign.run())
+        self.assertEqual(campaign.get_num_failures(), 0)
+        return self.ReadResults()
+
+    def ReadResults(self):
+        with open(self.sandbox('results.csv')) as f:
+            rows = [row for row in csv.reader(f)]
+        return rows[0], rows[1:]
+
+    def test_results_file(self):
+        header, rows = self.RunCampaign(2, 5, 1)
+
+        columns = ['run', 'seed', 'status', 'sim-time-sec']
+        columns += [prop for prop, t, d in self.dispersions]
+        for prop in self.summary:
+            columns += [prop+'/min', prop+'/max', prop+'/mean', prop+'/final']
+        self.assertEqual(header, columns)
+
+        self.assertEqual(len(rows), 5)
+        for i, row in enumerate(rows):
+            self.assertEqual(len(row), len(columns))
+            self.assertEqual(int(row[0]), i)
+            self.assertEqual(int(row[2]), 0)
+            self.assertTrue(10.0 <= float(row[3]) < 10.1)
+            for j in range(len(self.summary)):
+                first = 4 + len(self.dispersions) + 4*j
+                vmin, vmax, mean, final = [float(x) for x in row[first:first+4]]
+                self.assertTrue(vmin <= mean <= vmax)
+                self.assertTrue(vmin <= final <= vmax)
+
+        # Each run draws its own dispersions.
+        for j in range(len(self.dispersions)):
+            values = set([row[4+j] for row in rows])
+            self.assertEqual(len(values), len(rows))
+
+    def test_independent_of_threads(self):
+        ref = self.RunCampaign(1, 6, 2)
+        self.assertEqual(self.RunCampaign(4, 6, 2), ref)
+        self.assertEqual(self.RunCampaign(3, 6, 2), ref)
+
+        # A shorter campaign starts with the same runs.
+        header, rows = self.RunCampaign(2, 3, 2)
+        self.assertEqual(rows, ref[1][:3])
+
+        # Another seed draws other dispersions.
+        header, rows = self.RunCampaign(2, 6, 3)
+        for row, ref_row in zip(rows, ref[1]):
+            self.assertNotEqual(row[4:6], ref_row[4:6])
+
+    def test_reproduce_run(self):
+        header, rows = self.RunCampaign(3, 4, 4)
+
+        for row in rows:
+            fdm = CreateFDM(self.sandbox)
+            fdm.load_script(self.sandbox.path_to_jsbsim_file('scripts',
+                                                             self.script))
+            fdm.do_disable_output()
+            for j, (prop, t, d) in enumerate(self.dispersions):
+                fdm.set_property_value(prop, float(row[4+j]))
+            fdm.set_property_value('simulation/randomseed', int(row[1]))
+            fdm.run_ic()
+
+            samples = [[fdm.get_property_value(p) for p in self.summary]]
+            while fdm.run():
+                samples.append([fdm.get_property_value(p) for p in self.summary])
+            samples.append([fdm.get_property_value(p) for p in self.summary])
+
+            stats = []
+            for j in range(len(self.summary)):
+                values = [s[j] for s in samples]
+                total = 0.0
+                for v in values:
+                    total += v
+                stats += [min(values), max(values), total / len(values),
+                          values[-1]]
+
+            self.assertEqual([float(x) for x in row[4+len(self.dispersions):]],
+                             stats)
+            self.assertEqual(float(row[3]), fdm.get_sim_time())
+            del fdm
+
+    def test_load_campaign(self):
+        script = self.sandbox.path_to_jsbsim_file('scripts', self.script)
+        with open(self.sandbox('campaign.xml'), 'w') as f:
+            f.write('<?xml version="1.0"?>\n')
+            f.write('<monte_carlo name="test" runs="3" seed="5">\n')
+            f.write('  <script file="%s"/>\n' % script)
+            f.write('  <results file="%s"/>\n' % self.sandbox('results.csv'))
+            f.write('  <dispersions>\n')
+            for prop, dispersion_type, dispersion in self.dispersions:
+                f.write('    <property type="%s" dispersion="%f"> %s </property>\n'
+                        % (dispersion_type, dispersion, prop))
+            f.write('  </dispersions>\n')
+            f.write('  <summary>\n')
+            for prop in self.summary:
+                f.write('    <property> %s </property>\n' % prop)
+            f.write('  </summary>\n')
+            f.write('</monte_carlo>\n')
+
+        campaign = self.CreateCampaign(2)
+        self.assertTrue(campaign.load('campaign.xml'))
+        self.assertEqual(campaign.get_num_runs(), 3)
+        self.assertEqual(campaign.get_seed(), 5)
+        self.assertTrue(campaign.run())
+
+        self.assertEqual(self.ReadResults(), self.RunCampaign(1, 3, 5))
+
+    def test_unknown_dispersion(self):
+        campaign = self.CreateCampaign(1)
+        self.assertFalse(campaign.add_dispersion('ic/vc-kts', 'poisson', 1.0))
+
+suite = unittest.TestLoader().loadTestsFromTestCase(TestMonteCarlo)
+test_result = unittest.TextTestRunner(verbosity=2).run(suite)
+if test_result.failures or test_result.errors:
+    sys.exit(-1)  # 'make test' will report the test failed.
@@ -0,0 +1,119 @@
+# TestMultiRate.py
+#
+# Check that the channels of a system are executed at the rate and with the
+# phase specified in the aircraft definition and that their components use a
+# time step scaled accordingly.
+#
+# Copyright (c) 2016 JSBSim development team
+#
+# This program is free software; you can redistribute it and/or modify it under
+# the terms of the GNU General Public License as published by the Free Software
+# Foundation; either version 3 of the License, or (at your option) any later
+# version.
+#
+# This program is distributed in the hope that it will be useful, but WITHOUT
+# ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+# FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+# details.
+#
+# You should have received a copy of the GNU General Public License along with
+# this program; if not, see <http://www.gnu.org/licenses/>
+#
+
+import sys, unittest
+import xml.etree.ElementTree as et
+from JSBSim_utils import CreateFDM, SandBox, CopyAircraftDef
+
+
+class TestMultiRate(unittest.TestCase):
+    def setUp(self):
+        self.sandbox = SandBox()
+
+    def tearDown(self):
+        self.sandbox.erase()
+
+    def AddCounter(self, channel, name):
+        # The function increments its own output each time it is executed.
+        counter = et.SubElement(channel, 'fcs_function')
+        counter.attrib['name'] = name
+        function = et.SubElement(counter, 'function')
+        total = et.SubElement(function, 'sum')
+        et.SubElement(total, 'property').text = name
+        et.SubElement(total, 'value').text = '1.0'
+
+    def AddSlowSystem(self, script_path):
+        tree, aircraft_name, b = CopyAircraftDef(script_path, self.sandbox)
+        system = et.SubElement(tree.getroot(), 'system')
+        system.attrib['name'] = 'slow'
+        system.attrib['rate'] = '10'
+        one = et.SubElement(system, 'property')
+        one.attrib['value'] = '1.0'
+        one.text = 'test/one'
+
+        channel = et.SubElement(system, 'channel')
+        channel.attrib['name'] = 'A'
+        self.AddCounter(channel, 'test/count-a')
+        integrator = et.SubElement(channel, 'integrator')
+        integrator.attrib['name'] = 'test/time-a'
+        et.SubElement(integrator, 'input').text = 'test/one'
+        et.SubElement(integrator, 'c1').text = '1.0'
+
+        channel = et.SubElement(system, 'channel')
+        channel.attrib['name'] = 'B'
+        self.AddCounter(channel, 'test/count-b')
+
+        channel = et.SubElement(system, 'channel')
+        channel.attrib['name'] = 'C'
+        channel.attrib['rate'] = '50'
+        channel.attrib['phase'] = '3'
+        self.AddCounter(channel, 'test/count-c')
+
+        tree.write(self.sandbox('aircraft', aircraft_name, aircraft_name+'.xml'))
+
+    def test_channel_rates(self):
+        script_path = self.sandbox.path_to_jsbsim_file('scripts',
+                                                       'ball_orbit.xml')
+        self.AddSlowSystem(script_path)
+
+        fdm = CreateFDM(self.sandbox)
+        fdm.set_aircraft_path('aircraft')
+        fdm.load_script(script_path)
+        dt = fdm.get_delta_t()
+        self.assertAlmostEqual(dt, 0.005)
+        fdm.run_ic()
+
+        # All the channels are executed when the simulation is initialized.
+        count = [fdm.get_property_value('test/count-'+c) for c in 'abc']
+        self.assertEqual(count, [1.0, 1.0, 1.0])
+
+        # run_ic() has executed the frames 1 and 2. A and B run every 20 frames
+        # (10 Hz) on different frames and C every 4 frames (50 Hz) with a delay
+        # of 3 frames.
+        frames = {'a': [], 'b': [], 'c': []}
+        time_a = []
+        for frame in xrange(3, 83):
+            fdm.run()
+            for c in 'abc':
+                value = fdm.get_property_value('test/count-'+c)
+                if value != count['abc'.index(c)]:
+                    self.assertEqual(value, count['abc'.index(c)]+1.0)
+                    count['abc'.index(c)] = value
+                    frames[c].append(frame)
+            if frames['a'] and frames['a'][-1] == frame:
+                time_a.append(fdm.get_property_value('test/time-a'))
+
+        self.assertEqual(frames['a'], [21, 41, 61, 81])
+        self.assertEqual(frames['b'], [22, 42, 62, 82])
+        self.assertEqual(frames['c'], [8, 12, 16, 20, 24, 28, 32, 36, 40, 44,
+                                       48, 52, 56, 60, 64, 68, 72, 76, 80])
+
+        # The integrator uses the time step of its channel.
+        for i in xrange(1, len(time_a)):
+            self.assertAlmostEqual(time_a[i]-time_a[i-1], 20*dt)
+
+        del fdm
+
+suite = unittest.TestLoader().loadTestsFromTestCase(TestMultiRate)
+test_result = unittest.TextTestRunner(verbosity=2).run(suite)
+if test_result.failures or test_result.errors:
+    sys.exit(-1) # 'make test' will report the test failed.
@@ -0,0 +1,84 @@
+# TestMultistageIntegrators.py
+#
+# Check that the multistage integrators (Runge-Kutta 4 and Dormand-Prince)
+# give accurate orbits with time steps much larger than the single stage
+# integrators need.
+#
+# Copyright (c) 2016 JSBSim development team
+#
+# This program is free software; you can redistribute it and/or modify it under
+# the terms of the GNU General Public License as published by the Free Software
+# Foundation; either version 3 of the License, or (at your option) any later
+# version.
+#
+# This program is distributed in the hope that it will be useful, but WITHOUT
+# ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+# FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+# details.
+#
+# You should have received a copy of the GNU General Public License along with
+# this program; if not, see <http://www.gnu.org/licenses/>
+#
+
+import sys, unittest
+from JSBSim_utils import CreateFDM, SandBox
+
+
+class TestMultistageIntegrators(unittest.TestCase):
+    def setUp(self):
+        self.sandbox = SandBox()
+
+    def tearDown(self):
+        self.sandbox.erase()
+
+    def RunOrbit(self, dt, method, substeps=1, tolerance=1E-9,
+                 end_time=1800.0):
+        fdm = CreateFDM(self.sandbox)
+        fdm.load_script(self.sandbox.path_to_jsbsim_file('scripts',
+                                                         'ball_orbit.xml'),
+                        dt)
+        fdm.set_property_value('simulation/integrator/method', method)
+        fdm.set_property_value('simulation/integrator/substeps', substeps)
+        fdm.set_property_value('simulation/integrator/tolerance', tolerance)
+        fdm.run_ic()
+
+        while fdm.get_sim_time() < end_time - 0.5*dt:
+            fdm.run()
+
+        result = [fdm.get_property_value('position/long-gc-deg'),
+                  fdm.get_property_value('position/radius-to-vehicle-ft'),
+                  fdm.get_property_value('velocities/eci-velocity-mag-fps')]
+        del fdm
+        return result
+
+    def CheckOrbit(self, result, ref, tolerance):
+        # Longitude (deg), radius (ft) and velocity (ft/s)
+        self.assertAlmostEqual(result[0], ref[0], delta=tolerance*1E-6)
+        self.assertAlmostEqual(result[1], ref[1], delta=tolerance*0.1)
+        self.assertAlmostEqual(result[2], ref[2], delta=tolerance*1E-4)
+
+    def test_runge_kutta4(self):
+        ref = self.RunOrbit(0.1, 1)
+        self.CheckOrbit(self.RunOrbit(1.0, 1), ref, 1.0)
+        # The substeps give the same result as the equivalent time step
+        self.CheckOrbit(self.RunOrbit(1.0, 1, 10), ref, 0.01)
+
+        # The Adams-Bashforth integrators are much less accurate with the
+        # same time step.
+        result = self.RunOrbit(1.0, 0)
+        self.assertTrue(abs(result[0]-ref[0]) > 1E-5)
+
+    def test_dormand_prince(self):
+        ref = self.RunOrbit(0.1, 1)
+        self.CheckOrbit(self.RunOrbit(10.0, 2), ref, 1.0)
+        fine = self.RunOrbit(60.0, 2, tolerance=1E-12)
+        self.CheckOrbit(fine, ref, 1.0)
+
+        # The accuracy is driven by the tolerance, not by the time step
+        coarse = self.RunOrbit(60.0, 2, tolerance=1E-6)
+        self.assertTrue(abs(coarse[0]-ref[0]) > 100.*abs(fine[0]-ref[0]))
+
+suite = unittest.TestLoader().loadTestsFromTestCase(TestMultistageIntegrators)
+test_result = unittest.TextTestRunner(verbosity=2).run(suite)
+if test_result.failures or test_result.errors:
+    sys.exit(-1) # 'make test' will report the test failed.
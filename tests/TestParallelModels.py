@@ -0,0 +1,82 @@
+# TestParallelModels.py
+#
+# Check that the models executed concurrently (see the property
+# simulation/parallel-models) give exactly the same results as the sequential
+# execution.
+#
+# Copyright (c) 2016 JSBSim development team
+#
+# This program is free software; you can redistribute it and/or modify it under
+# the terms of the GNU General Public License as published by the Free Software
+# Foundation; either version 3 of the License, or (at your option) any later
+# version.
+#
+# This program is distributed in the hope that it will be useful, but WITHOUT
+# ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+# FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+# details.
+#
+# You should have received a copy of the GNU General Public License along with
+# this program; if not, see <http://www.gnu.org/licenses/>
+#
+
+import sys, unittest
+from JSBSim_utils import CreateFDM, SandBox
+
+
+class TestParallelModels(unittest.TestCase):
+    properties = ['position/h-sl-ft', 'position/lat-gc-rad',
+                  'position/long-gc-rad', 'velocities/u-fps',
+                  'velocities/v-fps', 'velocities/w-fps', 'attitude/phi-rad',
+                  'attitude/theta-rad', 'attitude/psi-rad',
+                  'forces/fbx-total-lbs', 'forces/fbz-total-lbs',
+                  'moments/m-total-lbsft']
+
+    def setUp(self):
+        self.sandbox = SandBox()
+
+    def tearDown(self):
+        self.sandbox.erase()
+
+    def RunScript(self, script_name, nthreads, before_load):
+        fdm = CreateFDM(self.sandbox)
+        if before_load:
+            fdm.set_property_value('simulation/parallel-models', nthreads)
+        fdm.load_script(self.sandbox.path_to_jsbsim_file('scripts',
+                                                         script_name))
+        if not before_load:
+            fdm.set_property_value('simulation/parallel-models', nthreads)
+        fdm.run_ic()
+
+        values = []
+        for i in xrange(2000):
+            if not fdm.run():
+                break
+            if i % 100 == 0:
+                values.append([fdm.get_property_value(p)
+                               for p in self.properties])
+
+        del fdm
+        return values
+
+    def CheckScript(self, script_name):
+        ref = self.RunScript(script_name, 1, True)
+        for before_load in (True, False):
+            values = self.RunScript(script_name, 3, before_load)
+            self.assertEqual(len(values), len(ref))
+            for v, r in zip(values, ref):
+                self.assertEqual(v, r)
+
+    def test_c172(self):
+        self.CheckScript('c1723.xml')
+
+    def test_737(self):
+        self.CheckScript('737_cruise.xml')
+
+    def test_helicopter(self):
+        self.CheckScript('ah1s_flight_test.xml')
+
+suite = unittest.TestLoader().loadTestsFromTestCase(TestParallelModels)
+test_result = unittest.TextTestRunner(verbosity=2).run(suite)
+if test_result.failures or test_result.errors:
+    sys.exit(-1) # 'make test' will report the test failed.
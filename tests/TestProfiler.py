@@ -0,0 +1,105 @@
+# TestProfiler.py
+#
+# Check the statistics published by the frame profiler under profiling/ and
+# that the profiling can be enabled and disabled while the simulation runs.
+#
+# Copyright (c) 2016 JSBSim development team
+#
+# This program is free software; you can redistribute it and/or modify it under
+# the terms of the GNU General Public License as published by the Free Software
+# Foundation; either version 3 of the License, or (at your option) any later
+# version.
+#
+# This program is distributed in the hope that it will be useful, but WITHOUT
+# ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+# FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+# details.
+#
+# You should have received a copy of the GNU General Public License along with
+# this program; if not, see <http://www.gnu.org/licenses/>
+#
+
+import os, sys, unittest
+from JSBSim_utils import CreateFDM, SandBox
+
+
+class TestProfiler(unittest.TestCase):
+    sections = ['frame', 'models/propagate', 'models/propagate/load-inputs',
+                'models/fcs', 'models/ground-reactions',
+                'propulsion/engine[0]', 'fcs/pitch',
+                'fcs/pitch/fcs/elevator-actuator']
+
+    def setUp(self):
+        os.environ['JSBSIM_DEBUG'] = str(0)
+        self.sandbox = SandBox()
+
+    def tearDown(self):
+        self.sandbox.erase()
+
+    def CreateFDM(self, parallel_models=1):
+        fdm = CreateFDM(self.sandbox)
+        fdm.load_script(self.sandbox.path_to_jsbsim_file('scripts',
+                                                         'c1723.xml'))
+        fdm.do_disable_output()
+        fdm.set_property_value('simulation/parallel-models', parallel_models)
+        fdm.run_ic()
+        return fdm
+
+    def CheckSections(self, fdm, frames):
+        for section in self.sections:
+            path = 'profiling/' + section + '/'
+            self.assertEqual(fdm.get_property_value(path+'count'), frames)
+            vmin = fdm.get_property_value(path+'min-us')
+            mean = fdm.get_property_value(path+'mean-us')
+            vmax = fdm.get_property_value(path+'max-us')
+            p99 = fdm.get_property_value(path+'p99-us')
+            self.assertTrue(0.0 < vmin <= mean <= vmax)
+            self.assertTrue(vmin <= p99 <= vmax)
+
+        # The frame includes the time spent in the models.
+        self.assertTrue(fdm.get_property_value('profiling/frame/mean-us') >
+                        fdm.get_property_value('profiling/models/fcs/mean-us'))
+
+    def test_statistics(self):
+        fdm = self.CreateFDM()
+        self.assertEqual(fdm.get_property_value('profiling/enabled'), 0.0)
+
+        fdm.set_property_value('profiling/enabled', 1.0)
+        self.assertEqual(fdm.get_property_value('profiling/enabled'), 1.0)
+        for i in range(100):
+            fdm.run()
+
+        self.CheckSections(fdm, 100)
+
+    def test_parallel_models(self):
+        fdm = self.CreateFDM(3)
+        fdm.set_property_value('profiling/enabled', 1.0)
+        for i in range(100):
+            fdm.run()
+
+        self.CheckSections(fdm, 100)
+
+    def test_disable(self):
+        fdm = self.CreateFDM()
+        fdm.set_property_value('profiling/enabled', 1.0)
+        for i in range(10):
+            fdm.run()
+
+        fdm.set_property_value('profiling/enabled', 0.0)
+        self.assertEqual(fdm.get_property_value('profiling/enabled'), 0.0)
+        for i in range(10):
+            fdm.run()
+
+        # The statistics are no longer updated.
+        self.assertEqual(fdm.get_property_value('profiling/frame/count'), 10)
+
+        # Enabling the profiling again starts new statistics.
+        fdm.set_property_value('profiling/enabled', 1.0)
+        for i in range(5):
+            fdm.run()
+        self.CheckSections(fdm, 5)
+
+suite = unittest.TestLoader().loadTestsFromTestCase(TestProfiler)
+test_result = unittest.TextTestRunner(verbosity=2).run(suite)
+if test_result.failures or test_result.errors:
+    sys.exit(-1)  # 'make test' will report the test failed.
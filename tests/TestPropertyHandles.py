@@ -0,0 +1,88 @@
+# TestPropertyHandles.py
+#
+# Check that the property handles give access to the same values as the
+# properties names.
+#
+# Copyright (c) 2016 JSBSim development team
+#
+# This program is free software; you can redistribute it and/or modify it under
+# the terms of the GNU General Public License as published by the Free Software
+# Foundation; either version 3 of the License, or (at your option) any later
+# version.
+#
+# This program is distributed in the hope that it will be useful, but WITHOUT
+# ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+# FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+# details.
+#
+# You should have received a copy of the GNU General Public License along with
+# this program; if not, see <http://www.gnu.org/licenses/>
+#
+
+import sys, unittest, array, math
+from JSBSim_utils import CreateFDM, SandBox
+
+
+class TestPropertyHandles(unittest.TestCase):
+    def setUp(self):
+        self.sandbox = SandBox()
+        self.fdm = CreateFDM(self.sandbox)
+        self.fdm.load_script(self.sandbox.path_to_jsbsim_file('scripts',
+                                                              'c1723.xml'))
+        self.fdm.run_ic()
+
+    def tearDown(self):
+        del self.fdm
+        self.sandbox.erase()
+
+    def checkValues(self, names, values):
+        for name, value in zip(names, values):
+            ref = self.fdm.get_property_value(name)
+            if math.isnan(ref):
+                self.assertTrue(math.isnan(value), msg=name)
+            else:
+                self.assertEqual(value, ref, msg=name)
+
+    def test_get_values(self):
+        catalog = self.fdm.query_property_catalog('/')
+        names = [line.split(' ')[0] for line in catalog if line]
+        handles = self.fdm.get_property_handles(names)
+        self.assertEqual(len(handles), len(names))
+
+        values = array.array('d', [0.0]) * len(names)
+        for i in range(100):
+            self.fdm.run()
+            self.assertTrue(handles.get_values(values) is values)
+            self.checkValues(names, values)
+
+        self.checkValues(names, handles.get_values())
+
+    def test_set_values(self):
+        names = ['fcs/throttle-cmd-norm', 'fcs/mixture-cmd-norm',
+                 'fcs/aileron-cmd-norm', 'fcs/elevator-cmd-norm']
+        handles = self.fdm.get_property_handles(names)
+        values = array.array('d', [0.25, 0.75, 0.5, -0.125])
+        handles.set_values(values)
+        self.checkValues(names, values)
+
+        self.fdm.run()
+        self.assertEqual(self.fdm.get_property_value('fcs/throttle-cmd-norm'),
+                         0.25)
+
+    def test_errors(self):
+        with self.assertRaises(KeyError):
+            self.fdm.get_property_handles(['velocities/vc-kts', 'foo/bar'])
+
+        handles = self.fdm.get_property_handles(['velocities/vc-kts',
+                                                 'position/h-sl-ft'])
+        with self.assertRaises(ValueError):
+            handles.get_values(array.array('d', [0.0]))
+        with self.assertRaises(ValueError):
+            handles.set_values(array.array('d', [0.0]))
+
+        self.assertEqual(len(self.fdm.get_property_handles([]).get_values()), 0)
+
+suite = unittest.TestLoader().loadTestsFromTestCase(TestPropertyHandles)
+test_result = unittest.TextTestRunner(verbosity=2).run(suite)
+if test_result.failures or test_result.errors:
+    sys.exit(-1)  # 'make test' will report the test failed.
@@ -0,0 +1,105 @@
+# TestPropertyIndex.py
+#
+# Check that the lookups of the children of a property node return the same
+# node whether the children are indexed (16 children or more) or searched
+# linearly, as children are added and removed.
+#
+# Copyright (c) 2016 JSBSim development team
+#
+# This program is free software; you can redistribute it and/or modify it under
+# the terms of the GNU General Public License as published by the Free Software
+# Foundation; either version 3 of the License, or (at your option) any later
+# version.
+#
+# This program is distributed in the hope that it will be useful, but WITHOUT
+# ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+# FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+# details.
+#
+# You should have received a copy of the GNU General Public License along with
+# this program; if not, see <http://www.gnu.org/licenses/>
+#
+
+import sys, unittest
+from JSBSim_utils import CreateFDM, SandBox
+
+
+class TestPropertyIndex(unittest.TestCase):
+    def setUp(self):
+        self.sandbox = SandBox()
+        self.fdm = CreateFDM(self.sandbox)
+        self.root = self.fdm.get_property_node('test')
+
+    def tearDown(self):
+        del self.fdm
+        self.sandbox.erase()
+
+    # The lookups must return the first child, in the order of the list of
+    # the children, that has the requested name and index.
+    def CheckLookups(self, node):
+        first = {}
+        for pos in range(node.n_children()):
+            child = node.get_child_at(pos)
+            key = (child.get_name(), child.get_index())
+            if key not in first:
+                first[key] = child
+
+        for (name, index), child in first.items():
+            self.assertEqual(node.get_child(name, index), child,
+                             msg='{0}[{1}]'.format(name, index))
+
+        return first
+
+    def test_index(self):
+        root = self.root
+        self.assertEqual(len(root.add_children('a', 20)), 20)
+        root.add_children('b', 4)
+        for i, child in enumerate([root.get_child_at(pos)
+                                   for pos in range(root.n_children())]):
+            child.set_double_value(i)
+        self.CheckLookups(root)
+        self.assertEqual(root.get_child('a', 20), None)
+        self.assertEqual(root.get_child('c', 0), None)
+
+        # addChildren() without append does not skip the indices that are
+        # already used, so a[5] to a[7] are duplicated.
+        dups = root.add_children('a', 3, 5, False)
+        self.assertEqual([c.get_index() for c in dups], [5, 6, 7])
+        for c in dups:
+            c.set_double_value(100 + c.get_index())
+        self.assertEqual(root.get_child('a', 5).get_double_value(), 5.0)
+        self.CheckLookups(root)
+
+        # Once the first of the duplicates is removed, the lookup returns the
+        # next one.
+        first = root.get_child('a', 5)
+        self.assertEqual(root.remove_child('a', 5), first)
+        self.assertEqual(root.get_child('a', 5), dups[0])
+        self.assertEqual(root.get_child('a', 5).get_double_value(), 105.0)
+        self.assertEqual(root.remove_child('a', 5), dups[0])
+        self.assertEqual(root.get_child('a', 5), None)
+        self.assertEqual(root.remove_child('a', 5), None)
+        self.CheckLookups(root)
+
+        # Remove the children one by one until the index is dropped.
+        for index in range(19, -1, -1):
+            root.remove_child('a', index)
+            self.assertEqual(root.get_child('a', index), dups[1]
+                             if index == 6 else dups[2] if index == 7 else None)
+            self.CheckLookups(root)
+
+        self.assertEqual([c.get_index() for c in root.remove_children('a')],
+                         [6, 7])
+        self.assertEqual(sorted(self.CheckLookups(root).keys()),
+                         [('b', i) for i in range(4)])
+
+        # The index is built again when the node grows.
+        root.add_children('a', 16)
+        self.CheckLookups(root)
+        self.assertEqual(len(root.remove_children('a')), 16)
+        self.assertEqual(root.get_child('a', 0), None)
+
+suite = unittest.TestLoader().loadTestsFromTestCase(TestPropertyIndex)
+test_result = unittest.TextTestRunner(verbosity=2).run(suite)
+if test_result.failures or test_result.errors:
+    sys.exit(-1)  # 'make test' will report the test failed.
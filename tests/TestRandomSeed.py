@@ -0,0 +1,102 @@
+# TestRandomSeed.py
+#
+# Check that the random numbers of an FDM instance are reproduced from its
+# seed and do not depend on the other instances.
+#
+# Copyright (c) 2016 JSBSim development team
+#
+# This program is free software; you can redistribute it and/or modify it under
+# the terms of the GNU General Public License as published by the Free Software
+# Foundation; either version 3 of the License, or (at your option) any later
+# version.
+#
+# This program is distributed in the hope that it will be useful, but WITHOUT
+# ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+# FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+# details.
+#
+# You should have received a copy of the GNU General Public License along with
+# this program; if not, see <http://www.gnu.org/licenses/>
+#
+
+import os, sys, unittest
+from JSBSim_utils import CreateFDM, SandBox
+
+
+class TestRandomSeed(unittest.TestCase):
+    properties = ['atmosphere/turb-north-fps', 'atmosphere/turb-east-fps',
+                  'atmosphere/turb-down-fps', 'velocities/u-fps',
+                  'velocities/v-fps', 'velocities/w-fps']
+    steps = 500
+
+    def setUp(self):
+        os.environ['JSBSIM_DEBUG'] = str(0)
+        self.sandbox = SandBox()
+
+    def tearDown(self):
+        self.sandbox.erase()
+
+    def CreateTurbulentFDM(self, seed):
+        fdm = CreateFDM(self.sandbox)
+        fdm.set_property_value('simulation/randomseed', seed)
+        fdm.load_script(self.sandbox.path_to_jsbsim_file('scripts',
+                                                         'c1723.xml'))
+        fdm.do_disable_output()
+        fdm.set_property_value('atmosphere/turb-type', 3) # MIL-F-8785C
+        fdm.set_property_value('atmosphere/turbulence/milspec/windspeed_at_20ft_AGL-fps', 30.0)
+        fdm.set_property_value('atmosphere/turbulence/milspec/severity', 4)
+        fdm.run_ic()
+        return fdm
+
+    def Run(self, fdm):
+        history = []
+        for i in xrange(self.steps):
+            if not fdm.run():
+                break
+            history.append([fdm.get_property_value(p)
+                            for p in self.properties])
+        return history
+
+    def test_same_seed(self):
+        fdm = self.CreateTurbulentFDM(17)
+        ref = self.Run(fdm)
+        del fdm
+
+        fdm = self.CreateTurbulentFDM(17)
+        self.assertEqual(self.Run(fdm), ref)
+        del fdm
+
+    def test_different_seeds(self):
+        fdm = self.CreateTurbulentFDM(17)
+        ref = self.Run(fdm)
+        del fdm
+
+        fdm = self.CreateTurbulentFDM(42)
+        self.assertNotEqual(self.Run(fdm), ref)
+        del fdm
+
+    def test_interleaved_instances(self):
+        fdm = self.CreateTurbulentFDM(17)
+        ref = self.Run(fdm)
+        del fdm
+
+        # Another instance drawing random numbers in between the time steps
+        # must not alter the random numbers of the first instance.
+        fdm1 = self.CreateTurbulentFDM(17)
+        fdm2 = self.CreateTurbulentFDM(42)
+        history = []
+        for i in xrange(self.steps):
+            fdm2.run()
+            if not fdm1.run():
+                break
+            history.append([fdm1.get_property_value(p)
+                            for p in self.properties])
+
+        self.assertEqual(history, ref)
+        del fdm1
+        del fdm2
+
+suite = unittest.TestLoader().loadTestsFromTestCase(TestRandomSeed)
+test_result = unittest.TextTestRunner(verbosity=2).run(suite)
+if test_result.failures or test_result.errors:
+    sys.exit(-1) # 'make test' will report the test failed.
@@ -0,0 +1,164 @@
+# TestRealTimeScheduler.py
+#
+# Check the overrun policies of the real time scheduler (drop, catch-up and
+# slip) and the statistics it publishes under simulation/realtime/. The frames
+# are forced to overrun with a time step that is much shorter than the time
+# needed to run a frame.
+#
+# Copyright (c) 2016 JSBSim development team
+#
+# This program is free software; you can redistribute it and/or modify it under
+# the terms of the GNU General Public License as published by the Free Software
+# Foundation; either version 3 of the License, or (at your option) any later
+# version.
+#
+# This program is distributed in the hope that it will be useful, but WITHOUT
+# ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+# FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+# details.
+#
+# You should have received a copy of the GNU General Public License along with
+# this program; if not, see <http://www.gnu.org/licenses/>
+#
+
+import sys, unittest
+from JSBSim_utils import CreateFDM, SandBox
+from jsbsim import FGRealTimeScheduler
+
+# The values of simulation/realtime/overrun-policy
+eDrop, eCatchUp, eSlip = 0, 1, 2
+
+# A frame of the ball takes several microseconds so every frame overruns.
+TinyDt = 1E-7
+Runs = 20
+
+
+class TestRealTimeScheduler(unittest.TestCase):
+    def setUp(self):
+        self.sandbox = SandBox()
+
+    def tearDown(self):
+        self.sandbox.erase()
+
+    def CreateFDM(self, dt):
+        fdm = CreateFDM(self.sandbox)
+        fdm.load_script(self.sandbox.path_to_jsbsim_file('scripts', 'ball.xml'))
+        fdm.run_ic()
+        fdm.set_dt(dt)
+        return fdm
+
+    def Stat(self, fdm, name):
+        return fdm.get_property_value('simulation/realtime/'+name)
+
+    def RunScheduler(self, fdm, policy, catch_up=0):
+        scheduler = FGRealTimeScheduler(fdm)
+        fdm.set_property_value('simulation/realtime/overrun-policy', policy)
+        fdm.set_property_value('simulation/realtime/max-catch-up-frames',
+                               catch_up)
+        scheduler.start()
+        for i in range(Runs):
+            self.assertTrue(scheduler.run())
+        return scheduler
+
+    def CheckTimings(self, fdm):
+        self.assertGreater(self.Stat(fdm, 'frame-us'), 0.0)
+        self.assertGreaterEqual(self.Stat(fdm, 'frame-max-us'),
+                                self.Stat(fdm, 'frame-us'))
+        self.assertGreaterEqual(self.Stat(fdm, 'jitter-mean-us'), 0.0)
+        self.assertGreaterEqual(self.Stat(fdm, 'jitter-max-us'),
+                                self.Stat(fdm, 'jitter-mean-us'))
+        self.assertGreaterEqual(self.Stat(fdm, 'jitter-max-us'),
+                                self.Stat(fdm, 'jitter-us'))
+
+    def test_drop(self):
+        fdm = self.CreateFDM(TinyDt)
+        scheduler = self.RunScheduler(fdm, eDrop)
+
+        # The missed deadlines are skipped: one frame per call and the
+        # simulation falls behind the wall clock.
+        self.assertEqual(self.Stat(fdm, 'frames'), Runs)
+        self.assertEqual(self.Stat(fdm, 'overruns'), Runs)
+        self.assertEqual(self.Stat(fdm, 'catch-up-frames'), 0)
+        self.assertGreaterEqual(self.Stat(fdm, 'dropped-frames'), Runs)
+        self.assertGreater(self.Stat(fdm, 'lag-sec'), 0.0)
+        self.assertAlmostEqual(fdm.get_sim_time(), Runs*TinyDt, delta=1E-12)
+        self.CheckTimings(fdm)
+
+        del scheduler
+        del fdm
+
+    def test_catch_up(self):
+        fdm = self.CreateFDM(TinyDt)
+        scheduler = self.RunScheduler(fdm, eCatchUp, 3)
+        self.assertEqual(scheduler.get_max_catch_up_frames(), 3)
+
+        # Each overrun is followed by the maximum number of catch-up frames,
+        # which are not enough so the remaining deadlines are dropped.
+        self.assertEqual(self.Stat(fdm, 'frames'), Runs*4)
+        self.assertEqual(self.Stat(fdm, 'overruns'), Runs)
+        self.assertEqual(self.Stat(fdm, 'catch-up-frames'), Runs*3)
+        self.assertGreater(self.Stat(fdm, 'dropped-frames'), 0)
+        self.assertAlmostEqual(fdm.get_sim_time(), Runs*4*TinyDt, delta=1E-12)
+        self.CheckTimings(fdm)
+
+        del scheduler
+        del fdm
+
+    def test_slip(self):
+        fdm = self.CreateFDM(TinyDt)
+        scheduler = self.RunScheduler(fdm, eSlip)
+
+        # The schedule is moved to the end of the late frame: nothing is
+        # dropped nor caught up.
+        self.assertEqual(self.Stat(fdm, 'frames'), Runs)
+        self.assertEqual(self.Stat(fdm, 'overruns'), Runs)
+        self.assertEqual(self.Stat(fdm, 'catch-up-frames'), 0)
+        self.assertEqual(self.Stat(fdm, 'dropped-frames'), 0)
+        self.CheckTimings(fdm)
+
+        del scheduler
+        del fdm
+
+    def test_policy_property(self):
+        fdm = self.CreateFDM(TinyDt)
+        scheduler = FGRealTimeScheduler(fdm)
+        self.assertEqual(self.Stat(fdm, 'overrun-policy'), eCatchUp)
+        fdm.set_property_value('simulation/realtime/overrun-policy', eSlip)
+        self.assertEqual(self.Stat(fdm, 'overrun-policy'), eSlip)
+
+        # Unknown policies are rejected.
+        fdm.set_property_value('simulation/realtime/overrun-policy', 3)
+        self.assertEqual(self.Stat(fdm, 'overrun-policy'), eSlip)
+
+        # Negative numbers of catch-up frames are clamped to 0.
+        scheduler.set_max_catch_up_frames(-1)
+        self.assertEqual(self.Stat(fdm, 'max-catch-up-frames'), 0)
+
+        del scheduler
+        del fdm
+
+    def test_on_time(self):
+        dt = 0.02
+        fdm = self.CreateFDM(dt)
+        scheduler = self.RunScheduler(fdm, eDrop)
+
+        # The scheduler waits for each deadline so the frames are paced by the
+        # wall clock.
+        self.assertEqual(self.Stat(fdm, 'frames'), Runs)
+        self.assertGreaterEqual(scheduler.get_elapsed_time(), (Runs-1)*dt)
+        self.assertAlmostEqual(fdm.get_sim_time(), Runs*dt, delta=1E-9)
+        self.assertEqual(self.Stat(fdm, 'catch-up-frames'), 0)
+
+        # The clock of the schedule is stopped while the scheduler is paused.
+        scheduler.pause()
+        elapsed = scheduler.get_elapsed_time()
+        self.assertEqual(scheduler.get_elapsed_time(), elapsed)
+        scheduler.resume()
+
+        del scheduler
+        del fdm
+
+suite = unittest.TestLoader().loadTestsFromTestCase(TestRealTimeScheduler)
+test_result = unittest.TextTestRunner(verbosity=2).run(suite)
+if test_result.failures or test_result.errors:
+    sys.exit(-1)  # 'make test' will report the test failed.
@@ -0,0 +1,105 @@
+# TestSnapshot.py
+#
+# Check that a simulation restored from a snapshot continues exactly as it
+# would have from the time the snapshot was saved.
+#
+# Copyright (c) 2016 JSBSim development team
+#
+# This program is free software; you can redistribute it and/or modify it under
+# the terms of the GNU General Public License as published by the Free Software
+# Foundation; either version 3 of the License, or (at your option) any later
+# version.
+#
+# This program is distributed in the hope that it will be useful, but WITHOUT
+# ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+# FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+# details.
+#
+# You should have received a copy of the GNU General Public License along with
+# this program; if not, see <http://www.gnu.org/licenses/>
+#
+
+import os, sys, unittest
+from JSBSim_utils import CreateFDM, SandBox
+import jsbsim
+
+
+class TestSnapshot(unittest.TestCase):
+    properties = ['atmosphere/turb-north-fps', 'atmosphere/turb-east-fps',
+                  'atmosphere/turb-down-fps', 'velocities/u-fps',
+                  'velocities/v-fps', 'velocities/w-fps',
+                  'position/h-sl-ft', 'propulsion/engine/thrust-lbs',
+                  'fcs/elevator-pos-rad', 'simulation/sim-time-sec']
+
+    def setUp(self):
+        os.environ['JSBSIM_DEBUG'] = str(0)
+        self.sandbox = SandBox()
+
+    def tearDown(self):
+        self.sandbox.erase()
+
+    def CreateTurbulentFDM(self):
+        fdm = CreateFDM(self.sandbox)
+        fdm.load_script(self.sandbox.path_to_jsbsim_file('scripts',
+                                                         'c1723.xml'))
+        fdm.do_disable_output()
+        fdm.set_property_value('atmosphere/turb-type', 3) # MIL-F-8785C
+        fdm.set_property_value('atmosphere/turbulence/milspec/windspeed_at_20ft_AGL-fps', 30.0)
+        fdm.set_property_value('atmosphere/turbulence/milspec/severity', 4)
+        fdm.run_ic()
+        return fdm
+
+    def Run(self, fdm, steps):
+        history = []
+        for i in xrange(steps):
+            if not fdm.run():
+                break
+            history.append([fdm.get_property_value(p)
+                            for p in self.properties])
+        return history
+
+    def test_restore_same_instance(self):
+        fdm = self.CreateTurbulentFDM()
+        self.Run(fdm, 200)
+
+        snapshot = jsbsim.FGSnapshot()
+        self.assertTrue(snapshot.is_empty())
+        fdm.save_state(snapshot)
+        self.assertFalse(snapshot.is_empty())
+        ref = self.Run(fdm, 500)
+
+        # The snapshot can be restored several times.
+        for i in xrange(3):
+            self.assertTrue(fdm.restore_state(snapshot))
+            self.assertEqual(self.Run(fdm, 500), ref)
+
+        del fdm
+
+    def test_restore_other_instance(self):
+        fdm = self.CreateTurbulentFDM()
+        self.Run(fdm, 200)
+        snapshot = jsbsim.FGSnapshot()
+        fdm.save_state(snapshot)
+        ref = self.Run(fdm, 500)
+        del fdm
+
+        fdm = self.CreateTurbulentFDM()
+        self.assertTrue(fdm.restore_state(snapshot))
+        self.assertEqual(self.Run(fdm, 500), ref)
+        del fdm
+
+    def test_model_mismatch(self):
+        fdm = self.CreateTurbulentFDM()
+        snapshot = jsbsim.FGSnapshot()
+        fdm.save_state(snapshot)
+        del fdm
+
+        fdm = CreateFDM(self.sandbox)
+        fdm.load_model('ball')
+        self.assertFalse(fdm.restore_state(snapshot))
+        del fdm
+
+suite = unittest.TestLoader().loadTestsFromTestCase(TestSnapshot)
+test_result = unittest.TextTestRunner(verbosity=2).run(suite)
+if test_result.failures or test_result.errors:
+    sys.exit(-1) # 'make test' will report the test failed.
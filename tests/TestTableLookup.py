@@ -0,0 +1,149 @@
+# TestTableLookup.py
+#
+# Check that the batch lookups of a table (FGTable::GetValues) return the same
+# values than the lookups of the keys one at a time (FGTable::GetValue) for 1D,
+# 2D and 3D tables, including the keys that are out of the range of the table.
+#
+# Copyright (c) 2016 JSBSim development team
+#
+# This program is free software; you can redistribute it and/or modify it under
+# the terms of the GNU General Public License as published by the Free Software
+# Foundation; either version 3 of the License, or (at your option) any later
+# version.
+#
+# This program is distributed in the hope that it will be useful, but WITHOUT
+# ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+# FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+# details.
+#
+# You should have received a copy of the GNU General Public License along with
+# this program; if not, see <http://www.gnu.org/licenses/>
+#
+
+import random, sys, unittest
+import jsbsim
+from JSBSim_utils import CreateFDM, SandBox
+
+Table1D = """<?xml version="1.0"?>
+<table>
+  <independentVar>test/row</independentVar>
+  <tableData>
+    -10.0  -0.5
+     -2.0   0.1
+      0.0   0.3
+      4.0   1.2
+     12.0   0.8
+     20.0   0.8
+     30.0  -0.2
+  </tableData>
+</table>
+"""
+
+Table2D = """<?xml version="1.0"?>
+<table>
+  <independentVar lookup="row">test/row</independentVar>
+  <independentVar lookup="column">test/column</independentVar>
+  <tableData>
+             -1.0   0.0   2.0   5.0
+    -10.0    -0.5  -0.4   0.2   0.9
+     -2.0     0.1   0.0  -0.3   0.4
+      0.0     0.3   0.5   0.7   1.1
+      4.0     1.2   1.0   0.6   0.2
+     12.0     0.8   0.9   1.5   2.0
+  </tableData>
+</table>
+"""
+
+Table3D = """<?xml version="1.0"?>
+<table>
+  <independentVar lookup="row">test/row</independentVar>
+  <independentVar lookup="column">test/column</independentVar>
+  <independentVar lookup="table">test/table</independentVar>
+  <tableData breakPoint="-3.0">
+             -1.0   0.0   2.0
+    -10.0    -0.5  -0.4   0.2
+      0.0     0.3   0.5   0.7
+     12.0     0.8   0.9   1.5
+  </tableData>
+  <tableData breakPoint="1.0">
+             -1.0   0.0   2.0
+    -10.0     0.5   0.4  -0.2
+      0.0    -0.3   0.1   0.9
+     12.0     1.8   1.9  -1.5
+  </tableData>
+  <tableData breakPoint="4.0">
+             -1.0   0.0   2.0
+    -10.0     1.5   1.4   1.2
+      0.0     0.0   0.0   0.0
+     12.0     0.2   0.3   0.4
+  </tableData>
+</table>
+"""
+
+
+class TestTableLookup(unittest.TestCase):
+    def setUp(self):
+        self.sandbox = SandBox()
+        self.fdm = CreateFDM(self.sandbox)
+        for name in ('row', 'column', 'table'):
+            self.fdm.set_property_value('test/'+name, 0.0)
+        random.seed(0)
+
+    def tearDown(self):
+        del self.fdm
+        self.sandbox.erase()
+
+    def LoadTable(self, content):
+        filename = self.sandbox('table.xml')
+        f = open(filename, 'w')
+        f.write(content)
+        f.close()
+        return jsbsim.FGTable(self.fdm, filename)
+
+    # Random keys that are out of the range [xmin, xmax] of the table for
+    # about 20% of them, in a random order so that the row index cached by the
+    # table is moved back and forth. The breakpoints are also included.
+    def Keys(self, xmin, xmax, breakpoints, n=500):
+        margin = 0.1*(xmax-xmin)
+        keys = [random.uniform(xmin-margin, xmax+margin) for i in range(n)]
+        keys += breakpoints + [xmin-1E6, xmax+1E6]
+        random.shuffle(keys)
+        return keys
+
+    def CheckValues(self, table, *keys):
+        values = table.get_values(*keys)
+        self.assertEqual(len(values), len(keys[0]))
+        for i, v in enumerate(values):
+            expected = table.get_value(*[k[i] for k in keys])
+            self.assertAlmostEqual(v, expected, delta=1E-12,
+                                   msg='keys={0}'.format([k[i] for k in keys]))
+
+    def test_1D(self):
+        table = self.LoadTable(Table1D)
+        rows = [-10.0, -2.0, 0.0, 4.0, 12.0, 20.0, 30.0]
+        self.CheckValues(table, self.Keys(-10.0, 30.0, rows))
+        # Sorted keys are the common case of the batch lookups.
+        self.CheckValues(table, sorted(self.Keys(-10.0, 30.0, rows)))
+        self.CheckValues(table, [])
+
+    def test_2D(self):
+        table = self.LoadTable(Table2D)
+        rows = [-10.0, -2.0, 0.0, 4.0, 12.0]
+        cols = [-1.0, 0.0, 2.0, 5.0]
+        n = len(rows) + 500 + 2
+        self.CheckValues(table, self.Keys(-10.0, 12.0, rows),
+                         self.Keys(-1.0, 5.0, cols, n-len(cols)-2))
+
+    def test_3D(self):
+        table = self.LoadTable(Table3D)
+        rows = [-10.0, 0.0, 12.0]
+        cols = [-1.0, 0.0, 2.0]
+        breakpoints = [-3.0, 1.0, 4.0]
+        self.CheckValues(table, self.Keys(-10.0, 12.0, rows),
+                         self.Keys(-1.0, 2.0, cols),
+                         self.Keys(-3.0, 4.0, breakpoints))
+
+suite = unittest.TestLoader().loadTestsFromTestCase(TestTableLookup)
+test_result = unittest.TextTestRunner(verbosity=2).run(suite)
+if test_result.failures or test_result.errors:
+    sys.exit(-1)  # 'make test' will report the test failed.
@@ -0,0 +1,152 @@
+# TestWindField.py
+#
+# Check the interpolation of a wind field gridded in latitude, longitude,
+# altitude and time, and its effect on the total wind and the temperature.
+#
+# Copyright (c) 2016 JSBSim development team
+#
+# This program is free software; you can redistribute it and/or modify it under
+# the terms of the GNU General Public License as published by the Free Software
+# Foundation; either version 3 of the License, or (at your option) any later
+# version.
+#
+# This program is distributed in the hope that it will be useful, but WITHOUT
+# ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+# FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+# details.
+#
+# You should have received a copy of the GNU General Public License along with
+# this program; if not, see <http://www.gnu.org/licenses/>
+#
+
+import struct, sys, unittest
+from JSBSim_utils import CreateFDM, SandBox
+
+
+# The wind and the temperature are linear in altitude and time so that they
+# are exactly interpolated.
+def WindNorth(h, t):
+    return h/1000. + t/10.
+
+
+def Temperature(h):
+    return 520. - 0.002*h
+
+
+class TestWindField(unittest.TestCase):
+    def setUp(self):
+        self.sandbox = SandBox()
+        self.filename = self.sandbox('wind.bin')
+        # Latitude, longitude (periodic), altitude and time axes.
+        counts = [3, 3, 3, 2]
+        axes = [-90., 90., 0., 120., 0., 10000., 0., 100.]
+        values = []
+        for t in range(counts[3]):
+            for h in range(counts[2]):
+                for lat in range(counts[0]):
+                    for lon in range(counts[1]):
+                        alt = h*axes[5]
+                        time = t*axes[7]
+                        values += [WindNorth(alt, time), -5.0, 1.0,
+                                   Temperature(alt)]
+
+        f = open(self.filename, 'wb')
+        f.write(struct.pack('=8sII4I8d', *([b'JSBWIND\0', 1, 4]
+                                           + counts + axes)))
+        f.write(struct.pack('=%df' % len(values), *values))
+        f.close()
+
+    def tearDown(self):
+        self.sandbox.erase()
+
+    def CreateFDM(self):
+        fdm = CreateFDM(self.sandbox)
+        fdm.load_script(self.sandbox.path_to_jsbsim_file('scripts',
+                                                         'c172_cruise_8K.xml'))
+        fdm.load_wind_field(self.filename)
+        fdm.run_ic()
+        return fdm
+
+    def CheckField(self, fdm, offset=0.0):
+        h = fdm.get_property_value('position/h-sl-ft')
+        t = fdm.get_property_value('simulation/sim-time-sec') + offset
+        wn = fdm.get_property_value('atmosphere/wind-field/wind-north-fps')
+        self.assertAlmostEqual(wn, WindNorth(h, t), delta=1E-2)
+        self.assertAlmostEqual(fdm.get_property_value('atmosphere/wind-field/wind-east-fps'),
+                               -5.0, delta=1E-6)
+        self.assertAlmostEqual(fdm.get_property_value('atmosphere/wind-field/wind-down-fps'),
+                               1.0, delta=1E-6)
+        self.assertAlmostEqual(fdm.get_property_value('atmosphere/total-wind-north-fps'),
+                               wn, delta=1E-6)
+        self.assertAlmostEqual(fdm.get_property_value('atmosphere/wind-field/temperature-R'),
+                               Temperature(h), delta=1E-2)
+        self.assertAlmostEqual(fdm.get_property_value('atmosphere/T-R'),
+                               Temperature(h), delta=1E-2)
+
+    def test_interpolation(self):
+        fdm = self.CreateFDM()
+        self.CheckField(fdm)
+
+        while fdm.get_property_value('simulation/sim-time-sec') < 10.0:
+            fdm.run()
+            self.CheckField(fdm)
+
+    def test_time_offset(self):
+        fdm = self.CreateFDM()
+        fdm.set_property_value('atmosphere/wind-field/time-offset-sec', 50.0)
+        for i in range(10):
+            fdm.run()
+        self.CheckField(fdm, 50.0)
+
+    def test_not_finite(self):
+        fdm = self.CreateFDM()
+        # A time that is not a number is located at the first node of the time
+        # axis.
+        fdm.set_property_value('atmosphere/wind-field/time-offset-sec',
+                               float('nan'))
+        fdm.run()
+        self.CheckField(fdm, -fdm.get_property_value('simulation/sim-time-sec'))
+
+    def test_shared_file(self):
+        fdm1 = self.CreateFDM()
+        fdm2 = self.CreateFDM()
+        for i in range(10):
+            fdm1.run()
+            fdm2.run()
+        self.CheckField(fdm1)
+        self.CheckField(fdm2)
+
+        # The mapping remains valid for the instance that keeps using it.
+        del fdm1
+        fdm2.run()
+        self.CheckField(fdm2)
+
+    def test_clear(self):
+        fdm = self.CreateFDM()
+        fdm.run()
+        fdm.clear_wind_field()
+        fdm.run()
+        fdm.run()
+
+        self.assertEqual(fdm.get_property_value('atmosphere/wind-field/wind-north-fps'), 0.0)
+        self.assertEqual(fdm.get_property_value('atmosphere/wind-field/temperature-R'), 0.0)
+        self.assertAlmostEqual(fdm.get_property_value('atmosphere/total-wind-north-fps'),
+                               0.0, delta=1E-8)
+        h = fdm.get_property_value('position/h-sl-ft')
+        self.assertNotAlmostEqual(fdm.get_property_value('atmosphere/T-R'),
+                                  Temperature(h), delta=1.0)
+
+    def test_invalid_file(self):
+        fdm = CreateFDM(self.sandbox)
+        f = open(self.sandbox('invalid.bin'), 'wb')
+        f.write(b'JSBWIND\0')
+        f.close()
+        self.assertRaises(RuntimeError, fdm.load_wind_field,
+                          self.sandbox('invalid.bin'))
+        self.assertRaises(RuntimeError, fdm.load_wind_field,
+                          self.sandbox('missing.bin'))
+
+suite = unittest.TestLoader().loadTestsFromTestCase(TestWindField)
+test_result = unittest.TextTestRunner(verbosity=2).run(suite)
+if test_result.failures or test_result.errors:
+    sys.exit(-1)  # 'make test' will report the test failed.
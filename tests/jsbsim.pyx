@@ -18,8 +18,9 @@
 from libcpp cimport bool
 from libcpp.string cimport string
 from libcpp.vector cimport vector
+from cpython cimport array
 
-import os, platform
+import os, platform, array
 
 cdef extern from "ExceptionManagement.h":
     cdef void convertJSBSimToPyExc()
@@ -30,11 +31,104 @@ cdef extern from "models/FGPropulsion.h" namespace "JSBSim":
         void InitRunning(int n)
         int GetNumEngines()
 
+cdef extern from "models/atmosphere/FGWinds.h" namespace "JSBSim":
+    cdef cppclass c_FGWinds "JSBSim::FGWinds":
+        c_FGWinds(c_FGFDMExec* fdm)
+        void LoadWindField(string filename) except +convertJSBSimToPyExc
+        void ClearWindField()
+
+cdef extern from "math/FGFunctionOptimizer.h" namespace "JSBSim":
+    cdef cppclass c_FGFunctionOptimizer "JSBSim::FGFunctionOptimizer":
+        unsigned int GetNumFoldedNodes()
+        unsigned int GetNumMergedNodes()
+        unsigned int GetNumSharedExpressions()
+
+cdef extern from "models/FGAtmosphere.h" namespace "JSBSim":
+    cdef cppclass c_FGAtmosphere "JSBSim::FGAtmosphere":
+        pass
+
+cdef extern from "models/atmosphere/FGMSIS.h" namespace "JSBSim":
+    cdef cppclass c_MSIS "JSBSim::MSIS"(c_FGAtmosphere):
+        void CalculateDirect(double& temperature, double& density)
+
 cdef extern from "initialization/FGInitialCondition.h" namespace "JSBSim":
     cdef cppclass c_FGInitialCondition "JSBSim::FGInitialCondition":
         c_FGInitialCondition(c_FGFDMExec* fdm)
         bool Load(string rstfile, bool useStoredPath)
 
+cdef extern from "input_output/FGSnapshot.h" namespace "JSBSim":
+    cdef cppclass c_FGSnapshot "JSBSim::FGSnapshot":
+        c_FGSnapshot()
+        bool IsEmpty()
+
+cdef extern from "input_output/FGPropertyManager.h" namespace "JSBSim":
+    cdef cppclass c_FGPropertyHandle "JSBSim::FGPropertyHandle":
+        c_FGPropertyHandle()
+        bool IsValid()
+        bool IsDirect()
+        double GetValue()
+        void SetValue(double value)
+
+cdef extern from "input_output/FGPropertyManager.h" namespace "JSBSim::FGPropertyHandle":
+    cdef void GetValues(const vector[c_FGPropertyHandle]& handles,
+                        double* values)
+    cdef void SetValues(const vector[c_FGPropertyHandle]& handles,
+                        const double* values)
+
+cdef extern from "input_output/FGXMLElement.h" namespace "JSBSim":
+    cdef cppclass c_Element "JSBSim::Element":
+        pass
+
+cdef extern from "input_output/FGXMLFileRead.h" namespace "JSBSim":
+    cdef cppclass c_FGXMLFileRead "JSBSim::FGXMLFileRead":
+        c_FGXMLFileRead()
+        c_Element* LoadXMLDocument(string filename, bool verbose)
+
+cdef extern from "simgear/props/props.hxx":
+    cdef cppclass c_SGPropertyNode "SGPropertyNode"
+
+    cdef cppclass c_SGPropertyNode_ptr "SGPropertyNode_ptr":
+        c_SGPropertyNode_ptr()
+        c_SGPropertyNode_ptr(c_SGPropertyNode* node)
+        c_SGPropertyNode* ptr()
+
+    cdef cppclass c_SGPropertyNode "SGPropertyNode":
+        string getNameString()
+        int getIndex()
+        int nChildren()
+        c_SGPropertyNode* getChild(int position)
+        c_SGPropertyNode* getChild(const string& name, int index, bool create)
+        vector[c_SGPropertyNode_ptr] addChildren(const string& name,
+                                                 size_t count, int min_index,
+                                                 bool append)
+        c_SGPropertyNode_ptr removeChild(const string& name, int index)
+        vector[c_SGPropertyNode_ptr] removeChildren(const string& name)
+        double getDoubleValue()
+        bool setDoubleValue(double value)
+
+cdef extern from "input_output/FGPropertyManager.h" namespace "JSBSim":
+    cdef cppclass c_FGPropertyManager "JSBSim::FGPropertyManager":
+        c_SGPropertyNode* GetNode(const string& path, bool create)
+
+cdef extern from "math/FGTable.h" namespace "JSBSim":
+    cdef cppclass c_FGTable "JSBSim::FGTable":
+        c_FGTable(c_FGPropertyManager* propMan,
+                  c_Element* el) except +convertJSBSimToPyExc
+        double GetValue(double key)
+        double GetValue(double rowKey, double colKey)
+        double GetValue(double rowKey, double colKey, double tableKey)
+        void GetValues(const double* keys, double* values, unsigned int n)
+        void GetValues(const double* rowKeys, const double* colKeys,
+                       double* values, unsigned int n)
+        void GetValues(const double* rowKeys, const double* colKeys,
+                       const double* tableKeys, double* values,
+                       unsigned int n)
+
+cdef extern from "FGFDMExec.h" namespace "JSBSim::FGFDMExec":
+    cdef enum eAtmosphereModel "JSBSim::FGFDMExec::eAtmosphereModel":
+        eStandardAtmosphere "JSBSim::FGFDMExec::eStandardAtmosphere"
+        eMSISAtmosphere "JSBSim::FGFDMExec::eMSISAtmosphere"
+
 cdef extern from "FGFDMExec.h" namespace "JSBSim":
     cdef cppclass c_FGFDMExec "JSBSim::FGFDMExec":
         c_FGFDMExec(int root, int fdmctr)
@@ -48,11 +142,14 @@ cdef extern from "FGFDMExec.h" namespace "JSBSim":
                        string systems_path,
                        string model,
                        bool add_model_to_path)
+        bool LoadModel(const c_FGFDMExec& fdmex)
         bool LoadScript(string script, double delta_t, string initfile) except +
         bool SetEnginePath(string path)
         bool SetAircraftPath(string path)
         bool SetSystemsPath(string path)
         void SetRootDir(string path)
+        void SetCacheDir(string path)
+        string GetCacheDir()
         string GetEnginePath()
         string GetAircraftPath()
         string GetSystemsPath()
@@ -60,6 +157,7 @@ cdef extern from "FGFDMExec.h" namespace "JSBSim":
         string GetFullAircraftPath()
         double GetPropertyValue(string property)
         void SetPropertyValue(string property, double value) except +convertJSBSimToPyExc
+        c_FGPropertyHandle GetPropertyHandle(string property, bool create)
         string GetModelName()
         bool SetOutputDirectives(string fname) except +
         #void ForceOutput(int idx=0)
@@ -91,7 +189,141 @@ cdef extern from "FGFDMExec.h" namespace "JSBSim":
         double IncrTime()
         int GetDebugLevel()
         c_FGPropulsion* GetPropulsion()
+        c_FGWinds* GetWinds()
+        c_FGAtmosphere* GetAtmosphere()
+        const c_FGFunctionOptimizer* GetFunctionOptimizer()
         c_FGInitialCondition* GetIC()
+        c_FGPropertyManager* GetPropertyManager()
+        void SaveState(c_FGSnapshot& snapshot)
+        bool RestoreState(c_FGSnapshot& snapshot)
+        bool SetAtmosphereModel(eAtmosphereModel model)
+        eAtmosphereModel GetAtmosphereModel()
+
+cdef extern from "math/FGStateSpace.h" namespace "JSBSim":
+    cdef cppclass c_Component "JSBSim::FGStateSpace::Component":
+        string getName()
+        string getUnit()
+
+    cdef cppclass c_ComponentVector "JSBSim::FGStateSpace::ComponentVector":
+        size_t getSize()
+        c_Component* getComp(int i)
+        double get(int i)
+        vector[double] get()
+        double getDeriv(int i)
+        void set(int i, double val)
+        void set(vector[double] vals)
+
+    cdef cppclass c_FGStateSpace "JSBSim::FGStateSpace":
+        c_ComponentVector x, u, y
+        c_FGStateSpace(c_FGFDMExec* fdm)
+        void setNumThreads(unsigned int nthreads)
+        void linearize(vector[double] x0, vector[double] u0,
+                       vector[double] y0, vector[vector[double]]& A,
+                       vector[vector[double]]& B, vector[vector[double]]& C,
+                       vector[vector[double]]& D) except +convertJSBSimToPyExc
+
+cdef extern from "initialization/FGLinearization.h" namespace "JSBSim::FGLinearization":
+    cdef void setupStateSpace(c_FGFDMExec* fdm, c_FGStateSpace& ss)
+
+cdef extern from "FGBatchExec.h" namespace "JSBSim":
+    cdef cppclass c_FGBatchExec "JSBSim::FGBatchExec":
+        c_FGBatchExec(unsigned int nthreads)
+        c_FGFDMExec* AddInstance()
+        c_FGFDMExec* GetInstance(unsigned int idx)
+        unsigned int GetNumInstances()
+        unsigned int GetNumThreads()
+        bool IsRunning(unsigned int idx)
+        string GetError(unsigned int idx)
+        bool RunIC() except +
+        bool Run(unsigned int steps) except +
+
+cdef extern from "FGRealTimeScheduler.h" namespace "JSBSim":
+    cdef cppclass c_FGRealTimeScheduler "JSBSim::FGRealTimeScheduler":
+        c_FGRealTimeScheduler(c_FGFDMExec* fdm)
+        void SetMaxCatchUpFrames(int frames)
+        int GetMaxCatchUpFrames()
+        void Start()
+        bool Run() except +convertJSBSimToPyExc
+        void Pause()
+        void Resume()
+        double GetElapsedTime()
+
+cdef extern from "FGMonteCarlo.h" namespace "JSBSim":
+    cdef cppclass c_FGMonteCarlo "JSBSim::FGMonteCarlo":
+        c_FGMonteCarlo(unsigned int nthreads)
+        void SetRootDir(string rootDir)
+        void SetAircraftPath(string path)
+        void SetEnginePath(string path)
+        void SetSystemsPath(string path)
+        bool Load(string filename) except +
+        void SetScript(string script)
+        void SetNumRuns(unsigned int runs)
+        unsigned int GetNumRuns()
+        void SetSeed(unsigned int seed)
+        unsigned int GetSeed()
+        void SetResultsFile(string fname)
+        string GetResultsFile()
+        bool AddDispersion(string property, string type, double dispersion)
+        void AddSummary(string property)
+        bool Run() except +
+        unsigned int GetNumFailures()
+
+# this is the python wrapper of the snapshots
+cdef class FGSnapshot:
+
+    cdef c_FGSnapshot *thisptr
+
+    def __cinit__(self, **kwargs):
+        self.thisptr = new c_FGSnapshot()
+        if self.thisptr is NULL:
+            raise MemoryError()
+
+    def __dealloc__(self):
+        del self.thisptr
+
+    def is_empty(self):
+        return self.thisptr.IsEmpty()
+
+# this is the python wrapper of a set of property handles
+cdef class FGPropertyHandles:
+    """
+    Set of properties which are looked up once for all. Their values are
+    transferred in bulk from or to an array of doubles (array.array('d'),
+    numpy array or any object that exposes a contiguous buffer of doubles).
+    """
+
+    cdef vector[c_FGPropertyHandle] handles
+    cdef object fdm  # Keeps the FGFDMExec instance alive
+
+    def __len__(self):
+        return self.handles.size()
+
+    def get_values(self, double[::1] values=None):
+        """
+        Reads the values of the properties.
+        @param values the array that receives the values. A new array is
+                      created if it is not supplied.
+        @return the array of the values.
+        """
+        if values is None:
+            values = array.array('d', [0.0]) * self.handles.size()
+        if values.shape[0] < self.handles.size():
+            raise ValueError("The array must hold at least {0} values"
+                             .format(self.handles.size()))
+        if self.handles.size() > 0:
+            GetValues(self.handles, &values[0])
+        return values.base
+
+    def set_values(self, double[::1] values):
+        """
+        Modifies the values of the properties.
+        @param values the array of the values.
+        """
+        if values.shape[0] < self.handles.size():
+            raise ValueError("The array must hold at least {0} values"
+                             .format(self.handles.size()))
+        if self.handles.size() > 0:
+            SetValues(self.handles, &values[0])
 
 # this is the python wrapper class
 cdef class FGFDMExec:
@@ -230,6 +462,16 @@ cdef class FGFDMExec:
         return self.thisptr.LoadModel(model, aircraft_path,
             engine_path, systems_path, add_model_to_path)
 
+    def load_model_from(self, FGFDMExec fdmex):
+        """
+        Loads the aircraft model that another instance has already loaded. The
+        files of the model are not read again: they are shared with the other
+        instance.
+        @param fdmex the instance that has loaded the model
+        @return true if successful
+        """
+        return self.thisptr.LoadModel(fdmex.thisptr[0])
+
     def load_script(self, script, delta_t=0.0, initfile=""):
         """
         Loads a script
@@ -313,6 +555,21 @@ cdef class FGFDMExec:
         """
         return self.thisptr.GetRootDir()
 
+    def set_cache_dir(self, path):
+        """
+        Sets the directory where a binary form of the model files is stored to
+        speed up the next loadings of the model.
+        @param path the path to the directory
+        """
+        self.thisptr.SetCacheDir(path)
+
+    def get_cache_dir(self):
+        """
+        Retrieves the directory where a binary form of the model files is
+        stored.
+        """
+        return self.thisptr.GetCacheDir()
+
     def get_property_value(self, name):
         """
         Retrieves the value of a property.
@@ -329,6 +586,23 @@ cdef class FGFDMExec:
         """
         self.thisptr.SetPropertyValue(name, value)
 
+    def get_property_handles(self, names):
+        """
+        Looks up a set of properties once for all. The handles must be
+        requested again when the model is reloaded.
+        @param names the names of the properties
+        @result a FGPropertyHandles object
+        """
+        cdef FGPropertyHandles result = FGPropertyHandles()
+        cdef c_FGPropertyHandle handle
+        for name in names:
+            handle = self.thisptr.GetPropertyHandle(name, False)
+            if not handle.IsValid():
+                raise KeyError("Unknown property: {0}".format(name))
+            result.handles.push_back(handle)
+        result.fdm = self
+        return result
+
     def get_model_name(self):
         """
         Retrieves the model name.
@@ -557,5 +831,488 @@ cdef class FGFDMExec:
     def propulsion_get_num_engines(self):
         return self.thisptr.GetPropulsion().GetNumEngines()
 
+    def load_wind_field(self, filename):
+        """
+        Loads a wind field gridded in latitude, longitude, altitude and time.
+        The file is mapped once for all the instances that load it.
+        """
+        self.thisptr.GetWinds().LoadWindField(filename)
+
+    def clear_wind_field(self):
+        """
+        Removes the wind field.
+        """
+        self.thisptr.GetWinds().ClearWindField()
+
+    def set_atmosphere_model(self, model):
+        """
+        Selects the model of the atmosphere: 'standard' or 'msis'. It must be
+        selected before the aircraft is loaded.
+        """
+        if model == 'standard':
+            return self.thisptr.SetAtmosphereModel(eStandardAtmosphere)
+        elif model == 'msis':
+            return self.thisptr.SetAtmosphereModel(eMSISAtmosphere)
+        raise ValueError("Unknown atmosphere model: " + model)
+
+    def get_atmosphere_model(self):
+        if self.thisptr.GetAtmosphereModel() == eMSISAtmosphere:
+            return 'msis'
+        return 'standard'
+
+    def get_function_optimizer_stats(self):
+        """
+        Returns the number of constant nodes folded, the number of nodes merged
+        and the number of shared expressions of the functions of the aircraft,
+        or None if the optimization of the functions is disabled.
+        """
+        cdef const c_FGFunctionOptimizer* optimizer = self.thisptr.GetFunctionOptimizer()
+        if optimizer == NULL:
+            return None
+        return (optimizer.GetNumFoldedNodes(), optimizer.GetNumMergedNodes(),
+                optimizer.GetNumSharedExpressions())
+
+    def get_msis_direct(self):
+        """
+        Returns the temperature (Rankine) and the density (slugs/ft^3) that
+        NRLMSISE-00 computes at the current location without the profile.
+        """
+        cdef double temperature = 0.0, density = 0.0
+        if self.thisptr.GetAtmosphereModel() != eMSISAtmosphere:
+            raise RuntimeError("The atmosphere model is not MSIS")
+        (<c_MSIS*>self.thisptr.GetAtmosphere()).CalculateDirect(temperature,
+                                                              density)
+        return temperature, density
+
+    def get_property_node(self, path, bool create=True):
+        """
+        Returns the node of a property or None if it does not exist.
+        """
+        return WrapPropertyNode(self.thisptr.GetPropertyManager().GetNode(path,
+                                                                         create))
+
     def load_ic(self, rstfile, useStoredPath):
         return self.thisptr.GetIC().Load(rstfile, useStoredPath)
+
+    def save_state(self, FGSnapshot snapshot):
+        """
+        Saves the state of the simulation in a snapshot.
+        """
+        self.thisptr.SaveState(snapshot.thisptr[0])
+
+    def restore_state(self, FGSnapshot snapshot):
+        """
+        Restores the state of the simulation from a snapshot.
+        @return false if the snapshot does not match the model.
+        """
+        return self.thisptr.RestoreState(snapshot.thisptr[0])
+
+# this is the python wrapper of the property nodes
+cdef class FGPropertyNode:
+    """
+    A node of the property tree. The node is kept alive by the wrapper even
+    after it has been removed from the tree.
+    """
+
+    cdef c_SGPropertyNode_ptr node
+
+    def __richcmp__(FGPropertyNode self, FGPropertyNode other, int op):
+        if op == 2:
+            return self.node.ptr() == other.node.ptr()
+        elif op == 3:
+            return self.node.ptr() != other.node.ptr()
+        return NotImplemented
+
+    def get_name(self):
+        return self.node.ptr().getNameString()
+
+    def get_index(self):
+        return self.node.ptr().getIndex()
+
+    def get_double_value(self):
+        return self.node.ptr().getDoubleValue()
+
+    def set_double_value(self, double value):
+        self.node.ptr().setDoubleValue(value)
+
+    def n_children(self):
+        return self.node.ptr().nChildren()
+
+    def get_child_at(self, int position):
+        """
+        Returns the child at a position in the list of the children.
+        """
+        return WrapPropertyNode(self.node.ptr().getChild(position))
+
+    def get_child(self, name, int index=0, bool create=False):
+        """
+        Returns the child with a name and an index or None if there is none.
+        """
+        return WrapPropertyNode(self.node.ptr().getChild(name, index, create))
+
+    def add_children(self, name, size_t count, int min_index=0,
+                     bool append=True):
+        return WrapPropertyList(self.node.ptr().addChildren(name, count,
+                                                            min_index, append))
+
+    def remove_child(self, name, int index=0):
+        return WrapPropertyNode(self.node.ptr().removeChild(name, index).ptr())
+
+    def remove_children(self, name):
+        return WrapPropertyList(self.node.ptr().removeChildren(name))
+
+cdef WrapPropertyNode(c_SGPropertyNode* node):
+    if node is NULL:
+        return None
+    cdef FGPropertyNode wrapper = FGPropertyNode()
+    wrapper.node = c_SGPropertyNode_ptr(node)
+    return wrapper
+
+cdef WrapPropertyList(const vector[c_SGPropertyNode_ptr]& nodes):
+    return [WrapPropertyNode(nodes[i].ptr()) for i in range(nodes.size())]
+
+# this is the python wrapper of the lookup tables
+cdef class FGTable:
+
+    cdef c_FGTable *thisptr
+    cdef FGFDMExec fdm
+
+    def __cinit__(self, FGFDMExec fdm, filename):
+        cdef c_FGXMLFileRead reader
+        cdef c_Element* document = reader.LoadXMLDocument(filename, True)
+        if document is NULL:
+            raise IOError("Could not read the table in " + filename)
+        self.fdm = fdm
+        self.thisptr = new c_FGTable(fdm.thisptr.GetPropertyManager(),
+                                     document)
+
+    def __dealloc__(self):
+        del self.thisptr
+
+    def get_value(self, *keys):
+        """
+        Looks up a single key (1D), pair (2D) or triplet (3D) of keys.
+        """
+        if len(keys) == 1:
+            return self.thisptr.GetValue(<double>keys[0])
+        elif len(keys) == 2:
+            return self.thisptr.GetValue(<double>keys[0], <double>keys[1])
+        elif len(keys) == 3:
+            return self.thisptr.GetValue(<double>keys[0], <double>keys[1],
+                                         <double>keys[2])
+        raise ValueError("A table takes 1 to 3 keys")
+
+    def get_values(self, *keys):
+        """
+        Looks up the keys of one, two or three sequences at once.
+        @return an array of the values.
+        """
+        cdef array.array rows = array.array('d', keys[0])
+        cdef array.array cols, tables
+        cdef unsigned int n = len(rows)
+        cdef array.array values = array.clone(rows, n, False)
+        if len(keys) == 1:
+            self.thisptr.GetValues(rows.data.as_doubles,
+                                   values.data.as_doubles, n)
+        elif len(keys) == 2:
+            cols = array.array('d', keys[1])
+            self.thisptr.GetValues(rows.data.as_doubles,
+                                   cols.data.as_doubles,
+                                   values.data.as_doubles, n)
+        elif len(keys) == 3:
+            cols = array.array('d', keys[1])
+            tables = array.array('d', keys[2])
+            self.thisptr.GetValues(rows.data.as_doubles,
+                                   cols.data.as_doubles,
+                                   tables.data.as_doubles,
+                                   values.data.as_doubles, n)
+        else:
+            raise ValueError("A table takes 1 to 3 keys")
+        return values
+
+# this is the python wrapper of the batch executor
+cdef class FGBatchExec:
+
+    cdef c_FGBatchExec *thisptr
+
+    def __cinit__(self, num_threads=0, **kwargs):
+        self.thisptr = new c_FGBatchExec(num_threads)
+        if self.thisptr is NULL:
+            raise MemoryError()
+
+    def __dealloc__(self):
+        del self.thisptr
+
+    cdef c_FGFDMExec* instance(self, idx) except NULL:
+        if idx < 0 or idx >= self.thisptr.GetNumInstances():
+            raise IndexError("No instance #{0} in the batch".format(idx))
+        return self.thisptr.GetInstance(idx)
+
+    def add_instance(self, root_dir, aircraft_path="aircraft",
+                     engine_path="engine", systems_path="systems"):
+        """
+        Creates a new instance in the batch.
+        @param root_dir the root directory of the instance.
+        @return the index of the new instance.
+        """
+        cdef c_FGFDMExec* fdm = self.thisptr.AddInstance()
+        fdm.SetRootDir(root_dir)
+        fdm.SetAircraftPath(aircraft_path)
+        fdm.SetEnginePath(engine_path)
+        fdm.SetSystemsPath(systems_path)
+        return self.thisptr.GetNumInstances()-1
+
+    def get_num_instances(self):
+        return self.thisptr.GetNumInstances()
+
+    def get_num_threads(self):
+        return self.thisptr.GetNumThreads()
+
+    def load_script(self, idx, script, delta_t=0.0, initfile=""):
+        """
+        Loads a script in an instance of the batch.
+        @see FGFDMExec.load_script
+        """
+        return self.instance(idx).LoadScript(script, delta_t, initfile)
+
+    def load_model(self, idx, model, add_model_to_path=True):
+        """
+        Loads an aircraft model in an instance of the batch.
+        @see FGFDMExec.load_model
+        """
+        return self.instance(idx).LoadModel(model, add_model_to_path)
+
+    def do_disable_output(self, idx):
+        self.instance(idx).DisableOutput()
+
+    def get_property_value(self, idx, name):
+        return self.instance(idx).GetPropertyValue(name)
+
+    def set_property_value(self, idx, name, value):
+        self.instance(idx).SetPropertyValue(name, value)
+
+    def get_sim_time(self, idx):
+        return self.instance(idx).GetSimTime()
+
+    def is_running(self, idx):
+        """
+        Checks if an instance is still running.
+        """
+        return self.thisptr.IsRunning(idx)
+
+    def get_error(self, idx):
+        """
+        Returns the message of the exception that stopped an instance.
+        """
+        return self.thisptr.GetError(idx)
+
+    def run_ic(self):
+        """
+        Initializes all the instances in parallel.
+        @return true if at least one instance is still running.
+        """
+        return self.thisptr.RunIC()
+
+    def run(self, steps=1):
+        """
+        Executes a number of time steps for all the instances in parallel.
+        @return true if at least one instance is still running.
+        """
+        return self.thisptr.Run(steps)
+
+# this is the python wrapper of the Monte Carlo campaigns
+cdef class FGMonteCarlo:
+
+    cdef c_FGMonteCarlo *thisptr
+
+    def __cinit__(self, num_threads=0, **kwargs):
+        self.thisptr = new c_FGMonteCarlo(num_threads)
+        if self.thisptr is NULL:
+            raise MemoryError()
+
+    def __dealloc__(self):
+        del self.thisptr
+
+    def set_paths(self, root_dir, aircraft_path="aircraft",
+                  engine_path="engine", systems_path="systems"):
+        """
+        Sets the paths of the instances run by the campaign.
+        """
+        self.thisptr.SetRootDir(root_dir)
+        self.thisptr.SetAircraftPath(aircraft_path)
+        self.thisptr.SetEnginePath(engine_path)
+        self.thisptr.SetSystemsPath(systems_path)
+
+    def load(self, filename):
+        """
+        Loads a campaign file.
+        @param filename the file name relative to the root directory.
+        @return true if the campaign has been successfully loaded.
+        """
+        return self.thisptr.Load(filename)
+
+    def set_script(self, script):
+        self.thisptr.SetScript(script)
+
+    def set_num_runs(self, runs):
+        self.thisptr.SetNumRuns(runs)
+
+    def get_num_runs(self):
+        return self.thisptr.GetNumRuns()
+
+    def set_seed(self, seed):
+        self.thisptr.SetSeed(seed)
+
+    def get_seed(self):
+        return self.thisptr.GetSeed()
+
+    def set_results_file(self, fname):
+        self.thisptr.SetResultsFile(fname)
+
+    def get_results_file(self):
+        return self.thisptr.GetResultsFile()
+
+    def add_dispersion(self, prop, dispersion_type, dispersion):
+        """
+        Adds a dispersed property.
+        @return false if the type of the dispersion is unknown.
+        """
+        return self.thisptr.AddDispersion(prop, dispersion_type, dispersion)
+
+    def add_summary(self, prop):
+        self.thisptr.AddSummary(prop)
+
+    def run(self):
+        """
+        Runs the campaign and writes the results file.
+        @return false if the campaign could not be started.
+        """
+        return self.thisptr.Run()
+
+    def get_num_failures(self):
+        return self.thisptr.GetNumFailures()
+
+# this is the python wrapper of the state space of the linearization
+cdef class FGStateSpace:
+    """
+    States, inputs and outputs of the linearization of an aircraft (see
+    FGLinearization). The vectors are named 'x', 'u' and 'y', the outputs
+    being the states.
+    """
+
+    cdef c_FGStateSpace *thisptr
+    cdef FGFDMExec fdm
+
+    def __cinit__(self, FGFDMExec fdm):
+        self.fdm = fdm
+        self.thisptr = new c_FGStateSpace(fdm.thisptr)
+        setupStateSpace(fdm.thisptr, self.thisptr[0])
+
+    def __dealloc__(self):
+        cdef size_t i
+        cdef c_Component* comp
+        if self.thisptr is not NULL:
+            # the outputs share the components of the states
+            for i in range(self.thisptr.x.getSize()):
+                comp = self.thisptr.x.getComp(i)
+                del comp
+            for i in range(self.thisptr.u.getSize()):
+                comp = self.thisptr.u.getComp(i)
+                del comp
+            del self.thisptr
+
+    cdef c_ComponentVector* vector(self, name) except NULL:
+        if name == 'x':
+            return &self.thisptr.x
+        elif name == 'u':
+            return &self.thisptr.u
+        elif name == 'y':
+            return &self.thisptr.y
+        raise ValueError("Unknown vector: {0}".format(name))
+
+    def get_size(self, name):
+        return self.vector(name).getSize()
+
+    def get_names(self, name):
+        cdef c_ComponentVector* v = self.vector(name)
+        return [v.getComp(i).getName() for i in range(v.getSize())]
+
+    def get_units(self, name):
+        cdef c_ComponentVector* v = self.vector(name)
+        return [v.getComp(i).getUnit() for i in range(v.getSize())]
+
+    def get(self, name):
+        return list(self.vector(name).get())
+
+    def get_element(self, name, int i):
+        return self.vector(name).get(i)
+
+    def get_deriv(self, name, int i):
+        return self.vector(name).getDeriv(i)
+
+    def set(self, name, values):
+        """
+        Sets all the components of a vector then runs the fdm to a steady
+        state.
+        """
+        self.vector(name).set(<vector[double]>values)
+
+    def set_element(self, name, int i, double value):
+        self.vector(name).set(i, value)
+
+    def linearize(self, unsigned int num_threads=1):
+        """
+        Linearizes the model about its current state, which is not modified.
+        @param num_threads the number of threads (0 for one per hardware
+                           thread).
+        @return the matrices (A, B, C, D) as lists of rows.
+        """
+        cdef vector[vector[double]] A, B, C, D
+        cdef vector[double] x0 = self.thisptr.x.get()
+        self.thisptr.setNumThreads(num_threads)
+        self.thisptr.linearize(x0, self.thisptr.u.get(), x0, A, B, C, D)
+        return ([list(row) for row in A], [list(row) for row in B],
+                [list(row) for row in C], [list(row) for row in D])
+
+# this is the python wrapper of the real time scheduler
+cdef class FGRealTimeScheduler:
+    """
+    Runs the frames of an instance in real time. The overrun policy and the
+    statistics are properties of the instance under simulation/realtime/.
+    """
+
+    cdef c_FGRealTimeScheduler *thisptr
+    cdef FGFDMExec fdm
+
+    def __cinit__(self, FGFDMExec fdm):
+        self.fdm = fdm
+        self.thisptr = new c_FGRealTimeScheduler(fdm.thisptr)
+
+    def __dealloc__(self):
+        del self.thisptr
+
+    def set_max_catch_up_frames(self, int frames):
+        self.thisptr.SetMaxCatchUpFrames(frames)
+
+    def get_max_catch_up_frames(self):
+        return self.thisptr.GetMaxCatchUpFrames()
+
+    def start(self):
+        self.thisptr.Start()
+
+    def run(self):
+        """
+        Waits for the next deadline and runs the frames that the overrun
+        policy schedules.
+        @return false when the simulation is over.
+        """
+        return self.thisptr.Run()
+
+    def pause(self):
+        self.thisptr.Pause()
+
+    def resume(self):
+        self.thisptr.Resume()
+
+    def get_elapsed_time(self):
+        return self.thisptr.GetElapsedTime()